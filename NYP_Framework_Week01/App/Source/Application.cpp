@@ -18,15 +18,32 @@
 #endif
 
 // Include CSettings which stores information about the App
-#include "GameControl\Settings.h"
+#include "GameControl/Settings.h"
 // Include CShaderManager which manages the shaders used in this App
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
+// Include CRenderState which skips the redundant OpenGL state changes
+#include "RenderControl/RenderState.h"
+// Include CGPUTimer which times the render passes on the GPU
+#include "RenderControl/GPUTimer.h"
+// Include CGLTelemetry which counts the OpenGL calls of each frame
+#include "RenderControl/GLTelemetry.h"
+// Include CJobSystem which runs jobs on the worker threads
+#include "JobControl/JobSystem.h"
+// Include CRandomService which gives out the seeded random numbers
+#include "System/Random.h"
+// Include CProfiler which times the zones of each frame
+#include "TimeControl/Profiler.h"
+// Include CPerfCounters which counts the hardware events of the zones
+#include "TimeControl/PerfCounters.h"
+// Include CMemoryTracker which counts the allocations of each frame
+#include "System/MemoryTracker.h"
 
 #include "SoundController/SoundController.h"
 
 // Inputs
-#include "Inputs\KeyboardController.h"
-#include "Inputs\MouseController.h"
+#include "Inputs/KeyboardController.h"
+#include "Inputs/MouseController.h"
+#include "Inputs/InputRecorder.h"
 
 #include "GameStateManagement/GameStateManager.h"
 #include "GameStateManagement/IntroState.h"
@@ -67,6 +84,10 @@ static void error_callback(int error, const char* description)
  */
 static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
+	// The keys come from the recording during a replay
+	if (CInputRecorder::GetInstance()->IsReplaying())
+		return;
+
 	CKeyboardController::GetInstance()->Update(key, action);
 }
 
@@ -109,6 +130,10 @@ void resize_callback(GLFWwindow* window, int width, int height)
  */
 void MouseButtonCallbacks(GLFWwindow* window, int button, int action, int mods)
 {
+	// The buttons come from the recording during a replay
+	if (CInputRecorder::GetInstance()->IsReplaying())
+		return;
+
 	// Send the callback to the mouse controller to handle
 	if (action == GLFW_PRESS)
 		CMouseController::GetInstance()->UpdateMouseButtonPressed(button);
@@ -124,6 +149,10 @@ void MouseButtonCallbacks(GLFWwindow* window, int button, int action, int mods)
  */
 void MouseScrollCallbacks(GLFWwindow* window, double xoffset, double yoffset)
 {
+	// The scrolling comes from the recording during a replay
+	if (CInputRecorder::GetInstance()->IsReplaying())
+		return;
+
 	CMouseController::GetInstance()->UpdateMouseScroll(xoffset, yoffset);
 }
 
@@ -221,6 +250,9 @@ bool Application::Init(void)
 		return false;
 	}
 
+	// Create the queries which time the render passes on the GPU. The game still runs without them, untimed.
+	CGPUTimer::GetInstance()->Init();
+
 	// Add the shaders to the ShaderManager
 	CShaderManager::GetInstance()->Add("Shader2D", "Shader//Shader2D.vs", "Shader//Shader2D.fs");
 	CShaderManager::GetInstance()->Add("Shader2D_Colour", "Shader//Shader2D_Colour.vs", "Shader//Shader2D_Colour.fs");
@@ -235,6 +267,17 @@ bool Application::Init(void)
 	// Initialise the CFPSCounter instance
 	cFPSCounter = CFPSCounter::GetInstance();
 	cFPSCounter->Init();
+	// A frame which takes twice as long as it should is a hitch
+	cFPSCounter->SetHitchThreshold(2000.0 / cSettings->FPS);
+
+	// Name the main thread in the profiler. This creates the CProfiler before the worker threads use it.
+	PROFILE_THREAD("Main");
+
+	// Start the worker threads of the CJobSystem
+	if (CJobSystem::GetInstance()->Init() == false)
+	{
+		return false;
+	}
 
 	if (CSoundController::GetInstance()->Init() == false)
 	{
@@ -249,7 +292,11 @@ bool Application::Init(void)
 
 	CGameStateManager::GetInstance()->AddGameState("END", new Cend);
 
-	CGameStateManager::GetInstance()->SetActiveGameState("IntroState");
+	// A recording starts at the first tick of the world, so a replay goes straight into the game
+	if (CInputRecorder::GetInstance()->IsReplaying())
+		CGameStateManager::GetInstance()->SetActiveGameState("PlayGameState");
+	else
+		CGameStateManager::GetInstance()->SetActiveGameState("IntroState");
 	return true;
 }
 
@@ -258,12 +305,17 @@ bool Application::Init(void)
 */ 
 void Application::Run(void)
 {
-	// Start timer to calculate how long it takes to render this frame
-	cStopWatch.StartTimer();
+	// Start the first frame, paced to the frame rate in CSettings as its pacing mode says.
+	// A replay runs one tick in each frame, as fast as it can, so that it can be used as a benchmark.
+	const bool bReplaying = CInputRecorder::GetInstance()->IsReplaying();
+	cFramePacer.Init(bReplaying ? CFramePacer::UNCAPPED : cSettings->ePacingMode, cSettings->FPS);
 
 	double dElapsedTime = 0.0;
-	double dDelayTime = 0.0;
-	double dTotalFrameTime = 0.0;
+
+	// The simulation is updated in fixed ticks. The time of the frames is added up, and used up one tick at a time.
+	// Each tick steps CSettings::dTickGameTime of game time, which is not the time between the ticks.
+	const double dTickTime = 1.0 / cSettings->iTickRate;
+	double dAccumulator = 0.0;
 
 	// Render loop
 	while (!glfwWindowShouldClose(cSettings->pWindow)
@@ -274,25 +326,76 @@ void Application::Run(void)
 		cScene2D->PreRender();
 		cScene2D->Render();
 		cScene2D->PostRender();*/
-		// This is to prevent the program from crashing due to long dElapsedTime
-		// Causing Physics to calculate a large jump/fall for the player
-		if (dElapsedTime > 0.0166666666666667)
-			dElapsedTime = 0.0166666666666667;
-
-		if (CGameStateManager::GetInstance()->Update(dElapsedTime) == false)
+		// Drop the time which is more than the ticks allowed in one frame. Otherwise a frame which is slow
+		// would need more ticks in the next frame, making it slower still, until the game stops responding.
+		if (dElapsedTime > dTickTime * cSettings->iMaxTicksPerFrame)
+			dElapsedTime = dTickTime * cSettings->iMaxTicksPerFrame;
+		if (bReplaying)
+			dAccumulator = dTickTime;
+		else
+			dAccumulator += dElapsedTime;
+
+		// Time the updates and the rendering of this frame apart
+		cSectionStopWatch.GetElapsedTime();
+
+		bool bQuit = false;
+		while (dAccumulator >= dTickTime)
+		{
+			PROFILE_ZONE("Tick");
+
+			// No jobs are running between ticks, so the scratch memory of the last tick can be reused
+			CJobSystem::GetInstance()->ResetScratchArenas();
+
+			// CWorld2D records the inputs of each of its ticks, or replaces them with the recorded ones.
+			// The run ends after the last recorded tick.
+			if (CInputRecorder::GetInstance()->IsReplayFinished())
+			{
+				bQuit = true;
+				break;
+			}
+
+			if (CGameStateManager::GetInstance()->Update(cSettings->dTickGameTime) == false)
+			{
+				bQuit = true;
+				break;
+			}
+			dAccumulator -= dTickTime;
+
+			// A key press is only seen by the first tick which runs after it
+			PostUpdateInputDevices();
+		}
+		if (bQuit == true)
 		{
 			break;
 		}
 
-		CGameStateManager::GetInstance()->Render();
+		cFPSCounter->SetUpdateTime(cSectionStopWatch.GetElapsedTime());
+
+		// Render the entities between the last two ticks, by how far this frame is into the next tick
+		cSettings->fTickInterpolation = (float)(dAccumulator / dTickTime);
+
+		// Start counting the OpenGL state changes of this frame
+		CRenderState::GetInstance()->NewFrame();
+		CGLTelemetry::GetInstance()->NewFrame();
+
+		{
+			PROFILE_ZONE("Render");
+			CGameStateManager::GetInstance()->Render();
+		}
 
 
 		// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
 		// -------------------------------------------------------------------------------
-		glfwSwapBuffers(cSettings->pWindow);
+		{
+			PROFILE_ZONE("SwapBuffers");
+			glfwSwapBuffers(cSettings->pWindow);
+		}
+		cFPSCounter->SetRenderTime(cSectionStopWatch.GetElapsedTime());
 
-		// Perform Post Update Input Devices
-		PostUpdateInputDevices();
+		// Read back the GPU times of an earlier frame, if they are ready
+		CGPUTimer::GetInstance()->EndFrame();
+		cFramePacer.SetGPUTime(CGPUTimer::GetInstance()->GetFrameTime() / 1000.0);
+		cFPSCounter->SetGPUTime(CGPUTimer::GetInstance()->GetFrameTime() / 1000.0);
 
 		// Poll events
 		glfwPollEvents();
@@ -300,16 +403,19 @@ void Application::Run(void)
 		// Update Input Devices
 		UpdateInputDevices();
 
-		// Calculate the elapsed time since the last frame
-		dElapsedTime = cStopWatch.GetElapsedTime();
-
-		// Frame rate limiter. Limits each frame to a specified time in ms by sleeping.  
-		dDelayTime = cSettings->frameTime - dElapsedTime * 1000;
-		cStopWatch.WaitUntil((const long long)dDelayTime);
+		// Frame rate limiter. Waits until the end of this frame, and calculates the elapsed time since the last frame.
+		{
+			PROFILE_ZONE("Pace");
+			dElapsedTime = cFramePacer.Pace();
+		}
 
 		// Update the FPS Counter
-		dTotalFrameTime = dElapsedTime + dDelayTime * 0.001;
-		cFPSCounter->Update(dTotalFrameTime);
+		cFPSCounter->Update(dElapsedTime);
+
+		// Collect the zones of this frame for the flame view and the capture
+		PROFILE_END_FRAME();
+		// Keep the allocations of this frame, and check them against the budget
+		CMemoryTracker::EndFrame();
 	}
 }
 
@@ -318,10 +424,36 @@ void Application::Run(void)
  */
 void Application::Destroy(void)
 {
+	// Stop the worker threads before anything which their jobs may use is destroyed
+	CJobSystem::GetInstance()->Destroy();
+
+	// Write the capture of the profiler, if it is running. No thread times a zone after this.
+	CProfiler::GetInstance()->Destroy();
+
+	// Print the hardware events of the zones, when it is built with ENABLE_PERF_COUNTERS
+	if (CPerfCounters::IsEnabled())
+		CPerfCounters::GetInstance()->PrintReport(cout);
+	CPerfCounters::GetInstance()->Destroy();
+	// Print the allocations of each subsystem per frame, when they are counted in this build
+	if (CMemoryTracker::IsEnabled())
+		CMemoryTracker::PrintReport(cout);
+
+	// Write the recording to its file
+	CInputRecorder::GetInstance()->Destroy();
 
 	CSoundController::GetInstance()->Destroy();
+	// Destroy the RandomService
+	CRandomService::GetInstance()->Destroy();
 	// Destory the ShaderManager
 	CShaderManager::GetInstance()->Destroy();
+	// Destroy the RenderState
+	CRenderState::GetInstance()->Destroy();
+	// Destroy the GPUTimer while the OpenGL context still exists
+	CGPUTimer::GetInstance()->Destroy();
+	// Print the textures, buffers and vertex arrays which were never deleted, when they are tracked in this build
+	if (CGLTelemetry::IsEnabled())
+		CGLTelemetry::GetInstance()->PrintLeakReport(cout);
+	CGLTelemetry::GetInstance()->Destroy();
 
 	// Destroy the mouse instance
 	CMouseController::GetInstance()->Destroy();
@@ -373,6 +505,10 @@ Application::Application(void)
 */
 void Application::UpdateInputDevices(void)
 {
+	// The mouse position comes from the recording during a replay
+	if (CInputRecorder::GetInstance()->IsReplaying())
+		return;
+
 	// Update Mouse Position
 	double dMouse_X, dMouse_Y;
 	glfwGetCursorPos( cSettings->pWindow, &dMouse_X, &dMouse_Y);
@@ -7,12 +7,13 @@
 #pragma once
 
 // Include SingletonTemplate
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
-#include "TimeControl\StopWatch.h"
+// Frame Pacer
+#include "TimeControl/FramePacer.h"
 
 // FPS Counter
-#include "TimeControl\FPSCounter.h"
+#include "TimeControl/FPSCounter.h"
 
 //#include "Scene2D/Scene2D.h"
 
@@ -39,8 +40,10 @@ public:
 	int GetWindowWidth(void) const;
 	
 protected:
-	// Declare timer for calculating time per frame
-	CStopWatch cStopWatch;
+	// Declare the frame pacer for holding the frame rate and calculating time per frame
+	CFramePacer cFramePacer;
+	// Times the updates and the rendering of each frame, for the CFPSCounter
+	CStopWatch cSectionStopWatch;
 
 	// The handler to the CSettings instance
 	CSettings* cSettings;
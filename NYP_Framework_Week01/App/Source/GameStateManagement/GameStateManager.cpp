@@ -1,5 +1,8 @@
 #include "GameStateManager.h"
 
+// Include CProfiler to time the zones of the frame
+#include "TimeControl/Profiler.h"
+
 #include <iostream>
 
 using namespace std;
@@ -33,15 +36,13 @@ void CGameStateManager::Destroy(void)
 	prevGameState = nullptr;
 	pauseGameState = nullptr;
 
-	// Delete all scenes stored and empty the entire map
-	std::map<std::string, CGameStateBase*>::iterator it, end;
-	end = GameStateMap.end();
-	for (it = GameStateMap.begin(); it != end; ++it)
+	// Delete all scenes stored and empty the entire registry
+	for (int iHandle = 0; iHandle < GameStateRegistry.GetNumHandles(); iHandle++)
 	{
-		delete it->second;
+		delete GameStateRegistry.Get(iHandle);
 	}
-	// Clear the map
-	GameStateMap.clear();
+	// Clear the registry
+	GameStateRegistry.Clear();
 }
 
 /**
@@ -49,6 +50,8 @@ void CGameStateManager::Destroy(void)
  */
 bool CGameStateManager::Update(const double dElapsedTime)
 {
+	PROFILE_ZONE("CGameStateManager::Update");
+
 	// Check for change of scene
 	if (nextGameState != activeGameState)
 	{
@@ -91,6 +94,8 @@ bool CGameStateManager::Update(const double dElapsedTime)
  */
 void CGameStateManager::Render(void)
 {
+	PROFILE_ZONE("CGameStateManager::Render");
+
 	if (activeGameState)
 		activeGameState->Render();
 	if (pauseGameState)
@@ -120,8 +125,8 @@ bool CGameStateManager::AddGameState(const std::string& _name, CGameStateBase* _
 		return false;
 	}
 
-	// If nothing is wrong, then add the scene to our map
-	GameStateMap[_name] = _scene;
+	// If nothing is wrong, then add the scene to our registry
+	GameStateRegistry.Register(_name, _scene);
 
 	return true;
 }
@@ -141,16 +146,17 @@ bool CGameStateManager::RemoveGameState(const std::string& _name)
 	}
 
 	// Find the CGameState*
-	CGameStateBase* target = GameStateMap[_name];
+	const int iHandle = GameStateRegistry.GetHandle(_name);
+	CGameStateBase* target = GameStateRegistry.Get(iHandle);
 	if (target == activeGameState || target == nextGameState)
 	{
 		cout << "Unable to remove active/next scene" << endl;
 		return false;
 	}
 
-	// Delete and remove from our map
+	// Delete and remove from our registry
 	delete target;
-	GameStateMap.erase(_name);
+	GameStateRegistry.Remove(iHandle);
 
 	return true;
 }
@@ -169,15 +175,41 @@ bool CGameStateManager::SetActiveGameState(const std::string& _name)
 		return false;
 	}
 
+	return SetActiveGameState(GameStateRegistry.GetHandle(_name));
+}
+
+/**
+ @brief Set a CGameState to be active
+ @param iHandle A const int variable which is the handle of the CGameState from GetGameStateHandle()
+ */
+bool CGameStateManager::SetActiveGameState(const int iHandle)
+{
+	// Check if this iHandle does not exists in the registry...
+	if (!GameStateRegistry.IsValid(iHandle))
+	{
+		// If it does not exist, then unable to proceed
+		cout << "CGameStateManager::SetActiveGameState - scene handle does not exists" << endl;
+		return false;
+	}
+
 	// Scene exist, set the next scene pointer to that scene
-	nextGameState = GameStateMap[_name];
+	nextGameState = GameStateRegistry.Get(iHandle);
 
 	return true;
 }
 
 bool CGameStateManager::CheckGameStateExist(const std::string& _name)
 {
-	return GameStateMap.count(_name) != 0;
+	return GameStateRegistry.GetHandle(_name) != CResourceRegistry<CGameStateBase*>::INVALID_HANDLE;
+}
+
+/**
+ @brief Get the handle of a CGameState, to be kept by the caller for SetActiveGameState() and SetPauseGameState()
+ @param _name A const std::string& variable which is the name of the CGameState
+ */
+int CGameStateManager::GetGameStateHandle(const std::string& _name) const
+{
+	return GameStateRegistry.GetHandle(_name);
 }
 
 bool CGameStateManager::SetPauseGameState(const std::string& _name)
@@ -197,8 +229,28 @@ bool CGameStateManager::SetPauseGameState(const std::string& _name)
 		return false;
 	}
 
+	return SetPauseGameState(GameStateRegistry.GetHandle(_name));
+}
+
+bool CGameStateManager::SetPauseGameState(const int iHandle)
+{
+	// Toggle to nullptr if pauseGameState already is in use
+	if (pauseGameState != nullptr)
+	{
+		pauseGameState = nullptr;
+		return true;
+	}
+
+	// Check if this iHandle does not exists in the registry...
+	if (!GameStateRegistry.IsValid(iHandle))
+	{
+		// If it does not exist, then unable to proceed
+		cout << "CGameStateManager::SetPauseGameState - scene handle does not exists" << endl;
+		return false;
+	}
+
 	// Scene exist, set the next scene pointer to that scene
-	pauseGameState = GameStateMap[_name];
+	pauseGameState = GameStateRegistry.Get(iHandle);
 	// Init the new pause CGameState
 	pauseGameState->Init();
 
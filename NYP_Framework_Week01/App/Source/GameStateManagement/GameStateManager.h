@@ -1,7 +1,7 @@
 #pragma once
 
 #include "DesignPatterns/SingletonTemplate.h"
-#include <map>
+#include "DesignPatterns/ResourceRegistry.h"
 #include <string>
 
 #include "GameStateBase.h"
@@ -25,8 +25,11 @@ public:
 	bool AddGameState(const std::string& _name, CGameStateBase* _scene);
 	bool RemoveGameState(const std::string& _name);
 	bool SetActiveGameState(const std::string& _name);
+	bool SetActiveGameState(const int iHandle);
 	bool CheckGameStateExist(const std::string& _name);
+	int GetGameStateHandle(const std::string& _name) const;
 	bool SetPauseGameState(const std::string& _name);
+	bool SetPauseGameState(const int iHandle);
 	void OffPauseGameState(void);
 
 	float timer;
@@ -38,8 +41,8 @@ protected:
 	// Destructor
 	~CGameStateManager();
 
-	// The map of CGameStates
-	std::map<std::string, CGameStateBase*> GameStateMap;
+	// The registry of CGameStates
+	CResourceRegistry<CGameStateBase*> GameStateRegistry;
 	// The handlers containing the active and next CGameState
 	CGameStateBase* activeGameState, *nextGameState, *prevGameState, *pauseGameState;
 };
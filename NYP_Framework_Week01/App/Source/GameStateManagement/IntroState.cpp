@@ -3,6 +3,8 @@
 #include <GL/glew.h>
 #define GLEW_STATIC
 #endif
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "RenderControl/GLTelemetry.h"
 
 // Include GLFW
 #include <GLFW/glfw3.h>
@@ -20,12 +22,12 @@
 // Include Mesh Builder
 #include "Primitives/MeshBuilder.h"
 // Include ImageLoader
-#include "System\ImageLoader.h"
+#include "System/ImageLoader.h"
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
 
  // Include shader
-#include "RenderControl\shader.h"
+#include "RenderControl/Shader.h"
 
 // Include CSettings
 #include "GameControl/Settings.h"
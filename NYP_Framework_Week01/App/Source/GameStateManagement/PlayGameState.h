@@ -9,7 +9,7 @@
 
 #include "GameStateBase.h"
 
-#include "..\Scene2D\Scene2D.h"
+#include "../Scene2D/Scene2D.h"
 #include "../Scene2D/BackgroundEntity.h"
 
 class CPlayGameState : public CGameStateBase
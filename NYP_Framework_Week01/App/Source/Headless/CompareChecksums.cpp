@@ -0,0 +1,123 @@
+/**
+ CompareChecksums
+ @brief This file compares the checksum logs of two runs of HeadlessSimulation, tick by tick,
+		and reports the first tick where the world is different, with the parts which differ.
+		Usage: CompareChecksums <checksum log A> <checksum log B> [<detail A> <detail B>]
+		With the detail files which HeadlessSimulation writes with -detail, the entities which differ at that tick
+		are listed too, with their checksums and positions.
+		It returns 0 if the runs are the same, 1 if they differ, and 2 if a log cannot be loaded.
+ By: agent
+ Date: Oct 2026
+ */
+#include "WorldChecksum.h"
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+@brief Get the part and the number of the entity of a line of a detail file, e.g. "enemies 12"
+@param line A const std::string& variable containing the line, without the tick
+*/
+static std::string GetDetailKey(const std::string& line)
+{
+	const size_t uiFirstSpace = line.find(' ');
+	if (uiFirstSpace == std::string::npos)
+		return line;
+	return line.substr(0, line.find(' ', uiFirstSpace + 1));
+}
+
+/**
+@brief Print the entities whose lines differ at a tick in two detail files
+@param filenameA A const std::string& variable containing the detail file of run A
+@param filenameB A const std::string& variable containing the detail file of run B
+@param uiTick A const uint32_t variable containing the tick
+*/
+static bool PrintDetail(const std::string& filenameA, const std::string& filenameB, const uint32_t uiTick)
+{
+	std::vector<std::string> linesA, linesB;
+	if ((CWorldChecksumLog::LoadDetail(filenameA, uiTick, linesA) == false)
+		|| (CWorldChecksumLog::LoadDetail(filenameB, uiTick, linesB) == false))
+	{
+		return false;
+	}
+	if ((linesA.empty()) || (linesB.empty()))
+	{
+		cout << "The detail files have no lines for tick " << uiTick << endl;
+		return true;
+	}
+
+	std::map<std::string, std::string> mapB;
+	for (size_t i = 0; i < linesB.size(); i++)
+	{
+		mapB[GetDetailKey(linesB[i])] = linesB[i];
+	}
+	cout << "The entities which differ at tick " << uiTick << ":" << endl;
+	for (size_t i = 0; i < linesA.size(); i++)
+	{
+		std::map<std::string, std::string>::iterator it = mapB.find(GetDetailKey(linesA[i]));
+		if (it == mapB.end())
+		{
+			cout << "  A: " << linesA[i] << endl << "  B: (none)" << endl;
+			continue;
+		}
+		if (it->second != linesA[i])
+			cout << "  A: " << linesA[i] << endl << "  B: " << it->second << endl;
+		mapB.erase(it);
+	}
+	for (std::map<std::string, std::string>::iterator it = mapB.begin(); it != mapB.end(); ++it)
+	{
+		cout << "  A: (none)" << endl << "  B: " << it->second << endl;
+	}
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	if ((argc != 3) && (argc != 5))
+	{
+		cout << "Usage: " << argv[0] << " <checksum log A> <checksum log B> [<detail A> <detail B>]" << endl;
+		return 2;
+	}
+
+	std::vector<SWorldChecksum> checksumsA, checksumsB;
+	if ((CWorldChecksumLog::Load(argv[1], checksumsA) == false) || (CWorldChecksumLog::Load(argv[2], checksumsB) == false))
+	{
+		return 2;
+	}
+
+	const size_t uiNumTicks = std::min(checksumsA.size(), checksumsB.size());
+	for (size_t i = 0; i < uiNumTicks; i++)
+	{
+		const SWorldChecksum& sA = checksumsA[i];
+		const SWorldChecksum& sB = checksumsB[i];
+		if (sA.GetTotal() == sB.GetTotal())
+			continue;
+
+		cout << "The runs differ from tick " << sA.uiTick << ":" << endl;
+		for (int iSection = 0; iSection < SWorldChecksum::NUM_SECTIONS; iSection++)
+		{
+			if (sA.arrSections[iSection] == sB.arrSections[iSection])
+				continue;
+			cout << "  " << setfill(' ') << left << setw(10) << SWorldChecksum::GetSectionName(iSection) << right
+				<< hex << setfill('0') << setw(16) << sA.arrSections[iSection] << " != "
+				<< setw(16) << sB.arrSections[iSection] << dec << endl;
+		}
+		if ((argc == 5) && (PrintDetail(argv[3], argv[4], sA.uiTick) == false))
+			return 2;
+		return 1;
+	}
+
+	if (checksumsA.size() != checksumsB.size())
+	{
+		cout << "The runs are the same for " << uiNumTicks << " ticks, but one has "
+			<< checksumsA.size() << " ticks and the other has " << checksumsB.size() << endl;
+		return 1;
+	}
+
+	cout << "The runs are the same for all " << uiNumTicks << " ticks" << endl;
+	return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ GenerateLevel
+ @brief This file generates a level for the stress scenes, in the CSV format which CMap2D loads, and its spawn manifest.
+		Run the level with HeadlessSimulation -level, from the App folder.
+		Usage: GenerateLevel -map file [-manifest file] [-rows N] [-cols N] [-density F] [-enemies N] [-pickups N] [-bosses N] [-seed N]
+		The level is 32 by 24 tiles with an obstacle density of 0.2 and no entities by default.
+		It returns 0 if the level is written, and 1 if the arguments are wrong or the entities do not fit.
+ By: agent
+ Date: Oct 2026
+ */
+#include "StressSceneGenerator.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+	CStressSceneGenerator::SParameters sParameters;
+	std::string mapFilename;
+	std::string manifestFilename;
+	bool bValidArguments = (argc % 2 == 1);
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "-map") == 0)
+			mapFilename = argv[i + 1];
+		else if (strcmp(argv[i], "-manifest") == 0)
+			manifestFilename = argv[i + 1];
+		else if (strcmp(argv[i], "-rows") == 0)
+			sParameters.uiNumRows = (unsigned int)strtoul(argv[i + 1], NULL, 10);
+		else if (strcmp(argv[i], "-cols") == 0)
+			sParameters.uiNumCols = (unsigned int)strtoul(argv[i + 1], NULL, 10);
+		else if (strcmp(argv[i], "-density") == 0)
+			sParameters.fObstacleDensity = (float)atof(argv[i + 1]);
+		else if (strcmp(argv[i], "-enemies") == 0)
+			sParameters.uiNumEnemies = (unsigned int)strtoul(argv[i + 1], NULL, 10);
+		else if (strcmp(argv[i], "-pickups") == 0)
+			sParameters.uiNumPickUps = (unsigned int)strtoul(argv[i + 1], NULL, 10);
+		else if (strcmp(argv[i], "-bosses") == 0)
+			sParameters.uiNumBosses = (unsigned int)strtoul(argv[i + 1], NULL, 10);
+		else if (strcmp(argv[i], "-seed") == 0)
+			sParameters.uiSeed = strtoull(argv[i + 1], NULL, 10);
+		else
+			bValidArguments = false;
+	}
+	if ((bValidArguments == false) || (mapFilename.empty()))
+	{
+		cout << "Usage: " << argv[0] << " -map file [-manifest file] [-rows N] [-cols N] [-density F] [-enemies N] [-pickups N] [-bosses N] [-seed N]" << endl;
+		return 1;
+	}
+
+	CStressSceneGenerator cGenerator;
+	if (cGenerator.Generate(sParameters) == false)
+		return 1;
+	if (cGenerator.SaveMap(mapFilename) == false)
+		return 1;
+	if ((!manifestFilename.empty()) && (cGenerator.SaveManifest(manifestFilename) == false))
+		return 1;
+
+	cout << "Generated a level of " << cGenerator.GetNumCols() << " by " << cGenerator.GetNumRows() << " tiles with "
+		<< sParameters.uiNumEnemies << " enemies, " << sParameters.uiNumPickUps << " pickups and "
+		<< sParameters.uiNumBosses << " bosses, and " << cGenerator.GetNumEmptyTiles() << " empty tiles" << endl;
+	return 0;
+}
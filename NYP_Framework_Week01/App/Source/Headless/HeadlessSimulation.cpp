@@ -0,0 +1,203 @@
+/**
+ CHeadlessSimulation
+ @brief A class which steps the CWorld2D of the Scene2D without a window, OpenGL or sound.
+		It is built with HEADLESS, where the rendering classes are built against a null OpenGL,
+		so that the game logic can run in CI, in soak tests and on servers.
+ By: agent
+ Date: Oct 2026
+ */
+#include "HeadlessSimulation.h"
+
+// Include CRandomService
+#include "System/Random.h"
+// Include CInventoryManager
+#include "Scene2D/InventoryManager.h"
+// Include CProfiler to time the zones of the tick
+#include "TimeControl/Profiler.h"
+
+#include <cstring>
+#include <iomanip>
+using namespace std;
+
+/**
+@brief Write a line for each entity in a vector, with its checksum, whether it is active and where it is
+@param os A std::ostream& variable to write into
+@param uiTick A const unsigned int variable containing the tick
+@param iSection A const int variable containing the part of the world which the entities are in
+@param entities A const std::vector<T*>& variable containing the entities
+*/
+template <typename T>
+static void WriteEntityDetail(std::ostream& os, const unsigned int uiTick, const int iSection, const std::vector<T*>& entities)
+{
+	for (size_t i = 0; i < entities.size(); i++)
+	{
+		CChecksum cChecksum;
+		entities[i]->AddToChecksum(cChecksum);
+		const glm::vec2 vec2Index = entities[i]->Geti32vec2Index();
+		const glm::vec2 vec2NumMicroSteps = entities[i]->Geti32vec2NumMicroSteps();
+		os << uiTick << " " << SWorldChecksum::GetSectionName(iSection) << " " << entities[i]->GetEntityID() << " "
+			<< hex << setfill('0') << setw(16) << cChecksum.GetValue() << dec
+			<< " active " << entities[i]->bIsActive
+			<< " index " << vec2Index.x << "," << vec2Index.y
+			<< " microsteps " << vec2NumMicroSteps.x << "," << vec2NumMicroSteps.y << "\n";
+	}
+}
+
+/**
+@brief Constructor
+*/
+CHeadlessSimulation::CHeadlessSimulation(void)
+	: uiNumTicks(0)
+	, uiNumPlayerLost(0)
+{
+}
+
+/**
+@brief Destructor
+*/
+CHeadlessSimulation::~CHeadlessSimulation(void)
+{
+	Destroy();
+}
+
+/**
+@brief Init Initialise this instance. It loads the maps from the working directory.
+@param levelFilename A const std::string& variable containing the CSV file of the level, absolute or relative to the
+	   working directory. The shipped maps are loaded when it is empty.
+*/
+bool CHeadlessSimulation::Init(const std::string& levelFilename)
+{
+	uiNumTicks = 0;
+	uiNumPlayerLost = 0;
+
+	return CWorld2D::Init(levelFilename);
+}
+
+/**
+@brief Update Step the world by one tick, as CScene2D::Update() does, without the GUI, the sound and the game states
+@param dElapsedTime A const double variable containing the time of the tick
+*/
+void CHeadlessSimulation::Update(const double dElapsedTime)
+{
+	PROFILE_ZONE("CHeadlessSimulation::Update");
+
+	uiNumTicks++;
+
+	// The player is reset by CWorld2D, so carry on as the DEATH state would start again
+	if (CWorld2D::Update(dElapsedTime) == PLAYER_LOST)
+	{
+		uiNumPlayerLost++;
+	}
+}
+
+/**
+@brief Destroy the entities and the singletons created by Init()
+*/
+void CHeadlessSimulation::Destroy(void)
+{
+	const bool bPlayerCreated = (cPlayer2D != NULL);
+	CWorld2D::Destroy();
+	// The items of the player, which CGUI_Scene2D destroys in the game
+	if (bPlayerCreated)
+	{
+		CInventoryManager::GetInstance()->Destroy();
+	}
+	CRandomService::GetInstance()->Destroy();
+}
+
+/**
+@brief Get the number of ticks since Init()
+*/
+unsigned int CHeadlessSimulation::GetNumTicks(void) const
+{
+	return uiNumTicks;
+}
+
+/**
+@brief Get the number of times the player has lost since Init()
+*/
+unsigned int CHeadlessSimulation::GetNumPlayerLost(void) const
+{
+	return uiNumPlayerLost;
+}
+
+/**
+@brief Compute the checksums of the world after the last tick. The entities are added in the order
+	   they were created, which is the same in every run of the same replay.
+@param sChecksum A SWorldChecksum& variable which receives the checksums
+*/
+void CHeadlessSimulation::ComputeChecksum(SWorldChecksum& sChecksum) const
+{
+	memset(&sChecksum, 0, sizeof(sChecksum));
+	sChecksum.uiTick = uiNumTicks;
+
+	CChecksum cChecksum;
+	cMap2D->AddToChecksum(cChecksum);
+	sChecksum.arrSections[SWorldChecksum::MAP] = cChecksum.GetValue();
+
+	cChecksum.Reset();
+	cPlayer2D->AddToChecksum(cChecksum);
+	sChecksum.arrSections[SWorldChecksum::PLAYER] = cChecksum.GetValue();
+
+	cChecksum.Reset();
+	CInventoryManager::GetInstance()->AddToChecksum(cChecksum);
+	sChecksum.arrSections[SWorldChecksum::INVENTORY] = cChecksum.GetValue();
+
+	cChecksum.Reset();
+	for (size_t i = 0; i < enemyVector.size(); i++)
+	{
+		enemyVector[i]->AddToChecksum(cChecksum);
+	}
+	sChecksum.arrSections[SWorldChecksum::ENEMIES] = cChecksum.GetValue();
+
+	cChecksum.Reset();
+	for (size_t i = 0; i < bulletVector.size(); i++)
+	{
+		bulletVector[i]->AddToChecksum(cChecksum);
+	}
+	sChecksum.arrSections[SWorldChecksum::BULLETS] = cChecksum.GetValue();
+
+	cChecksum.Reset();
+	for (size_t i = 0; i < Pick.size(); i++)
+	{
+		Pick[i]->AddToChecksum(cChecksum);
+	}
+	sChecksum.arrSections[SWorldChecksum::PICKUPS] = cChecksum.GetValue();
+
+	cChecksum.Reset();
+	for (size_t i = 0; i < bossVector.size(); i++)
+	{
+		bossVector[i]->AddToChecksum(cChecksum);
+	}
+	sChecksum.arrSections[SWorldChecksum::BOSS] = cChecksum.GetValue();
+}
+
+/**
+@brief Write the checksum and the position of each entity after the last tick, one line each, which start with the
+	   tick. CompareChecksums compares the lines of the tick where two runs differ, to tell which entity differs.
+@param os A std::ostream& variable to write into
+*/
+void CHeadlessSimulation::WriteChecksumDetail(std::ostream& os) const
+{
+	CChecksum cChecksum;
+	cMap2D->AddToChecksum(cChecksum);
+	os << uiNumTicks << " " << SWorldChecksum::GetSectionName(SWorldChecksum::MAP) << " " << cMap2D->GetCurrentLevel() << " "
+		<< hex << setfill('0') << setw(16) << cChecksum.GetValue() << dec << "\n";
+
+	cChecksum.Reset();
+	cPlayer2D->AddToChecksum(cChecksum);
+	os << uiNumTicks << " " << SWorldChecksum::GetSectionName(SWorldChecksum::PLAYER) << " " << cPlayer2D->GetEntityID() << " "
+		<< hex << setfill('0') << setw(16) << cChecksum.GetValue() << dec
+		<< " index " << cPlayer2D->vec2Index.x << "," << cPlayer2D->vec2Index.y
+		<< " microsteps " << cPlayer2D->vec2NumMicroSteps.x << "," << cPlayer2D->vec2NumMicroSteps.y << "\n";
+
+	cChecksum.Reset();
+	CInventoryManager::GetInstance()->AddToChecksum(cChecksum);
+	os << uiNumTicks << " " << SWorldChecksum::GetSectionName(SWorldChecksum::INVENTORY) << " 0 "
+		<< hex << setfill('0') << setw(16) << cChecksum.GetValue() << dec << "\n";
+
+	WriteEntityDetail(os, uiNumTicks, SWorldChecksum::ENEMIES, enemyVector);
+	WriteEntityDetail(os, uiNumTicks, SWorldChecksum::BULLETS, bulletVector);
+	WriteEntityDetail(os, uiNumTicks, SWorldChecksum::PICKUPS, Pick);
+	WriteEntityDetail(os, uiNumTicks, SWorldChecksum::BOSS, bossVector);
+}
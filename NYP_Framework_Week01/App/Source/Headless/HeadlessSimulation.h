@@ -0,0 +1,54 @@
+/**
+ CHeadlessSimulation
+ @brief A class which steps the CWorld2D of the Scene2D without a window, OpenGL or sound.
+		It is built with HEADLESS, where the rendering classes are built against a null OpenGL,
+		so that the game logic can run in CI, in soak tests and on servers.
+		It runs the shipped maps, or a level of any size from CStressSceneGenerator.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+#include <ostream>
+#include <string>
+
+// Include CWorld2D, which CScene2D steps in the game
+#include "Scene2D/World2D.h"
+
+// Include SWorldChecksum
+#include "WorldChecksum.h"
+
+class CHeadlessSimulation : public CWorld2D
+{
+public:
+	// Constructor
+	CHeadlessSimulation(void);
+
+	// Destructor
+	virtual ~CHeadlessSimulation(void);
+
+	// Init with the shipped maps, or with a level of any size which has no neighbours
+	bool Init(const std::string& levelFilename = "");
+
+	// Step the world by one tick
+	void Update(const double dElapsedTime);
+
+	// Destroy the entities and the singletons created by Init()
+	void Destroy(void);
+
+	// Get the number of ticks since Init()
+	unsigned int GetNumTicks(void) const;
+
+	// Get the number of times the player has lost since Init()
+	unsigned int GetNumPlayerLost(void) const;
+
+	// Compute the checksums of the world after the last tick
+	void ComputeChecksum(SWorldChecksum& sChecksum) const;
+
+	// Write the checksum and the position of each entity after the last tick, one line each, for CompareChecksums
+	void WriteChecksumDetail(std::ostream& os) const;
+
+protected:
+	unsigned int uiNumTicks;
+	unsigned int uiNumPlayerLost;
+};
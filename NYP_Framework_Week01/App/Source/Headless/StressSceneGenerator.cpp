@@ -0,0 +1,305 @@
+/**
+ CStressSceneGenerator
+ @brief A class which generates a level of any size and obstacle density for the stress scenes,
+		with the enemies, pickups and bosses placed on random tiles which the player can reach.
+		The level is written in the CSV format which CMap2D::LoadMap() loads, and the entities
+		are also listed in a spawn manifest, so that a run can be matched to what was in it.
+ By: agent
+ Date: Oct 2026
+ */
+#include "StressSceneGenerator.h"
+
+// Include CRandom
+#include "System/Random.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+// The kinds of enemies, in the order which they are placed in
+static const int arrEnemyTiles[] = { 302, 301, 400, 401 };
+// The obstacles inside the border
+static const int arrObstacleTiles[] = { 100, 101, 102 };
+
+/**
+ @brief Constructor
+ */
+CStressSceneGenerator::SParameters::SParameters(void)
+	: uiNumRows(24)
+	, uiNumCols(32)
+	, fObstacleDensity(0.2f)
+	, uiNumEnemies(0)
+	, uiNumPickUps(0)
+	, uiNumBosses(0)
+	, uiSeed(1)
+{
+}
+
+/**
+ @brief Constructor
+ */
+CStressSceneGenerator::CStressSceneGenerator(void)
+	: uiNumEmptyTiles(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CStressSceneGenerator::~CStressSceneGenerator(void)
+{
+}
+
+/**
+@brief Generate a level. It has a border of solid rock, obstacles on random tiles inside it, and the player
+	   in the middle. The empty tiles which the player cannot reach are filled, so that every entity can be
+	   reached and every path which is searched for can be found. The enemies, pickups and bosses are then
+	   placed on random empty tiles.
+@param sParameters A const SParameters& variable containing the size, the density and the entities of the level
+@return false if the parameters are invalid or the entities do not fit into the empty tiles
+*/
+bool CStressSceneGenerator::Generate(const SParameters& sParameters)
+{
+	// The paths are kept in 16 bit tile indices
+	if ((sParameters.uiNumRows < 8) || (sParameters.uiNumCols < 8) ||
+		(sParameters.uiNumRows > 32767) || (sParameters.uiNumCols > 32767))
+	{
+		cout << "The level must be from 8 to 32767 tiles in each direction." << endl;
+		return false;
+	}
+	if ((sParameters.fObstacleDensity < 0.0f) || (sParameters.fObstacleDensity > 0.9f))
+	{
+		cout << "The obstacle density must be from 0 to 0.9." << endl;
+		return false;
+	}
+
+	this->sParameters = sParameters;
+	const unsigned int uiNumRows = sParameters.uiNumRows;
+	const unsigned int uiNumCols = sParameters.uiNumCols;
+	arrTiles.assign(uiNumRows * uiNumCols, TILE_EMPTY);
+	spawns.clear();
+	uiNumEmptyTiles = 0;
+
+	CRandom cRandom(sParameters.uiSeed);
+	const unsigned int uiPlayerRow = uiNumRows / 2;
+	const unsigned int uiPlayerCol = uiNumCols / 2;
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+		{
+			int& iTile = arrTiles[uiRow * uiNumCols + uiCol];
+			if ((uiRow == 0) || (uiCol == 0) || (uiRow == uiNumRows - 1) || (uiCol == uiNumCols - 1))
+			{
+				// The border keeps the player from walking off the level
+				iTile = TILE_BORDER;
+			}
+			else if ((uiRow + 1 >= uiPlayerRow) && (uiRow <= uiPlayerRow + 1) &&
+					 (uiCol + 1 >= uiPlayerCol) && (uiCol <= uiPlayerCol + 1))
+			{
+				// The tiles around the player are kept empty, so that it is never walled in
+			}
+			else if (cRandom.Float() < sParameters.fObstacleDensity)
+			{
+				iTile = arrObstacleTiles[cRandom.Range(sizeof(arrObstacleTiles) / sizeof(arrObstacleTiles[0]))];
+			}
+		}
+	}
+	FillUnreachableTiles(uiPlayerRow, uiPlayerCol);
+
+	// List the empty tiles, except the one of the player
+	std::vector<unsigned int> arrEmptyTiles;
+	for (unsigned int i = 0; i < arrTiles.size(); i++)
+	{
+		if ((arrTiles[i] == TILE_EMPTY) && (i != uiPlayerRow * uiNumCols + uiPlayerCol))
+			arrEmptyTiles.push_back(i);
+	}
+	const unsigned int uiNumEntities = sParameters.uiNumEnemies + sParameters.uiNumPickUps + sParameters.uiNumBosses;
+	if (uiNumEntities > arrEmptyTiles.size())
+	{
+		cout << "Only " << arrEmptyTiles.size() << " empty tiles can be reached, which is too few for "
+			<< uiNumEntities << " entities." << endl;
+		return false;
+	}
+
+	SSpawn sSpawn;
+	sSpawn.iValue = TILE_PLAYER;
+	sSpawn.uiRow = uiPlayerRow;
+	sSpawn.uiCol = uiPlayerCol;
+	arrTiles[uiPlayerRow * uiNumCols + uiPlayerCol] = TILE_PLAYER;
+	spawns.push_back(sSpawn);
+
+	for (unsigned int i = 0; i < uiNumEntities; i++)
+	{
+		// Swap a random tile from the rest of the list into this place, so that no tile is picked twice
+		std::swap(arrEmptyTiles[i], arrEmptyTiles[i + cRandom.Range((int)(arrEmptyTiles.size() - i))]);
+
+		if (i < sParameters.uiNumEnemies)
+			sSpawn.iValue = arrEnemyTiles[i % (sizeof(arrEnemyTiles) / sizeof(arrEnemyTiles[0]))];
+		else if (i < sParameters.uiNumEnemies + sParameters.uiNumPickUps)
+			sSpawn.iValue = TILE_PICKUP;
+		else
+			sSpawn.iValue = TILE_BOSS;
+		sSpawn.uiRow = arrEmptyTiles[i] / uiNumCols;
+		sSpawn.uiCol = arrEmptyTiles[i] % uiNumCols;
+		arrTiles[arrEmptyTiles[i]] = sSpawn.iValue;
+		spawns.push_back(sSpawn);
+	}
+	uiNumEmptyTiles = (unsigned int)arrEmptyTiles.size() - uiNumEntities;
+
+	return true;
+}
+
+/**
+@brief Write the level in the CSV format which CMap2D::LoadMap() loads. The first row holds the column numbers.
+@param filename A const std::string& variable containing the name of the file
+*/
+bool CStressSceneGenerator::SaveMap(const std::string& filename) const
+{
+	ofstream file(filename.c_str());
+	if (!file)
+	{
+		cout << "Unable to write the map into " << filename << endl;
+		return false;
+	}
+
+	file << "//";
+	for (unsigned int uiCol = 0; uiCol < sParameters.uiNumCols; uiCol++)
+	{
+		file << (uiCol > 0 ? "," : "") << (uiCol + 1);
+	}
+	file << "\n";
+	for (unsigned int uiRow = 0; uiRow < sParameters.uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < sParameters.uiNumCols; uiCol++)
+		{
+			file << (uiCol > 0 ? "," : "") << arrTiles[uiRow * sParameters.uiNumCols + uiCol];
+		}
+		file << "\n";
+	}
+	return file.good();
+}
+
+/**
+@brief Write the spawn manifest. It starts with the parameters of the level as comments, and then lists
+	   one entity in each row, with the row counted from the top of the map file.
+@param filename A const std::string& variable containing the name of the file
+*/
+bool CStressSceneGenerator::SaveManifest(const std::string& filename) const
+{
+	ofstream file(filename.c_str());
+	if (!file)
+	{
+		cout << "Unable to write the spawn manifest into " << filename << endl;
+		return false;
+	}
+
+	file << "# rows " << sParameters.uiNumRows << ", cols " << sParameters.uiNumCols
+		<< ", obstacle density " << sParameters.fObstacleDensity << ", seed " << sParameters.uiSeed << "\n";
+	file << "# " << uiNumEmptyTiles << " empty tiles can be reached\n";
+	file << "entity,value,row,col\n";
+	for (size_t i = 0; i < spawns.size(); i++)
+	{
+		file << GetEntityName(spawns[i].iValue) << "," << spawns[i].iValue << ","
+			<< spawns[i].uiRow << "," << spawns[i].uiCol << "\n";
+	}
+	return file.good();
+}
+
+/**
+ @brief Get the number of rows of the level
+ */
+unsigned int CStressSceneGenerator::GetNumRows(void) const
+{
+	return sParameters.uiNumRows;
+}
+
+/**
+ @brief Get the number of columns of the level
+ */
+unsigned int CStressSceneGenerator::GetNumCols(void) const
+{
+	return sParameters.uiNumCols;
+}
+
+/**
+@brief Get the value of a tile
+@param uiRow A const unsigned int variable containing the row, counted from the top of the map file
+@param uiCol A const unsigned int variable containing the column
+*/
+int CStressSceneGenerator::GetTile(const unsigned int uiRow, const unsigned int uiCol) const
+{
+	return arrTiles[uiRow * sParameters.uiNumCols + uiCol];
+}
+
+/**
+ @brief Get the number of empty tiles which the player can reach, after the entities are placed
+ */
+unsigned int CStressSceneGenerator::GetNumEmptyTiles(void) const
+{
+	return uiNumEmptyTiles;
+}
+
+/**
+ @brief Get the entities, with the player first
+ */
+const std::vector<CStressSceneGenerator::SSpawn>& CStressSceneGenerator::GetSpawns(void) const
+{
+	return spawns;
+}
+
+/**
+@brief Get the name of the entity which a tile value creates
+@param iValue A const int variable containing the tile value
+*/
+const char* CStressSceneGenerator::GetEntityName(const int iValue)
+{
+	switch (iValue)
+	{
+	case TILE_PLAYER:
+		return "player";
+	case TILE_BOSS:
+		return "boss";
+	case TILE_PICKUP:
+		return "pickup";
+	default:
+		return "enemy";
+	}
+}
+
+/**
+@brief Fill the empty tiles which cannot be reached from the player with obstacles. The tiles are
+	   flooded from the player in the 4 directions which the AStar PathFinding moves in by default.
+@param uiPlayerRow A const unsigned int variable containing the row of the player
+@param uiPlayerCol A const unsigned int variable containing the column of the player
+*/
+void CStressSceneGenerator::FillUnreachableTiles(const unsigned int uiPlayerRow, const unsigned int uiPlayerCol)
+{
+	const unsigned int uiNumCols = sParameters.uiNumCols;
+	std::vector<bool> arrReached(arrTiles.size(), false);
+	std::vector<unsigned int> arrOpen;
+	arrOpen.push_back(uiPlayerRow * uiNumCols + uiPlayerCol);
+	arrReached[arrOpen.back()] = true;
+	while (!arrOpen.empty())
+	{
+		const unsigned int uiTile = arrOpen.back();
+		arrOpen.pop_back();
+
+		// The border is never empty, so the neighbours of an empty tile are always in the level
+		const unsigned int arrNeighbours[4] = { uiTile - 1, uiTile + 1, uiTile - uiNumCols, uiTile + uiNumCols };
+		for (int i = 0; i < 4; i++)
+		{
+			if ((arrReached[arrNeighbours[i]] == false) && (arrTiles[arrNeighbours[i]] == TILE_EMPTY))
+			{
+				arrReached[arrNeighbours[i]] = true;
+				arrOpen.push_back(arrNeighbours[i]);
+			}
+		}
+	}
+
+	for (unsigned int i = 0; i < arrTiles.size(); i++)
+	{
+		if ((arrTiles[i] == TILE_EMPTY) && (arrReached[i] == false))
+			arrTiles[i] = TILE_OBSTACLE;
+	}
+}
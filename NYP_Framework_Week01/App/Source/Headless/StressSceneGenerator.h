@@ -0,0 +1,100 @@
+/**
+ CStressSceneGenerator
+ @brief A class which generates a level of any size and obstacle density for the stress scenes,
+		with the enemies, pickups and bosses placed on random tiles which the player can reach.
+		The level is written in the CSV format which CMap2D::LoadMap() loads, and the entities
+		are also listed in a spawn manifest, so that a run can be matched to what was in it.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class CStressSceneGenerator
+{
+public:
+	// The parameters of a level
+	struct SParameters
+	{
+		unsigned int uiNumRows;
+		unsigned int uiNumCols;
+		// The fraction of the tiles inside the border which are obstacles, from 0 to 0.9
+		float fObstacleDensity;
+		unsigned int uiNumEnemies;
+		unsigned int uiNumPickUps;
+		unsigned int uiNumBosses;
+		// The seed of the random numbers. The same parameters and seed give the same level.
+		uint64_t uiSeed;
+
+		// Constructor, with the size of the shipped levels and no entities
+		SParameters(void);
+	};
+
+	// An entity placed in the level
+	struct SSpawn
+	{
+		// The tile value which creates the entity when the level is loaded
+		int iValue;
+		// The row, counted from the top of the map file, and the column of the tile
+		unsigned int uiRow;
+		unsigned int uiCol;
+	};
+
+	// The tile values which the Scene2D creates its entities from
+	enum TILE
+	{
+		TILE_EMPTY = 0,
+		TILE_OBSTACLE = 100,
+		TILE_BORDER = 110,
+		TILE_PLAYER = 200,
+		TILE_BOSS = 300,
+		TILE_PICKUP = 1100
+	};
+
+	// Constructor
+	CStressSceneGenerator(void);
+
+	// Destructor
+	virtual ~CStressSceneGenerator(void);
+
+	// Generate a level. Returns false if the parameters are invalid or the entities do not fit.
+	bool Generate(const SParameters& sParameters);
+
+	// Write the level in the CSV format which CMap2D::LoadMap() loads
+	bool SaveMap(const std::string& filename) const;
+
+	// Write the spawn manifest, one entity in each row
+	bool SaveManifest(const std::string& filename) const;
+
+	// Get the size of the level
+	unsigned int GetNumRows(void) const;
+	unsigned int GetNumCols(void) const;
+
+	// Get the value of a tile, with the row counted from the top of the map file
+	int GetTile(const unsigned int uiRow, const unsigned int uiCol) const;
+
+	// Get the number of empty tiles which the player can reach, after the entities are placed
+	unsigned int GetNumEmptyTiles(void) const;
+
+	// Get the entities, with the player first
+	const std::vector<SSpawn>& GetSpawns(void) const;
+
+	// Get the name of the entity which a tile value creates
+	static const char* GetEntityName(const int iValue);
+
+protected:
+	// Fill the empty tiles which cannot be reached from the player with obstacles
+	void FillUnreachableTiles(const unsigned int uiPlayerRow, const unsigned int uiPlayerCol);
+
+	SParameters sParameters;
+
+	// The tiles of the level, row by row from the top of the map file
+	std::vector<int> arrTiles;
+
+	std::vector<SSpawn> spawns;
+
+	unsigned int uiNumEmptyTiles;
+};
@@ -0,0 +1,175 @@
+/**
+ CWorldChecksum
+ @brief The checksums of the parts of the world at a tick, and a log of them over a run.
+		Two runs of the same replay must have the same checksums at every tick. When they do not,
+		the parts which differ show where the gameplay has changed.
+ By: agent
+ Date: Oct 2026
+ */
+#include "WorldChecksum.h"
+
+// Include CChecksum
+#include "System/Checksum.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+// The file starts with these 4 bytes, followed by the tick and the checksum of each part for each tick.
+// They are written one by one, so that the padding of SWorldChecksum is not in the file.
+static const char WORLD_CHECKSUM_MAGIC[4] = { 'N', 'Y', 'C', '2' };
+
+/**
+@brief Get a checksum of all the parts
+*/
+uint64_t SWorldChecksum::GetTotal(void) const
+{
+	CChecksum cChecksum;
+	cChecksum.Add(arrSections, sizeof(arrSections));
+	return cChecksum.GetValue();
+}
+
+/**
+@brief Get the name of a part
+@param iSection A const int variable containing the part
+*/
+const char* SWorldChecksum::GetSectionName(const int iSection)
+{
+	static const char* arrNames[NUM_SECTIONS] = { "map", "player", "inventory", "enemies", "bullets", "pickups", "boss" };
+	if ((iSection < 0) || (iSection >= NUM_SECTIONS))
+		return "unknown";
+	return arrNames[iSection];
+}
+
+/**
+@brief Constructor
+*/
+CWorldChecksumLog::CWorldChecksumLog(void)
+{
+}
+
+/**
+@brief Destructor
+*/
+CWorldChecksumLog::~CWorldChecksumLog(void)
+{
+	Close();
+}
+
+/**
+@brief Open a file to write the checksums into
+@param filename A const std::string& variable containing the name of the file
+*/
+bool CWorldChecksumLog::Open(const std::string& filename)
+{
+	Close();
+
+	file.open(filename.c_str(), std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		cout << "CWorldChecksumLog::Open - Unable to open " << filename << endl;
+		return false;
+	}
+	file.write(WORLD_CHECKSUM_MAGIC, sizeof(WORLD_CHECKSUM_MAGIC));
+
+	return true;
+}
+
+/**
+@brief Write the checksums of a tick
+@param sChecksum A const SWorldChecksum& variable containing the checksums
+*/
+void CWorldChecksumLog::Write(const SWorldChecksum& sChecksum)
+{
+	if (file.is_open())
+	{
+		file.write((const char*)&sChecksum.uiTick, sizeof(sChecksum.uiTick));
+		file.write((const char*)sChecksum.arrSections, sizeof(sChecksum.arrSections));
+	}
+}
+
+/**
+@brief Close the file
+*/
+void CWorldChecksumLog::Close(void)
+{
+	if (file.is_open())
+		file.close();
+}
+
+/**
+@brief Check if a file is open
+*/
+bool CWorldChecksumLog::IsOpen(void) const
+{
+	return file.is_open();
+}
+
+/**
+@brief Load all the checksums in a file
+@param filename A const std::string& variable containing the name of the file
+@param checksums A std::vector<SWorldChecksum>& variable which receives the checksums
+*/
+bool CWorldChecksumLog::Load(const std::string& filename, std::vector<SWorldChecksum>& checksums)
+{
+	checksums.clear();
+
+	std::ifstream inputFile(filename.c_str(), std::ios::binary);
+	if (!inputFile.is_open())
+	{
+		cout << "CWorldChecksumLog::Load - Unable to open " << filename << endl;
+		return false;
+	}
+
+	char cMagic[sizeof(WORLD_CHECKSUM_MAGIC)];
+	if ((!inputFile.read(cMagic, sizeof(cMagic))) || (memcmp(cMagic, WORLD_CHECKSUM_MAGIC, sizeof(cMagic)) != 0))
+	{
+		cout << "CWorldChecksumLog::Load - " << filename << " is not a checksum log" << endl;
+		return false;
+	}
+
+	SWorldChecksum sChecksum;
+	memset(&sChecksum, 0, sizeof(sChecksum));
+	while ((inputFile.read((char*)&sChecksum.uiTick, sizeof(sChecksum.uiTick)))
+		&& (inputFile.read((char*)sChecksum.arrSections, sizeof(sChecksum.arrSections))))
+	{
+		checksums.push_back(sChecksum);
+	}
+
+	return true;
+}
+
+/**
+@brief Load the lines of a tick from a detail file, which HeadlessSimulation writes with -detail.
+	   Each line is for one entity, and starts with the tick.
+@param filename A const std::string& variable containing the name of the file
+@param uiTick A const uint32_t variable containing the tick
+@param lines A std::vector<std::string>& variable which receives the lines, without the tick
+*/
+bool CWorldChecksumLog::LoadDetail(const std::string& filename, const uint32_t uiTick, std::vector<std::string>& lines)
+{
+	lines.clear();
+
+	std::ifstream inputFile(filename.c_str());
+	if (!inputFile.is_open())
+	{
+		cout << "CWorldChecksumLog::LoadDetail - Unable to open " << filename << endl;
+		return false;
+	}
+
+	std::string line;
+	while (std::getline(inputFile, line))
+	{
+		const size_t uiSpace = line.find(' ');
+		if (uiSpace == std::string::npos)
+			continue;
+		const uint32_t uiLineTick = (uint32_t)strtoul(line.c_str(), NULL, 10);
+		if (uiLineTick == uiTick)
+			lines.push_back(line.substr(uiSpace + 1));
+		else if (uiLineTick > uiTick)
+			break;
+	}
+
+	return true;
+}
@@ -0,0 +1,73 @@
+/**
+ CWorldChecksum
+ @brief The checksums of the parts of the world at a tick, and a log of them over a run.
+		Two runs of the same replay must have the same checksums at every tick. When they do not,
+		the parts which differ show where the gameplay has changed.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+struct SWorldChecksum
+{
+	// The parts of the world which are checked
+	enum SECTION
+	{
+		MAP = 0,	// The tiles of the current level
+		PLAYER,		// The position and the stats of the player
+		INVENTORY,	// The count of each item, including the health
+		ENEMIES,	// The enemies, in the order they were created
+		BULLETS,	// The bullets, in the order they were fired
+		PICKUPS,	// The pickups, in the order they were dropped
+		BOSS,		// The boss
+		NUM_SECTIONS
+	};
+
+	// The tick which these checksums are for
+	uint32_t uiTick;
+	// The checksum of each part
+	uint64_t arrSections[NUM_SECTIONS];
+
+	// Get a checksum of all the parts
+	uint64_t GetTotal(void) const;
+
+	// Get the name of a part
+	static const char* GetSectionName(const int iSection);
+};
+
+class CWorldChecksumLog
+{
+public:
+	// Constructor
+	CWorldChecksumLog(void);
+
+	// Destructor
+	~CWorldChecksumLog(void);
+
+	// Open a file to write the checksums into
+	bool Open(const std::string& filename);
+
+	// Write the checksums of a tick
+	void Write(const SWorldChecksum& sChecksum);
+
+	// Close the file
+	void Close(void);
+
+	// Check if a file is open
+	bool IsOpen(void) const;
+
+	// Load all the checksums in a file
+	static bool Load(const std::string& filename, std::vector<SWorldChecksum>& checksums);
+
+	// Load the lines of a tick from a detail file, one for each entity
+	static bool LoadDetail(const std::string& filename, const uint32_t uiTick, std::vector<std::string>& lines);
+
+protected:
+	// The file being written
+	std::ofstream file;
+};
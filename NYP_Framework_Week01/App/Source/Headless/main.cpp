@@ -0,0 +1,245 @@
+/**
+ HeadlessSimulation
+ @brief This file runs the Scene2D without a window, as fast as it can.
+		Run it from the App folder, so that the maps are found.
+		Usage: HeadlessSimulation [-ticks N] [-rate N] [-seed N] [-replay file] [-record file] [-checksums file] [-detail file] [-trace file] [-frametimes file] [-allocbudget N] [-zeroalloc off|count|assert]
+		[-enemies N] [-bullets N] [-pickups N] [-level file] [-workers N]
+		-rate sets the ticks per second which a tick must keep up with. Each tick steps CSettings::dTickGameTime of game time.
+		-replay sets the tick rate and the seed of the recording, and ends the run when it has been replayed.
+		-record records the inputs of each tick with the tick rate and the seed, so that the run can be replayed
+		in the game or here. A recording starts at the first tick of the world in both.
+		-checksums writes the checksums of the world at each tick, for CompareChecksums.
+		-detail writes the checksum and the position of each entity at each tick into a text file, so that
+		CompareChecksums can tell which entity differs. It is large, so it is only written when asked for.
+		-trace writes the zones of all the ticks in the Chrome trace format. It needs ENABLE_PROFILER.
+		-frametimes writes the time of each tick into a CSV file, so that two builds can be compared.
+		-allocbudget counts the ticks which make more than N allocations, and -zeroalloc sets what to do when a zone
+		marked by MEMORY_ZERO_ALLOC allocates. The allocations of each tick are printed at the end when it is built
+		with ENABLE_MEMORY_TRACKING.
+		-enemies, -bullets and -pickups place N extra entities into the level, to stress the scene.
+		-level runs a level of any size from GenerateLevel, instead of the shipped maps.
+		-workers sets the number of worker threads of the CJobSystem, so that the checksums of runs with different
+		numbers of threads can be compared. By default, there is one for each core after the first.
+		The hardware events of the zones are printed at the end when it is built with ENABLE_PERF_COUNTERS.
+ By: agent
+ Date: Oct 2026
+ */
+#include "HeadlessSimulation.h"
+
+// Include CSettings
+#include "GameControl/Settings.h"
+// Include CJobSystem
+#include "JobControl/JobSystem.h"
+// Include CProfiler, which times the zones of each tick
+#include "TimeControl/Profiler.h"
+// Include CFPSCounter, which keeps the times of the ticks
+#include "TimeControl/FPSCounter.h"
+// Include CPerfCounters, which counts the hardware events of the zones
+#include "TimeControl/PerfCounters.h"
+// Include CMemoryTracker, which counts the allocations of each tick
+#include "System/MemoryTracker.h"
+// Include CGLTelemetry, which tracks the OpenGL objects which the entities create
+#include "RenderControl/GLTelemetry.h"
+// Include the controllers and CInputRecorder, which records or replays their inputs
+#include "Inputs/KeyboardController.h"
+#include "Inputs/MouseController.h"
+#include "Inputs/InputRecorder.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+	// The ticks of a headless run are checksummed and compared, so they must not depend on the time which they take
+	CSettings::GetInstance()->bDeterministic = true;
+
+	int iNumTicks = 10000;
+	int iTickRate = CSettings::GetInstance()->iTickRate;
+	std::string replayFilename;
+	std::string recordFilename;
+	std::string checksumFilename;
+	std::string detailFilename;
+	std::string traceFilename;
+	std::string frameTimesFilename;
+	std::string levelFilename;
+	int iNumWorkers = -1;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "-ticks") == 0)
+			iNumTicks = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "-rate") == 0)
+			iTickRate = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "-seed") == 0)
+			CSettings::GetInstance()->iRandomSeed = (unsigned int)strtoul(argv[i + 1], NULL, 10);
+		else if (strcmp(argv[i], "-replay") == 0)
+			replayFilename = argv[i + 1];
+		else if (strcmp(argv[i], "-record") == 0)
+			recordFilename = argv[i + 1];
+		else if (strcmp(argv[i], "-checksums") == 0)
+			checksumFilename = argv[i + 1];
+		else if (strcmp(argv[i], "-detail") == 0)
+			detailFilename = argv[i + 1];
+		else if (strcmp(argv[i], "-trace") == 0)
+			traceFilename = argv[i + 1];
+		else if (strcmp(argv[i], "-frametimes") == 0)
+			frameTimesFilename = argv[i + 1];
+		else if (strcmp(argv[i], "-allocbudget") == 0)
+			CMemoryTracker::SetFrameBudget((unsigned int)strtoul(argv[i + 1], NULL, 10));
+		else if (strcmp(argv[i], "-zeroalloc") == 0)
+		{
+			if (strcmp(argv[i + 1], "off") == 0)
+				CMemoryTracker::SetZeroAllocMode(CMemoryTracker::ZERO_ALLOC_OFF);
+			else if (strcmp(argv[i + 1], "assert") == 0)
+				CMemoryTracker::SetZeroAllocMode(CMemoryTracker::ZERO_ALLOC_ASSERT);
+			else
+				CMemoryTracker::SetZeroAllocMode(CMemoryTracker::ZERO_ALLOC_COUNT);
+		}
+		else if (strcmp(argv[i], "-level") == 0)
+			levelFilename = argv[i + 1];
+		else if (strcmp(argv[i], "-enemies") == 0)
+			CSettings::GetInstance()->iStressEnemies = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "-bullets") == 0)
+			CSettings::GetInstance()->iStressBullets = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "-pickups") == 0)
+			CSettings::GetInstance()->iStressPickUps = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "-workers") == 0)
+			iNumWorkers = atoi(argv[i + 1]);
+		else
+			iNumTicks = 0;
+	}
+	if ((iNumTicks <= 0) || (iTickRate <= 0) || (argc % 2 == 0) || ((!replayFilename.empty()) && (!recordFilename.empty())))
+	{
+		cout << "Usage: " << argv[0] << " [-ticks N] [-rate N] [-seed N] [-replay file] [-record file] [-checksums file] [-detail file] [-trace file] [-frametimes file] [-allocbudget N] [-zeroalloc off|count|assert] [-enemies N] [-bullets N] [-pickups N] [-level file] [-workers N]" << endl;
+		return 1;
+	}
+	if (!replayFilename.empty())
+	{
+		if (CInputRecorder::GetInstance()->StartReplay(replayFilename) == false)
+			return 1;
+		iTickRate = CSettings::GetInstance()->iTickRate;
+	}
+	else if (!recordFilename.empty())
+	{
+		// The recording keeps the tick rate and the seed of this run
+		CSettings::GetInstance()->iTickRate = iTickRate;
+		if (CInputRecorder::GetInstance()->StartRecording(recordFilename) == false)
+			return 1;
+	}
+
+	CWorldChecksumLog cChecksumLog;
+	if ((!checksumFilename.empty()) && (cChecksumLog.Open(checksumFilename) == false))
+		return 1;
+	std::ofstream detailFile;
+	if (!detailFilename.empty())
+	{
+		detailFile.open(detailFilename.c_str());
+		if (!detailFile.is_open())
+		{
+			cout << "Unable to write the checksum detail into " << detailFilename << endl;
+			return 1;
+		}
+	}
+
+	// Name the main thread in the profiler. This creates the CProfiler before the worker threads use it.
+	PROFILE_THREAD("Main");
+	if ((!traceFilename.empty()) && (CProfiler::GetInstance()->StartCapture(traceFilename) == false))
+		return 1;
+
+	CJobSystem::GetInstance()->Init(iNumWorkers);
+
+	CHeadlessSimulation cSimulation;
+	if (cSimulation.Init(levelFilename) == false)
+	{
+		cout << "Failed to initialise the headless simulation. Run it from the App folder." << endl;
+		CJobSystem::GetInstance()->Destroy();
+		return 1;
+	}
+
+	// A tick which takes longer than the game time which it steps could not keep up with a real-time game
+	const double dTickTime = 1.0 / iTickRate;
+	CFPSCounter* cFPSCounter = CFPSCounter::GetInstance();
+	cFPSCounter->Init();
+	cFPSCounter->SetHitchThreshold(dTickTime * 1000.0);
+	if (!frameTimesFilename.empty())
+		cFPSCounter->SetCSVFilename(frameTimesFilename);
+
+	// The checksums are computed at every tick, whether they are written or not, so that their cost is always measured
+	SWorldChecksum sChecksum;
+	std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+	for (int i = 0; i < iNumTicks; i++)
+	{
+		const std::chrono::steady_clock::time_point tTickStart = std::chrono::steady_clock::now();
+
+		// The replay ends after its last tick. CWorld2D replays or records the inputs of each tick.
+		if (CInputRecorder::GetInstance()->IsReplayFinished())
+			break;
+
+		CJobSystem::GetInstance()->ResetScratchArenas();
+
+		cSimulation.Update(CSettings::GetInstance()->dTickGameTime);
+		const std::chrono::steady_clock::time_point tUpdated = std::chrono::steady_clock::now();
+
+		// A key press is only seen by the first tick which runs after it
+		CKeyboardController::GetInstance()->PostUpdate();
+
+		{
+			PROFILE_ZONE("ComputeChecksum");
+			cSimulation.ComputeChecksum(sChecksum);
+		}
+		cChecksumLog.Write(sChecksum);
+		if (detailFile.is_open())
+			cSimulation.WriteChecksumDetail(detailFile);
+
+		// Each tick is a frame of the CFPSCounter
+		cFPSCounter->SetUpdateTime(std::chrono::duration<double>(tUpdated - tTickStart).count());
+		cFPSCounter->Update(std::chrono::duration<double>(std::chrono::steady_clock::now() - tTickStart).count());
+
+		// Each tick is a frame of the profiler, of the allocation counts and of the OpenGL call counts
+		PROFILE_END_FRAME();
+		CMemoryTracker::EndFrame();
+		CGLTelemetry::GetInstance()->NewFrame();
+	}
+	const double dTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+
+	cout << fixed << setprecision(2)
+		<< cSimulation.GetNumTicks() << " ticks (" << cSimulation.GetNumTicks() * CSettings::GetInstance()->dTickGameTime << " s of game time) in "
+		<< dTime * 1000.0 << " ms, " << cSimulation.GetNumTicks() / dTime << " ticks per second" << endl;
+	cout << "Active enemies: " << cSimulation.GetNumActiveEnemies()
+		<< ", bullets: " << cSimulation.GetNumActiveBullets()
+		<< ", pickups: " << cSimulation.GetNumActivePickUps()
+		<< ", player lost: " << cSimulation.GetNumPlayerLost() << endl;
+	cout << "Checksum: " << hex << setfill('0') << setw(16) << sChecksum.GetTotal() << dec << endl;
+	cFPSCounter->UpdateWindowStatistics();
+	cout << setprecision(3) << "Last " << cFPSCounter->GetNumSamples() << " ticks: p50 "
+		<< cFPSCounter->GetFrameTimePercentile(CFPSCounter::P50) << " ms, p95 "
+		<< cFPSCounter->GetFrameTimePercentile(CFPSCounter::P95) << " ms, p99 "
+		<< cFPSCounter->GetFrameTimePercentile(CFPSCounter::P99) << " ms, max "
+		<< cFPSCounter->GetFrameTimePercentile(CFPSCounter::P100) << " ms, update "
+		<< cFPSCounter->GetAverageUpdateTime() << " ms, hitches " << cFPSCounter->GetNumHitches() << endl;
+	if (CPerfCounters::IsEnabled())
+		CPerfCounters::GetInstance()->PrintReport(cout);
+	if (CMemoryTracker::IsEnabled())
+		CMemoryTracker::PrintReport(cout);
+
+	cChecksumLog.Close();
+	cSimulation.Destroy();
+	CJobSystem::GetInstance()->Destroy();
+	// The entities are destroyed, so the OpenGL objects which are still alive were never deleted
+	if (CGLTelemetry::IsEnabled())
+		CGLTelemetry::GetInstance()->PrintLeakReport(cout);
+	CGLTelemetry::GetInstance()->Destroy();
+	// Write the trace, if any. No thread times a zone after this.
+	CProfiler::GetInstance()->Destroy();
+	CPerfCounters::GetInstance()->Destroy();
+	CInputRecorder::GetInstance()->Destroy();
+	// Write the times of the ticks, if asked for
+	cFPSCounter->Destroy();
+
+	return 0;
+}
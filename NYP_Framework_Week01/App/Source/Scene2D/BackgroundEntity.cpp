@@ -10,7 +10,11 @@
 #include "Primitives/MeshBuilder.h"
 
 // Include ImageLoader
-#include "System\ImageLoader.h"
+#include "System/ImageLoader.h"
+// Include CGPUTimer
+#include "RenderControl/GPUTimer.h"
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "RenderControl/GLTelemetry.h"
 
 #include <iostream>
 #include <vector>
@@ -51,6 +55,17 @@ bool CBackgroundEntity::Init()
 
 	return true;
 }
+
+/**
+ @brief Render this instance
+ */
+void CBackgroundEntity::Render(void)
+{
+	CGPUTimer::GetInstance()->BeginPass(CGPUTimer::BACKGROUND);
+	CEntity2D::Render();
+	CGPUTimer::GetInstance()->EndPass(CGPUTimer::BACKGROUND);
+}
+
 void CBackgroundEntity::changeBG(std::string name)
 {
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
@@ -7,7 +7,7 @@
 #pragma once
 
 // Include Singleton template
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
 // Include GLEW
 #ifndef GLEW_STATIC
@@ -34,6 +34,9 @@ public:
 
 	// Init
 	bool Init(void);
+
+	// Render, timed on the GPU as the background pass
+	virtual void Render(void);
 	void changeBG(std::string name);
 protected:
 	std::string textureName;
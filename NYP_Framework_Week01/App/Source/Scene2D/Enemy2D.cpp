@@ -6,25 +6,39 @@
  */
 #include "Enemy2D.h"
 
+// Include CProfiler to time the zones of the frame
+#include "TimeControl/Profiler.h"
+// Include CMemoryTracker to count the allocations of the frame
+#include "System/MemoryTracker.h"
+// Include CPerfCounters to count the hardware events of the zones
+#include "TimeControl/PerfCounters.h"
+
 #include <iostream>
 using namespace std;
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
+// Include Sprite Batch
+#include "RenderControl/SpriteBatch.h"
 // Include Mesh Builder
 #include "Primitives/MeshBuilder.h"
 
 // Include GLEW
 #include <GL/glew.h>
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "RenderControl/GLTelemetry.h"
 
 // Include ImageLoader
-#include "System\ImageLoader.h"
+#include "System/ImageLoader.h"
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
 // Include math.h
 #include <math.h>
 
+// Include CPathFindingService
+#include "PathFindingService.h"
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
@@ -33,6 +47,8 @@ CEnemy2D::CEnemy2D(void)
 	, cMap2D(NULL)
 	, cSettings(NULL)
 	, cPlayer2D(NULL)
+	, cBulletGrid(NULL)
+	, cWorldSnapshot(NULL)
 	, sCurrentFSM(FSM::IDLE)
 	, iFSMCounter(0)
 	, quadMesh(NULL)
@@ -47,6 +63,7 @@ CEnemy2D::CEnemy2D(void)
 
 	// Initialise vec2UVCoordinate
 	vec2UVCoordinate = glm::vec2(0.0f);
+	vec2PrevUVCoordinate = glm::vec2(0.0f);
 
 	i32vec2Destination = glm::i32vec2(0, 0);	// Initialise the iDestination
 	i32vec2Direction = glm::i32vec2(0, 0);		// Initialise the iDirection
@@ -67,6 +84,12 @@ CEnemy2D::~CEnemy2D(void)
 	// We won't delete this since it was created elsewhere
 	cPlayer2D = NULL;
 
+	// We won't delete this since it was created elsewhere
+	cBulletGrid = NULL;
+
+	// We won't delete this since it was created elsewhere
+	cWorldSnapshot = NULL;
+
 	// We won't delete this since it was created elsewhere
 	cMap2D = NULL;
 
@@ -177,7 +200,10 @@ bool CEnemy2D::Init(void)
 	// If this class is initialised properly, then set the bIsActive to true
 	bIsActive = true;
 
-	rand_dir = rand() % 2; // 0 or 1
+	// Seed this enemy's own random numbers here on the main thread, as Update() may run on a worker thread
+	cRandom = CRandomService::GetInstance()->CreateEntityStream();
+
+	rand_dir = cRandom.Range(2); // 0 or 1
 
 
 
@@ -192,36 +218,22 @@ void CEnemy2D::Update(const double dElapsedTime)
 	if (!bIsActive)
 		return;
 
+	PROFILE_ZONE("CEnemy2D::Update");
+	MEMORY_TAG(ENTITIES);
+
 	dt = dElapsedTime;
 
 	/*cout << enemyHealth << endl;*/
 
 	if (enemyHealth <= 0)
 	{
-		if (enemyType < 3)
-		{
-			cPlayer2D->enemies_unalived++;
-		}
-
-		if (enemyType == 0) //blues
-		{
-			cPlayer2D->addToinventory(13,"metalparts", rand() % 2 + 1, 10);
-		}
-
-		else if (enemyType == 1) //clifford
-		{
-			cPlayer2D->addToinventory(12, "firepowder", rand() % 2 + 1, 10);
-		}
-
-		else if (enemyType == 2) //cow
+		// The kill count and the loot are given to the player in ApplyIntents()
+		int iNumItems = 1;
+		if ((enemyType == 0) || (enemyType == 1)) //blues or clifford
 		{
-			cPlayer2D->addToinventory(15, "oilcan", 1, 1);
-		}
-
-		else //unicorn
-		{
-			cPlayer2D->addToinventory(14, "ironhorn", 1, 10);
+			iNumItems = cRandom.Range(1, 2);
 		}
+		AddIntent(SIntent::KILLED, NULL, vec2Index, iNumItems);
 
 		bIsActive = false;
 	}
@@ -251,7 +263,7 @@ void CEnemy2D::Update(const double dElapsedTime)
 		{
 			iFSMCounter = 0;
 			//cout << "Switching to Patrol State" << endl;
-			ShortCutPath(cPlayer2D->vec2Index);
+			ShortCutPath(cWorldSnapshot->vec2PlayerIndex);
 			UpdatePosition();
 		}
 		iFSMCounter++;
@@ -293,10 +305,10 @@ void CEnemy2D::Update(const double dElapsedTime)
 			iFSMCounter = 0;
 			//cout << "Switching to Patrol State" << endl;
 			glm::vec2 rundes; //run destination
-			rundes.x = cPlayer2D->vec2Index.x;
+			rundes.x = cWorldSnapshot->vec2PlayerIndex.x;
 			rundes.y = vec2Index.y;
 			ShortCutPath(rundes);
-			if (vec2Index.x == cPlayer2D->vec2Index.x)
+			if (vec2Index.x == cWorldSnapshot->vec2PlayerIndex.x)
 			{
 				targetLocked = true;
 			}
@@ -314,10 +326,10 @@ void CEnemy2D::Update(const double dElapsedTime)
 			iFSMCounter = 0;
 			//cout << "Switching to Patrol State" << endl;
 			glm::vec2 rundes; //run destination
-			rundes.y = cPlayer2D->vec2Index.y;
+			rundes.y = cWorldSnapshot->vec2PlayerIndex.y;
 			rundes.x = vec2Index.x;
 			ShortCutPath(rundes);
-			if (vec2Index.y == cPlayer2D->vec2Index.y)
+			if (vec2Index.y == cWorldSnapshot->vec2PlayerIndex.y)
 			{
 				targetLocked = true;
 			}
@@ -345,7 +357,7 @@ void CEnemy2D::Update(const double dElapsedTime)
 				walktimer += dElapsedTime;
 				if (walktimer > 0.3f)
 				{
-					int random_walk_direction = rand() % 4;
+					int random_walk_direction = cRandom.Range(4);
 					
 					if (random_walk_direction == 1)
 					{
@@ -388,6 +400,9 @@ void CEnemy2D::Update(const double dElapsedTime)
 	// Update Jump or Fall
 	UpdateJumpFall(dElapsedTime);
 
+	// Keep the UV Coordinates of the tick before, to render between the ticks
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+
 	// Update the UV Coordinates
 	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, i32vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
 	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, i32vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
@@ -398,18 +413,7 @@ void CEnemy2D::Update(const double dElapsedTime)
  */
 void CEnemy2D::PreRender(void)
 {
-	if (!bIsActive)
-		return;
-
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-
-	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	// Activate the shader
-	CShaderManager::GetInstance()->Use(sShaderName);
+	// The blending mode and the shader are set up by CSpriteBatch when it draws this frame's sprites
 }
 
 /**
@@ -420,29 +424,14 @@ void CEnemy2D::Render(void)
 	if (!bIsActive)
 		return;
 
-	glBindVertexArray(VAO);
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
-	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
-		vec2UVCoordinate.y,
-		0.0f));
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-	glUniform4fv(colorLoc, 1, glm::value_ptr(runtimeColour));
-
-	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-
-	// Render the tile
-	//glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-	quadMesh->Render();
-
-	glBindVertexArray(0);
+	PROFILE_ZONE("CEnemy2D::Render");
+	MEMORY_ZERO_ALLOC("CEnemy2D::Render");
 
+	// Submit this enemy to the sprite batch, which draws it with the other sprites using the same texture
+	CSpriteBatch::GetInstance()->Submit(iTextureID,
+										InterpolateUVCoordinate(vec2PrevUVCoordinate, vec2UVCoordinate),
+										glm::vec2(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT),
+										runtimeColour);
 }
 
 /**
@@ -450,11 +439,7 @@ void CEnemy2D::Render(void)
  */
 void CEnemy2D::PostRender(void)
 {
-	if (!bIsActive)
-		return;
-
-	// Disable blending
-	glDisable(GL_BLEND);
+	// The blending mode is disabled by CSpriteBatch after it draws this frame's sprites
 }
 
 /**
@@ -479,6 +464,22 @@ void CEnemy2D::Seti32vec2NumMicroSteps(const int iNumMicroSteps_XAxis, const int
 	this->i32vec2NumMicroSteps.y = iNumMicroSteps_YAxis;
 }
 
+/**
+@brief Get the indices of the enemy2D
+*/
+glm::vec2 CEnemy2D::Geti32vec2Index(void) const
+{
+	return vec2Index;
+}
+
+/**
+@brief Get the number of microsteps of the enemy2D
+*/
+glm::vec2 CEnemy2D::Geti32vec2NumMicroSteps(void) const
+{
+	return i32vec2NumMicroSteps;
+}
+
 /**
  @brief Set the handle to cPlayer to this class instance
  @param cPlayer2D A CPlayer2D* variable which contains the pointer to the CPlayer2D instance
@@ -491,6 +492,115 @@ void CEnemy2D::SetPlayer2D(CPlayer2D* cPlayer2D)
 	UpdateDirection();
 }
 
+/**
+ @brief Set the handle to the world snapshot which Update() reads instead of the player and the mouse
+ @param cWorldSnapshot A const SWorldSnapshot* variable which contains the world snapshot
+ */
+void CEnemy2D::SetWorldSnapshot(const SWorldSnapshot* cWorldSnapshot)
+{
+	this->cWorldSnapshot = cWorldSnapshot;
+}
+
+/**
+ @brief Apply the changes to the world which the last Update() recorded.
+		Call this on the main thread after all the enemies have updated, in the same order as enemyVector,
+		so that the result is the same however many threads ran Update().
+ */
+void CEnemy2D::ApplyIntents(void)
+{
+	for (unsigned int i = 0; i < intents.size(); i++)
+	{
+		const SIntent& sIntent = intents[i];
+		switch (sIntent.eType)
+		{
+		case SIntent::DAMAGE_PLAYER:
+			// An enemy before this one may have already hit the player this tick
+			if (cPlayer2D->getIframe() == false)
+			{
+				cPlayer2D->SetIframe();
+				cPlayer2D->setHealth(10);
+			}
+			break;
+
+		case SIntent::HIT_BY_BULLET:
+			// An enemy before this one may have already taken this bullet this tick
+			if (sIntent.cBullet->bIsActive)
+			{
+				enemyHealth -= cPlayer2D->getGunDmg();
+				sIntent.cBullet->bIsActive = false;
+			}
+			break;
+
+		case SIntent::FIRE:
+		{
+			cMap2D->SetMapInfo(sIntent.vec2Index.y, sIntent.vec2Index.x, 372);
+			MEMORY_TAG(BULLETS);
+			bullet* p = new bullet();
+			p->SetShader("Shader2D_Colour");
+			p->Init();
+			p->des = cPlayer2D->vec2Index;
+			eBullet.push_back(p);
+		}
+		break;
+
+		case SIntent::KILLED:
+			if (enemyType < 3)
+			{
+				cPlayer2D->enemies_unalived++;
+			}
+
+			if (enemyType == 0) //blues
+			{
+				cPlayer2D->addToinventory(13, "metalparts", sIntent.iValue, 10);
+			}
+			else if (enemyType == 1) //clifford
+			{
+				cPlayer2D->addToinventory(12, "firepowder", sIntent.iValue, 10);
+			}
+			else if (enemyType == 2) //cow
+			{
+				cPlayer2D->addToinventory(15, "oilcan", 1, 1);
+			}
+			else //unicorn
+			{
+				cPlayer2D->addToinventory(14, "ironhorn", 1, 10);
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	intents.clear();
+}
+
+/**
+ @brief Record a change to the world, to be made in ApplyIntents()
+ @param eType A const SIntent::TYPE variable which states the type of change
+ @param cBullet A bullet* variable containing the bullet, for HIT_BY_BULLET
+ @param vec2Index A const glm::vec2& variable containing the tile, for FIRE
+ @param iValue A const int variable containing the number of items dropped, for KILLED
+ */
+void CEnemy2D::AddIntent(const SIntent::TYPE eType, bullet* cBullet, const glm::vec2& vec2Index, const int iValue)
+{
+	SIntent sIntent;
+	sIntent.eType = eType;
+	sIntent.cBullet = cBullet;
+	sIntent.vec2Index = vec2Index;
+	sIntent.iValue = iValue;
+	intents.push_back(sIntent);
+}
+
+/**
+ @brief Set the handle to the grid of the player's bullets to this class instance
+ @param cBulletGrid A CSpatialHash2D<bullet*>* variable which contains the pointer to the grid
+ */
+void CEnemy2D::SetBulletGrid(CSpatialHash2D<bullet*>* cBulletGrid)
+{
+	this->cBulletGrid = cBulletGrid;
+}
+
 
 
 void CEnemy2D::SetHp(int i)
@@ -549,6 +659,9 @@ void CEnemy2D::Constraint(DIRECTION eDirection)
  */
 bool CEnemy2D::CheckPosition(DIRECTION eDirection)
 {
+	PROFILE_COUNTERS("CEnemy2D::CheckPosition");
+	MEMORY_ZERO_ALLOC("CEnemy2D::CheckPosition");
+
 	if (eDirection == LEFT)
 	{
 		// If the new position is fully within a row, then check this row only
@@ -791,7 +904,7 @@ void CEnemy2D::UpdateJumpFall(const double dElapsedTime)
 
 bool CEnemy2D::InteractWithPlayer(void)
 {
-	glm::i32vec2 i32vec2PlayerPos = cPlayer2D->vec2Index;
+	glm::i32vec2 i32vec2PlayerPos = cWorldSnapshot->vec2PlayerIndex;
 
 	// Check if the enemy2D is within 6.5 indices of the player2D
 	if (((vec2Index.x >= i32vec2PlayerPos.x - 6.5) &&
@@ -807,18 +920,24 @@ bool CEnemy2D::InteractWithPlayer(void)
 		iFSMCounter = 0;
 	}
 
-	for (size_t i = 0; i < watchout.size(); i++)
+	// Check the player's bullets in the tiles around this enemy.
+	// The bullets are only read here, and the hits are resolved in ApplyIntents() in the order of the enemies.
+	if (cBulletGrid)
 	{
-		if (((vec2Index.x >= watchout[i]->vec2Index.x - .5) &&
-			(vec2Index.x <= watchout[i]->vec2Index.x + .5))
-			&&
-			((vec2Index.y >= watchout[i]->vec2Index.y - .5) &&
-				(vec2Index.y <= watchout[i]->vec2Index.y + .5)))
+		cBulletGrid->ForEachInRange(vec2Index, 0.5f, [&](bullet* cBullet)
 		{
-			enemyHealth -= cPlayer2D->getGunDmg();
-			watchout[i]->bIsActive = false;
-		}
+			if (cBullet->bIsActive == false)
+				return;
 
+			if (((vec2Index.x >= cBullet->vec2Index.x - .5) &&
+				(vec2Index.x <= cBullet->vec2Index.x + .5))
+				&&
+				((vec2Index.y >= cBullet->vec2Index.y - .5) &&
+					(vec2Index.y <= cBullet->vec2Index.y + .5)))
+			{
+				AddIntent(SIntent::HIT_BY_BULLET, cBullet);
+			}
+		});
 	}
 
 
@@ -831,10 +950,9 @@ bool CEnemy2D::InteractWithPlayer(void)
 			((vec2Index.y >= i32vec2PlayerPos.y - 2) &&
 				(vec2Index.y <= i32vec2PlayerPos.y + 2)))
 		{
-			if (cPlayer2D->getIframe() == false)
+			if (cWorldSnapshot->bPlayerIframe == false)
 			{
-				cPlayer2D->SetIframe();
-				cPlayer2D->setHealth(10);
+				AddIntent(SIntent::DAMAGE_PLAYER);
 			}
 		}
 	}
@@ -844,23 +962,16 @@ bool CEnemy2D::InteractWithPlayer(void)
 		firerate += dt;
 		if (firerate >= 0.3)
 		{
-			cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 372);
-			bullet* p = new bullet();
-			p->SetShader("Shader2D_Colour");
-			p->Init();
-			p->des = cPlayer2D->vec2Index;
-			eBullet.push_back(p);
+			AddIntent(SIntent::FIRE, NULL, vec2Index);
 			firerate = 0.f;
 		}
 	}
 
-	float posX = CMouseController::GetInstance()->GetMousePositionX() / cSettings->iWindowWidth * 32; //convert (0,800) to (0,80)
-	float posY = 24 - (CMouseController::GetInstance()->GetMousePositionY() / cSettings->iWindowHeight * 24);
-	glm::vec2 mousePos(posX, posY);
+	glm::vec2 mousePos = cWorldSnapshot->vec2MousePos;
 
 	if ((mousePos.x > 0 && mousePos.x < cSettings->NUM_TILES_XAXIS - 1) && (mousePos.y > 0 && mousePos.y < cSettings->NUM_TILES_YAXIS - 1))
 	{
-		if (cPhysics2D.CalculateDistance(cPlayer2D->vec2Index, mousePos) <= 2)
+		if (cPhysics2D.CalculateDistance(cWorldSnapshot->vec2PlayerIndex, mousePos) <= 2)
 		{
 			if (((vec2Index.x >= mousePos.x - 2) &&
 				(vec2Index.x <= mousePos.x + 2))
@@ -868,13 +979,13 @@ bool CEnemy2D::InteractWithPlayer(void)
 				((vec2Index.y >= mousePos.y - 2) &&
 					(vec2Index.y <= mousePos.y + 2)))
 			{
-				if (CMouseController::GetInstance()->IsButtonDown(0))
+				if (cWorldSnapshot->bMouseButtonDown)
 				{
-					enemyHealth -= cPlayer2D->getDmg();
+					enemyHealth -= cWorldSnapshot->fPlayerDmg;
 				}
-				if (CMouseController::GetInstance()->IsButtonDown(0) && cowplscome == true)
+				if (cWorldSnapshot->bMouseButtonDown && cowplscome == true)
 				{
-					enemyHealth -= cPlayer2D->getDmg();
+					enemyHealth -= cWorldSnapshot->fPlayerDmg;
 				}
 			}
 
@@ -890,8 +1001,11 @@ bool CEnemy2D::InteractWithPlayer(void)
  */
 void CEnemy2D::UpdateDirection(void)
 {
-	// Set the destination to the player
-	i32vec2Destination = cPlayer2D->vec2Index;
+	// Set the destination to the player. SetPlayer2D() calls this before there is a world snapshot.
+	if (cWorldSnapshot)
+		i32vec2Destination = cWorldSnapshot->vec2PlayerIndex;
+	else
+		i32vec2Destination = cPlayer2D->vec2Index;
 
 	// Calculate the direction between enemy2D and player2D
 	i32vec2Direction = i32vec2Destination - vec2Index;
@@ -1074,14 +1188,24 @@ void CEnemy2D::UpdatePosition(void)
 
 void CEnemy2D::ShortCutPath(glm::vec2 des)
 {
-	auto path = cMap2D->PathFind(vec2Index,
-		des,
-		heuristic::euclidean,
-		10);
+	// Ask for a path to the destination, unless one is still being found
+	if (pathFuture.valid() == false)
+	{
+		pathFuture = CPathFindingService::GetInstance()->Request(uiEntityID,
+			vec2Index,
+			des,
+			heuristic::EUCLIDEAN,
+			10);
+	}
+
+	// Keep to the destination of the previous path until the new path arrives
+	if (pathFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return;
+	auto path = pathFuture.get();
 
 	// Calculate new destination
 	bool bFirstPosition = true;
-	for (const auto& coord : path)
+	for (const glm::vec2 coord : path)
 	{
 		//std::cout << coord.x << "," << coord.y << "\n";
 		if (bFirstPosition == true)
@@ -1104,3 +1228,22 @@ void CEnemy2D::ShortCutPath(glm::vec2 des)
 		}
 	}
 }
+
+/**
+ @brief Add the state of this enemy to a checksum of the world
+ @param cChecksum A CChecksum& variable containing the checksum
+ */
+void CEnemy2D::AddToChecksum(CChecksum& cChecksum) const
+{
+	cChecksum.Add(bIsActive);
+	// An inactive entity is never active again, so the rest of its state does not matter
+	if (!bIsActive)
+		return;
+
+	cChecksum.Add(vec2Index);
+	cChecksum.Add(i32vec2NumMicroSteps);
+	cChecksum.Add(sCurrentFSM);
+	cChecksum.Add(iFSMCounter);
+	cChecksum.Add(hp);
+	cChecksum.Add(enemyType);
+}
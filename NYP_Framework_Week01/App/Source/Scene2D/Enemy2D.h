@@ -7,7 +7,7 @@
 #pragma once
 
 // Include shader
-#include "RenderControl\shader.h"
+#include "RenderControl/Shader.h"
 
 // Include GLM
 #include <includes/glm.hpp>
@@ -21,7 +21,17 @@
 class CMap2D;
 
 // Include Settings
-#include "GameControl\Settings.h"
+#include "GameControl/Settings.h"
+
+// Include CRandom
+#include "System/Random.h"
+
+// Include CChecksum
+#include "System/Checksum.h"
+
+#include <future>
+// Include CMap2D for the SPath which CPathFindingService finds
+#include "Map2D.h"
 
 // Include Physics2D
 #include "Physics2D.h"
@@ -31,9 +41,23 @@ class CMap2D;
 
 #include "bullet.h"
 
+// Include SpatialHash2D
+#include "SpatialHash2D.h"
+
 class CEnemy2D : public CEntity2D
 {
 public:
+	// The state of the world which the enemies read while they update in parallel.
+	// It is filled in once per tick before the enemies update, and does not change while they do.
+	struct SWorldSnapshot
+	{
+		glm::vec2 vec2PlayerIndex;
+		bool bPlayerIframe;
+		float fPlayerDmg;
+		glm::vec2 vec2MousePos;
+		bool bMouseButtonDown;
+	};
+
 	// Constructor
 	CEnemy2D(void);
 
@@ -76,6 +100,9 @@ public:
 	// Set the handle to cPlayer to this class instance
 	void SetPlayer2D(CPlayer2D* cPlayer2D);
 
+	// Add the state of this enemy to a checksum of the world
+	void AddToChecksum(CChecksum& cChecksum) const;
+
 
 	// boolean flag to indicate if this enemy is active
 	bool bIsActive;
@@ -87,7 +114,14 @@ public:
 	vector<bullet*> eBullet;
 
 
-	vector<bullet*> watchout;
+	// Set the handle to the grid of the player's bullets
+	void SetBulletGrid(CSpatialHash2D<bullet*>* cBulletGrid);
+
+	// Set the handle to the world snapshot which Update() reads
+	void SetWorldSnapshot(const SWorldSnapshot* cWorldSnapshot);
+
+	// Apply the changes to the world which the last Update() recorded. Call this on the main thread.
+	void ApplyIntents(void);
 
 	float firerate = 2.f;
 
@@ -133,6 +167,8 @@ protected:
 
 	// The vec2 variable which stores the UV coordinates to render the enemy2D
 	glm::vec2 vec2UVCoordinate;
+	// The UV coordinates of the tick before, to render the enemy2D between the ticks
+	glm::vec2 vec2PrevUVCoordinate;
 
 	// The vec2 which stores the indices of the destination for enemy2D in the Map2D
 	glm::vec2 i32vec2Destination;
@@ -151,6 +187,42 @@ protected:
 	// Handle to the CPlayer2D
 	CPlayer2D* cPlayer2D;
 
+	// Handle to the grid of the player's bullets
+	CSpatialHash2D<bullet*>* cBulletGrid;
+
+	// Handle to the world snapshot
+	const SWorldSnapshot* cWorldSnapshot;
+
+	// A change to the world outside of this enemy. Update() records them, and ApplyIntents() makes them.
+	struct SIntent
+	{
+		enum TYPE
+		{
+			DAMAGE_PLAYER = 0,
+			HIT_BY_BULLET,
+			FIRE,
+			KILLED,
+			NUM_TYPES
+		};
+
+		TYPE eType;
+		// The bullet which hit this enemy, for HIT_BY_BULLET
+		bullet* cBullet;
+		// The tile to fire from, for FIRE
+		glm::vec2 vec2Index;
+		// The number of items dropped, for KILLED
+		int iValue;
+	};
+
+	// The intents recorded by the last Update()
+	std::vector<SIntent> intents;
+
+	// Record an intent
+	void AddIntent(const SIntent::TYPE eType, bullet* cBullet = NULL, const glm::vec2& vec2Index = glm::vec2(0.0f), const int iValue = 0);
+
+	// This enemy's own random numbers, so that it does not share rand() with the other threads
+	CRandom cRandom;
+
 	glm::vec2 escapeDestination;
 
 
@@ -189,6 +261,8 @@ protected:
 	void UpdatePosition(void);
 
 	void ShortCutPath(glm::vec2 des);
+	// The path which CPathFindingService is finding for ShortCutPath()
+	std::future<SPath> pathFuture;
 	//myStuff;
 
 	float hp=11;
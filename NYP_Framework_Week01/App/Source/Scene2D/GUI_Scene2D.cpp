@@ -6,9 +6,25 @@
  */
 #include "GUI_Scene2D.h"
 
+// Include CProfiler to time the zones of the frame
+#include "TimeControl/Profiler.h"
+// Include CMemoryTracker to count the allocations of the frame
+#include "System/MemoryTracker.h"
+// Include CArenaAllocator for the temporary strings of the frame
+#include "JobControl/ArenaAllocator.h"
+
 #include <iostream>
 #include <sstream>
 
+// Include Sprite Batch
+#include "RenderControl/SpriteBatch.h"
+// Include Render State
+#include "RenderControl/RenderState.h"
+// Include CGPUTimer
+#include "RenderControl/GPUTimer.h"
+// Include CGLTelemetry to show the OpenGL calls of the frame
+#include "RenderControl/GLTelemetry.h"
+
 using namespace std;
 
 /**
@@ -19,6 +35,9 @@ CGUI_Scene2D::CGUI_Scene2D(void)
 	, m_fProgressBar(0.0f)
 	, cInventoryManager(NULL)
 	, cInventoryItem(NULL)
+	, bShowProfiler(false)
+	, bShowFrameTimes(false)
+	, bShowGLTelemetry(false)
 	, lever(NULL)
 	, map(NULL)
 {
@@ -90,6 +109,9 @@ bool CGUI_Scene2D::Init(void)
 	// These variables are for IMGUI demo only
 	show_demo_window = false;
 	show_another_window = false;
+	bShowProfiler = false;
+	bShowFrameTimes = false;
+	bShowGLTelemetry = false;
 	clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
 
 	m_fProgressBar = 0.0f;
@@ -111,6 +133,8 @@ bool CGUI_Scene2D::Init(void)
  */
 void CGUI_Scene2D::Update(const double dElapsedTime)
 {
+	PROFILE_ZONE("CGUI_Scene2D::Update");
+	MEMORY_TAG(GUI);
 	// Calculate the relative scale to our default windows width
 	const float relativeScale_x = cSettings->iWindowWidth / 800.0f;
 	const float relativeScale_y = cSettings->iWindowHeight / 600.0f;
@@ -191,6 +215,15 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 
 		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)",
 			1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+		ImGui::Text("Sprites: %u draw calls, %u vertices",
+			CSpriteBatch::GetInstance()->GetNumDrawCalls(), CSpriteBatch::GetInstance()->GetNumVertices());
+		ImGui::Text("GL state calls: %u made, %u avoided",
+			CRenderState::GetInstance()->GetTotalCalls(), CRenderState::GetInstance()->GetTotalAvoided());
+		ImGui::Text("  program %u/%u, blend %u/%u, texture %u/%u, VAO %u/%u",
+			CRenderState::GetInstance()->GetNumCalls(CRenderState::PROGRAM), CRenderState::GetInstance()->GetNumAvoided(CRenderState::PROGRAM),
+			CRenderState::GetInstance()->GetNumCalls(CRenderState::BLEND), CRenderState::GetInstance()->GetNumAvoided(CRenderState::BLEND),
+			CRenderState::GetInstance()->GetNumCalls(CRenderState::TEXTURE), CRenderState::GetInstance()->GetNumAvoided(CRenderState::TEXTURE),
+			CRenderState::GetInstance()->GetNumCalls(CRenderState::VERTEX_ARRAY), CRenderState::GetInstance()->GetNumAvoided(CRenderState::VERTEX_ARRAY));
 		ImGui::End();
 	}
 
@@ -234,7 +267,8 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 	cInventoryItem = cInventoryManager->GetItem("");
 
 
-	ostringstream ss;
+	// The names of the windows are built in the scratch arena, which is released before the next tick
+	ScratchStringStream ss;
 	
 	PHK = CPlayer2D::GetInstance()->GetHotKeyInv();
 	PHKQ = CPlayer2D::GetInstance()->GetHotKeyQuitity();
@@ -280,7 +314,7 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 
 		}
 		ss << i;
-		string a = ss.str();
+		const ScratchString a = ss.str();
 		const char* b = a.c_str();
 		if (timer <= 0)
 		{
@@ -345,6 +379,19 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 	}
 
 
+	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_F2))
+	{
+		bShowFrameTimes = !bShowFrameTimes;
+	}
+	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_F3))
+	{
+		bShowProfiler = !bShowProfiler;
+	}
+	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_F4))
+	{
+		bShowGLTelemetry = !bShowGLTelemetry;
+	}
+
 	static bool openInv = false;
 	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_E))
 	{
@@ -372,7 +419,7 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 			{
 
 				ss << i;
-				string a = ss.str();
+				const ScratchString a = ss.str();
 				const char* b = a.c_str();
 				if (timer <= 0)
 				{
@@ -441,7 +488,7 @@ void CGUI_Scene2D::Update(const double dElapsedTime)
 				ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.f, 1.f, 0.f, 1.f));  // Set a background color
 			}
 				ss << i;
-				string a = ss.str();
+				const ScratchString a = ss.str();
 				const char* b = a.c_str();
 				if (timer <= 0)
 				{
@@ -677,6 +724,50 @@ bool CGUI_Scene2D::craftable(int i)
 	return true;
 }
 
+/**
+ @brief Show the graph, the histogram and the percentiles of the frame times in the rolling window of the CFPSCounter
+ */
+void CGUI_Scene2D::RenderFrameTimes(void)
+{
+	ImGui::SetNextWindowSize(ImVec2(420.0f, 500.0f), ImGuiCond_FirstUseEver);
+	ImGui::Begin("Frame times", &bShowFrameTimes);
+
+	ImGui::Text("FPS: %d, p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms", cFPSCounter->GetFrameRate(),
+		cFPSCounter->GetFrameTimePercentile(CFPSCounter::P50), cFPSCounter->GetFrameTimePercentile(CFPSCounter::P95),
+		cFPSCounter->GetFrameTimePercentile(CFPSCounter::P99), cFPSCounter->GetFrameTimePercentile(CFPSCounter::P100));
+	ImGui::Text("Update %.2f ms, render %.2f ms, GPU %.2f ms, jitter %.2f ms", cFPSCounter->GetAverageUpdateTime(),
+		cFPSCounter->GetAverageRenderTime(), cFPSCounter->GetAverageGPUTime(), cFPSCounter->GetJitter());
+	CGPUTimer* cGPUTimer = CGPUTimer::GetInstance();
+	ImGui::Text("GPU: background %.2f ms, map %.2f ms, entities %.2f ms, GUI %.2f ms",
+		cGPUTimer->GetPassTime(CGPUTimer::BACKGROUND), cGPUTimer->GetPassTime(CGPUTimer::MAP),
+		cGPUTimer->GetPassTime(CGPUTimer::ENTITIES), cGPUTimer->GetPassTime(CGPUTimer::GUI));
+	ImGui::Text("Hitches above %.1f ms: %u", cFPSCounter->GetHitchThreshold(), cFPSCounter->GetNumHitches());
+
+	// The graph goes up to twice the hitch threshold, so that the hitches stand out
+	const float fMaxTime = (float)cFPSCounter->GetHitchThreshold() * 2.0f;
+	ImGui::PlotLines("##FrameTimes", cFPSCounter->GetFrameTimeSamples(), cFPSCounter->GetNumSamples(),
+		cFPSCounter->GetSampleOffset(), "Frame time (ms)", 0.0f, fMaxTime, ImVec2(ImGui::GetContentRegionAvail().x, 100.0f));
+	ImGui::PlotHistogram("##Histogram", cFPSCounter->GetHistogram(), CFPSCounter::NUM_HISTOGRAM_BUCKETS,
+		0, "Frames per 1 ms", 0.0f, FLT_MAX, ImVec2(ImGui::GetContentRegionAvail().x, 100.0f));
+
+	// The allocations of each subsystem in the last frame, when they are counted in this build
+	if (CMemoryTracker::IsEnabled())
+	{
+		ImGui::Separator();
+		ImGui::Text("Allocations in the last frame (zero-alloc violations: %llu)",
+			(unsigned long long)CMemoryTracker::GetNumViolations());
+		for (int i = 0; i < CMemoryTracker::NUM_TAGS; i++)
+		{
+			const CMemoryTracker::TAG eTag = (CMemoryTracker::TAG)i;
+			ImGui::Text("  %-12s %6llu allocs %9llu bytes", CMemoryTracker::GetTagName(eTag),
+				(unsigned long long)CMemoryTracker::GetFrameAllocations(eTag),
+				(unsigned long long)CMemoryTracker::GetFrameBytes(eTag));
+		}
+	}
+
+	ImGui::End();
+}
+
 /**
  @brief Set up the OpenGL display environment before rendering
  */
@@ -689,9 +780,22 @@ void CGUI_Scene2D::PreRender(void)
  */
 void CGUI_Scene2D::Render(void)
 {
+	PROFILE_ZONE("CGUI_Scene2D::Render");
+	MEMORY_TAG(GUI);
+
+	// The flame view shows the last frame, so it is added after all the ticks of this frame
+	if (bShowProfiler)
+		CProfiler::GetInstance()->RenderImGui();
+	if (bShowFrameTimes)
+		RenderFrameTimes();
+	if (bShowGLTelemetry)
+		CGLTelemetry::GetInstance()->RenderImGui(&bShowGLTelemetry);
+
 	// Rendering
 	ImGui::Render();
+	CGPUTimer::GetInstance()->BeginPass(CGPUTimer::GUI);
 	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+	CGPUTimer::GetInstance()->EndPass(CGPUTimer::GUI);
 }
 
 /**
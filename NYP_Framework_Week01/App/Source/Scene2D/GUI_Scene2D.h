@@ -13,7 +13,7 @@
 #include "Primitives/Entity2D.h"
 
 // FPS Counter
-#include "TimeControl\FPSCounter.h"
+#include "TimeControl/FPSCounter.h"
 
 // Include CInventoryManager
 #include "InventoryManager.h"
@@ -32,9 +32,9 @@
 // Include IMGUI
 // Important: GLEW and GLFW must be included before IMGUI
 #ifndef IMGUI_ACTIVE
-#include "GUI\imgui.h"
-#include "GUI\backends\imgui_impl_glfw.h"
-#include "GUI\backends\imgui_impl_opengl3.h"
+#include "GUI/imgui.h"
+#include "GUI/backends/imgui_impl_glfw.h"
+#include "GUI/backends/imgui_impl_opengl3.h"
 #define IMGUI_ACTIVE
 #endif
 
@@ -102,6 +102,16 @@ protected:
 	bool show_another_window;
 	ImVec4 clear_color;
 
+	// Show the flame view of the profiler. F3 toggles it.
+	bool bShowProfiler;
+	// Show the graph of the frame times. F2 toggles it.
+	bool bShowFrameTimes;
+	// Show the OpenGL calls of the last frame and the live OpenGL objects. F4 toggles it.
+	bool bShowGLTelemetry;
+
+	// Show the graph, the histogram and the percentiles of the frame times
+	void RenderFrameTimes(void);
+
 
 	CPlayer2D* lever;
 	CMap2D* map;
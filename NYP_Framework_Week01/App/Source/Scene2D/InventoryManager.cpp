@@ -51,7 +51,7 @@ CInventoryItem* CInventoryManager::Add(	const std::string& _name,
 	if (Check(_name))
 	{
 		// Item name already exist here, unable to proceed
-		throw std::exception("Duplicate item name provided");
+		throw std::runtime_error("Duplicate item name provided");
 		return NULL;
 	}
 
@@ -75,7 +75,7 @@ bool CInventoryManager::Remove(const std::string& _name)
 	if (Check(_name))
 	{
 		// Item name already exist here, unable to proceed
-		throw std::exception("Unknown item name provided");
+		throw std::runtime_error("Unknown item name provided");
 		return NULL;
 	}
 
@@ -116,3 +116,16 @@ int CInventoryManager::GetNumItems(void) const
 {
 	return inventoryMap.size();
 }
+
+/**
+ @brief Add the count of each item to a checksum of the world. The items are sorted by name in inventoryMap.
+ @param cChecksum A CChecksum& variable containing the checksum
+ */
+void CInventoryManager::AddToChecksum(CChecksum& cChecksum) const
+{
+	for (std::map<std::string, CInventoryItem*>::const_iterator it = inventoryMap.begin(); it != inventoryMap.end(); ++it)
+	{
+		cChecksum.Add(it->first.c_str(), it->first.size());
+		cChecksum.Add(it->second->GetCount());
+	}
+}
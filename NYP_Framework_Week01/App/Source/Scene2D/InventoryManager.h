@@ -7,12 +7,15 @@
 #pragma once
 
 // Include SingletonTemplate
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
 #include <map>
 #include <string>
 #include "InventoryItem.h"
 
+// Include CChecksum
+#include "System/Checksum.h"
+
 class CInventoryManager : public CSingletonTemplate<CInventoryManager>
 {
 	friend CSingletonTemplate<CInventoryManager>;
@@ -34,6 +37,9 @@ public:
 	// Get the number of items
 	int GetNumItems(void) const;
 
+	// Add the state of the items to a checksum of the world
+	void AddToChecksum(CChecksum& cChecksum) const;
+
 protected:
 	// Constructor
 	CInventoryManager(void);
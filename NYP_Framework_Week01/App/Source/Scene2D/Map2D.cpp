@@ -6,15 +6,26 @@
  */
 #include "Map2D.h"
 
-// Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+// Include CProfiler to time the zones of the frame
+#include "TimeControl/Profiler.h"
+// Include CMemoryTracker to count the allocations of the frame
+#include "System/MemoryTracker.h"
+// Include CArenaAllocator for the temporary buffers of the frame
+#include "JobControl/ArenaAllocator.h"
+// Include CPerfCounters to count the hardware events of the zones
+#include "TimeControl/PerfCounters.h"
+
+// Include CSpriteBatch to draw the tiles
+#include "RenderControl/SpriteBatch.h"
+// Include CGPUTimer
+#include "RenderControl/GPUTimer.h"
 
 // Include Filesystem
-#include "System\filesystem.h"
-// Include ImageLoader
-#include "System\ImageLoader.h"
-#include "Primitives/MeshBuilder.h"
+#include "System/filesystem.h"
+// Include CRandom
+#include "System/Random.h"
 
+#include <fstream>
 #include <iostream>
 #include <vector>
 using namespace std;
@@ -26,8 +37,9 @@ using namespace std::placeholders;
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
 CMap2D::CMap2D(void)
-	: uiCurLevel(0)
-	, quadMesh(NULL)
+	: arrMapInfo(NULL)
+	, uiCurLevel(0)
+	, uiNumLevels(0)
 {
 }
 
@@ -38,27 +50,23 @@ CMap2D::CMap2D(void)
  */
 CMap2D::~CMap2D(void)
 {
-	// Dynamically deallocate the 3D array used to store the map information
-	for (unsigned int uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
+	// Dynamically deallocate the 3D array used to store the map information. It is not there if Init() was never called.
+	if ((arrMapInfo) && (cSettings))
 	{
-		for (unsigned int iRow = 0; iRow < cSettings->NUM_TILES_YAXIS; iRow++)
+		for (unsigned int uiLevel = 0; uiLevel < uiNumLevels; uiLevel++)
 		{
-			delete[] arrMapInfo[uiLevel][iRow];
+			for (unsigned int iRow = 0; iRow < cSettings->NUM_TILES_YAXIS; iRow++)
+			{
+				delete[] arrMapInfo[uiLevel][iRow];
+			}
+			delete [] arrMapInfo[uiLevel];
 		}
-		delete [] arrMapInfo[uiLevel];
+		delete[] arrMapInfo;
+		arrMapInfo = NULL;
 	}
-	delete[] arrMapInfo;
 
-	if (quadMesh)
-	{
-		delete quadMesh;
-		quadMesh = NULL;
-	}
-
-	// optional: de-allocate all resources once they've outlived their purpose:
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-	glDeleteBuffers(1, &EBO);
+	// Delete the atlas of the tile textures
+	cTileRegistry.Clear();
 
 	// Set this to NULL since it was created elsewhere, so we let it be deleted there.
 	cSettings = NULL;
@@ -100,262 +108,19 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 	cSettings->NUM_TILES_YAXIS = uiNumRows;
 	cSettings->UpdateSpecifications();
 
-	glGenVertexArrays(1, &VAO);
-	glBindVertexArray(VAO);
-
-	//CS: Create the Quad Mesh using the mesh builder
-	quadMesh = CMeshBuilder::GenerateQuad(glm::vec4(1, 1, 1, 1), cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
-
-	// Load and create textures
-	// Load the ground texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D_GroundTile.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Scene2D_GroundTile.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(100, iTextureID));
-	}
-	 //Load the going erupt texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/gerupt.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/gerupt.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(6, iTextureID));
-	}
-
-	//Load the actual erupt texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/erupt.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/erupt.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(9, iTextureID));
-	}
-	//iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D_Spikes.tga", true);
-	//if (iTextureID == 0)
-	//{
-	//	cout << "Unable to load Image/Scene2D_TreeTile.tga" << endl;
-	//	return false;
-	//}
-	//else
-	//{
-	//	// Store the texture ID into MapOfTextureIDs
-	//	MapOfTextureIDs.insert(pair<int, int>(9, iTextureID));//fake
-	//}
-
-
-
-	
-	//iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Protect.tga", true);
-	//if (iTextureID == 0)
-	//{
-	//	cout << "Unable to load Image/Scene2D_TreeTile.tga" << endl;
-	//	return false;
-	//}
-	//else
-	//{
-	//	// Store the texture ID into MapOfTextureIDs
-	//	MapOfTextureIDs.insert(pair<int, int>(30, iTextureID));//objective
-	//}
-
-	//iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D_Spikes.tga", true);
-
-	// Load the steel pile texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/steelpile.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/steelpile.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(101, iTextureID));
-	}
-	// Load the rusting trees texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/rustedtree.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/rustedtree.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(102, iTextureID));
-	}
-	// Load the metal cubes+ texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/metalcubePLUS.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/metalcubePLUS.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(103, iTextureID));
-	}
-	// Load the upgrading altar texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/upgradealtar.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/upgradealtar.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(104, iTextureID));
-	}
-
-	// Load the rusted wood PLUS texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/rustedwoodPLUS.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/rustedwoodPLUS.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(105, iTextureID));
-	}
-
-	// Load the solid rocks texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/solidrock.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/solidrock.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(110, iTextureID));
-	}
-
-	// Load the rusted wood texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/rustedwood.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/rustedwood.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(10, iTextureID));
-	}
-
-	// Load the metal cubes texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/metalcube.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/metalcube.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(11, iTextureID));
-	}
-
-	// Load the gunpowder texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/gunpowder.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/gunpowder.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(12, iTextureID));
-	}
-
-	// Load the metal parts texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/metalparts.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/metalparts.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(13, iTextureID));
-	}
-
-	// Load the iron horn texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/ironhorn.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/ironhorn.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(14, iTextureID));
-	}
-
-	// Load the oil can texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/oilcan.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/oilcan.tga" << endl;
+	// Load the properties of the tile values, and pack their textures into one atlas
+	if (cTileRegistry.Load("Maps/TileRegistry.csv") == false)
 		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(15, iTextureID));
-	}
-
-	// Load the ghens heart texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/ghensheart.tga", true);
-	if (iTextureID == 0)
+	if (cTileRegistry.BuildAtlas() == false)
 	{
-		cout << "Unable to load Image/ghensheart.tga" << endl;
+		cout << "Unable to build the atlas of the tile textures" << endl;
 		return false;
 	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(20, iTextureID));
-	}
-
-	// Load the portal texture
-	iTextureID = CImageLoader::GetInstance()->LoadTextureGetID("Image/Scene2D_PI.tga", true);
-	if (iTextureID == 0)
-	{
-		cout << "Unable to load Image/Scene2D_PI.tga" << endl;
-		return false;
-	}
-	else
-	{
-		// Store the texture ID into MapOfTextureIDs
-		MapOfTextureIDs.insert(pair<int, int>(30, iTextureID));
-	}
 
 	// Initialise the variables for AStar
-	m_weight = 1;
-	m_startPos = glm::vec2(0, 0);
-	m_targetPos = glm::vec2(0, 0);
+	m_context.m_weight = 1;
+	m_context.m_startPos = glm::vec2(0, 0);
+	m_context.m_targetPos = glm::vec2(0, 0);
 	//m_size = cSettings->NUM_TILES_YAXIS* cSettings->NUM_TILES_XAXIS;
 
 	m_nrOfDirections = 4;
@@ -363,8 +128,8 @@ bool CMap2D::Init(	const unsigned int uiNumLevels,
 						{ -1, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 } };
 
 	// Resize these 2 lists
-	m_cameFromList.resize(cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS);
-	m_closedList.resize(cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS, false);
+	m_context.m_cameFromList.resize(cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS);
+	m_context.m_closedList.resize(cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS, false);
 
 	return true; 
 }
@@ -381,15 +146,7 @@ void CMap2D::Update(const double dElapsedTime)
  */
 void CMap2D::PreRender(void)
 {
-	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-
-	// Activate the shader
-	CShaderManager::GetInstance()->Use(sShaderName);
+	// The blending mode and the shader are set up by CSpriteBatch when it draws the tiles
 }
 
 /**
@@ -397,28 +154,37 @@ void CMap2D::PreRender(void)
  */
 void CMap2D::Render(void)
 {
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
+	PROFILE_ZONE("CMap2D::Render");
+	MEMORY_ZERO_ALLOC("CMap2D::Render");
+	CGPUTimer::GetInstance()->BeginPass(CGPUTimer::MAP);
 
-	// Render
+	// All the tile textures are in one atlas, so the tiles are drawn by the sprite batch in one draw call
+	CSpriteBatch* cSpriteBatch = CSpriteBatch::GetInstance();
+	cSpriteBatch->Begin();
+
+	const unsigned int uiAtlasTextureID = cTileRegistry.GetAtlasTextureID();
+	const glm::vec2 vec2TileSize(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT);
+	glm::vec2 vec2UVMin, vec2UVMax;
 	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
 	{
 		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
 		{
-			transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-			transform = glm::translate(transform, glm::vec3(cSettings->ConvertIndexToUVSpace(cSettings->x, uiCol, false, 0),
-															cSettings->ConvertIndexToUVSpace(cSettings->y, uiRow, true, 0),
-															0.0f));
-			//transform = glm::rotate(transform, (float)glfwGetTime(), glm::vec3(0.0f, 0.0f, 1.0f));
-
-			// Update the shaders with the latest transform
-			glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
+			// Skip the empty tiles and the values which have no texture
+			if (cTileRegistry.GetUV(arrMapInfo[uiCurLevel][uiRow][uiCol].value, vec2UVMin, vec2UVMax) == false)
+				continue;
 
-			// Render a tile
-			RenderTile(uiRow, uiCol);
+			cSpriteBatch->Submit(uiAtlasTextureID,
+								 glm::vec2(cSettings->ConvertIndexToUVSpace(cSettings->x, uiCol, false, 0),
+										   cSettings->ConvertIndexToUVSpace(cSettings->y, uiRow, true, 0)),
+								 vec2TileSize,
+								 glm::vec4(1.0f),
+								 vec2UVMin,
+								 vec2UVMax);
 		}
 	}
+	cSpriteBatch->End();
+
+	CGPUTimer::GetInstance()->EndPass(CGPUTimer::MAP);
 }
 
 /**
@@ -426,8 +192,7 @@ void CMap2D::Render(void)
  */
 void CMap2D::PostRender(void)
 {
-	// Disable blending
-	glDisable(GL_BLEND);
+	// The blending mode is disabled by CSpriteBatch after it draws the tiles
 }
 
 // Set the specifications of the map
@@ -506,9 +271,9 @@ void CMap2D::SetMapInfo(const unsigned int uiRow, const unsigned int uiCol, cons
 
 void CMap2D::replaceSomething(int textureID,int replace)
 {
-	for (size_t i = 0; i < 32; i++)
+	for (size_t i = 0; i < cSettings->NUM_TILES_XAXIS; i++)
 	{
-		for (size_t j = 0; j < 24; j++)
+		for (size_t j = 0; j < cSettings->NUM_TILES_YAXIS; j++)
 		{
 			if (GetMapInfo(j, i) == textureID)
 			{
@@ -521,9 +286,9 @@ void CMap2D::replaceSomething(int textureID,int replace)
 int CMap2D::GetCountOfId(int textureID)
 {
 	int a = 0;
-	for (size_t i = 0; i < 32; i++)
+	for (size_t i = 0; i < cSettings->NUM_TILES_XAXIS; i++)
 	{
-		for (size_t j = 0; j < 24; j++)
+		for (size_t j = 0; j < cSettings->NUM_TILES_YAXIS; j++)
 		{
 			if (GetMapInfo(j, i) == textureID)
 			{
@@ -553,6 +318,9 @@ int CMap2D::GetMapInfo(const unsigned int uiRow, const int unsigned uiCol, const
  */ 
 bool CMap2D::LoadMap(string filename, const unsigned int uiCurLevel)
 {
+	PROFILE_COUNTERS("CMap2D::LoadMap");
+	MEMORY_TAG(MAP);
+
 	doc = rapidcsv::Document(FileSystem::getPath(filename).c_str());
 
 	// Check if the sizes of CSV data matches the declared arrMapInfo sizes
@@ -579,6 +347,26 @@ bool CMap2D::LoadMap(string filename, const unsigned int uiCurLevel)
 	return true;
 }
 
+/**
+ @brief Read the number of rows and columns of a map, so that CMap2D can be initialised to its size before it is loaded
+ @param filename A string variable containing the name of the CSV file
+ @param sMapSize A MapSize& variable which receives the size of the map
+ */
+bool CMap2D::ReadMapSize(string filename, MapSize& sMapSize) const
+{
+	const std::string path = FileSystem::getPath(filename);
+	if (!std::ifstream(path.c_str()))
+	{
+		cout << "Unable to open the map " << filename << endl;
+		return false;
+	}
+
+	rapidcsv::Document cDoc(path.c_str());
+	sMapSize.uiRowSize = (unsigned int)cDoc.GetRowCount();
+	sMapSize.uiColSize = (unsigned int)cDoc.GetColumnCount();
+	return (sMapSize.uiRowSize > 0) && (sMapSize.uiColSize > 0);
+}
+
 /**
  @brief Save the tilemap to a text file
  @param filename A string variable containing the name of the text file to save the map to
@@ -628,6 +416,36 @@ bool CMap2D::FindValue(const int iValue, unsigned int& uirRow, unsigned int& uir
 	return false;
 }
 
+/**
+@brief Set a value on random empty tiles of the current level. The empty tiles are listed first,
+	   so that a map which is nearly full cannot make this search forever.
+@param iValue A const int variable containing the value to set
+@param uiCount A const unsigned int variable containing the number of tiles to set
+@param cRandom A CRandom& variable containing the random numbers which pick the tiles
+@return The number of tiles which were set, which is less than uiCount if there are not enough empty tiles
+*/
+unsigned int CMap2D::PlaceOnEmptyTiles(const int iValue, const unsigned int uiCount, CRandom& cRandom)
+{
+	std::vector<glm::i32vec2> arrEmptyTiles;
+	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
+		{
+			if (arrMapInfo[uiCurLevel][uiRow][uiCol].value == 0)
+				arrEmptyTiles.push_back(glm::i32vec2(uiCol, uiRow));
+		}
+	}
+
+	const unsigned int uiNumPlaced = std::min(uiCount, (unsigned int)arrEmptyTiles.size());
+	for (unsigned int i = 0; i < uiNumPlaced; i++)
+	{
+		// Swap a random tile from the rest of the list into this place, so that no tile is picked twice
+		std::swap(arrEmptyTiles[i], arrEmptyTiles[i + cRandom.Range((int)(arrEmptyTiles.size() - i))]);
+		arrMapInfo[uiCurLevel][arrEmptyTiles[i].y][arrEmptyTiles[i].x].value = iValue;
+	}
+	return uiNumPlaced;
+}
+
 /**
  @brief Set current level
  */
@@ -646,25 +464,6 @@ unsigned int CMap2D::GetCurrentLevel(void) const
 	return uiCurLevel;
 }
 
-/**
- @brief Render a tile at a position based on its tile index
- @param iRow A const int variable containing the row index of the tile
- @param iCol A const int variable containing the column index of the tile
- */
-void CMap2D::RenderTile(const unsigned int uiRow, const unsigned int uiCol)
-{
-	if (arrMapInfo[uiCurLevel][uiRow][uiCol].value != 0)
-	{
-		//if (arrMapInfo[uiCurLevel][uiRow][uiCol].value < 3)
-    		glBindTexture(GL_TEXTURE_2D, MapOfTextureIDs.at(arrMapInfo[uiCurLevel][uiRow][uiCol].value));
-		
-		glBindVertexArray(VAO);
-		//CS: Render the tile
-		quadMesh->Render();
-		glBindVertexArray(0);
-	}
-}
-
 /**
  @brief Print out the details about this class instance in the console
  */
@@ -676,14 +475,17 @@ void CMap2D::RenderTile(const unsigned int uiRow, const unsigned int uiCol)
  */
 std::vector<glm::vec2> CMap2D::PathFind(const glm::vec2& startPos, const glm::vec2& targetPos, HeuristicFunction heuristicFunc, int weight)
 {
-	static float a=0;
-	a -= 1;
-	if (a<=0)
-	{
-		//cout <<"x: "<<startPos.x<<" Y : "<< startPos.y << endl;
-		a = 0;
-	}
+	return PathFind(startPos, targetPos, heuristicFunc, weight, m_context);
+}
 
+/**
+ @brief Find a path using the lists in a context. Only the context is changed.
+ */
+std::vector<glm::vec2> CMap2D::PathFind(const glm::vec2& startPos, const glm::vec2& targetPos, HeuristicFunction heuristicFunc, int weight, AStarContext& context) const
+{
+	// The zones are told apart by their names, so this one is named after its HeuristicFunction
+	PROFILE_COUNTERS("CMap2D::PathFindFunction");
+	MEMORY_TAG(PATHFINDING);
 	// Check if the startPos and targetPost are blocked
 	if (isBlocked(startPos.y, startPos.x) ||
 		(isBlocked(targetPos.y, targetPos.x)))
@@ -696,40 +498,41 @@ std::vector<glm::vec2> CMap2D::PathFind(const glm::vec2& startPos, const glm::ve
 	}
 
 	// Set up the variables and lists
-	m_startPos = startPos;
-	m_targetPos = targetPos;
-	m_weight = weight;
-	m_heuristic = std::bind(heuristicFunc, _1, _2, _3);
+	context.m_startPos = startPos;
+	context.m_targetPos = targetPos;
+	context.m_weight = weight;
+	// The heuristic is copied as it is. Binding it into another std::function would allocate on every search.
+	context.m_heuristic = heuristicFunc;
 
 	// Reset AStar lists
-	ResetAStarLists();
+	ResetAStarLists(context);
 
 	// Add the start pos to 2 lists
-	m_cameFromList[ConvertTo1D(m_startPos)].parent = m_startPos;
-	m_openList.push(Grid(m_startPos, 0));
+	context.m_cameFromList[ConvertTo1D(context.m_startPos)].parent = context.m_startPos;
+	context.m_openList.push(Grid(context.m_startPos, 0));
 
 	unsigned int fNew, gNew, hNew;
 	glm::vec2 currentPos;
 
 	// Start the path finding...
-	while (!m_openList.empty())
+	while (!context.m_openList.empty())
 	{
 		// Get the node with the least f value
-		currentPos = m_openList.top().pos;
+		currentPos = context.m_openList.top().pos;
 		//cout << endl << "*** New position to check: " << currentPos.x << ", " << currentPos.y << endl;
-		//cout << "*** targetPos: " << m_targetPos.x << ", " << m_targetPos.y << endl;
+		//cout << "*** targetPos: " << context.m_targetPos.x << ", " << context.m_targetPos.y << endl;
 
 		// If the targetPos was reached, then quit this loop
-		if (currentPos == m_targetPos)
+		if (currentPos == context.m_targetPos)
 		{
-			//cout << "=== Found the targetPos: " << m_targetPos.x << ", " << m_targetPos.y << endl;
-			while (m_openList.size() != 0)
-				m_openList.pop();
+			//cout << "=== Found the targetPos: " << context.m_targetPos.x << ", " << context.m_targetPos.y << endl;
+			while (context.m_openList.size() != 0)
+				context.m_openList.pop();
 			break;
 		}
 
-		m_openList.pop();
-		m_closedList[ConvertTo1D(currentPos)] = true;
+		context.m_openList.pop();
+		context.m_closedList[ConvertTo1D(currentPos)] = true;
 
 		// Check the neighbors of the current node
 		for (unsigned int i = 0; i < m_nrOfDirections; ++i)
@@ -740,22 +543,22 @@ std::vector<glm::vec2> CMap2D::PathFind(const glm::vec2& startPos, const glm::ve
 		//	cout << "\t#" << i << ": Check this: " << neighborPos.x << ", " << neighborPos.y << ":\t";
 			if (!isValid(neighborPos) ||//
 				isBlocked(neighborPos.y, neighborPos.x) ||
-				m_closedList[neighborIndex] == true)
+				context.m_closedList[neighborIndex] == true)
 			{
 				//cout << "This position is not valid. Going to next neighbour." << endl;
 				continue;
 			}
 
-			gNew = m_cameFromList[ConvertTo1D(currentPos)].g + 1;
-			hNew = m_heuristic(neighborPos, m_targetPos, m_weight);
+			gNew = context.m_cameFromList[ConvertTo1D(currentPos)].g + 1;
+			hNew = context.m_heuristic(neighborPos, context.m_targetPos, context.m_weight);
 			fNew = gNew + hNew;
 
-			if (m_cameFromList[neighborIndex].f == 0 || fNew < m_cameFromList[neighborIndex].f)
+			if (context.m_cameFromList[neighborIndex].f == 0 || fNew < context.m_cameFromList[neighborIndex].f)
 			{
 				//cout << "Adding to Open List: " << neighborPos.x << ", " << neighborPos.y;
 			//	cout << ". [ f : " << fNew << ", g : " << gNew << ", h : " << hNew << "]" << endl;
-				m_openList.push(Grid(neighborPos, fNew));
-				m_cameFromList[neighborIndex] = { neighborPos, currentPos, fNew, gNew, hNew };
+				context.m_openList.push(Grid(neighborPos, fNew));
+				context.m_cameFromList[neighborIndex] = { neighborPos, currentPos, fNew, gNew, hNew };
 			}
 			else
 			{
@@ -765,22 +568,72 @@ std::vector<glm::vec2> CMap2D::PathFind(const glm::vec2& startPos, const glm::ve
 		//system("pause");
 	}
 
-	return BuildPath();
+	return BuildPath(context);
+}
+
+/**
+ @brief Find a path with one of the inlined heuristics, and the connectivity set by SetDiagonalMovement()
+ @param startPos A const glm::i16vec2& variable containing the tile to start from
+ @param targetPos A const glm::i16vec2& variable containing the tile to go to
+ @param eHeuristic A const heuristic::TYPE variable containing the heuristic to use
+ @param weight A int variable containing the weight of the heuristic
+ @param context A AStarContext& variable containing the lists of this search
+ @param pPath A glm::i16vec2* variable containing the buffer for the path
+ @param iCapacity A const int variable containing the number of nodes which fit in pPath
+ @return The number of nodes written into pPath
+ */
+int CMap2D::PathFind(const glm::i16vec2& startPos, const glm::i16vec2& targetPos, const heuristic::TYPE eHeuristic, int weight, AStarContext& context,
+	glm::i16vec2* pPath, const int iCapacity) const
+{
+	const bool bDiagonal = (m_nrOfDirections == 8);
+	// Time the searches with 4 and 8 directions apart
+	PROFILE_COUNTERS(bDiagonal ? "CMap2D::PathFind8" : "CMap2D::PathFind4");
+	MEMORY_TAG(PATHFINDING);
+	switch (eHeuristic)
+	{
+	case heuristic::MANHATTAN:
+		return bDiagonal ? PathFind<heuristic::SManhattan, 8>(startPos, targetPos, weight, context, pPath, iCapacity)
+			: PathFind<heuristic::SManhattan, 4>(startPos, targetPos, weight, context, pPath, iCapacity);
+	case heuristic::OCTILE:
+		return bDiagonal ? PathFind<heuristic::SOctile, 8>(startPos, targetPos, weight, context, pPath, iCapacity)
+			: PathFind<heuristic::SOctile, 4>(startPos, targetPos, weight, context, pPath, iCapacity);
+	case heuristic::EUCLIDEAN:
+		return bDiagonal ? PathFind<heuristic::SEuclidean, 8>(startPos, targetPos, weight, context, pPath, iCapacity)
+			: PathFind<heuristic::SEuclidean, 4>(startPos, targetPos, weight, context, pPath, iCapacity);
+	default:
+		cout << "CMap2D::PathFind() - Unknown heuristic: " << eHeuristic << endl;
+		return 0;
+	}
+}
+
+/**
+ @brief Find a path with one of the inlined heuristics into a SPath
+ @param startPos A const glm::i16vec2& variable containing the tile to start from
+ @param targetPos A const glm::i16vec2& variable containing the tile to go to
+ @param eHeuristic A const heuristic::TYPE variable containing the heuristic to use
+ @param weight A int variable containing the weight of the heuristic
+ @param context A AStarContext& variable containing the lists of this search
+ @param path A SPath& variable which receives the path
+ */
+void CMap2D::PathFind(const glm::i16vec2& startPos, const glm::i16vec2& targetPos, const heuristic::TYPE eHeuristic, int weight, AStarContext& context,
+	SPath& path) const
+{
+	path.iNumNodes = PathFind(startPos, targetPos, eHeuristic, weight, context, path.arrNodes, SPath::CAPACITY);
 }
 
 /**
  @brief Build a path
  */
-std::vector<glm::vec2> CMap2D::BuildPath() const
+std::vector<glm::vec2> CMap2D::BuildPath(const AStarContext& context) const
 {
 	std::vector<glm::vec2> path;
-	auto currentPos = m_targetPos;
+	auto currentPos = context.m_targetPos;
 	auto currentIndex = ConvertTo1D(currentPos);
 
-	while (!(m_cameFromList[currentIndex].parent == currentPos))
+	while (!(context.m_cameFromList[currentIndex].parent == currentPos))
 	{
 		path.push_back(currentPos);
-		currentPos = m_cameFromList[currentIndex].parent;
+		currentPos = context.m_cameFromList[currentIndex].parent;
 		currentIndex = ConvertTo1D(currentPos);
 	}
 
@@ -790,14 +643,14 @@ std::vector<glm::vec2> CMap2D::BuildPath() const
 		// if m_startPos is next to m_targetPos, then having 1 path point is OK
 		if (m_nrOfDirections == 4)
 		{
-			if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 1)
+			if (abs(context.m_targetPos.y - context.m_startPos.y) + abs(context.m_targetPos.x - context.m_startPos.x) > 1)
 				path.clear();
 		}
 		else
 		{
-			if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 2)
+			if (abs(context.m_targetPos.y - context.m_startPos.y) + abs(context.m_targetPos.x - context.m_startPos.x) > 2)
 				path.clear();
-			else if (abs(m_targetPos.y - m_startPos.y) + abs(m_targetPos.x - m_startPos.x) > 1)
+			else if (abs(context.m_targetPos.y - context.m_startPos.y) + abs(context.m_targetPos.x - context.m_startPos.x) > 1)
 				path.clear();
 		}
 	}
@@ -840,9 +693,9 @@ void CMap2D::PrintSelf(void) const
 		}
 	}
 
-	cout << "m_openList: " << m_openList.size() << endl;
-	cout << "m_cameFromList: " << m_cameFromList.size() << endl;
-	cout << "m_closedList: " << m_closedList.size() << endl;
+	cout << "m_openList: " << m_context.m_openList.size() << endl;
+	cout << "m_cameFromList: " << m_context.m_cameFromList.size() << endl;
+	cout << "m_closedList: " << m_context.m_closedList.size() << endl;
 
 	cout << "===== AStar::PrintSelf() =====" << endl;
 }
@@ -865,22 +718,11 @@ bool CMap2D::isBlocked(const unsigned int uiRow, const unsigned int uiCol, const
 {
 
 
+	// The flag table of the tile registry says which tile values are solid
 	if (bInvert == true)
-	{
-		if ((arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value >= 100) &&
-			(arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value < 200))
-			return true;
-		else
-			return false;
-	}
+		return cTileRegistry.IsSolid(arrMapInfo[uiCurLevel][cSettings->NUM_TILES_YAXIS - uiRow - 1][uiCol].value);
 	else
-	{
-		if ((arrMapInfo[uiCurLevel][uiRow][uiCol].value >= 100) &&
-			(arrMapInfo[uiCurLevel][uiRow][uiCol].value < 200))
-			return true;
-		else
-			return false;
-	}
+		return cTileRegistry.IsSolid(arrMapInfo[uiCurLevel][uiRow][uiCol].value);
 }
 
 /**
@@ -898,38 +740,44 @@ int CMap2D::ConvertTo1D(const glm::vec2& pos) const
 bool CMap2D::DeleteAStarLists(void)
 {
 	// Delete m_openList
-	while (m_openList.size() != 0)
-		m_openList.pop();
+	while (m_context.m_openList.size() != 0)
+		m_context.m_openList.pop();
 	// Delete m_cameFromList
-	m_cameFromList.clear();
+	m_context.m_cameFromList.clear();
 	// Delete m_closedList
-	m_closedList.clear();
+	m_context.m_closedList.clear();
 
 	return true;
 }
 
 
 /**
- @brief Reset AStar lists
+ @brief Reset AStar lists. The lists of a new context are sized to the map here.
  */
-bool CMap2D::ResetAStarLists(void)
+bool CMap2D::ResetAStarLists(AStarContext& context) const
 {
+	const unsigned int uiNumGrids = cSettings->NUM_TILES_YAXIS * cSettings->NUM_TILES_XAXIS;
+	if (context.m_cameFromList.size() != uiNumGrids)
+		context.m_cameFromList.resize(uiNumGrids);
+	if (context.m_closedList.size() != uiNumGrids)
+		context.m_closedList.resize(uiNumGrids, false);
+
 	// Delete m_openList
-	while (m_openList.size() != 0)
-		m_openList.pop();
+	while (context.m_openList.size() != 0)
+		context.m_openList.pop();
 	// Reset m_cameFromList
-	for (int i = 0; i < m_cameFromList.size(); i++)
+	for (size_t i = 0; i < context.m_cameFromList.size(); i++)
 	{
-		m_cameFromList[i].pos = glm::vec2(0, 0);
-		m_cameFromList[i].parent = glm::vec2(0, 0);
-		m_cameFromList[i].f = 0;
-		m_cameFromList[i].g = 0;
-		m_cameFromList[i].h = 0;
+		context.m_cameFromList[i].pos = glm::vec2(0, 0);
+		context.m_cameFromList[i].parent = glm::vec2(0, 0);
+		context.m_cameFromList[i].f = 0;
+		context.m_cameFromList[i].g = 0;
+		context.m_cameFromList[i].h = 0;
 	}
 	// Reset m_closedList
-	for (int i = 0; i < m_closedList.size(); i++)
+	for (size_t i = 0; i < context.m_closedList.size(); i++)
 	{
-		m_closedList[i] = false;
+		context.m_closedList[i] = false;
 	}
 
 	return true;
@@ -942,7 +790,7 @@ bool CMap2D::ResetAStarLists(void)
 unsigned int heuristic::manhattan(const glm::vec2& v1, const glm::vec2& v2, int weight)
 {
 	glm::vec2 delta = v2 - v1;
-	return static_cast<unsigned int>(weight * (delta.x + delta.y));
+	return static_cast<unsigned int>(weight * (abs(delta.x) + abs(delta.y)));
 }
 
 /**
@@ -952,4 +800,32 @@ unsigned int heuristic::euclidean(const glm::vec2& v1, const glm::vec2& v2, int
 {
 	glm::vec2 delta = v2 - v1;
 	return static_cast<unsigned int>(weight * sqrt((delta.x * delta.x) + (delta.y * delta.y)));
-}
\ No newline at end of file
+}
+
+/**
+ @brief Add the tiles of the current level to a checksum of the world
+ @param cChecksum A CChecksum& variable containing the checksum
+ */
+void CMap2D::AddToChecksum(CChecksum& cChecksum) const
+{
+	cChecksum.Add(uiCurLevel);
+
+	// Gather each row of values, as they are spread out in the Grids, and add them together
+	ScratchVector<unsigned int> arrRowValues(cSettings->NUM_TILES_XAXIS);
+	for (unsigned int uiRow = 0; uiRow < cSettings->NUM_TILES_YAXIS; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < cSettings->NUM_TILES_XAXIS; uiCol++)
+		{
+			arrRowValues[uiCol] = arrMapInfo[uiCurLevel][uiRow][uiCol].value;
+		}
+		cChecksum.Add(&arrRowValues[0], arrRowValues.size() * sizeof(unsigned int));
+	}
+}
+
+/**
+ @brief Get the properties of the tile values, which are read in Init()
+ */
+const CTileRegistry& CMap2D::GetTileRegistry(void) const
+{
+	return cTileRegistry;
+}
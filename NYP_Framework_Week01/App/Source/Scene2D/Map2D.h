@@ -7,9 +7,12 @@
 #pragma once
  
 // Include SingletonTemplate
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 #include <queue>
 #include <functional>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
 // Include GLEW
 #ifndef GLEW_STATIC
 #include <GL/glew.h>
@@ -20,6 +23,7 @@
 #include <includes/glm.hpp>
 #include <includes/gtc/matrix_transform.hpp>
 #include <includes/gtc/type_ptr.hpp>
+#include <includes/gtc/type_precision.hpp>
 
 // Include the RapidCSV
 #include "System/rapidcsv.h"
@@ -27,10 +31,18 @@
 #include <map>
 
 // Include Settings
-#include "GameControl\Settings.h"
+#include "GameControl/Settings.h"
 
 // Include Entity2D
 #include "Primitives/Entity2D.h"
+
+// Include CChecksum
+#include "System/Checksum.h"
+
+// Include CTileRegistry
+#include "TileRegistry.h"
+
+class CRandom;
 // A structure storing information about Map Sizes
 struct MapSize {
 	unsigned int uiRowSize;
@@ -61,8 +73,94 @@ namespace heuristic
 {
 	unsigned int manhattan(const glm::vec2& v1, const glm::vec2& v2, int weight);
 	unsigned int euclidean(const glm::vec2& v1, const glm::vec2& v2, int weight);
+
+	// The heuristics which the templated CMap2D::PathFind() can inline
+	enum TYPE
+	{
+		MANHATTAN = 0,
+		OCTILE,
+		EUCLIDEAN,
+		NUM_TYPES
+	};
+
+	// The heuristics for the templated CMap2D::PathFind(), from the delta to the target
+	struct SManhattan
+	{
+		static unsigned int Calculate(const int iDeltaX, const int iDeltaY, const int iWeight)
+		{
+			return static_cast<unsigned int>(iWeight * (std::abs(iDeltaX) + std::abs(iDeltaY)));
+		}
+	};
+	struct SOctile
+	{
+		static unsigned int Calculate(const int iDeltaX, const int iDeltaY, const int iWeight)
+		{
+			const int iMax = std::max(std::abs(iDeltaX), std::abs(iDeltaY));
+			const int iMin = std::min(std::abs(iDeltaX), std::abs(iDeltaY));
+			return static_cast<unsigned int>(iWeight * (iMax + 0.41421356f * iMin));
+		}
+	};
+	struct SEuclidean
+	{
+		// The same float calculation as euclidean(), so that both give the same paths
+		static unsigned int Calculate(const int iDeltaX, const int iDeltaY, const int iWeight)
+		{
+			const float fDeltaX = static_cast<float>(iDeltaX);
+			const float fDeltaY = static_cast<float>(iDeltaY);
+			return static_cast<unsigned int>(iWeight * std::sqrt((fDeltaX * fDeltaX) + (fDeltaY * fDeltaY)));
+		}
+	};
 }
 
+// A node of the templated CMap2D::PathFind(), which keeps only what the search needs
+struct SAStarNode {
+	glm::i16vec2 parent;
+	unsigned int f;
+	unsigned int g;
+	bool bClosed;
+};
+
+// An entry of the open list of the templated CMap2D::PathFind()
+struct SAStarOpenNode {
+	glm::i16vec2 pos;
+	unsigned int f;
+};
+// Reverse the heap to get the smallest element on top, the same as the std::priority_queue of Grids
+inline bool operator< (const SAStarOpenNode& a, const SAStarOpenNode& b) { return b.f < a.f; }
+
+// A path which fits in a fixed buffer, from the tile after the start to the target
+struct SPath {
+	enum { CAPACITY = 256 };
+
+	glm::i16vec2 arrNodes[CAPACITY];
+	int iNumNodes;
+
+	SPath() : iNumNodes(0) {}
+
+	const glm::i16vec2* begin(void) const { return arrNodes; }
+	const glm::i16vec2* end(void) const { return arrNodes + iNumNodes; }
+	bool empty(void) const { return iNumNodes == 0; }
+};
+
+// A structure storing the lists of one AStar PathFinding search.
+// Searches which run at the same time, e.g. on different threads, must each use their own.
+struct AStarContext {
+	int m_weight;
+	glm::vec2 m_startPos;
+	glm::vec2 m_targetPos;
+
+	std::priority_queue<Grid> m_openList;
+	std::vector<bool> m_closedList;
+	std::vector<Grid> m_cameFromList;
+	HeuristicFunction m_heuristic;
+
+	// The lists of the templated CMap2D::PathFind()
+	std::vector<SAStarOpenNode> m_openHeap;
+	std::vector<SAStarNode> m_nodeList;
+
+	AStarContext() : m_weight(1), m_startPos(0, 0), m_targetPos(0, 0) {}
+};
+
 
 class CMap2D : public CSingletonTemplate<CMap2D>, public CEntity2D
 {
@@ -70,6 +168,18 @@ class CMap2D : public CSingletonTemplate<CMap2D>, public CEntity2D
 public:
 	// For AStar PathFinding
 	std::vector<glm::vec2> PathFind(const glm::vec2& startPos, const glm::vec2& targetPos, HeuristicFunction heuristicFunc, int weight = 1);
+	// For AStar PathFinding with the caller's own lists. This does not change the CMap2D, so it can run on many threads at once.
+	std::vector<glm::vec2> PathFind(const glm::vec2& startPos, const glm::vec2& targetPos, HeuristicFunction heuristicFunc, int weight, AStarContext& context) const;
+	// For AStar PathFinding with an inlined heuristic and connectivity, into the caller's buffer. Returns the number of nodes written.
+	template<class THeuristic, int iConnectivity>
+	int PathFind(const glm::i16vec2& startPos, const glm::i16vec2& targetPos, int weight, AStarContext& context,
+		glm::i16vec2* pPath, const int iCapacity) const;
+	// For AStar PathFinding with one of the inlined heuristics, and the connectivity set by SetDiagonalMovement()
+	int PathFind(const glm::i16vec2& startPos, const glm::i16vec2& targetPos, const heuristic::TYPE eHeuristic, int weight, AStarContext& context,
+		glm::i16vec2* pPath, const int iCapacity) const;
+	// For AStar PathFinding into a SPath
+	void PathFind(const glm::i16vec2& startPos, const glm::i16vec2& targetPos, const heuristic::TYPE eHeuristic, int weight, AStarContext& context,
+		SPath& path) const;
 	// Set if AStar PathFinding will consider diagonal movements
 	void SetDiagonalMovement(const bool bEnable);
 	// Print out details about this class instance in the console window
@@ -109,17 +219,29 @@ public:
 	// Load a map
 	bool LoadMap(string filename, const unsigned int uiLevel = 0);
 
+	// Read the size of a map without loading it
+	bool ReadMapSize(string filename, MapSize& sMapSize) const;
+
 	// Save a tilemap
 	bool SaveMap(string filename, const unsigned int uiLevel = 0);
 
 	// Find the indices of a certain value in arrMapInfo
 	bool FindValue(const int iValue, unsigned int& uirRow, unsigned int& uirCol, const bool bInvert = true);
 
+	// Set a value on random empty tiles of the current level, and return the number of tiles which were set
+	unsigned int PlaceOnEmptyTiles(const int iValue, const unsigned int uiCount, CRandom& cRandom);
+
 	// Set current level
 	void SetCurrentLevel(unsigned int uiCurLevel);
 	// Get current level
 	unsigned int GetCurrentLevel(void) const;
 
+	// Add the state of the current level to a checksum of the world
+	void AddToChecksum(CChecksum& cChecksum) const;
+
+	// Get the properties of the tile values
+	const CTileRegistry& GetTileRegistry(void) const;
+
 
 protected:
 	// The variable containing the rapidcsv::Document
@@ -137,11 +259,8 @@ protected:
 	// A 1-D array which stores the map sizes for each level
 	MapSize* arrMapSizes;
 
-	// Map containing texture IDs
-	map<int, int> MapOfTextureIDs;
-
-	//CS: The quadMesh for drawing the tiles
-	CMesh* quadMesh;
+	// The properties of the tile values, and the atlas of their textures
+	CTileRegistry cTileRegistry;
 
 	// Constructor
 	CMap2D(void);
@@ -149,11 +268,9 @@ protected:
 	// Destructor
 	virtual ~CMap2D(void);
 
-	// Render a tile
-	void RenderTile(const unsigned int uiRow, const unsigned int uiCol);
 	// For A-Star PathFinding
 		// Build a path from m_cameFromList after calling PathFind()
-	std::vector<glm::vec2> BuildPath() const;
+	std::vector<glm::vec2> BuildPath(const AStarContext& context) const;
 	// Check if a grid is valid
 	bool isValid(const glm::vec2& pos) const;
 	// Check if a grid is blocked
@@ -166,20 +283,143 @@ protected:
 	// Delete AStar lists
 	bool DeleteAStarLists(void);
 	// Reset AStar lists
-	bool ResetAStarLists(void);
+	bool ResetAStarLists(AStarContext& context) const;
 
-	int m_weight;
 	//int m_size;
 	unsigned int m_nrOfDirections;
 	//glm::vec2 m_dimensions;
-	glm::vec2 m_startPos;
-	glm::vec2 m_targetPos;
 
-	std::priority_queue<Grid> m_openList;
-	std::vector<bool> m_closedList;
-	std::vector<Grid> m_cameFromList;
+	// The AStar lists used by PathFind() without a context
+	AStarContext m_context;
 	//std::vector<int> m_grid;
 	std::vector<glm::vec2> m_directions;
-	HeuristicFunction m_heuristic;
 };
 
+
+/**
+ @brief Find a path with the heuristic and connectivity inlined, using the compact lists in a context.
+		It searches the tiles in the same order as the PathFind() with a HeuristicFunction, so both give
+		the same path. The nodes nearest to the start are written, up to iCapacity of them.
+ @param startPos A const glm::i16vec2& variable containing the tile to start from
+ @param targetPos A const glm::i16vec2& variable containing the tile to go to
+ @param weight A int variable containing the weight of the heuristic
+ @param context A AStarContext& variable containing the lists of this search
+ @param pPath A glm::i16vec2* variable containing the buffer for the path
+ @param iCapacity A const int variable containing the number of nodes which fit in pPath
+ @return The number of nodes written into pPath
+ */
+template<class THeuristic, int iConnectivity>
+int CMap2D::PathFind(const glm::i16vec2& startPos, const glm::i16vec2& targetPos, int weight, AStarContext& context,
+	glm::i16vec2* pPath, const int iCapacity) const
+{
+	static_assert((iConnectivity == 4) || (iConnectivity == 8), "The connectivity must be 4 or 8");
+	// The same directions, in the same order, as m_directions
+	static const int arrDirectionX[8] = { -1, 1, 0, 0, -1, 1, -1, 1 };
+	static const int arrDirectionY[8] = { 0, 0, 1, -1, -1, 1, 1, -1 };
+
+	// Check if the startPos and targetPost are blocked
+	if (isBlocked(startPos.y, startPos.x) ||
+		(isBlocked(targetPos.y, targetPos.x)))
+	{
+		std::cout << "Invalid start or target position." << std::endl;
+		return 0;
+	}
+
+	const int iNumCols = (int)cSettings->NUM_TILES_XAXIS;
+	const int iNumRows = (int)cSettings->NUM_TILES_YAXIS;
+	const int iNumGrids = iNumCols * iNumRows;
+
+	// Reset the lists. Unvisited nodes point to (0, 0), the same as ResetAStarLists().
+	context.m_openHeap.clear();
+	SAStarNode sEmptyNode;
+	sEmptyNode.parent = glm::i16vec2(0, 0);
+	sEmptyNode.f = 0;
+	sEmptyNode.g = 0;
+	sEmptyNode.bClosed = false;
+	context.m_nodeList.assign(iNumGrids, sEmptyNode);
+
+	// Add the start pos to 2 lists
+	context.m_nodeList[startPos.y * iNumCols + startPos.x].parent = startPos;
+	SAStarOpenNode sOpenNode;
+	sOpenNode.pos = startPos;
+	sOpenNode.f = 0;
+	context.m_openHeap.push_back(sOpenNode);
+
+	// Start the path finding...
+	while (!context.m_openHeap.empty())
+	{
+		// Get the node with the least f value
+		const glm::i16vec2 currentPos = context.m_openHeap.front().pos;
+
+		// If the targetPos was reached, then quit this loop
+		if (currentPos == targetPos)
+			break;
+
+		std::pop_heap(context.m_openHeap.begin(), context.m_openHeap.end());
+		context.m_openHeap.pop_back();
+		const int iCurrentIndex = currentPos.y * iNumCols + currentPos.x;
+		context.m_nodeList[iCurrentIndex].bClosed = true;
+
+		// Check the neighbors of the current node
+		for (int i = 0; i < iConnectivity; ++i)
+		{
+			const int iNeighborX = currentPos.x + arrDirectionX[i];
+			const int iNeighborY = currentPos.y + arrDirectionY[i];
+			if ((iNeighborX < 0) || (iNeighborX >= iNumCols) ||
+				(iNeighborY < 0) || (iNeighborY >= iNumRows) ||
+				isBlocked(iNeighborY, iNeighborX))
+				continue;
+
+			SAStarNode& sNeighbor = context.m_nodeList[iNeighborY * iNumCols + iNeighborX];
+			if (sNeighbor.bClosed)
+				continue;
+
+			const unsigned int gNew = context.m_nodeList[iCurrentIndex].g + 1;
+			const unsigned int hNew = THeuristic::Calculate(targetPos.x - iNeighborX, targetPos.y - iNeighborY, weight);
+			const unsigned int fNew = gNew + hNew;
+
+			if (sNeighbor.f == 0 || fNew < sNeighbor.f)
+			{
+				sOpenNode.pos = glm::i16vec2(iNeighborX, iNeighborY);
+				sOpenNode.f = fNew;
+				context.m_openHeap.push_back(sOpenNode);
+				std::push_heap(context.m_openHeap.begin(), context.m_openHeap.end());
+				sNeighbor.parent = currentPos;
+				sNeighbor.f = fNew;
+				sNeighbor.g = gNew;
+			}
+		}
+	}
+
+	// Count the nodes from the target back to the start, which is its own parent.
+	// A target which was not reached has a broken chain, so the count stops at the number of grids.
+	int iNumNodes = 0;
+	glm::i16vec2 currentPos = targetPos;
+	while ((context.m_nodeList[currentPos.y * iNumCols + currentPos.x].parent != currentPos) &&
+		(iNumNodes <= iNumGrids))
+	{
+		currentPos = context.m_nodeList[currentPos.y * iNumCols + currentPos.x].parent;
+		iNumNodes++;
+	}
+	if (iNumNodes > iNumGrids)
+		return 0;
+
+	// If the path has only 1 entry, then it is the the target position,
+	// which is only OK if m_startPos is next to m_targetPos
+	if ((iNumNodes == 1) &&
+		(std::abs(targetPos.y - startPos.y) + std::abs(targetPos.x - startPos.x) > 1))
+		return 0;
+
+	// Skip the nodes nearest to the target which do not fit, and write the rest from the back
+	const int iNumWritten = std::min(iNumNodes, iCapacity);
+	currentPos = targetPos;
+	for (int i = iNumNodes; i > iNumWritten; i--)
+		currentPos = context.m_nodeList[currentPos.y * iNumCols + currentPos.x].parent;
+	for (int i = iNumWritten - 1; i >= 0; i--)
+	{
+		pPath[i] = currentPos;
+		currentPos = context.m_nodeList[currentPos.y * iNumCols + currentPos.x].parent;
+	}
+
+	return iNumWritten;
+}
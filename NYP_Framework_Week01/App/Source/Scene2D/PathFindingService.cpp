@@ -0,0 +1,345 @@
+/**
+ CPathFindingService
+ @brief A class which finds AStar paths for the entities away from their Update().
+		An entity requests a path and gets a future, and the requests are run on the
+		CJobSystem threads in Update(), within a budget of milliseconds per frame.
+		The entity checks the future on a later frame, and keeps to its previous path until then.
+		The requests are run in the order of the frame and the entity which made them, so that
+		the order does not depend on the threads. When CSettings::bDeterministic is set, the
+		budget is a number of requests per frame instead, so that the paths arrive on the same
+		frame in every run.
+ By: agent
+ Date: Oct 2026
+ */
+#include "PathFindingService.h"
+
+// Include CProfiler to time the zones of the frame
+#include "TimeControl/Profiler.h"
+// Include CMemoryTracker to count the allocations of the frame
+#include "System/MemoryTracker.h"
+
+// Include CJobSystem
+#include "JobControl/JobSystem.h"
+// Include CSettings
+#include "GameControl/Settings.h"
+// Include CArenaAllocator for the batches, which only live in one tick
+#include "JobControl/ArenaAllocator.h"
+
+#include <algorithm>
+#include <iostream>
+using namespace std;
+
+// The time in milliseconds since a start time
+static float MillisecondsSince(const std::chrono::high_resolution_clock::time_point& tStart)
+{
+	return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+}
+
+/**
+ @brief Constructor
+ */
+CPathFindingService::CPathFindingService(void)
+	: fBudget(2.0f)
+	, iRequestBudget(64)
+	, uiFrame(0)
+	, iNumCompleted(0)
+	, fTimeSpent(0.0f)
+	, fAverageLatency(0.0f)
+	, fMaxLatency(0.0f)
+	, iMaxLatencyFrames(0)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CPathFindingService::~CPathFindingService(void)
+{
+	Exit();
+}
+
+/**
+ @brief Initialise this class instance
+ @param fBudget A const float variable containing the number of milliseconds per frame which Update() may spend
+ @param iRequestBudget A const int variable containing the number of requests per frame which Update() completes
+		when CSettings::bDeterministic is set
+ */
+bool CPathFindingService::Init(const float fBudget, const int iRequestBudget)
+{
+	Exit();
+
+	this->fBudget = fBudget;
+	this->iRequestBudget = iRequestBudget;
+	uiFrame = 0;
+	iNumCompleted = 0;
+	fTimeSpent = 0.0f;
+	fAverageLatency = 0.0f;
+	fMaxLatency = 0.0f;
+	iMaxLatencyFrames = 0;
+
+	return true;
+}
+
+/**
+ @brief Complete the requests which are still queued with empty paths, so that no entity waits forever
+ */
+void CPathFindingService::Exit(void)
+{
+	std::lock_guard<std::mutex> lock(requestMutex);
+	for (unsigned int i = 0; i < requests.size(); i++)
+	{
+		requests[i].promise.set_value(Path());
+	}
+	requests.clear();
+}
+
+/**
+ @brief Request a path with one of the inlined heuristics. It is safe to call this from any thread.
+ @param uiEntityID A const unsigned int variable containing the number of the entity which requests the path
+ @param startPos A const glm::vec2& variable containing the tile to start from
+ @param targetPos A const glm::vec2& variable containing the tile to go to
+ @param eHeuristic A const heuristic::TYPE variable containing the heuristic for CMap2D::PathFind()
+ @param iWeight A const int variable containing the weight of the heuristic
+ @return A future which holds the path once Update() has found it
+ */
+std::future<CPathFindingService::Path> CPathFindingService::Request(const unsigned int uiEntityID, const glm::vec2& startPos, const glm::vec2& targetPos, const heuristic::TYPE eHeuristic, const int iWeight)
+{
+	SRequest sRequest;
+	sRequest.uiEntityID = uiEntityID;
+	sRequest.startPos = startPos;
+	sRequest.targetPos = targetPos;
+	sRequest.eHeuristic = eHeuristic;
+	sRequest.iWeight = iWeight;
+	sRequest.tRequested = std::chrono::high_resolution_clock::now();
+	std::future<Path> future = sRequest.promise.get_future();
+
+	std::lock_guard<std::mutex> lock(requestMutex);
+	sRequest.uiFrameRequested = uiFrame;
+	requests.push_back(std::move(sRequest));
+
+	return future;
+}
+
+/**
+ @brief Request a path with a HeuristicFunction. It is safe to call this from any thread.
+ @param uiEntityID A const unsigned int variable containing the number of the entity which requests the path
+ @param startPos A const glm::vec2& variable containing the tile to start from
+ @param targetPos A const glm::vec2& variable containing the tile to go to
+ @param heuristicFunc A HeuristicFunction variable containing the heuristic for CMap2D::PathFind()
+ @param iWeight A const int variable containing the weight of the heuristic
+ @return A future which holds the path once Update() has found it
+ */
+std::future<CPathFindingService::Path> CPathFindingService::Request(const unsigned int uiEntityID, const glm::vec2& startPos, const glm::vec2& targetPos, HeuristicFunction heuristicFunc, const int iWeight)
+{
+	SRequest sRequest;
+	sRequest.uiEntityID = uiEntityID;
+	sRequest.startPos = startPos;
+	sRequest.targetPos = targetPos;
+	sRequest.eHeuristic = heuristic::NUM_TYPES;
+	sRequest.heuristicFunc = heuristicFunc;
+	sRequest.iWeight = iWeight;
+	sRequest.tRequested = std::chrono::high_resolution_clock::now();
+	std::future<Path> future = sRequest.promise.get_future();
+
+	std::lock_guard<std::mutex> lock(requestMutex);
+	sRequest.uiFrameRequested = uiFrame;
+	requests.push_back(std::move(sRequest));
+
+	return future;
+}
+
+/**
+ @brief Find the paths of the queued requests, oldest first, in batches of one request per thread,
+		until the budget of this frame is used up. At least one batch is run every frame, so that
+		the requests keep moving even with a budget of 0.
+		The requests of the same frame are run in the order of the entities, as the enemies request
+		their paths from the worker threads in any order. When CSettings::bDeterministic is set, the
+		budget is iRequestBudget requests instead of fBudget milliseconds, as the time taken would
+		change which frame each path arrives on.
+ */
+void CPathFindingService::Update(void)
+{
+	PROFILE_ZONE("CPathFindingService::Update");
+	MEMORY_TAG(PATHFINDING);
+	const std::chrono::high_resolution_clock::time_point tStart = std::chrono::high_resolution_clock::now();
+	CJobSystem* cJobSystem = CJobSystem::GetInstance();
+	const CMap2D* cMap2D = CMap2D::GetInstance();
+
+	unsigned int uiThisFrame = 0;
+	{
+		std::lock_guard<std::mutex> lock(requestMutex);
+		uiThisFrame = uiFrame++;
+		std::stable_sort(requests.begin(), requests.end(), [](const SRequest& a, const SRequest& b)
+		{
+			if (a.uiFrameRequested != b.uiFrameRequested)
+				return a.uiFrameRequested < b.uiFrameRequested;
+			return a.uiEntityID < b.uiEntityID;
+		});
+	}
+	const bool bDeterministic = CSettings::GetInstance()->bDeterministic;
+	int iNumRequestsLeft = std::max(iRequestBudget, 1);
+
+	iNumCompleted = 0;
+	fMaxLatency = 0.0f;
+	iMaxLatencyFrames = 0;
+	float fTotalLatency = 0.0f;
+
+	// The batch only lives in this tick, so it is kept in the scratch arena instead of the heap
+	ScratchVector<SRequest> batch;
+	batch.reserve(cJobSystem->GetNumThreads());
+	do
+	{
+		batch.clear();
+		{
+			std::lock_guard<std::mutex> lock(requestMutex);
+			while ((batch.size() < (size_t)cJobSystem->GetNumThreads()) && (!requests.empty()) &&
+				((bDeterministic == false) || (iNumRequestsLeft > 0)))
+			{
+				batch.push_back(std::move(requests.front()));
+				requests.pop_front();
+				iNumRequestsLeft--;
+			}
+		}
+		if (batch.empty())
+			break;
+
+		cJobSystem->ParallelFor(0, (int)batch.size(), 1, [&batch, cMap2D](const int iBegin, const int iEnd)
+		{
+			// Each thread searches with its own lists
+			static thread_local AStarContext context;
+			for (int i = iBegin; i < iEnd; i++)
+			{
+				SRequest& sRequest = batch[i];
+				Path path;
+				if (sRequest.heuristicFunc)
+				{
+					const std::vector<glm::vec2> vecPath = cMap2D->PathFind(sRequest.startPos,
+						sRequest.targetPos,
+						sRequest.heuristicFunc,
+						sRequest.iWeight,
+						context);
+					path.iNumNodes = std::min((int)vecPath.size(), (int)Path::CAPACITY);
+					for (int j = 0; j < path.iNumNodes; j++)
+						path.arrNodes[j] = glm::i16vec2(vecPath[j]);
+				}
+				else
+				{
+					cMap2D->PathFind(glm::i16vec2(sRequest.startPos),
+						glm::i16vec2(sRequest.targetPos),
+						sRequest.eHeuristic,
+						sRequest.iWeight,
+						context,
+						path);
+				}
+				sRequest.promise.set_value(path);
+			}
+		});
+
+		for (unsigned int i = 0; i < batch.size(); i++)
+		{
+			const float fLatency = MillisecondsSince(batch[i].tRequested);
+			fTotalLatency += fLatency;
+			fMaxLatency = std::max(fMaxLatency, fLatency);
+			iMaxLatencyFrames = std::max(iMaxLatencyFrames, (int)(uiThisFrame - batch[i].uiFrameRequested));
+		}
+		iNumCompleted += (int)batch.size();
+	} while (bDeterministic ? (iNumRequestsLeft > 0) : (MillisecondsSince(tStart) < fBudget));
+
+	fAverageLatency = (iNumCompleted > 0) ? fTotalLatency / iNumCompleted : 0.0f;
+	fTimeSpent = MillisecondsSince(tStart);
+}
+
+/**
+ @brief Set the number of milliseconds per frame which Update() may spend
+ @param fBudget A const float variable containing the budget in milliseconds
+ */
+void CPathFindingService::SetBudget(const float fBudget)
+{
+	this->fBudget = fBudget;
+}
+
+/**
+ @brief Get the number of milliseconds per frame which Update() may spend
+ */
+float CPathFindingService::GetBudget(void) const
+{
+	return fBudget;
+}
+
+/**
+ @brief Set the number of requests per frame which Update() completes when CSettings::bDeterministic is set
+ @param iRequestBudget A const int variable containing the number of requests. At least one is completed.
+ */
+void CPathFindingService::SetRequestBudget(const int iRequestBudget)
+{
+	this->iRequestBudget = iRequestBudget;
+}
+
+/**
+ @brief Get the number of requests per frame which Update() completes when CSettings::bDeterministic is set
+ */
+int CPathFindingService::GetRequestBudget(void) const
+{
+	return iRequestBudget;
+}
+
+/**
+ @brief Get the number of requests which are waiting
+ */
+int CPathFindingService::GetQueueDepth(void) const
+{
+	std::lock_guard<std::mutex> lock(requestMutex);
+	return (int)requests.size();
+}
+
+/**
+ @brief Get the number of requests completed in the last Update()
+ */
+int CPathFindingService::GetNumCompleted(void) const
+{
+	return iNumCompleted;
+}
+
+/**
+ @brief Get the number of milliseconds spent in the last Update()
+ */
+float CPathFindingService::GetTimeSpent(void) const
+{
+	return fTimeSpent;
+}
+
+/**
+ @brief Get the average time in milliseconds from request to result, of the requests completed in the last Update()
+ */
+float CPathFindingService::GetAverageLatency(void) const
+{
+	return fAverageLatency;
+}
+
+/**
+ @brief Get the longest time in milliseconds from request to result, of the requests completed in the last Update()
+ */
+float CPathFindingService::GetMaxLatency(void) const
+{
+	return fMaxLatency;
+}
+
+/**
+ @brief Get the longest number of frames from request to result, of the requests completed in the last Update()
+ */
+int CPathFindingService::GetMaxLatencyFrames(void) const
+{
+	return iMaxLatencyFrames;
+}
+
+/**
+ @brief PrintSelf
+ */
+void CPathFindingService::PrintSelf(void) const
+{
+	cout << "CPathFindingService::PrintSelf()" << endl;
+	cout << "Queue depth: " << GetQueueDepth()
+		<< ", completed: " << iNumCompleted
+		<< ", time spent: " << fTimeSpent << " / " << fBudget << " ms"
+		<< ", latency: " << fAverageLatency << " ms average, " << fMaxLatency << " ms / " << iMaxLatencyFrames << " frames max" << endl;
+}
@@ -0,0 +1,116 @@
+/**
+ CPathFindingService
+ @brief A class which finds AStar paths for the entities away from their Update().
+		An entity requests a path and gets a future, and the requests are run on the
+		CJobSystem threads in Update(), within a budget of milliseconds per frame.
+		The entity checks the future on a later frame, and keeps to its previous path until then.
+		The requests are run in the order of the frame and the entity which made them, so that
+		the order does not depend on the threads. When CSettings::bDeterministic is set, the
+		budget is a number of requests per frame instead, so that the paths arrive on the same
+		frame in every run.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "DesignPatterns/SingletonTemplate.h"
+
+// Include CMap2D
+#include "Map2D.h"
+
+#include <chrono>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <vector>
+
+class CPathFindingService : public CSingletonTemplate<CPathFindingService>
+{
+	friend CSingletonTemplate<CPathFindingService>;
+public:
+	// A path from the tile after the start to the target, in a fixed buffer
+	typedef SPath Path;
+
+	// Initialise this class instance
+	bool Init(const float fBudget = 2.0f, const int iRequestBudget = 64);
+
+	// Complete the requests which are still queued with empty paths
+	void Exit(void);
+
+	// Request a path with one of the inlined heuristics for an entity. It is safe to call this from any thread.
+	std::future<Path> Request(const unsigned int uiEntityID, const glm::vec2& startPos, const glm::vec2& targetPos, const heuristic::TYPE eHeuristic, const int iWeight = 1);
+	// Request a path with a HeuristicFunction. This is slower, as the heuristic is called through the std::function.
+	std::future<Path> Request(const unsigned int uiEntityID, const glm::vec2& startPos, const glm::vec2& targetPos, HeuristicFunction heuristicFunc, const int iWeight = 1);
+
+	// Find the paths of the queued requests until the budget of this frame is used up
+	void Update(void);
+
+	// Set the number of milliseconds per frame which Update() may spend
+	void SetBudget(const float fBudget);
+	// Get the number of milliseconds per frame which Update() may spend
+	float GetBudget(void) const;
+
+	// Set the number of requests per frame which Update() completes when CSettings::bDeterministic is set
+	void SetRequestBudget(const int iRequestBudget);
+	// Get the number of requests per frame which Update() completes when CSettings::bDeterministic is set
+	int GetRequestBudget(void) const;
+
+	// Get the number of requests which are waiting
+	int GetQueueDepth(void) const;
+	// Get the number of requests completed in the last Update()
+	int GetNumCompleted(void) const;
+	// Get the number of milliseconds spent in the last Update()
+	float GetTimeSpent(void) const;
+	// Get the average time in milliseconds from request to result, of the requests completed in the last Update()
+	float GetAverageLatency(void) const;
+	// Get the longest time in milliseconds from request to result, of the requests completed in the last Update()
+	float GetMaxLatency(void) const;
+	// Get the longest number of frames from request to result, of the requests completed in the last Update()
+	int GetMaxLatencyFrames(void) const;
+
+	// PrintSelf
+	void PrintSelf(void) const;
+
+protected:
+	// A request which is waiting for its path
+	struct SRequest
+	{
+		// The entity which made the request
+		unsigned int uiEntityID;
+		glm::vec2 startPos;
+		glm::vec2 targetPos;
+		heuristic::TYPE eHeuristic;
+		// Empty unless the request was made with a HeuristicFunction
+		HeuristicFunction heuristicFunc;
+		int iWeight;
+		std::promise<Path> promise;
+		std::chrono::high_resolution_clock::time_point tRequested;
+		unsigned int uiFrameRequested;
+	};
+
+	// Constructor
+	CPathFindingService(void);
+
+	// Destructor
+	virtual ~CPathFindingService(void);
+
+	// The requests which are waiting, oldest first
+	std::deque<SRequest> requests;
+	// Protects requests and uiFrame, as the entities may request paths from the worker threads
+	mutable std::mutex requestMutex;
+
+	// The number of milliseconds per frame which Update() may spend
+	float fBudget;
+	// The number of requests per frame which Update() completes when CSettings::bDeterministic is set
+	int iRequestBudget;
+	// The number of calls to Update()
+	unsigned int uiFrame;
+
+	// The metrics of the last Update()
+	int iNumCompleted;
+	float fTimeSpent;
+	float fAverageLatency;
+	float fMaxLatency;
+	int iMaxLatencyFrames;
+};
@@ -6,25 +6,37 @@
  */
 #include "PickUP.h"
 
+// Include CProfiler to time the zones of the frame
+#include "TimeControl/Profiler.h"
+// Include CMemoryTracker to count the allocations of the frame
+#include "System/MemoryTracker.h"
+
 #include <iostream>
 using namespace std;
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
+// Include Sprite Batch
+#include "RenderControl/SpriteBatch.h"
 // Include Mesh Builder
 #include "Primitives/MeshBuilder.h"
 
 // Include GLEW
 #include <GL/glew.h>
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "RenderControl/GLTelemetry.h"
 
 // Include ImageLoader
-#include "System\ImageLoader.h"
+#include "System/ImageLoader.h"
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
 // Include math.h
 #include <math.h>
 
+// Include CPathFindingService
+#include "PathFindingService.h"
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
@@ -47,6 +59,7 @@ PickUP::PickUP(void)
 
 	// Initialise vec2UVCoordinate
 	vec2UVCoordinate = glm::vec2(0.0f);
+	vec2PrevUVCoordinate = glm::vec2(0.0f);
 
 	i32vec2Destination = glm::i32vec2(0, 0);	// Initialise the iDestination
 	i32vec2Direction = glm::i32vec2(0, 0);		// Initialise the iDirection
@@ -140,7 +153,8 @@ bool PickUP::Init(void)
 	// If this class is initialised properly, then set the bIsActive to true
 	bIsActive = true;
 
-	rand_dir = rand() % 2; // 0 or 1
+	cRandom = CRandomService::GetInstance()->CreateEntityStream();
+	rand_dir = cRandom.Range(2); // 0 or 1
 
 
 
@@ -152,6 +166,8 @@ bool PickUP::Init(void)
  */
 void PickUP::Update(const double dElapsedTime)
 {
+	PROFILE_ZONE("PickUP::Update");
+	MEMORY_TAG(SCENE);
 
 	if (enemyHealth <= 0)
 	{
@@ -194,7 +210,7 @@ void PickUP::Update(const double dElapsedTime)
 				walktimer += dElapsedTime;
 				if (walktimer > 0.3f)
 				{
-					int random_walk_direction = rand() % 4;
+					int random_walk_direction = cRandom.Range(4);
 					
 					if (random_walk_direction == 1)
 					{
@@ -244,6 +260,9 @@ void PickUP::Update(const double dElapsedTime)
 	// Update Jump or Fall
 	UpdateJumpFall(dElapsedTime);
 
+	// Keep the UV Coordinates of the tick before, to render between the ticks
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+
 	// Update the UV Coordinates
 	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, i32vec2NumMicroSteps.x * cSettings->MICRO_STEP_XAXIS);
 	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, i32vec2NumMicroSteps.y * cSettings->MICRO_STEP_YAXIS);
@@ -254,18 +273,7 @@ void PickUP::Update(const double dElapsedTime)
  */
 void PickUP::PreRender(void)
 {
-	if (!bIsActive)
-		return;
-
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-
-	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	// Activate the shader
-	CShaderManager::GetInstance()->Use(sShaderName);
+	// The blending mode and the shader are set up by CSpriteBatch when it draws this frame's sprites
 }
 
 /**
@@ -276,29 +284,11 @@ void PickUP::Render(void)
 	if (!bIsActive)
 		return;
 
-	glBindVertexArray(VAO);
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
-	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
-		vec2UVCoordinate.y,
-		0.0f));
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-	glUniform4fv(colorLoc, 1, glm::value_ptr(runtimeColour));
-
-	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-
-	// Render the tile
-	//glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-	quadMesh->Render();
-
-	glBindVertexArray(0);
-
+	// Submit this pick up to the sprite batch, which draws it with the other sprites using the same texture
+	CSpriteBatch::GetInstance()->Submit(iTextureID,
+										InterpolateUVCoordinate(vec2PrevUVCoordinate, vec2UVCoordinate),
+										glm::vec2(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT),
+										runtimeColour);
 }
 
 /**
@@ -306,11 +296,7 @@ void PickUP::Render(void)
  */
 void PickUP::PostRender(void)
 {
-	if (!bIsActive)
-		return;
-
-	// Disable blending
-	glDisable(GL_BLEND);
+	// The blending mode is disabled by CSpriteBatch after it draws this frame's sprites
 }
 
 /**
@@ -335,6 +321,22 @@ void PickUP::Seti32vec2NumMicroSteps(const int iNumMicroSteps_XAxis, const int i
 	this->i32vec2NumMicroSteps.y = iNumMicroSteps_YAxis;
 }
 
+/**
+@brief Get the indices of the enemy2D
+*/
+glm::vec2 PickUP::Geti32vec2Index(void) const
+{
+	return vec2Index;
+}
+
+/**
+@brief Get the number of microsteps of the enemy2D
+*/
+glm::vec2 PickUP::Geti32vec2NumMicroSteps(void) const
+{
+	return i32vec2NumMicroSteps;
+}
+
 /**
  @brief Set the handle to cPlayer to this class instance
  @param cPlayer2D A CPlayer2D* variable which contains the pointer to the CPlayer2D instance
@@ -664,9 +666,8 @@ bool PickUP::InteractWithPlayer(void)
 			((vec2Index.y >= i32vec2PlayerPos.y - 1.5) &&
 				(vec2Index.y <= i32vec2PlayerPos.y + 1.5)))
 		{
-			std::vector<string>	PHK = CPlayer2D::GetInstance()->GetHotKeyInv();
-			std::vector<int> PHKQ = CPlayer2D::GetInstance()->GetHotKeyQuitity();
-			std::vector<int>  PHKID = CPlayer2D::GetInstance()->GetHotKeyid();
+			const std::vector<string>& PHK = CPlayer2D::GetInstance()->GetHotKeyInv();
+			const std::vector<int>& PHKQ = CPlayer2D::GetInstance()->GetHotKeyQuitity();
 			for (size_t i = 0; i < PHK.size(); i++)
 			{
 				if (PHK[i] == name && PHKQ[i] < MaxQuant)
@@ -881,14 +882,24 @@ void PickUP::UpdatePosition(void)
 
 void PickUP::ShortCutPath(glm::vec2 des)
 {
-	auto path = cMap2D->PathFind(vec2Index,
-		des,
-		heuristic::euclidean,
-		10);
+	// Ask for a path to the destination, unless one is still being found
+	if (pathFuture.valid() == false)
+	{
+		pathFuture = CPathFindingService::GetInstance()->Request(uiEntityID,
+			vec2Index,
+			des,
+			heuristic::EUCLIDEAN,
+			10);
+	}
+
+	// Keep to the destination of the previous path until the new path arrives
+	if (pathFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return;
+	auto path = pathFuture.get();
 
 	// Calculate new destination
 	bool bFirstPosition = true;
-	for (const auto& coord : path)
+	for (const glm::vec2 coord : path)
 	{
 		//std::cout << coord.x << "," << coord.y << "\n";
 		if (bFirstPosition == true)
@@ -911,3 +922,21 @@ void PickUP::ShortCutPath(glm::vec2 des)
 		}
 	}
 }
+
+/**
+ @brief Add the state of this pickup to a checksum of the world
+ @param cChecksum A CChecksum& variable containing the checksum
+ */
+void PickUP::AddToChecksum(CChecksum& cChecksum) const
+{
+	cChecksum.Add(bIsActive);
+	// An inactive entity is never active again, so the rest of its state does not matter
+	if (!bIsActive)
+		return;
+
+	cChecksum.Add(vec2Index);
+	cChecksum.Add(i32vec2NumMicroSteps);
+	cChecksum.Add(sCurrentFSM);
+	cChecksum.Add(Iid);
+	cChecksum.Add(MaxQuant);
+}
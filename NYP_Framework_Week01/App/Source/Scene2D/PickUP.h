@@ -7,7 +7,7 @@
 #pragma once
 
 // Include shader
-#include "RenderControl\shader.h"
+#include "RenderControl/Shader.h"
 
 // Include GLM
 #include <includes/glm.hpp>
@@ -21,7 +21,17 @@
 class CMap2D;
 
 // Include Settings
-#include "GameControl\Settings.h"
+#include "GameControl/Settings.h"
+
+// Include CRandom
+#include "System/Random.h"
+
+// Include CChecksum
+#include "System/Checksum.h"
+
+#include <future>
+// Include CMap2D for the SPath which CPathFindingService finds
+#include "Map2D.h"
 
 // Include Physics2D
 #include "Physics2D.h"
@@ -76,6 +86,9 @@ public:
 	// Set the handle to cPlayer to this class instance
 	void SetPlayer2D(CPlayer2D* cPlayer2D);
 
+	// Add the state of this pickup to a checksum of the world
+	void AddToChecksum(CChecksum& cChecksum) const;
+
 
 	// boolean flag to indicate if this enemy is active
 	bool bIsActive;
@@ -87,8 +100,6 @@ public:
 	vector<bullet*> eBullet;
 
 
-	vector<bullet*> watchout;
-
 	int getId();
 
 protected:
@@ -128,6 +139,8 @@ protected:
 
 	// The vec2 variable which stores the UV coordinates to render the enemy2D
 	glm::vec2 vec2UVCoordinate;
+	// The UV coordinates of the pickup in the tick before, so that it is drawn between its last two positions
+	glm::vec2 vec2PrevUVCoordinate;
 
 	// The vec2 which stores the indices of the destination for enemy2D in the Map2D
 	glm::vec2 i32vec2Destination;
@@ -140,6 +153,9 @@ protected:
 	// Physics
 	CPhysics2D cPhysics2D;
 
+	// The random numbers of this pickup
+	CRandom cRandom;
+
 	// Current color
 	glm::vec4 runtimeColour;
 
@@ -184,6 +200,8 @@ protected:
 	void UpdatePosition(void);
 
 	void ShortCutPath(glm::vec2 des);
+	// The path which CPathFindingService is finding for ShortCutPath()
+	std::future<SPath> pathFuture;
 	//myStuff;
 
 	float hp=11;
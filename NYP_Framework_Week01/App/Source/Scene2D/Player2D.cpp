@@ -6,6 +6,13 @@
  */
 #include "Player2D.h"
 
+// Include CProfiler to time the zones of the frame
+#include "TimeControl/Profiler.h"
+// Include CMemoryTracker to count the allocations of the frame
+#include "System/MemoryTracker.h"
+// Include CPerfCounters to count the hardware events of the zones
+#include "TimeControl/PerfCounters.h"
+
 #include <iostream>
 
 #include <algorithm>
@@ -13,10 +20,14 @@
 using namespace std;
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
+// Include Sprite Batch
+#include "RenderControl/SpriteBatch.h"
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "RenderControl/GLTelemetry.h"
 
 // Include ImageLoader
-#include "System\ImageLoader.h"
+#include "System/ImageLoader.h"
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
@@ -27,6 +38,7 @@ using namespace std;
  */
 CPlayer2D::CPlayer2D(void)
 	: cMap2D(NULL)
+	, cBulletGrid(NULL)
 	, cKeyboardController(NULL)
 	, animatedSprites(NULL)
 	, runtimeColour(glm::vec4(1.0f))
@@ -54,6 +66,9 @@ CPlayer2D::~CPlayer2D(void)
 	// We won't delete this since it was created elsewhere
 	cMap2D = NULL;
 
+	// We won't delete this since it was created elsewhere
+	cBulletGrid = NULL;
+
 	// optional: de-allocate all resources once they've outlived their purpose:
 	glDeleteVertexArrays(1, &VAO);
 
@@ -194,29 +209,35 @@ void CPlayer2D::InteractWithMap(void)
 		break;
 	}
 
-	for (size_t i = 0; i < WatchOutBullet.size(); i++)
+	// Check the enemies' bullets in the tiles around the player
+	if (cBulletGrid)
 	{
-		if (((vec2Index.x >= WatchOutBullet[i]->vec2Index.x - 1) &&
-			(vec2Index.x <= WatchOutBullet[i]->vec2Index.x + 1))
-			&&
-			((vec2Index.y >= WatchOutBullet[i]->vec2Index.y - 1) &&
-				(vec2Index.y <= WatchOutBullet[i]->vec2Index.y + 1)))
+		cBulletGrid->ForEachInRange(vec2Index, 1.0f, [&](bullet* cBullet)
 		{
-			if (getIframe()==false)
+			if (cBullet->bIsActive == false)
+				return;
+
+			if (((vec2Index.x >= cBullet->vec2Index.x - 1) &&
+				(vec2Index.x <= cBullet->vec2Index.x + 1))
+				&&
+				((vec2Index.y >= cBullet->vec2Index.y - 1) &&
+					(vec2Index.y <= cBullet->vec2Index.y + 1)))
 			{
-				SetIframe();
-				if (WatchOutBullet[i]->boss == false)
-				{
-					setHealth(5);
-				}
-				else
+				if (getIframe() == false)
 				{
-					setHealth(10);
+					SetIframe();
+					if (cBullet->boss == false)
+					{
+						setHealth(5);
+					}
+					else
+					{
+						setHealth(10);
+					}
 				}
+				cBullet->bIsActive = false;
 			}
-			WatchOutBullet[i]->bIsActive = false;
-		}
-
+		});
 	}
 
 
@@ -233,6 +254,8 @@ bool CPlayer2D::bInteractWithMap(int i)
  */
 void CPlayer2D::Update(const double dElapsedTime)
 {
+	PROFILE_ZONE("CPlayer2D::Update");
+	MEMORY_TAG(ENTITIES);
 	fireRate -= dElapsedTime;
 	shooting = false;
 	if (cKeyboardController->IsKeyPressed(GLFW_KEY_F))
@@ -439,6 +462,9 @@ void CPlayer2D::Update(const double dElapsedTime)
 	UpdateHealthLives();
 
 
+	// Keep the UV Coordinates of the tick before, to render between the ticks
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+
 	// Update the UV Coordinates
 	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, vec2NumMicroSteps.x*cSettings->MICRO_STEP_XAXIS);
 	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, vec2NumMicroSteps.y*cSettings->MICRO_STEP_YAXIS);
@@ -450,16 +476,7 @@ void CPlayer2D::Update(const double dElapsedTime)
  */
 void CPlayer2D::PreRender(void)
 {
-	// Activate blending mode
-	if (bActive == false)
-	{
-		return;
-	}
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	// Activate the shader
-	CShaderManager::GetInstance()->Use(sShaderName);
+	// The blending mode and the shader are set up by CSpriteBatch when it draws this frame's sprites
 }
 
 /**
@@ -467,35 +484,22 @@ void CPlayer2D::PreRender(void)
  */
 void CPlayer2D::Render(void)
 {
+	PROFILE_ZONE("CPlayer2D::Render");
+	MEMORY_ZERO_ALLOC("CPlayer2D::Render");
 	if (bActive == false)
 	{
 		return;
 	}
-	glBindVertexArray(VAO);
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
 
-	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
-													vec2UVCoordinate.y,
-													0.0f));
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-	glUniform4fv(colorLoc, 1, glm::value_ptr(runtimeColour));
-
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-
-		//Render the Player sprite
-		glBindVertexArray(VAO);
-		//quadMesh->Render();
-		animatedSprites->Render();
-		glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	// Submit the current frame of the player's animation to the sprite batch
+	glm::vec2 vec2UVMin, vec2UVMax;
+	animatedSprites->GetCurrentFrameUV(vec2UVMin, vec2UVMax);
+	CSpriteBatch::GetInstance()->Submit(iTextureID,
+										InterpolateUVCoordinate(vec2PrevUVCoordinate, vec2UVCoordinate),
+										glm::vec2(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT),
+										runtimeColour,
+										vec2UVMin,
+										vec2UVMax);
 }
 
 /**
@@ -503,12 +507,7 @@ void CPlayer2D::Render(void)
  */
 void CPlayer2D::PostRender(void)
 {
-	if (bActive == false)
-	{
-		return;
-	}
-	// Disable blending
-	glDisable(GL_BLEND);
+	// The blending mode is disabled by CSpriteBatch after it draws this frame's sprites
 }
 
 void CPlayer2D::UpdateJumpFall(const double dElapsedTime)
@@ -709,6 +708,9 @@ bool  CPlayer2D::BConstraint(DIRECTION eDirection,int i)
 
 bool CPlayer2D::CheckPosition(DIRECTION eDirection)
 {
+	PROFILE_COUNTERS("CPlayer2D::CheckPosition");
+	MEMORY_ZERO_ALLOC("CPlayer2D::CheckPosition");
+
 	if (eDirection == LEFT)
 	{
 		if (vec2NumMicroSteps.y == 0)
@@ -843,8 +845,8 @@ void CPlayer2D::MouseInteracteWithMap(const double dElapsedTime)
 		//play sound;
 	}
 
-	float posX = cMouseController->GetMousePositionX() / cSettings->iWindowWidth * 32; //convert (0,800) to (0,80)
-	float posY = 24 - (cMouseController->GetMousePositionY() / cSettings->iWindowHeight * 24);
+	float posX = cMouseController->GetMousePositionX() / cSettings->iWindowWidth * cSettings->NUM_TILES_XAXIS; //convert (0,800) to (0,80)
+	float posY = cSettings->NUM_TILES_YAXIS - (cMouseController->GetMousePositionY() / cSettings->iWindowHeight * cSettings->NUM_TILES_YAXIS);
 	glm::vec2 mousePos(posX, posY);
 	
 	if ((mousePos.x > 0 && mousePos.x < cSettings->NUM_TILES_XAXIS - 1) && (mousePos.y > 0 && mousePos.y < cSettings->NUM_TILES_YAXIS - 1))
@@ -852,98 +854,21 @@ void CPlayer2D::MouseInteracteWithMap(const double dElapsedTime)
 		if (cPhysics2D.CalculateDistance(vec2Index, mousePos) <= 3)
 		{
 	
-			switch (cMap2D->GetMapInfo(mousePos.y, mousePos.x))
+			// The tile registry says which tiles the player can break, and what each of them drops
+			const CTileRegistry::STile* pTile = cMap2D->GetTileRegistry().GetTile(cMap2D->GetMapInfo(mousePos.y, mousePos.x));
+			if ((pTile != NULL) && (pTile->bDestructible) && (cMouseController->IsButtonDown(0)))
 			{
-		
-
-			case 101: //steelpile
-				if (cMouseController->IsButtonDown(0))
-				{
-					breakTimer += dt;
-					if (breakTimer >= 2)
-					{
-						cMap2D->SetMapInfo(mousePos.y, mousePos.x, 0);
-						addToinventory(11, "metalcube", 1, 10);
-						breakTimer = 0;
-					}
-					else
-					{
-						CSC->PlaySoundByID(1);
-					}
-				}
-				break;
-
-			case 102: //rusted tree
-				if (cMouseController->IsButtonDown(0))
-				{
-					breakTimer += dt;
-					if (breakTimer >= 2)
-					{
-						cMap2D->SetMapInfo(mousePos.y, mousePos.x, 0);
-						addToinventory(10, "rustedwood", 1, 10);
-						breakTimer = 0;
-					}
-					else
-					{
-						CSC->PlaySoundByID(1);
-					}
-				}
-				break;
-
-			case 103:
-				if (cMouseController->IsButtonDown(0))
+				breakTimer += dt;
+				if (breakTimer >= 2)
 				{
-					breakTimer += dt;
-					if (breakTimer >= 2)
-					{
-						cMap2D->SetMapInfo(mousePos.y, mousePos.x, 0);
-						addToinventory(103, "metalcubePLUS (block)", 1, 10);
-						breakTimer = 0;
-					}
-					else
-					{
-						CSC->PlaySoundByID(1);
-					}
+					cMap2D->SetMapInfo(mousePos.y, mousePos.x, 0);
+					addToinventory(pTile->iDropID, pTile->dropName, pTile->iDropAmount, pTile->iDropMax);
+					breakTimer = 0;
 				}
-				break;
-
-
-			case 105:
-				if (cMouseController->IsButtonDown(0))
-				{
-					breakTimer += dt;
-					if (breakTimer >= 2)
-					{
-						cMap2D->SetMapInfo(mousePos.y, mousePos.x, 0);
-						addToinventory(105, "rustedwoodPLUS (block)", 1, 10);
-						breakTimer = 0;
-					}
-					else
-					{
-						CSC->PlaySoundByID(1);
-					}
-				}
-				break;
-			case 30:
-				if (cMouseController->IsButtonDown(0))
+				else
 				{
-					breakTimer += dt;
-					if (breakTimer >= 2)
-					{
-						cMap2D->SetMapInfo(mousePos.y, mousePos.x, 0);
-						addToinventory(30, "portal (block)", 1, 1);
-						breakTimer = 0;
-					}
-					else
-					{
-						CSC->PlaySoundByID(1);
-					}
+					CSC->PlaySoundByID(1);
 				}
-				break;
-
-
-			default:
-				break;
 			}
 		}
 
@@ -1165,8 +1090,8 @@ void CPlayer2D::Wepon(string wepon)
 
 void CPlayer2D::MouseAction()
 {
-	float posX = cMouseController->GetMousePositionX() / cSettings->iWindowWidth * 32; //convert (0,800) to (0,80)
-	float posY = 24 - (cMouseController->GetMousePositionY() / cSettings->iWindowHeight * 24);
+	float posX = cMouseController->GetMousePositionX() / cSettings->iWindowWidth * cSettings->NUM_TILES_XAXIS; //convert (0,800) to (0,80)
+	float posY = cSettings->NUM_TILES_YAXIS - (cMouseController->GetMousePositionY() / cSettings->iWindowHeight * cSettings->NUM_TILES_YAXIS);
 	glm::vec2 mousePos(posX, posY);
 	if (cMouseController->IsButtonDown(1))
 	{
@@ -1202,6 +1127,7 @@ void CPlayer2D::MouseAction()
 
 				shooting = true;
 				cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 372);
+				MEMORY_TAG(BULLETS);
 				bullet* p = new bullet();
 				p->SetShader("Shader2D_Colour");
 				p->Init();
@@ -1365,17 +1291,17 @@ void CPlayer2D::AssignAmtOfDog(int amt)
 	}
 }
 
-std::vector<string> CPlayer2D::GetHotKeyInv()
+const std::vector<string>& CPlayer2D::GetHotKeyInv()
 {
 	return hotKeyInv;
 }
 
-std::vector<int> CPlayer2D::GetHotKeyQuitity()
+const std::vector<int>& CPlayer2D::GetHotKeyQuitity()
 {
 	return hotKeyInvQuantity;
 }
 
-std::vector<int> CPlayer2D::GetHotKeyid()
+const std::vector<int>& CPlayer2D::GetHotKeyid()
 {
 	return hotKeyInvID;
 }
@@ -1408,6 +1334,15 @@ void CPlayer2D::SetIframe()
 	iFrame = true;
 }
 
+/**
+ @brief Set the handle to the grid of the enemies' bullets to this class instance
+ @param cBulletGrid A CSpatialHash2D<bullet*>* variable which contains the pointer to the grid
+ */
+void CPlayer2D::SetBulletGrid(CSpatialHash2D<bullet*>* cBulletGrid)
+{
+	this->cBulletGrid = cBulletGrid;
+}
+
 void CPlayer2D::fuelTime()
 {
 	
@@ -1433,3 +1368,19 @@ void CPlayer2D::setHealth(int damage)
 		CGameManager::GetInstance()->bPlayerLost = true;
 	}
 }
+
+/**
+ @brief Add the state of the player to a checksum of the world. The health and the other items are in the inventory.
+ @param cChecksum A CChecksum& variable containing the checksum
+ */
+void CPlayer2D::AddToChecksum(CChecksum& cChecksum) const
+{
+	cChecksum.Add(vec2Index);
+	cChecksum.Add(vec2NumMicroSteps);
+	cChecksum.Add(iFrame);
+	cChecksum.Add(dmg);
+	cChecksum.Add(gunDmg);
+	cChecksum.Add(fireRate);
+	cChecksum.Add(enemies_unalived);
+	cChecksum.Add(select);
+}
@@ -7,7 +7,7 @@
 #pragma once
 
 // Include Singleton template
-#include "DesignPatterns\SingletonTemplate.h"
+#include "DesignPatterns/SingletonTemplate.h"
 
 // Include GLEW
 #ifndef GLEW_STATIC
@@ -27,8 +27,8 @@
 class CMap2D;
 
 // Include Keyboard controller
-#include "Inputs\KeyboardController.h"
-#include "Inputs\MouseController.h"
+#include "Inputs/KeyboardController.h"
+#include "Inputs/MouseController.h"
 
 #include "InventoryManager.h"
 #include "GameManager.h"
@@ -41,6 +41,12 @@ class CMap2D;
 #include "Physics2D.h"
 #include "bullet.h"
 
+// Include SpatialHash2D
+#include "SpatialHash2D.h"
+
+// Include CChecksum
+#include "System/Checksum.h"
+
 
 
 
@@ -90,11 +96,12 @@ public:
 
 	void AssignAmtOfDog(int amt);
 
-	std::vector<string> GetHotKeyInv();
+	// The hotkey slots are returned by reference, so that the GUI can copy them into its own vectors without allocating
+	const std::vector<string>& GetHotKeyInv();
 
-	std::vector<int> GetHotKeyQuitity();
+	const std::vector<int>& GetHotKeyQuitity();
 
-	std::vector<int> GetHotKeyid();
+	const std::vector<int>& GetHotKeyid();
 
 	void setHotKeyInventory(std::vector<string> name, std::vector<int> id, std::vector<int> quan);
 
@@ -107,6 +114,9 @@ public:
 
 	void fuelTime();
 
+	// Add the state of the player to a checksum of the world
+	void AddToChecksum(CChecksum& cChecksum) const;
+
 	void setHealth(int damage);
 
 	void addToinventory(int num, string name, int amt, int maxQuantity);
@@ -119,7 +129,8 @@ public:
 	std::vector<bullet*> pBullet;
 
 
-	std::vector<bullet*> WatchOutBullet;
+	// Set the handle to the grid of the enemies' bullets
+	void SetBulletGrid(CSpatialHash2D<bullet*>* cBulletGrid);
 	int enemies_unalived = 10;
 	void selectKey();
 	float getGunDmg();
@@ -171,6 +182,9 @@ protected:
 	// Handler to the CMap2D instance
 	CMap2D* cMap2D;
 
+	// Handle to the grid of the enemies' bullets
+	CSpatialHash2D<bullet*>* cBulletGrid;
+
 	// Keyboard Controller singleton instance
 	CKeyboardController* cKeyboardController;
 	CMouseController* cMouseController;
@@ -22,25 +22,20 @@
 #include "../GameStateManagement/GameStateManager.h"
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
+// Include Sprite Batch
+#include "RenderControl/SpriteBatch.h"
 
 // Include vector
 #include <vector>
 
 // Include Keyboard controller
-#include "Inputs\KeyboardController.h"
-#include "Inputs\MouseController.h"
+#include "Inputs/KeyboardController.h"
+#include "Inputs/MouseController.h"
 
-#include "Map2D.h"
-#include "Player2D.h"
 #include "GUI_Scene2D.h"
-#include "GameManager.h"
-#include "Enemy2D.h"
-#include "bullet.h"
-#include "ghens.h"
-
-#include "PickUP.h"
-#include <vector>
+// Include CWorld2D, which holds and steps the entities
+#include "World2D.h"
 // Add your include files here
 
 class CScene2D : public CSingletonTemplate<CScene2D>
@@ -62,17 +57,6 @@ public:
 	// PostRender
 	void PostRender(void);
 
-	float worldTime=0;
-
-	float worldTime1=0;
-
-	float clock = 0;
-	int enemies_spawnned = 0;
-
-	int random_enemy_spawn = -1;
-
-	bool spawnable = true;
-
 protected:
 	// Keyboard Controller singleton instance
 	CKeyboardController* cKeyboardController;
@@ -81,28 +65,17 @@ protected:
 	glm::mat4 transform;
 
 	// Add your variables and methods here.
-	std::vector<CEntity2D*> enemyVector;
-	std::vector<PickUP*> Pick;
-	CEntity2D* boss;
-	ghens* G;
-
-	std::vector<CEnemy2D*> a;
-
+	// The map, the player and the entities, which are stepped in the same way as in the HeadlessSimulation
+	CWorld2D cWorld2D;
 
 	// Constructor
 	CScene2D(void);
 	// Destructor
 	virtual ~CScene2D(void);
 
-	CPlayer2D* cPlayer2D;
 	CMap2D* cMap2D;
 	CGUI_Scene2D* cGUI_Scene2D;
-	CGameManager* cGameManager;
 	CSoundController* CSC;
-
-	std::vector<bullet*> bulletVector;
-
-	bool spawnGhens = false;
-
+	CSpriteBatch* cSpriteBatch;
 };
 
@@ -0,0 +1,148 @@
+/**
+ CSpatialHash2D
+ @brief A uniform grid over the map tiles, used to find the entities near a position
+		without testing every entity in the scene. Items are inserted once per frame
+		and the grid is cleared before the next frame, keeping the memory of the cells.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include vector
+#include <vector>
+
+template <typename T>
+class CSpatialHash2D
+{
+public:
+	// Constructor
+	CSpatialHash2D(void)
+		: iNumCols(0)
+		, iNumRows(0)
+		, uiNumItems(0)
+	{
+	}
+
+	// Destructor
+	virtual ~CSpatialHash2D(void)
+	{
+	}
+
+	/**
+	 @brief Init the grid to cover the map
+	 @param iNumCols A const int variable containing the number of tiles in the x-axis
+	 @param iNumRows A const int variable containing the number of tiles in the y-axis
+	 */
+	void Init(const int iNumCols, const int iNumRows)
+	{
+		this->iNumCols = iNumCols;
+		this->iNumRows = iNumRows;
+		cells.clear();
+		cells.resize(iNumCols * iNumRows);
+		uiNumItems = 0;
+	}
+
+	/**
+	 @brief Remove all the items from the grid. The cells keep their capacity.
+	 */
+	void Clear(void)
+	{
+		for (size_t i = 0; i < cells.size(); i++)
+		{
+			cells[i].clear();
+		}
+		uiNumItems = 0;
+	}
+
+	/**
+	 @brief Insert an item into the cell which contains a position
+	 @param vec2Position A const glm::vec2& variable containing the position in tile indices
+	 @param item A T variable containing the item to insert
+	 */
+	void Insert(const glm::vec2& vec2Position, T item)
+	{
+		if (cells.empty())
+			return;
+
+		cells[GetCellIndex(GetCol(vec2Position.x), GetRow(vec2Position.y))].push_back(item);
+		uiNumItems++;
+	}
+
+	/**
+	 @brief Call a function for every item in the cells touched by a box around a position.
+			The caller still has to do its own hit test, as the cells are one tile in size.
+	 @param vec2Position A const glm::vec2& variable containing the centre of the box
+	 @param fRange A const float variable containing the half size of the box in tile indices
+	 @param func A Func variable which is called with each item found
+	 */
+	template <typename Func>
+	void ForEachInRange(const glm::vec2& vec2Position, const float fRange, Func func) const
+	{
+		if (cells.empty())
+			return;
+
+		const int iMinCol = GetCol(vec2Position.x - fRange);
+		const int iMaxCol = GetCol(vec2Position.x + fRange);
+		const int iMinRow = GetRow(vec2Position.y - fRange);
+		const int iMaxRow = GetRow(vec2Position.y + fRange);
+		for (int iRow = iMinRow; iRow <= iMaxRow; iRow++)
+		{
+			for (int iCol = iMinCol; iCol <= iMaxCol; iCol++)
+			{
+				const std::vector<T>& cell = cells[GetCellIndex(iCol, iRow)];
+				for (size_t i = 0; i < cell.size(); i++)
+				{
+					func(cell[i]);
+				}
+			}
+		}
+	}
+
+	// Get the number of items in the grid
+	unsigned int GetNumItems(void) const
+	{
+		return uiNumItems;
+	}
+
+protected:
+	// The number of cells in the x-axis and y-axis
+	int iNumCols;
+	int iNumRows;
+
+	// The cells, stored row by row
+	std::vector< std::vector<T> > cells;
+
+	// The number of items inserted since the last Clear()
+	unsigned int uiNumItems;
+
+	// Get the column of a x-axis position, clamped to the grid
+	int GetCol(const float fX) const
+	{
+		int iCol = (int)floor(fX);
+		if (iCol < 0)
+			iCol = 0;
+		else if (iCol >= iNumCols)
+			iCol = iNumCols - 1;
+		return iCol;
+	}
+
+	// Get the row of a y-axis position, clamped to the grid
+	int GetRow(const float fY) const
+	{
+		int iRow = (int)floor(fY);
+		if (iRow < 0)
+			iRow = 0;
+		else if (iRow >= iNumRows)
+			iRow = iNumRows - 1;
+		return iRow;
+	}
+
+	// Get the index of a cell
+	int GetCellIndex(const int iCol, const int iRow) const
+	{
+		return iRow * iNumCols + iCol;
+	}
+};
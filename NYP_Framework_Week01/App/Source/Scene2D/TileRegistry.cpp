@@ -0,0 +1,197 @@
+/**
+ CTileRegistry
+ @brief A class which reads the properties of the tile values from a CSV file: the texture, whether
+		the tile blocks movement, whether the player can break it and what it drops when broken.
+		The textures are packed into one texture atlas, so that the map is drawn without switching
+		textures, and the properties are kept in flat tables indexed by the tile value.
+ By: agent
+ Date: Oct 2026
+ */
+#include "TileRegistry.h"
+
+#include <exception>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+// Include the RapidCSV
+#include "System/rapidcsv.h"
+// Include Filesystem
+#include "System/filesystem.h"
+
+/**
+ @brief Constructor
+ */
+CTileRegistry::CTileRegistry(void)
+{
+}
+
+/**
+ @brief Destructor
+ */
+CTileRegistry::~CTileRegistry(void)
+{
+	Clear();
+}
+
+/**
+@brief Read the tile values from a CSV file, and build the flat tables which are indexed by the tile value.
+	   A tile value which is listed twice keeps its last row.
+@param filename A const std::string& variable containing the name of the CSV file
+@return false if the file cannot be read or a tile value is negative
+*/
+bool CTileRegistry::Load(const std::string& filename)
+{
+	const std::string path = FileSystem::getPath(filename);
+	if (!std::ifstream(path.c_str()))
+	{
+		cout << "Unable to open the tile registry " << filename << endl;
+		return false;
+	}
+
+	Clear();
+	try
+	{
+		rapidcsv::Document cDoc(path.c_str());
+		const std::vector<int> arrIDs = cDoc.GetColumn<int>("id");
+		const std::vector<std::string> arrTextures = cDoc.GetColumn<std::string>("texture");
+		const std::vector<int> arrSolid = cDoc.GetColumn<int>("solid");
+		const std::vector<int> arrDestructible = cDoc.GetColumn<int>("destructible");
+		const std::vector<int> arrDropIDs = cDoc.GetColumn<int>("drop id");
+		const std::vector<std::string> arrDropNames = cDoc.GetColumn<std::string>("drop name");
+		const std::vector<int> arrDropAmounts = cDoc.GetColumn<int>("drop amount");
+		const std::vector<int> arrDropMaxes = cDoc.GetColumn<int>("drop max");
+
+		for (size_t i = 0; i < arrIDs.size(); i++)
+		{
+			if (arrIDs[i] < 0)
+			{
+				cout << "The tile registry " << filename << " has a negative tile value in row " << i + 1 << endl;
+				Clear();
+				return false;
+			}
+
+			STile sTile;
+			sTile.iID = arrIDs[i];
+			sTile.texture = arrTextures[i];
+			sTile.bSolid = (arrSolid[i] != 0);
+			sTile.bDestructible = (arrDestructible[i] != 0);
+			sTile.iDropID = arrDropIDs[i];
+			sTile.dropName = arrDropNames[i];
+			sTile.iDropAmount = arrDropAmounts[i];
+			sTile.iDropMax = arrDropMaxes[i];
+			sTile.uiLayer = 0;
+
+			if (sTile.iID >= (int)arrTileIndices.size())
+			{
+				arrTileIndices.resize(sTile.iID + 1, -1);
+				arrFlags.resize(sTile.iID + 1, 0);
+			}
+			if (arrTileIndices[sTile.iID] >= 0)
+			{
+				tiles[arrTileIndices[sTile.iID]] = sTile;
+			}
+			else
+			{
+				arrTileIndices[sTile.iID] = (int)tiles.size();
+				tiles.push_back(sTile);
+			}
+			arrFlags[sTile.iID] = (sTile.bSolid ? FLAG_SOLID : 0) | (sTile.bDestructible ? FLAG_DESTRUCTIBLE : 0);
+		}
+	}
+	catch (const std::exception& e)
+	{
+		cout << "Unable to read the tile registry " << filename << ": " << e.what() << endl;
+		Clear();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+@brief Pack the textures of the tile values into the atlas. The tile values which share an image share its layer.
+@return false if a texture cannot be loaded
+*/
+bool CTileRegistry::BuildAtlas(void)
+{
+	for (size_t i = 0; i < tiles.size(); i++)
+	{
+		if (!tiles[i].texture.empty())
+			tiles[i].uiLayer = cAtlas.AddImage(tiles[i].texture);
+	}
+	if (cAtlas.Build(true) == false)
+		return false;
+
+	arrLayerUVs.resize(cAtlas.GetNumImages());
+	for (unsigned int uiLayer = 0; uiLayer < arrLayerUVs.size(); uiLayer++)
+	{
+		glm::vec2 vec2UVMin, vec2UVMax;
+		cAtlas.GetUV(uiLayer, vec2UVMin, vec2UVMax);
+		arrLayerUVs[uiLayer] = glm::vec4(vec2UVMin, vec2UVMax);
+	}
+	for (size_t i = 0; i < tiles.size(); i++)
+	{
+		if (!tiles[i].texture.empty())
+			arrFlags[tiles[i].iID] |= FLAG_TEXTURED;
+	}
+	return true;
+}
+
+/**
+@brief Delete the atlas and forget the tile values
+*/
+void CTileRegistry::Clear(void)
+{
+	tiles.clear();
+	arrTileIndices.clear();
+	arrFlags.clear();
+	arrLayerUVs.clear();
+	cAtlas.Clear();
+}
+
+/**
+@brief Get the properties of a tile value
+@param iID A const int variable containing the tile value
+@return The properties, or NULL if the tile value is not in the registry
+*/
+const CTileRegistry::STile* CTileRegistry::GetTile(const int iID) const
+{
+	if (((unsigned int)iID >= arrTileIndices.size()) || (arrTileIndices[iID] < 0))
+		return NULL;
+	return &tiles[arrTileIndices[iID]];
+}
+
+/**
+@brief Get the number of tile values in the registry
+*/
+unsigned int CTileRegistry::GetNumTiles(void) const
+{
+	return (unsigned int)tiles.size();
+}
+
+/**
+@brief Get the texture coordinates of a tile value in the atlas
+@param iID A const int variable containing the tile value
+@param vec2UVMin A glm::vec2& variable which receives the bottom-left texture coordinate
+@param vec2UVMax A glm::vec2& variable which receives the top-right texture coordinate
+@return false if the tile value has no texture
+*/
+bool CTileRegistry::GetUV(const int iID, glm::vec2& vec2UVMin, glm::vec2& vec2UVMax) const
+{
+	if (HasFlag(iID, FLAG_TEXTURED) == false)
+		return false;
+
+	const glm::vec4& vec4UV = arrLayerUVs[tiles[arrTileIndices[iID]].uiLayer];
+	vec2UVMin = glm::vec2(vec4UV.x, vec4UV.y);
+	vec2UVMax = glm::vec2(vec4UV.z, vec4UV.w);
+	return true;
+}
+
+/**
+@brief Get the texture of the atlas, or 0 if it was not built
+*/
+unsigned int CTileRegistry::GetAtlasTextureID(void) const
+{
+	return cAtlas.GetTextureID();
+}
@@ -0,0 +1,100 @@
+/**
+ CTileRegistry
+ @brief A class which reads the properties of the tile values from a CSV file: the texture, whether
+		the tile blocks movement, whether the player can break it and what it drops when broken.
+		The textures are packed into one texture atlas, so that the map is drawn without switching
+		textures, and the properties are kept in flat tables indexed by the tile value.
+		The file has a row of column names, and then one row for each tile value:
+		id,texture,solid,destructible,drop id,drop name,drop amount,drop max
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include CTextureAtlas
+#include "RenderControl/TextureAtlas.h"
+
+// Include GLM
+#include <includes/glm.hpp>
+
+#include <string>
+#include <vector>
+
+class CTileRegistry
+{
+public:
+	// The properties of a tile value
+	struct STile
+	{
+		int iID;
+		// The image file of the tile
+		std::string texture;
+		// The tile blocks movement and the AStar PathFinding
+		bool bSolid;
+		// The player can break the tile
+		bool bDestructible;
+		// The inventory item which the player gets when the tile is broken
+		int iDropID;
+		std::string dropName;
+		int iDropAmount;
+		int iDropMax;
+		// The index of the texture in the atlas
+		unsigned int uiLayer;
+	};
+
+	// The flags of a tile value in the flag table
+	enum FLAG
+	{
+		FLAG_SOLID = 1,
+		FLAG_DESTRUCTIBLE = 2,
+		FLAG_TEXTURED = 4
+	};
+
+	// Constructor
+	CTileRegistry(void);
+
+	// Destructor
+	virtual ~CTileRegistry(void);
+
+	// Read the tile values from a CSV file
+	bool Load(const std::string& filename);
+
+	// Pack the textures of the tile values into the atlas
+	bool BuildAtlas(void);
+
+	// Delete the atlas and forget the tile values
+	void Clear(void);
+
+	// Get the properties of a tile value, or NULL if it is not in the registry
+	const STile* GetTile(const int iID) const;
+
+	// Get the number of tile values in the registry
+	unsigned int GetNumTiles(void) const;
+
+	// Check a flag of a tile value. The values which are not in the registry have no flags.
+	bool HasFlag(const int iID, const FLAG eFlag) const
+	{
+		return ((unsigned int)iID < arrFlags.size()) && ((arrFlags[iID] & eFlag) != 0);
+	}
+	bool IsSolid(const int iID) const { return HasFlag(iID, FLAG_SOLID); }
+	bool IsDestructible(const int iID) const { return HasFlag(iID, FLAG_DESTRUCTIBLE); }
+
+	// Get the texture coordinates of a tile value in the atlas. Returns false if it has no texture.
+	bool GetUV(const int iID, glm::vec2& vec2UVMin, glm::vec2& vec2UVMax) const;
+
+	// Get the texture of the atlas
+	unsigned int GetAtlasTextureID(void) const;
+
+protected:
+	// The tile values, in the order of the file
+	std::vector<STile> tiles;
+
+	// The flat tables indexed by the tile value: the index into tiles, or -1, and the flags
+	std::vector<int> arrTileIndices;
+	std::vector<unsigned char> arrFlags;
+
+	// The texture coordinates of each layer of the atlas
+	std::vector<glm::vec4> arrLayerUVs;
+
+	CTextureAtlas cAtlas;
+};
@@ -0,0 +1,764 @@
+/**
+ CWorld2D
+ @brief A class which holds and steps the world of the Scene2D: the map, the player, the enemies, the bullets,
+		the pickups and the bosses. CScene2D draws it with the GUI and the sound, and CHeadlessSimulation
+		steps it without a window, so that both run the same game logic.
+ By: agent
+ Date: Oct 2026
+ */
+#include "World2D.h"
+
+// Include CSettings
+#include "GameControl/Settings.h"
+// Include CJobSystem
+#include "JobControl/JobSystem.h"
+// Include CRandomService
+#include "System/Random.h"
+// Include the controllers
+#include "Inputs/KeyboardController.h"
+#include "Inputs/MouseController.h"
+// Include CSpriteBatch
+#include "RenderControl/SpriteBatch.h"
+// Include CProfiler to time the zones of the tick
+#include "TimeControl/Profiler.h"
+// Include CPerfCounters to count the hardware events of the zones
+#include "TimeControl/PerfCounters.h"
+// Include CMemoryTracker to count the allocations of the tick
+#include "System/MemoryTracker.h"
+// Include CInputRecorder to record or replay the inputs of each tick
+#include "Inputs/InputRecorder.h"
+
+#include <iostream>
+using namespace std;
+
+/**
+@brief Constructor
+*/
+CWorld2D::CWorld2D(void)
+	: worldTime(0.0f)
+	, worldTime1(0.0f)
+	, clock(0.0f)
+	, hunger(0)
+	, enemies_spawnned(0)
+	, random_enemy_spawn(-1)
+	, spawnable(true)
+	, cMap2D(NULL)
+	, cPlayer2D(NULL)
+	, cGameManager(NULL)
+	, cPathFindingService(NULL)
+	, bGeneratedLevel(false)
+	, spawnGhens(false)
+{
+}
+
+/**
+@brief Destructor
+*/
+CWorld2D::~CWorld2D(void)
+{
+	Destroy();
+}
+
+/**
+@brief Init Initialise this instance with the shipped maps, or with a level of any size, such as one from
+	   CStressSceneGenerator. A generated level has no neighbours, so the player stays in it, and its bosses
+	   are created at once.
+@param levelFilename A const std::string& variable containing the CSV file of the level, absolute or relative to the
+	   working directory. The shipped maps are loaded when it is empty.
+*/
+bool CWorld2D::Init(const std::string& levelFilename)
+{
+	// Seed the random numbers of this run. Set CSettings::iRandomSeed to repeat a run.
+	CRandomService::GetInstance()->Init(CSettings::GetInstance()->iRandomSeed);
+
+	// The shipped maps are 32 by 24 tiles, and a level is as big as its file
+	MapSize sMapSize;
+	sMapSize.uiRowSize = 24;
+	sMapSize.uiColSize = 32;
+	CMap2D* cNewMap2D = CMap2D::GetInstance();
+	if ((!levelFilename.empty()) && (cNewMap2D->ReadMapSize(levelFilename, sMapSize) == false))
+	{
+		cout << "Failed to load " << levelFilename << endl;
+		cNewMap2D->Destroy();
+		return false;
+	}
+	bGeneratedLevel = !levelFilename.empty();
+	cNewMap2D->SetShader("Shader2D");
+	if (cNewMap2D->Init(bGeneratedLevel ? 1 : 12, sMapSize.uiRowSize, sMapSize.uiColSize) == false)
+	{
+		cout << "Failed to load CMap2D" << endl;
+		cNewMap2D->Destroy();
+		return false;
+	}
+	// Only keep the map once it is set up, so that Destroy() only destroys what Init() created
+	cMap2D = cNewMap2D;
+
+	// Create the service which finds the paths of the entities
+	cPathFindingService = CPathFindingService::GetInstance();
+	if (cPathFindingService->Init() == false)
+	{
+		cout << "Failed to load CPathFindingService" << endl;
+		return false;
+	}
+
+	// The shipped maps, in the order of their levels. The player starts in the middle of level 1, and the boss
+	// is on the right of level 2.
+	const char* arrMaps[] = {
+		"Maps/DM2213_Map_Level_01.csv",
+		"Maps/DM2213_Map_Level_01_topleft.csv",
+		"Maps/DM2213_Map_Level_01_topmiddle.csv",
+		"Maps/DM2213_Map_Level_01_topright.csv",
+		"Maps/DM2213_Map_Level_01_middleleft.csv",
+		"Maps/DM2213_Map_Level_01_middle.csv",
+		"Maps/DM2213_Map_Level_01_middleright.csv",
+		"Maps/DM2213_Map_Level_01.csv",
+		"Maps/DM2213_Map_Level_01_bottommiddle.csv",
+		"Maps/DM2213_Map_Level_01_bottomright.csv",
+		"Maps/DM2213_Map_Level_02_left.csv",
+		"Maps/DM2213_Map_Level_02_right.csv"
+	};
+	if (bGeneratedLevel)
+	{
+		if (cMap2D->LoadMap(levelFilename, 0) == false)
+		{
+			cout << "Failed to load " << levelFilename << endl;
+			return false;
+		}
+		cMap2D->SetCurrentLevel(0);
+	}
+	else
+	{
+		for (unsigned int i = 0; i < sizeof(arrMaps) / sizeof(arrMaps[0]); i++)
+		{
+			if (cMap2D->LoadMap(arrMaps[i], i) == false)
+			{
+				cout << "Failed to load " << arrMaps[i] << endl;
+				return false;
+			}
+		}
+		cMap2D->SetCurrentLevel(5);
+	}
+
+	cPlayer2D = CPlayer2D::GetInstance();
+	cPlayer2D->SetShader("Shader2D_Colour");
+	if (cPlayer2D->Init() == false)
+	{
+		cout << "Failed to load CPlayer2D" << endl;
+		return false;
+	}
+
+	cGameManager = CGameManager::GetInstance();
+	cGameManager->Init();
+
+	// Create the grids of the bullets to cover the map
+	cPlayerBulletGrid.Init(CSettings::GetInstance()->NUM_TILES_XAXIS, CSettings::GetInstance()->NUM_TILES_YAXIS);
+	cEnemyBulletGrid.Init(CSettings::GetInstance()->NUM_TILES_XAXIS, CSettings::GetInstance()->NUM_TILES_YAXIS);
+	cPlayer2D->SetBulletGrid(&cEnemyBulletGrid);
+
+	SpawnEnemies();
+	if (bGeneratedLevel)
+		SpawnBosses();
+	AddStressEntities();
+
+	return true;
+}
+
+/**
+@brief Update Step the world by one tick. When the player has lost or won, the player is reset and the rest
+	   of the tick is skipped, so that the caller can change the game state.
+@param dElapsedTime A const double variable containing the game time of the tick
+*/
+CWorld2D::OUTCOME CWorld2D::Update(const double dElapsedTime)
+{
+	PROFILE_ZONE("CWorld2D::Update");
+	MEMORY_TAG(SCENE);
+
+	// Record the inputs of this tick, or replace them with the recorded ones. A recording holds only the ticks
+	// of the world, so that the game and the HeadlessSimulation replay it from the same first tick.
+	CInputRecorder::GetInstance()->Tick();
+
+	worldTime += dElapsedTime;
+	worldTime1 += dElapsedTime;
+
+	cPlayer2D->Update(dElapsedTime);
+	cMap2D->Update(dElapsedTime);
+
+	if (cGameManager->bLevelCompleted)
+	{
+		cGameManager->bLevelCompleted = false;
+	}
+	// Debug keys, to go to the boss and to lose at once
+	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_L))
+	{
+		cMap2D->SetCurrentLevel(10);
+	}
+	if (CKeyboardController::GetInstance()->IsKeyPressed(GLFW_KEY_C))
+	{
+		cGameManager->bPlayerLost = true;
+	}
+
+	// The boss is in level 10 of the shipped maps
+	if ((bGeneratedLevel == false) && (cMap2D->GetCurrentLevel() == 10) && (spawnGhens == false))
+	{
+		ghens* G = new ghens();
+		G->SetShader("Shader2D_Colour");
+		if (G->Init())
+		{
+			G->SetPlayer2D(cPlayer2D);
+			G->SetBulletGrid(&cPlayerBulletGrid);
+			bossVector.push_back(G);
+		}
+		else
+		{
+			delete G;
+		}
+		spawnGhens = true;
+	}
+
+	for (size_t i = 0; i < bossVector.size(); i++)
+	{
+		if (bossVector[i]->corpse_arise == true)
+		{
+			SummonEnemies(bossVector[i]);
+		}
+	}
+	for (size_t i = 0; i < bossVector.size(); i++)
+	{
+		bossVector[i]->Update(dElapsedTime);
+	}
+
+	if (cGameManager->bPlayerLost)
+	{
+		cGameManager->bPlayerLost = false;
+		cPlayer2D->Reset();
+		return PLAYER_LOST;
+	}
+	if (cGameManager->bPlayerWon)
+	{
+		cGameManager->bPlayerWon = false;
+		cPlayer2D->Reset();
+		return PLAYER_WON;
+	}
+
+	// Collect the bullets fired by the player, the bosses and the enemies
+	for (size_t i = 0; i < cPlayer2D->pBullet.size(); i++)
+	{
+		bulletVector.push_back(cPlayer2D->pBullet[i]);
+	}
+	cPlayer2D->pBullet.clear();
+	for (size_t i = 0; i < bossVector.size(); i++)
+	{
+		for (size_t j = 0; j < bossVector[i]->eBullet.size(); j++)
+		{
+			bulletVector.push_back(bossVector[i]->eBullet[j]);
+		}
+		bossVector[i]->eBullet.clear();
+	}
+	for (size_t i = 0; i < enemyVector.size(); i++)
+	{
+		for (size_t j = 0; j < enemyVector[i]->eBullet.size(); j++)
+		{
+			bulletVector.push_back(enemyVector[i]->eBullet[j]);
+		}
+		enemyVector[i]->eBullet.clear();
+	}
+
+	// The enemies look up the player's bullets around them in this grid
+	UpdatePlayerBulletGrid();
+
+	// Update the enemies in parallel. They only read the player and the mouse from the snapshot,
+	// and record their changes to the world as intents instead of making them.
+	UpdateEnemyWorldSnapshot();
+	CJobSystem::GetInstance()->ParallelFor(0, (int)enemyVector.size(), 0, [this, dElapsedTime](const int iBegin, const int iEnd)
+	{
+		PROFILE_COUNTERS("CWorld2D::UpdateEnemies");
+		for (int i = iBegin; i < iEnd; i++)
+		{
+			enemyVector[i]->Update(dElapsedTime);
+		}
+	});
+	// Then apply the intents in the order of the enemies, so that the result does not depend on the threads
+	for (size_t i = 0; i < enemyVector.size(); i++)
+	{
+		enemyVector[i]->ApplyIntents();
+	}
+	{
+		PROFILE_COUNTERS("UpdateBullets");
+		MEMORY_TAG(BULLETS);
+		for (size_t i = 0; i < bulletVector.size(); i++)
+		{
+			bulletVector[i]->Update(dElapsedTime);
+		}
+	}
+
+	// The player looks up the enemies' bullets around it in this grid during the next update
+	UpdateEnemyBulletGrid();
+
+	// Find the paths requested during this update. The entities get them in the next update.
+	cPathFindingService->Update();
+
+	if (worldTime >= 15) //change this to set how long you want it to take to 1 hour ( worldtime = 1 means every 1 sec 1 hour passes)
+	{
+		hunger++;
+		clock++;
+
+		if (clock == 24)
+		{
+			clock = 0;
+		}
+		worldTime = 0;
+	}
+	if (hunger >= 1)
+	{
+		cPlayer2D->fuelTime();
+		hunger = 0;
+	}
+
+	if (worldTime1 >= 10 && cMap2D->GetCurrentLevel() != 10)//change this to see how fast you want enemy to be spawn
+	{
+		CRandom& cRandom = CRandomService::GetInstance()->GetStream(CRandomService::SPAWN);
+		for (size_t i = 0; i < 2; i++)
+		{
+			while (true)
+			{
+				glm::vec2 asd;
+				asd.x = cRandom.Range((int)CSettings::GetInstance()->NUM_TILES_XAXIS);
+
+				asd.y = cRandom.Range((int)CSettings::GetInstance()->NUM_TILES_YAXIS);
+
+				if (cMap2D->GetMapInfo(asd.y, asd.x) == 0)
+				{
+					if (spawnable == true)
+					{
+						// More kinds of enemies are out at night
+						if (clock >= 18 || clock <= 6)
+						{
+							random_enemy_spawn = cRandom.Range(4); // 0 1 2 3
+						}
+						else
+						{
+							random_enemy_spawn = cRandom.Range(2); // 0 1
+						}
+						const int arrEnemyTiles[] = { 401, 400, 302, 301 };
+						cMap2D->SetMapInfo(asd.y, asd.x, arrEnemyTiles[random_enemy_spawn]);
+						enemies_spawnned++;
+					}
+
+					SpawnEnemies();
+					break;
+				}
+			}
+		}
+		worldTime1 = 0;
+	}
+
+	// The items dropped by the player
+	for (size_t i = 0; i < cPlayer2D->DropId.size(); i++)
+	{
+		for (int j = 0; j < cPlayer2D->DropId[i].second; j++)
+		{
+			cMap2D->SetMapInfo(cPlayer2D->vec2Index.y, cPlayer2D->vec2Index.x, cPlayer2D->DropId[i].first);
+			PickUP* cPU = new PickUP();
+			cPU->SetShader("Shader2D_Colour");
+			if (cPU->Init())
+			{
+				cPU->SetPlayer2D(cPlayer2D);
+				Pick.push_back(cPU);
+			}
+			else
+			{
+				delete cPU;
+			}
+		}
+	}
+	cPlayer2D->DropId.clear();
+
+	if (!bossVector.empty())
+	{
+		cPlayer2D->bossHp = bossVector.front()->hp;
+	}
+
+	for (size_t i = 0; i < Pick.size(); i++)
+	{
+		Pick[i]->Update(dElapsedTime);
+	}
+
+	// Change the map when the player walks off an edge. A generated level has no neighbours.
+	if (bGeneratedLevel == false)
+	{
+		const int iNumCols = (int)CSettings::GetInstance()->NUM_TILES_XAXIS;
+		const int iNumRows = (int)CSettings::GetInstance()->NUM_TILES_YAXIS;
+		//left & right
+		if (cPlayer2D->vec2Index.x >= iNumCols - 1)
+		{
+			cMap2D->SetCurrentLevel(cMap2D->GetCurrentLevel() + 1);
+			cPlayer2D->vec2Index.x = 1;
+			DeactivateEntities();
+		}
+		else if (cPlayer2D->vec2Index.x <= 0)
+		{
+			cMap2D->SetCurrentLevel(cMap2D->GetCurrentLevel() - 1);
+			cPlayer2D->vec2Index.x = iNumCols - 2;
+			DeactivateEntities();
+		}
+		//up and down
+		if (cPlayer2D->vec2Index.y >= iNumRows - 1)
+		{
+			cMap2D->SetCurrentLevel(cMap2D->GetCurrentLevel() - 3);
+			cPlayer2D->vec2Index.y = 1;
+			DeactivateEntities();
+		}
+		else if (cPlayer2D->vec2Index.y <= 0)
+		{
+			cMap2D->SetCurrentLevel(cMap2D->GetCurrentLevel() + 3);
+			cPlayer2D->vec2Index.y = iNumRows - 2;
+			DeactivateEntities();
+		}
+	}
+	if (cPlayer2D->portal == true)
+	{
+		cPlayer2D->portal = false;
+		DeactivateEntities();
+	}
+
+	return RUNNING;
+}
+
+/**
+@brief RenderEntities Render the player and the entities into the CSpriteBatch, which the caller begins and ends
+*/
+void CWorld2D::RenderEntities(void)
+{
+	CSpriteBatch* cSpriteBatch = CSpriteBatch::GetInstance();
+
+	cSpriteBatch->SetLayer(0);
+	cPlayer2D->PreRender();
+
+	cPlayer2D->Render();
+
+	cPlayer2D->PostRender();
+
+	cSpriteBatch->SetLayer(1);
+	for (size_t i = 0; i < bossVector.size(); i++)
+	{
+		bossVector[i]->PreRender();
+
+		bossVector[i]->Render();
+
+		bossVector[i]->PostRender();
+	}
+
+	cSpriteBatch->SetLayer(2);
+	for (size_t i = 0; i < enemyVector.size(); i++)
+	{
+		enemyVector[i]->PreRender();
+
+		enemyVector[i]->Render();
+
+		enemyVector[i]->PostRender();
+	}
+	cSpriteBatch->SetLayer(3);
+	for (size_t i = 0; i < Pick.size(); i++)
+	{
+		Pick[i]->PreRender();
+
+		Pick[i]->Render();
+
+		Pick[i]->PostRender();
+	}
+	cSpriteBatch->SetLayer(4);
+	for (size_t i = 0; i < bulletVector.size(); i++)
+	{
+		bulletVector[i]->PreRender();
+
+		bulletVector[i]->Render();
+
+		bulletVector[i]->PostRender();
+	}
+}
+
+/**
+@brief Destroy the entities and the singletons created by Init()
+*/
+void CWorld2D::Destroy(void)
+{
+	// The bullets fired during the last tick are still held by the enemies
+	for (size_t i = 0; i < enemyVector.size(); i++)
+	{
+		for (size_t j = 0; j < enemyVector[i]->eBullet.size(); j++)
+		{
+			delete enemyVector[i]->eBullet[j];
+		}
+		delete enemyVector[i];
+	}
+	enemyVector.clear();
+	for (size_t i = 0; i < bulletVector.size(); i++)
+	{
+		delete bulletVector[i];
+	}
+	bulletVector.clear();
+	for (size_t i = 0; i < Pick.size(); i++)
+	{
+		delete Pick[i];
+	}
+	Pick.clear();
+	// The bullets fired by the bosses during the last tick are still held by them
+	for (size_t i = 0; i < bossVector.size(); i++)
+	{
+		for (size_t j = 0; j < bossVector[i]->eBullet.size(); j++)
+		{
+			delete bossVector[i]->eBullet[j];
+		}
+		delete bossVector[i];
+	}
+	bossVector.clear();
+
+	// The paths still being found refer to the map, so the service goes first
+	if (cPathFindingService)
+	{
+		cPathFindingService->Destroy();
+		cPathFindingService = NULL;
+	}
+	if (cPlayer2D)
+	{
+		cPlayer2D->Destroy();
+		cPlayer2D = NULL;
+	}
+	if (cGameManager)
+	{
+		cGameManager->Destroy();
+		cGameManager = NULL;
+	}
+	if (cMap2D)
+	{
+		cMap2D->Destroy();
+		cMap2D = NULL;
+	}
+}
+
+/**
+@brief Get the hour of the day
+*/
+int CWorld2D::GetClock(void) const
+{
+	return (int)clock;
+}
+
+/**
+@brief Get the number of active enemies
+*/
+int CWorld2D::GetNumActiveEnemies(void) const
+{
+	int iCount = 0;
+	for (size_t i = 0; i < enemyVector.size(); i++)
+	{
+		if (enemyVector[i]->bIsActive)
+			iCount++;
+	}
+	return iCount;
+}
+
+/**
+@brief Get the number of active bullets
+*/
+int CWorld2D::GetNumActiveBullets(void) const
+{
+	int iCount = 0;
+	for (size_t i = 0; i < bulletVector.size(); i++)
+	{
+		if (bulletVector[i]->bIsActive)
+			iCount++;
+	}
+	return iCount;
+}
+
+/**
+@brief Get the number of active pickups
+*/
+int CWorld2D::GetNumActivePickUps(void) const
+{
+	int iCount = 0;
+	for (size_t i = 0; i < Pick.size(); i++)
+	{
+		if (Pick[i]->bIsActive)
+			iCount++;
+	}
+	return iCount;
+}
+
+/**
+@brief Create the enemies for the enemy tiles in the current map. CEnemy2D::Init() fails when there are none left.
+*/
+void CWorld2D::SpawnEnemies(void)
+{
+	while (true)
+	{
+		CEnemy2D* cE = new CEnemy2D();
+		cE->SetShader("Shader2D_Colour");
+		if (cE->Init() == false)
+		{
+			delete cE;
+			break;
+		}
+		cE->SetPlayer2D(cPlayer2D);
+		cE->SetBulletGrid(&cPlayerBulletGrid);
+		cE->SetWorldSnapshot(&sEnemyWorldSnapshot);
+		enemyVector.push_back(cE);
+	}
+}
+
+/**
+@brief Create the bosses for the boss tiles in the current map
+*/
+void CWorld2D::SpawnBosses(void)
+{
+	while (true)
+	{
+		ghens* G = new ghens();
+		G->SetShader("Shader2D_Colour");
+		if (G->Init() == false)
+		{
+			delete G;
+			break;
+		}
+		G->SetPlayer2D(cPlayer2D);
+		G->SetBulletGrid(&cPlayerBulletGrid);
+		bossVector.push_back(G);
+	}
+}
+
+/**
+@brief Raise an enemy on a random empty tile while the boss has summoned no more than the player has killed
+@param G A ghens* variable containing the boss which summons them
+*/
+void CWorld2D::SummonEnemies(ghens* G)
+{
+	CRandom& cRandom = CRandomService::GetInstance()->GetStream(CRandomService::BOSS);
+
+	if (G->summoned <= cPlayer2D->enemies_unalived)
+	{
+		glm::vec2 corpse_tile;
+		corpse_tile.x = cRandom.Range((int)CSettings::GetInstance()->NUM_TILES_XAXIS);
+
+		corpse_tile.y = cRandom.Range((int)CSettings::GetInstance()->NUM_TILES_YAXIS);
+
+		if (cMap2D->GetMapInfo(corpse_tile.y, corpse_tile.x) == 0)
+		{
+			const int rand_enemy = cRandom.Range(2);
+			cMap2D->SetMapInfo(corpse_tile.y, corpse_tile.x, (rand_enemy == 0) ? 302 : 301);
+			G->summoned++;
+
+			SpawnEnemies();
+		}
+	}
+	G->summonDone = true;
+}
+
+/**
+@brief Place the extra enemies, bullets and pickups of a stress scene on random empty tiles of the current map.
+	   The bullets are fired at the player. Nothing is placed unless they are set in CSettings.
+*/
+void CWorld2D::AddStressEntities(void)
+{
+	CSettings* cSettings = CSettings::GetInstance();
+	CRandom& cRandom = CRandomService::GetInstance()->GetStream(CRandomService::SPAWN);
+
+	// The two kinds of enemies which are out during the day
+	for (unsigned int i = 0; i < cSettings->iStressEnemies; i++)
+	{
+		cMap2D->PlaceOnEmptyTiles((i % 2 == 0) ? 302 : 301, 1, cRandom);
+	}
+	SpawnEnemies();
+
+	for (unsigned int i = 0; i < cSettings->iStressBullets; i++)
+	{
+		if (cMap2D->PlaceOnEmptyTiles(372, 1, cRandom) == 0)
+			break;
+		bullet* p = new bullet();
+		p->SetShader("Shader2D_Colour");
+		p->Init();
+		p->des = cPlayer2D->vec2Index;
+		bulletVector.push_back(p);
+	}
+
+	cMap2D->PlaceOnEmptyTiles(1100, cSettings->iStressPickUps, cRandom);
+	while (true)
+	{
+		PickUP* cPU = new PickUP();
+		cPU->SetShader("Shader2D_Colour");
+		if (cPU->Init() == false)
+		{
+			delete cPU;
+			break;
+		}
+		cPU->SetPlayer2D(cPlayer2D);
+		Pick.push_back(cPU);
+	}
+}
+
+/**
+@brief Set all the enemies, bullets and pickups to inactive when the player leaves the map
+*/
+void CWorld2D::DeactivateEntities(void)
+{
+	for (size_t i = 0; i < Pick.size(); i++)
+	{
+		Pick[i]->bIsActive = false;
+	}
+	for (size_t i = 0; i < enemyVector.size(); i++)
+	{
+		enemyVector[i]->bIsActive = false;
+	}
+	for (size_t i = 0; i < bulletVector.size(); i++)
+	{
+		bulletVector[i]->bIsActive = false;
+	}
+}
+
+/**
+@brief UpdatePlayerBulletGrid Insert the active bullets of the player into the grid
+*/
+void CWorld2D::UpdatePlayerBulletGrid(void)
+{
+	cPlayerBulletGrid.Clear();
+	for (size_t i = 0; i < bulletVector.size(); i++)
+	{
+		if ((bulletVector[i]->bIsActive) && (bulletVector[i]->player == true))
+		{
+			cPlayerBulletGrid.Insert(bulletVector[i]->vec2Index, bulletVector[i]);
+		}
+	}
+}
+
+/**
+@brief UpdateEnemyBulletGrid Insert the active bullets of the enemies into the grid
+*/
+void CWorld2D::UpdateEnemyBulletGrid(void)
+{
+	cEnemyBulletGrid.Clear();
+	for (size_t i = 0; i < bulletVector.size(); i++)
+	{
+		if ((bulletVector[i]->bIsActive) && (bulletVector[i]->player == false))
+		{
+			cEnemyBulletGrid.Insert(bulletVector[i]->vec2Index, bulletVector[i]);
+		}
+	}
+}
+
+/**
+@brief UpdateEnemyWorldSnapshot Copy the state of the player and the mouse which the enemies read during their update.
+	   In a headless run, the mouse stays where it is and is never down, unless it is replayed.
+*/
+void CWorld2D::UpdateEnemyWorldSnapshot(void)
+{
+	sEnemyWorldSnapshot.vec2PlayerIndex = cPlayer2D->vec2Index;
+	sEnemyWorldSnapshot.bPlayerIframe = cPlayer2D->getIframe();
+	sEnemyWorldSnapshot.fPlayerDmg = cPlayer2D->getDmg();
+
+	// Convert the mouse position from the window to the tiles
+	CMouseController* cMouseController = CMouseController::GetInstance();
+	CSettings* cSettings = CSettings::GetInstance();
+	sEnemyWorldSnapshot.vec2MousePos.x = cMouseController->GetMousePositionX() / cSettings->iWindowWidth * cSettings->NUM_TILES_XAXIS;
+	sEnemyWorldSnapshot.vec2MousePos.y = cSettings->NUM_TILES_YAXIS - (cMouseController->GetMousePositionY() / cSettings->iWindowHeight * cSettings->NUM_TILES_YAXIS);
+	sEnemyWorldSnapshot.bMouseButtonDown = cMouseController->IsButtonDown(0);
+}
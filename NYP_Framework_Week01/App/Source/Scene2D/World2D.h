@@ -0,0 +1,126 @@
+/**
+ CWorld2D
+ @brief A class which holds and steps the world of the Scene2D: the map, the player, the enemies, the bullets,
+		the pickups and the bosses. CScene2D draws it with the GUI and the sound, and CHeadlessSimulation
+		steps it without a window, so that both run the same game logic.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include GLM
+#include <includes/glm.hpp>
+
+#include <string>
+#include <vector>
+
+#include "Map2D.h"
+#include "Player2D.h"
+#include "GameManager.h"
+#include "Enemy2D.h"
+#include "bullet.h"
+#include "ghens.h"
+#include "PickUP.h"
+#include "SpatialHash2D.h"
+#include "PathFindingService.h"
+
+class CWorld2D
+{
+public:
+	// The result of a step of the world
+	enum OUTCOME
+	{
+		RUNNING = 0,
+		PLAYER_LOST,
+		PLAYER_WON
+	};
+
+	// Constructor
+	CWorld2D(void);
+
+	// Destructor
+	virtual ~CWorld2D(void);
+
+	// Init with the shipped maps, or with a level of any size which has no neighbours
+	bool Init(const std::string& levelFilename = "");
+
+	// Step the world by one tick
+	OUTCOME Update(const double dElapsedTime);
+
+	// Render the player and the entities into the CSpriteBatch, in layers to keep the drawing order
+	void RenderEntities(void);
+
+	// Destroy the entities and the singletons created by Init()
+	void Destroy(void);
+
+	// Get the hour of the day
+	int GetClock(void) const;
+
+	// Get the number of active enemies, bullets and pickups
+	int GetNumActiveEnemies(void) const;
+	int GetNumActiveBullets(void) const;
+	int GetNumActivePickUps(void) const;
+
+	float worldTime;
+
+	float worldTime1;
+
+	float clock;
+
+	int hunger;
+
+	int enemies_spawnned;
+
+	int random_enemy_spawn;
+
+	bool spawnable;
+
+protected:
+	// Create the enemies for the enemy tiles in the current map. CEnemy2D::Init() fails when there are none left.
+	void SpawnEnemies(void);
+
+	// Create the bosses for the boss tiles in the current map
+	void SpawnBosses(void);
+
+	// Raise the enemies which a boss summons from the corpses
+	void SummonEnemies(ghens* G);
+
+	// Place the extra enemies, bullets and pickups of a stress scene, which are set in CSettings
+	void AddStressEntities(void);
+
+	// Set all the enemies, bullets and pickups to inactive when the player leaves the map
+	void DeactivateEntities(void);
+
+	// Insert the active bullets of the player into the grid
+	void UpdatePlayerBulletGrid(void);
+
+	// Insert the active bullets of the enemies into the grid
+	void UpdateEnemyBulletGrid(void);
+
+	// Copy the state of the player and the mouse into sEnemyWorldSnapshot
+	void UpdateEnemyWorldSnapshot(void);
+
+	CMap2D* cMap2D;
+	CPlayer2D* cPlayer2D;
+	CGameManager* cGameManager;
+	CPathFindingService* cPathFindingService;
+
+	std::vector<CEnemy2D*> enemyVector;
+	std::vector<bullet*> bulletVector;
+	std::vector<PickUP*> Pick;
+	// The boss of level 10 of the shipped maps, or the bosses of a generated level
+	std::vector<ghens*> bossVector;
+
+	// Whether the level is loaded from one file instead of the shipped maps
+	bool bGeneratedLevel;
+	// Whether the boss of level 10 has been created
+	bool spawnGhens;
+
+	// The grids of the active bullets, used for the hit tests. Only the bullets are in grids, as they are the only
+	// entities which are looked up by position: each enemy, pickup and boss only tests itself against the player.
+	CSpatialHash2D<bullet*> cPlayerBulletGrid;
+	CSpatialHash2D<bullet*> cEnemyBulletGrid;
+
+	// The state of the player and the mouse which the enemies read while they update in parallel
+	CEnemy2D::SWorldSnapshot sEnemyWorldSnapshot;
+};
@@ -10,21 +10,28 @@
 using namespace std;
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
+// Include Sprite Batch
+#include "RenderControl/SpriteBatch.h"
 // Include Mesh Builder
 #include "Primitives/MeshBuilder.h"
 
 // Include GLEW
 #include <GL/glew.h>
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "RenderControl/GLTelemetry.h"
 
 // Include ImageLoader
-#include "System\ImageLoader.h"
+#include "System/ImageLoader.h"
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
 // Include math.h
 #include <math.h>
 
+// Include CPathFindingService
+#include "PathFindingService.h"
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
@@ -45,6 +52,7 @@ bullet::bullet(void)
 
 	// Initialise vec2UVCoordinate
 	vec2UVCoordinate = glm::vec2(0.0f);
+	vec2PrevUVCoordinate = glm::vec2(0.0f);
 
 	i32vec2Destination = glm::i32vec2(0, 0);	// Initialise the iDestination
 	i32vec2Direction = glm::i32vec2(0, 0);		// Initialise the iDirection
@@ -151,6 +159,9 @@ void bullet::Update(const double dElapsedTime)
 	UpdatePosition();
 
 
+	// Keep the UV Coordinates of the tick before, to render between the ticks
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+
 	// Update the UV Coordinates
 	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, i32vec2NumMicroSteps.x*cSettings->MICRO_STEP_XAXIS);
 	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, i32vec2NumMicroSteps.y*cSettings->MICRO_STEP_YAXIS);
@@ -161,20 +172,7 @@ void bullet::Update(const double dElapsedTime)
  */
 void bullet::PreRender(void)
 {
-	if (!bIsActive)
-		return;
-
-
-
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-
-	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	// Activate the shader
-	CShaderManager::GetInstance()->Use(sShaderName);
+	// The blending mode and the shader are set up by CSpriteBatch when it draws this frame's sprites
 }
 
 /**
@@ -185,29 +183,11 @@ void bullet::Render(void)
 	if (!bIsActive)
 		return;
 
-	glBindVertexArray(VAO);
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
-	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
-		vec2UVCoordinate.y,
-		0.0f));
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-	glUniform4fv(colorLoc, 1, glm::value_ptr(runtimeColour));
-
-	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-
-	// Render the tile
-	//glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-	quadMesh->Render();
-
-	glBindVertexArray(0);
-
+	// Submit this bullet to the sprite batch, which draws it with the other sprites using the same texture
+	CSpriteBatch::GetInstance()->Submit(iTextureID,
+										InterpolateUVCoordinate(vec2PrevUVCoordinate, vec2UVCoordinate),
+										glm::vec2(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT),
+										runtimeColour);
 }
 
 /**
@@ -215,12 +195,7 @@ void bullet::Render(void)
  */
 void bullet::PostRender(void)
 {
-	if (!bIsActive)
-		return;
-
-
-	// Disable blending
-	glDisable(GL_BLEND);
+	// The blending mode is disabled by CSpriteBatch after it draws this frame's sprites
 }
 
 /**
@@ -245,6 +220,22 @@ void bullet::Seti32vec2NumMicroSteps(const int iNumMicroSteps_XAxis, const int i
 	this->i32vec2NumMicroSteps.y = iNumMicroSteps_YAxis;
 }
 
+/**
+@brief Get the indices of the enemy2D
+*/
+glm::vec2 bullet::Geti32vec2Index(void) const
+{
+	return vec2Index;
+}
+
+/**
+@brief Get the number of microsteps of the enemy2D
+*/
+glm::vec2 bullet::Geti32vec2NumMicroSteps(void) const
+{
+	return i32vec2NumMicroSteps;
+}
+
 /**
  @brief Set the handle to cPlayer to this class instance
  @param cPlayer2D A CPlayer2D* variable which contains the pointer to the CPlayer2D instance
@@ -642,14 +633,24 @@ void bullet::UpdatePosition(void)
 }
 void bullet::ShortCutPath(glm::vec2 des)
 {
-	auto path = cMap2D->PathFind(vec2Index,
-		des,
-		heuristic::euclidean,
-		10);
+	// Ask for a path to the destination, unless one is still being found
+	if (pathFuture.valid() == false)
+	{
+		pathFuture = CPathFindingService::GetInstance()->Request(uiEntityID,
+			vec2Index,
+			des,
+			heuristic::EUCLIDEAN,
+			10);
+	}
+
+	// Keep to the destination of the previous path until the new path arrives
+	if (pathFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return;
+	auto path = pathFuture.get();
 
 	// Calculate new destination
 	bool bFirstPosition = true;
-	for (const auto& coord : path)
+	for (const glm::vec2 coord : path)
 	{
 		//std::cout << coord.x << "," << coord.y << "\n";
 		if (bFirstPosition == true)
@@ -672,3 +673,21 @@ void bullet::ShortCutPath(glm::vec2 des)
 		}
 	}
 }
+
+/**
+ @brief Add the state of this bullet to a checksum of the world
+ @param cChecksum A CChecksum& variable containing the checksum
+ */
+void bullet::AddToChecksum(CChecksum& cChecksum) const
+{
+	cChecksum.Add(bIsActive);
+	// An inactive entity is never active again, so the rest of its state does not matter
+	if (!bIsActive)
+		return;
+
+	cChecksum.Add(player);
+	cChecksum.Add(boss);
+	cChecksum.Add(vec2Index);
+	cChecksum.Add(i32vec2NumMicroSteps);
+	cChecksum.Add(des);
+}
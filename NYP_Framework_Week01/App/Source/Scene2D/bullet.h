@@ -7,7 +7,7 @@
 #pragma once
 
 // Include shader
-#include "RenderControl\shader.h"
+#include "RenderControl/Shader.h"
 
 // Include GLM
 #include <includes/glm.hpp>
@@ -21,7 +21,14 @@
 class CMap2D;
 
 // Include Settings
-#include "GameControl\Settings.h"
+#include "GameControl/Settings.h"
+
+// Include CChecksum
+#include "System/Checksum.h"
+
+#include <future>
+// Include CMap2D for the SPath which CPathFindingService finds
+#include "Map2D.h"
 
 // Include Physics2D
 #include "Physics2D.h"
@@ -71,6 +78,9 @@ public:
 	// Set the UV coordinates of the enemy2D
 	glm::vec2 Getvec2UVCoordinates(void) const;
 
+	// Add the state of this bullet to a checksum of the world
+	void AddToChecksum(CChecksum& cChecksum) const;
+
 	// Set the handle to cPlayer to this class instance
 
 	bool boss = false;
@@ -113,6 +123,8 @@ protected:
 
 	// The vec2 variable which stores the UV coordinates to render the enemy2D
 	glm::vec2 vec2UVCoordinate;
+	// The UV coordinates of the bullet in the tick before, so that it is drawn between its last two positions
+	glm::vec2 vec2PrevUVCoordinate;
 
 	// The vec2 which stores the indices of the destination for enemy2D in the Map2D
 	glm::vec2 i32vec2Destination;
@@ -154,6 +166,8 @@ protected:
 	void UpdatePosition(void);
 
 	void ShortCutPath(glm::vec2 des);
+	// The path which CPathFindingService is finding for ShortCutPath()
+	std::future<SPath> pathFuture;
 
 
 	//myStuff;
@@ -6,25 +6,37 @@
  */
 #include "ghens.h"
 
+// Include CProfiler to time the zones of the frame
+#include "TimeControl/Profiler.h"
+// Include CMemoryTracker to count the allocations of the frame
+#include "System/MemoryTracker.h"
+
 #include <iostream>
 using namespace std;
 
 // Include Shader Manager
-#include "RenderControl\ShaderManager.h"
+#include "RenderControl/ShaderManager.h"
+// Include Sprite Batch
+#include "RenderControl/SpriteBatch.h"
 // Include Mesh Builder
 #include "Primitives/MeshBuilder.h"
 
 // Include GLEW
 #include <GL/glew.h>
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "RenderControl/GLTelemetry.h"
 
 // Include ImageLoader
-#include "System\ImageLoader.h"
+#include "System/ImageLoader.h"
 
 // Include the Map2D as we will use it to check the player's movements and actions
 #include "Map2D.h"
 // Include math.h
 #include <math.h>
 
+// Include CPathFindingService
+#include "PathFindingService.h"
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
@@ -33,6 +45,7 @@ ghens::ghens(void)
 	, cMap2D(NULL)
 	, cSettings(NULL)
 	, cPlayer2D(NULL)
+	, cBulletGrid(NULL)
 	, sCurrentFSM(FSM::IDLE)
 	, iFSMCounter(0)
 	, quadMesh(NULL)
@@ -47,6 +60,7 @@ ghens::ghens(void)
 
 	// Initialise vec2UVCoordinate
 	vec2UVCoordinate = glm::vec2(0.0f);
+	vec2PrevUVCoordinate = glm::vec2(0.0f);
 
 	i32vec2Destination = glm::i32vec2(0, 0);	// Initialise the iDestination
 	i32vec2Direction = glm::i32vec2(0, 0);		// Initialise the iDirection
@@ -67,6 +81,9 @@ ghens::~ghens(void)
 	// We won't delete this since it was created elsewhere
 	cPlayer2D = NULL;
 
+	// We won't delete this since it was created elsewhere
+	cBulletGrid = NULL;
+
 	// We won't delete this since it was created elsewhere
 	cMap2D = NULL;
 
@@ -123,6 +140,8 @@ bool ghens::Init(void)
 	// If this class is initialised properly, then set the bIsActive to true
 	bIsActive = true;
 
+	cRandom = CRandomService::GetInstance()->CreateEntityStream();
+
 	SetEscape();
 
 	return true;
@@ -133,10 +152,12 @@ bool ghens::Init(void)
  */
 void ghens::Update(const double dElapsedTime)
 {
-
 	if (!bIsActive)
 		return;
 
+	PROFILE_ZONE("ghens::Update");
+	MEMORY_TAG(ENTITIES);
+
 	if (hp <= 0)
 	{
 		/*cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 20);*/
@@ -170,12 +191,12 @@ void ghens::Update(const double dElapsedTime)
 				}
 				else
 				{
-					random_move = rand() % 4; // 0 Pulse 1 Erupt 2 Teleport 3 Summon
+					random_move = cRandom.Range(4); // 0 Pulse 1 Erupt 2 Teleport 3 Summon
 				}
 			}
 			else //not critical hp zone
 			{
-				random_move = rand() % 3; // 0 Pulse 1 Erupt 2 Teleport
+				random_move = cRandom.Range(3); // 0 Pulse 1 Erupt 2 Teleport
 			}
 
 			switch (random_move)
@@ -209,7 +230,7 @@ void ghens::Update(const double dElapsedTime)
 		{
 			//shoot
 
-			int shoottype = rand() % 3; // 0 for + direction | 1 for X direction | 2 for all directions
+			int shoottype = cRandom.Range(3); // 0 for + direction | 1 for X direction | 2 for all directions
 
 			if (shoottype == 0) // +
 			{
@@ -242,6 +263,7 @@ void ghens::Update(const double dElapsedTime)
 					}
 
 					cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 372);
+					MEMORY_TAG(BULLETS);
 					bullet* p = new bullet();
 					p->SetShader("Shader2D_Colour");
 					p->Init();
@@ -265,23 +287,24 @@ void ghens::Update(const double dElapsedTime)
 
 					else if (i == 1)
 					{
-						shootdes.x = 31;
+						shootdes.x = cSettings->NUM_TILES_XAXIS - 1;
 						shootdes.y = 0;
 					}
 
 					else if (i == 2)
 					{
-						shootdes.x = 31;
-						shootdes.y = 23;
+						shootdes.x = cSettings->NUM_TILES_XAXIS - 1;
+						shootdes.y = cSettings->NUM_TILES_YAXIS - 1;
 					}
 
 					else
 					{
 						shootdes.x = 0;
-						shootdes.y = 23;
+						shootdes.y = cSettings->NUM_TILES_YAXIS - 1;
 					}
 					
 					cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 372);
+					MEMORY_TAG(BULLETS);
 					bullet* p = new bullet();
 					p->SetShader("Shader2D_Colour");
 					p->Init();
@@ -304,20 +327,20 @@ void ghens::Update(const double dElapsedTime)
 
 					else if (i == 1)
 					{
-						shootdes.x = 31;
+						shootdes.x = cSettings->NUM_TILES_XAXIS - 1;
 						shootdes.y = 0;
 					}
 
 					else if (i == 2)
 					{
-						shootdes.x = 31;
-						shootdes.y = 23;
+						shootdes.x = cSettings->NUM_TILES_XAXIS - 1;
+						shootdes.y = cSettings->NUM_TILES_YAXIS - 1;
 					}
 
 					else if (i == 3)
 					{
 						shootdes.x = 0;
-						shootdes.y = 23;
+						shootdes.y = cSettings->NUM_TILES_YAXIS - 1;
 					}
 
 					else if (i == 4)
@@ -345,6 +368,7 @@ void ghens::Update(const double dElapsedTime)
 					}
 
 					cMap2D->SetMapInfo(vec2Index.y, vec2Index.x, 372);
+					MEMORY_TAG(BULLETS);
 					bullet* p = new bullet();
 					p->SetShader("Shader2D_Colour");
 					p->Init();
@@ -370,8 +394,8 @@ void ghens::Update(const double dElapsedTime)
 		glm::vec2 temp;
 		if (eruptcount < 10)
 		{
-			rand_erupt_tile.x = rand() % 28 + 2;
-			rand_erupt_tile.y = rand() % 20 + 2;
+			rand_erupt_tile.x = cRandom.Range(2, 29);
+			rand_erupt_tile.y = cRandom.Range(2, 21);
 
 			cMap2D->SetMapInfo(rand_erupt_tile.y, rand_erupt_tile.x, 6);
 			erupt.push_back(rand_erupt_tile);
@@ -483,8 +507,8 @@ void ghens::Update(const double dElapsedTime)
 			if (tptime >= 0.3)
 			{
 				glm::vec2 tp_tile;
-				tp_tile.x = rand() % 32;
-				tp_tile.y = rand() % 24;
+				tp_tile.x = cRandom.Range((int)cSettings->NUM_TILES_XAXIS);
+				tp_tile.y = cRandom.Range((int)cSettings->NUM_TILES_YAXIS);
 				if (cMap2D->GetMapInfo(tp_tile.y, tp_tile.x) == 0)
 				{
 					vec2Index = tp_tile;
@@ -507,6 +531,9 @@ void ghens::Update(const double dElapsedTime)
 	// Update Jump or Fall
 	UpdateJumpFall(dElapsedTime);
 	InteractWithPlayer();
+	// Keep the UV Coordinates of the tick before, to render between the ticks
+	vec2PrevUVCoordinate = vec2UVCoordinate;
+
 	// Update the UV Coordinates
 	vec2UVCoordinate.x = cSettings->ConvertIndexToUVSpace(cSettings->x, vec2Index.x, false, i32vec2NumMicroSteps.x*cSettings->MICRO_STEP_XAXIS);
 	vec2UVCoordinate.y = cSettings->ConvertIndexToUVSpace(cSettings->y, vec2Index.y, false, i32vec2NumMicroSteps.y*cSettings->MICRO_STEP_YAXIS);
@@ -517,18 +544,7 @@ void ghens::Update(const double dElapsedTime)
  */
 void ghens::PreRender(void)
 {
-	if (!bIsActive)
-		return;
-
-	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
-
-	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	// Activate the shader
-	CShaderManager::GetInstance()->Use(sShaderName);
+	// The blending mode and the shader are set up by CSpriteBatch when it draws this frame's sprites
 }
 
 /**
@@ -539,29 +555,11 @@ void ghens::Render(void)
 	if (!bIsActive)
 		return;
 
-	glBindVertexArray(VAO);
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	unsigned int colorLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "runtimeColour");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-
-	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
-	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
-		vec2UVCoordinate.y,
-		0.0f));
-	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
-	glUniform4fv(colorLoc, 1, glm::value_ptr(runtimeColour));
-
-	// Get the texture to be rendered
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-
-	// Render the tile
-	//glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-	quadMesh->Render();
-
-	glBindVertexArray(0);
-
+	// Submit this boss to the sprite batch, which draws it with the other sprites using the same texture
+	CSpriteBatch::GetInstance()->Submit(iTextureID,
+										InterpolateUVCoordinate(vec2PrevUVCoordinate, vec2UVCoordinate),
+										glm::vec2(cSettings->TILE_WIDTH, cSettings->TILE_HEIGHT),
+										runtimeColour);
 }
 
 /**
@@ -569,11 +567,7 @@ void ghens::Render(void)
  */
 void ghens::PostRender(void)
 {
-	if (!bIsActive)
-		return;
-
-	// Disable blending
-	glDisable(GL_BLEND);
+	// The blending mode is disabled by CSpriteBatch after it draws this frame's sprites
 }
 
 /**
@@ -598,6 +592,22 @@ void ghens::Seti32vec2NumMicroSteps(const int iNumMicroSteps_XAxis, const int iN
 	this->i32vec2NumMicroSteps.y = iNumMicroSteps_YAxis;
 }
 
+/**
+@brief Get the indices of the enemy2D
+*/
+glm::vec2 ghens::Geti32vec2Index(void) const
+{
+	return vec2Index;
+}
+
+/**
+@brief Get the number of microsteps of the enemy2D
+*/
+glm::vec2 ghens::Geti32vec2NumMicroSteps(void) const
+{
+	return i32vec2NumMicroSteps;
+}
+
 /**
  @brief Set the handle to cPlayer to this class instance
  @param cPlayer2D A CPlayer2D* variable which contains the pointer to the CPlayer2D instance
@@ -610,6 +620,15 @@ void ghens::SetPlayer2D(CPlayer2D* cPlayer2D)
 	UpdateDirection();
 }
 
+/**
+ @brief Set the handle to the grid of the player's bullets to this class instance
+ @param cBulletGrid A CSpatialHash2D<bullet*>* variable which contains the pointer to the grid
+ */
+void ghens::SetBulletGrid(CSpatialHash2D<bullet*>* cBulletGrid)
+{
+	this->cBulletGrid = cBulletGrid;
+}
+
 void ghens::SetEscape()
 {
 	this->escapeDestination = this->vec2Index;
@@ -928,22 +947,28 @@ bool ghens::InteractWithPlayer(void)
 		sCurrentFSM = IDLE;
 		iFSMCounter = 0;
 	}
-	for (size_t i = 0; i < watchout.size(); i++)
+	// Check the player's bullets in the tiles around this enemy
+	if (cBulletGrid)
 	{
-		if (((vec2Index.x >= watchout[i]->vec2Index.x - .5) &&
-			(vec2Index.x <= watchout[i]->vec2Index.x + .5))
-			&&
-			((vec2Index.y >= watchout[i]->vec2Index.y - .5) &&
-				(vec2Index.y <= watchout[i]->vec2Index.y + .5)))
+		cBulletGrid->ForEachInRange(vec2Index, 0.5f, [&](bullet* cBullet)
 		{
-			hp -= cPlayer2D->getGunDmg();
-			watchout[i]->bIsActive = false;
-		}
+			if (cBullet->bIsActive == false)
+				return;
 
+			if (((vec2Index.x >= cBullet->vec2Index.x - .5) &&
+				(vec2Index.x <= cBullet->vec2Index.x + .5))
+				&&
+				((vec2Index.y >= cBullet->vec2Index.y - .5) &&
+					(vec2Index.y <= cBullet->vec2Index.y + .5)))
+			{
+				hp -= cPlayer2D->getGunDmg();
+				cBullet->bIsActive = false;
+			}
+		});
 	}
 
-	float posX = CMouseController::GetInstance()->GetMousePositionX() / cSettings->iWindowWidth * 32; //convert (0,800) to (0,80)
-	float posY = 24 - (CMouseController::GetInstance()->GetMousePositionY() / cSettings->iWindowHeight * 24);
+	float posX = CMouseController::GetInstance()->GetMousePositionX() / cSettings->iWindowWidth * cSettings->NUM_TILES_XAXIS; //convert (0,800) to (0,80)
+	float posY = cSettings->NUM_TILES_YAXIS - (CMouseController::GetInstance()->GetMousePositionY() / cSettings->iWindowHeight * cSettings->NUM_TILES_YAXIS);
 	glm::vec2 mousePos(posX, posY);
 
 	if ((mousePos.x > 0 && mousePos.x < cSettings->NUM_TILES_XAXIS - 1) && (mousePos.y > 0 && mousePos.y < cSettings->NUM_TILES_YAXIS - 1))
@@ -1177,14 +1202,24 @@ void ghens::UpdatePosition(void)
 
 void ghens::ShortCutPath(glm::vec2 des)
 {
-	auto path = cMap2D->PathFind(vec2Index,
-		des,
-		heuristic::euclidean,
-		10);
+	// Ask for a path to the destination, unless one is still being found
+	if (pathFuture.valid() == false)
+	{
+		pathFuture = CPathFindingService::GetInstance()->Request(uiEntityID,
+			vec2Index,
+			des,
+			heuristic::EUCLIDEAN,
+			10);
+	}
+
+	// Keep to the destination of the previous path until the new path arrives
+	if (pathFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return;
+	auto path = pathFuture.get();
 
 	// Calculate new destination
 	bool bFirstPosition = true;
-	for (const auto& coord : path)
+	for (const glm::vec2 coord : path)
 	{
 		//std::cout << coord.x << "," << coord.y << "\n";
 		if (bFirstPosition == true)
@@ -1206,4 +1241,24 @@ void ghens::ShortCutPath(glm::vec2 des)
 			//	break;
 		}
 	}
-}
\ No newline at end of file
+}
+
+/**
+ @brief Add the state of the boss to a checksum of the world
+ @param cChecksum A CChecksum& variable containing the checksum
+ */
+void ghens::AddToChecksum(CChecksum& cChecksum) const
+{
+	cChecksum.Add(bIsActive);
+	// An inactive entity is never active again, so the rest of its state does not matter
+	if (!bIsActive)
+		return;
+
+	cChecksum.Add(vec2Index);
+	cChecksum.Add(i32vec2NumMicroSteps);
+	cChecksum.Add(sCurrentFSM);
+	cChecksum.Add(hp);
+	cChecksum.Add(random_move);
+	cChecksum.Add(summoned);
+	cChecksum.Add(eruptcount);
+}
@@ -7,7 +7,7 @@
 #pragma once
 
 // Include shader
-#include "RenderControl\shader.h"
+#include "RenderControl/Shader.h"
 
 // Include GLM
 #include <includes/glm.hpp>
@@ -21,7 +21,17 @@
 class CMap2D;
 
 // Include Settings
-#include "GameControl\Settings.h"
+#include "GameControl/Settings.h"
+
+// Include CRandom
+#include "System/Random.h"
+
+// Include CChecksum
+#include "System/Checksum.h"
+
+#include <future>
+// Include CMap2D for the SPath which CPathFindingService finds
+#include "Map2D.h"
 
 // Include Physics2D
 #include "Physics2D.h"
@@ -31,6 +41,9 @@ class CMap2D;
 
 #include "bullet.h"
 
+// Include SpatialHash2D
+#include "SpatialHash2D.h"
+
 class ghens : public CEntity2D
 {
 public:
@@ -76,6 +89,9 @@ public:
 	// Set the handle to cPlayer to this class instance
 	void SetPlayer2D(CPlayer2D* cPlayer2D);
 
+	// Add the state of the boss to a checksum of the world
+	void AddToChecksum(CChecksum& cChecksum) const;
+
 
 	void SetEscape();
 	// boolean flag to indicate if this enemy is active
@@ -86,7 +102,8 @@ public:
 	vector<bullet*> eBullet;
 
 
-	vector<bullet*> watchout;
+	// Set the handle to the grid of the player's bullets
+	void SetBulletGrid(CSpatialHash2D<bullet*>* cBulletGrid);
 
 	int shotsfired = 0;
 
@@ -154,6 +171,8 @@ protected:
 
 	// The vec2 variable which stores the UV coordinates to render the enemy2D
 	glm::vec2 vec2UVCoordinate;
+	// The UV coordinates of the boss in the tick before, so that it is drawn between its last two positions
+	glm::vec2 vec2PrevUVCoordinate;
 
 	// The vec2 which stores the indices of the destination for enemy2D in the Map2D
 	glm::vec2 i32vec2Destination;
@@ -166,12 +185,18 @@ protected:
 	// Physics
 	CPhysics2D cPhysics2D;
 
+	// The random numbers of the boss
+	CRandom cRandom;
+
 	// Current color
 	glm::vec4 runtimeColour;
 
 	// Handle to the CPlayer2D
 	CPlayer2D* cPlayer2D;
 
+	// Handle to the grid of the player's bullets
+	CSpatialHash2D<bullet*>* cBulletGrid;
+
 	glm::vec2 escapeDestination;
 
 	
@@ -213,6 +238,8 @@ protected:
 	void UpdatePosition(void);
 
 	void ShortCutPath(glm::vec2 des);
+	// The path which CPathFindingService is finding for ShortCutPath()
+	std::future<SPath> pathFuture;
 
 
 	//myStuff;
@@ -24,19 +24,19 @@ CSoundController::CSoundController(void)
  */
 CSoundController::~CSoundController(void)
 {
-	// Iterate through the entityMap
-	for (std::map<int, CSoundInfo*>::iterator it = soundMap.begin(); it != soundMap.end(); ++it)
+	// Iterate through the soundRegistry
+	for (int iHandle = 0; iHandle < soundRegistry.GetNumHandles(); iHandle++)
 	{
-		// If the value/second was not deleted elsewhere, then delete it here
-		if (it->second != NULL)
+		// If the sound was not removed elsewhere, then delete it here
+		if (soundRegistry.IsValid(iHandle))
 		{
-			delete it->second;
-			it->second = NULL;
+			delete soundRegistry.Get(iHandle);
 		}
 	}
 
-	// Remove all elements in entityMap
-	soundMap.clear();
+	// Remove all elements in soundRegistry
+	soundRegistry.Clear();
+	soundHandles.clear();
 
 	// Since we have already dropped the ISoundSource, then we don't need to delete the cSoundEngine
 	//// Clear the sound engine
@@ -53,6 +53,10 @@ CSoundController::~CSoundController(void)
  */
 bool CSoundController::Init(void)
 {
+#ifdef HEADLESS
+	// There is no sound device in the HEADLESS build. Without a sound engine, no sound is loaded or played.
+	return true;
+#else
 	// Initialise the sound engine with default parameters
 	cSoundEngine = createIrrKlangDevice(ESOD_WIN_MM, ESEO_MULTI_THREADED);
 	if (cSoundEngine == NULL)
@@ -61,6 +65,7 @@ bool CSoundController::Init(void)
 		return false;
 	}
 	return true;
+#endif
 }
 
 /**
@@ -80,6 +85,9 @@ bool CSoundController::LoadSound(	string filename,
 									CSoundInfo::SOUNDTYPE eSoundType,
 									vec3df vec3dfSoundPos)
 {
+	if (cSoundEngine == NULL)
+		return false;
+
 	// Load the sound from the file
 	ISoundSource* pSoundSource = cSoundEngine->addSoundSourceFromFile(filename.c_str(),
 																	E_STREAM_MODE::ESM_NO_STREAMING, 
@@ -106,8 +114,14 @@ bool CSoundController::LoadSound(	string filename,
 	else
 		cSoundInfo->Init(ID, pSoundSource, bIsLooped, eSoundType, vec3dfSoundPos);
 
-	// Set to soundMap
-	soundMap[ID] = cSoundInfo;
+	// Set to soundRegistry, and keep its handle so that it can be played by ID without a search
+	const int iHandle = soundRegistry.Register(std::to_string(ID), cSoundInfo);
+	if (ID >= 0)
+	{
+		if (ID >= (int)soundHandles.size())
+			soundHandles.resize(ID + 1, CResourceRegistry<CSoundInfo*>::INVALID_HANDLE);
+		soundHandles[ID] = iHandle;
+	}
 
 	return true;
 }
@@ -118,6 +132,9 @@ bool CSoundController::LoadSound(	string filename,
  */
 void CSoundController::PlaySoundByID(const int ID)
 {
+	if (cSoundEngine == NULL)
+		return;
+
 	CSoundInfo* pSoundInfo = GetSound(ID);
 
 	if (!pSoundInfo)
@@ -152,6 +169,9 @@ void CSoundController::PlaySoundByID(const int ID)
  */
 bool CSoundController::MasterVolumeIncrease(void)
 {
+	if (cSoundEngine == NULL)
+		return false;
+
 	// Get the current volume
 	float fCurrentVolume = cSoundEngine->getSoundVolume() + 0.1f;
 	// Check if the maximum volume has been reached
@@ -171,6 +191,9 @@ bool CSoundController::MasterVolumeIncrease(void)
  */
 bool CSoundController::MasterVolumeDecrease(void)
 {
+	if (cSoundEngine == NULL)
+		return false;
+
 	// Get the current volume
 	float fCurrentVolume = cSoundEngine->getSoundVolume() - 0.1f;
 	// Check if the minimum volume has been reached
@@ -269,20 +292,17 @@ void CSoundController::SetListenerDirection(const float x, const float y, const
 }
 
 /**
- @brief Get an sound from this map
- @param ID A const int variable which will be the ID of the iSoundSource in the map
+ @brief Get an sound from this registry
+ @param ID A const int variable which will be the ID of the iSoundSource in the registry
  @return A CSoundInfo* variable
  */
 CSoundInfo* CSoundController::GetSound(const int ID)
 {
-	if (soundMap.count(ID) != 0)
-		return soundMap[ID];
-
-	return nullptr;
+	return soundRegistry.Get(GetSoundHandle(ID));
 }
 
 /**
- @brief Remove an sound from this map
+ @brief Remove an sound from this registry
  @param ID A const int variable which will be the ID of the iSoundSource in the map
  @return true if the sound was successfully removed, else false
  */
@@ -292,17 +312,40 @@ bool CSoundController::RemoveSound(const int ID)
 	if (pSoundInfo != nullptr)
 	{
 		delete pSoundInfo;
-		soundMap.erase(ID);
+		soundRegistry.Remove(GetSoundHandle(ID));
+		if ((ID >= 0) && (ID < (int)soundHandles.size()))
+			soundHandles[ID] = CResourceRegistry<CSoundInfo*>::INVALID_HANDLE;
 		return true;
 	}
 	return false;
 }
 
 /**
-@brief Get the number of sounds in this map
-@return The number of sounds currently stored in the Map
+@brief Get the number of sounds in this registry
+@return The number of sounds currently stored in the registry
 */
 int CSoundController::GetNumOfSounds(void) const
 {
-	return soundMap.size();
+	int iNumOfSounds = 0;
+	for (int iHandle = 0; iHandle < soundRegistry.GetNumHandles(); iHandle++)
+	{
+		if (soundRegistry.IsValid(iHandle))
+			iNumOfSounds++;
+	}
+	return iNumOfSounds;
+}
+
+/**
+@brief Get the handle of a sound in the registry by its ID. A non-negative ID is an index into
+	   soundHandles, so this does not search the registry.
+@param ID A const int variable which will be the ID of the iSoundSource in the registry
+@return The handle of the sound, or CResourceRegistry<CSoundInfo*>::INVALID_HANDLE
+*/
+int CSoundController::GetSoundHandle(const int ID) const
+{
+	if (ID < 0)
+		return soundRegistry.GetHandle(std::to_string(ID));
+	if (ID >= (int)soundHandles.size())
+		return CResourceRegistry<CSoundInfo*>::INVALID_HANDLE;
+	return soundHandles[ID];
 }
\ No newline at end of file
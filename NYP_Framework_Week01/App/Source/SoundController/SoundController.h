@@ -7,7 +7,9 @@
 #pragma once
 
 // Include SingletonTemplate
-#include <DesignPatterns\SingletonTemplate.h>
+#include <DesignPatterns/SingletonTemplate.h>
+// Include ResourceRegistry
+#include <DesignPatterns/ResourceRegistry.h>
 
 // Include GLEW
 #include <includes/irrKlang.h>
@@ -16,8 +18,8 @@ using namespace irrklang;
 
 // Include string
 #include <string>
-// Include map storage
-#include <map>
+// Include vector storage
+#include <vector>
 using namespace std;
 
 // Include SoundInfo class; it stores the sound and other information
@@ -64,18 +66,22 @@ protected:
 	// Destructor
 	virtual ~CSoundController(void);
 
-	// Get an sound from this map
+	// Get an sound from this registry
 	CSoundInfo* GetSound(const int ID);
-	// Remove an sound from this map
+	// Remove an sound from this registry
 	bool RemoveSound(const int ID);
-	// Get the number of sounds in this map
+	// Get the number of sounds in this registry
 	int GetNumOfSounds(void) const;
+	// Get the handle of a sound in the registry by its ID
+	int GetSoundHandle(const int ID) const;
 
 	// The handler to the irrklang Sound Engine
 	ISoundEngine* cSoundEngine;
 
-	// The map of all the entity created
-	std::map<int, CSoundInfo*> soundMap;
+	// The registry of all the sounds loaded
+	CResourceRegistry<CSoundInfo*> soundRegistry;
+	// The handles of the sounds in soundRegistry, indexed by their ID
+	std::vector<int> soundHandles;
 
 	// For 3D sound only: Listener position
 	vec3df vec3dfListenerPos;
@@ -5,13 +5,114 @@
  Date: Mar 2020
  */
 #include "Application.h"
+
+// Include CInputRecorder to record or replay the inputs
+#include "Inputs/InputRecorder.h"
+// Include CProfiler to capture the zones of the frames
+#include "TimeControl/Profiler.h"
+// Include CMemoryTracker to set the allocation budget and the zero-allocation zones
+#include "System/MemoryTracker.h"
+// Include CSettings to set the entities of a stress scene
+#include "GameControl/Settings.h"
+// Include CBenchmarkResults to compare the frame times of the run against a baseline
+#include "TimeControl/BenchmarkResults.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
  
 /**
  @brief This function is the main function which is called by the operating system when you run the executables
+ @param argc The number of arguments
+ @param argv The arguments. "-record <file>" records the inputs into a file, and "-replay <file>" replays them.
+			A recording starts at the first tick of the game, so a replay skips the menus, and the HeadlessSimulation
+			can replay it too.
+			"-profile <file>" writes the zones of all the frames into a file in the Chrome trace format.
+			"-frametimes <file>" writes the frame times into a CSV file on exit, instead of FrameTimes.csv.
+			"-pacing <capped|uncapped|adaptive>" sets how the frames are held to the frame rate. adaptive lowers it
+			when the CPU or the GPU cannot keep up.
+			"-allocbudget <N>" counts the frames which make more than N allocations.
+			"-zeroalloc <off|count|assert>" sets what to do when a zone marked by MEMORY_ZERO_ALLOC allocates.
+			"-enemies <N>", "-bullets <N>" and "-pickups <N>" place N extra entities into the level, to stress the scene.
+			"-results <file>" writes the frame times of the run as benchmark results, and "-baseline <file>" compares them
+			against the results of an earlier run. 1 is returned if any of them has regressed.
  @return This function returns the error codes
  */
-int main(void)
+int main(int argc, char* argv[])
 {
+	std::string resultsFilename;
+	std::string baselineFilename;
+
+	// The frame times are written into a CSV file on exit, so that two builds can be compared
+	CFPSCounter::GetInstance()->SetCSVFilename("FrameTimes.csv");
+
+	// Start the recording or the replay before the scene is created, so that it uses the recorded seed
+	for (int i = 1; i + 1 < argc; i++)
+	{
+		if (strcmp(argv[i], "-record") == 0)
+		{
+			if (CInputRecorder::GetInstance()->StartRecording(argv[i + 1]) == false)
+				return 1;
+		}
+		else if (strcmp(argv[i], "-replay") == 0)
+		{
+			if (CInputRecorder::GetInstance()->StartReplay(argv[i + 1]) == false)
+				return 1;
+		}
+		else if (strcmp(argv[i], "-frametimes") == 0)
+		{
+			CFPSCounter::GetInstance()->SetCSVFilename(argv[i + 1]);
+		}
+		else if (strcmp(argv[i], "-pacing") == 0)
+		{
+			if (strcmp(argv[i + 1], "uncapped") == 0)
+				CSettings::GetInstance()->ePacingMode = CFramePacer::UNCAPPED;
+			else if (strcmp(argv[i + 1], "adaptive") == 0)
+				CSettings::GetInstance()->ePacingMode = CFramePacer::ADAPTIVE;
+			else
+				CSettings::GetInstance()->ePacingMode = CFramePacer::CAPPED;
+		}
+		else if (strcmp(argv[i], "-profile") == 0)
+		{
+			if (CProfiler::GetInstance()->StartCapture(argv[i + 1]) == false)
+				return 1;
+		}
+		else if (strcmp(argv[i], "-allocbudget") == 0)
+		{
+			CMemoryTracker::SetFrameBudget((unsigned int)strtoul(argv[i + 1], NULL, 10));
+		}
+		else if (strcmp(argv[i], "-zeroalloc") == 0)
+		{
+			if (strcmp(argv[i + 1], "off") == 0)
+				CMemoryTracker::SetZeroAllocMode(CMemoryTracker::ZERO_ALLOC_OFF);
+			else if (strcmp(argv[i + 1], "assert") == 0)
+				CMemoryTracker::SetZeroAllocMode(CMemoryTracker::ZERO_ALLOC_ASSERT);
+			else
+				CMemoryTracker::SetZeroAllocMode(CMemoryTracker::ZERO_ALLOC_COUNT);
+		}
+		else if (strcmp(argv[i], "-enemies") == 0)
+		{
+			CSettings::GetInstance()->iStressEnemies = atoi(argv[i + 1]);
+		}
+		else if (strcmp(argv[i], "-bullets") == 0)
+		{
+			CSettings::GetInstance()->iStressBullets = atoi(argv[i + 1]);
+		}
+		else if (strcmp(argv[i], "-pickups") == 0)
+		{
+			CSettings::GetInstance()->iStressPickUps = atoi(argv[i + 1]);
+		}
+		else if (strcmp(argv[i], "-results") == 0)
+		{
+			resultsFilename = argv[i + 1];
+		}
+		else if (strcmp(argv[i], "-baseline") == 0)
+		{
+			baselineFilename = argv[i + 1];
+		}
+	}
+
 	Application* pApp = Application::GetInstance();
 	// if the application is initialised properly, then run it
 	if (pApp->Init() == true)
@@ -19,14 +120,32 @@ int main(void)
 		// Run the Application instance
 		pApp->Run();
 
+		// Keep the frame times of the run, before the CFPSCounter is destroyed
+		int iExitCode = 0;
+		if ((resultsFilename.empty() == false) || (baselineFilename.empty() == false))
+		{
+			CBenchmarkResults cResults;
+			CFPSCounter::GetInstance()->AddToResults(cResults, "Scene2D windowed");
+			if ((resultsFilename.empty() == false) && (cResults.WriteCSV(resultsFilename) == false))
+				iExitCode = 1;
+			CBenchmarkResults cBaseline;
+			if (baselineFilename.empty() == false)
+			{
+				if (cBaseline.LoadCSV(baselineFilename) == false)
+					iExitCode = 1;
+				else if (cResults.Compare(cBaseline, 10.0, std::cout) > 0)
+					iExitCode = 1;
+			}
+		}
+
 		// Destroy the Application instance, just to be sure
 		pApp->Destroy();
 
 		// Set the Application handler to NULL
 		pApp = NULL;
 
-		// Return 0 since the application successfully ran
-		return 0;
+		// Return 0 since the application successfully ran, unless the frame times have regressed
+		return iExitCode;
 	}
 
 	// Return 1 if the application failed to run
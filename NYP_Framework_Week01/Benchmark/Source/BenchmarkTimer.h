@@ -0,0 +1,57 @@
+/**
+ BenchmarkTimer
+ @brief Functions which time a piece of code over a few runs, and report the results of the benchmarks.
+		The median time of the runs is used, so that a run which was slowed down by the operating system
+		does not move the result.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include CBenchmarkResults
+#include "TimeControl/BenchmarkResults.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+@brief Time a piece of code
+@param iNumCalls A const int variable containing the number of calls in each run
+@param function A TFunction variable containing the code to time. It is called with the number of the call.
+@param iNumRuns A const int variable containing the number of runs
+@return The median time of one call over the runs, in nanoseconds
+*/
+template<class TFunction>
+double MeasureNanoseconds(const int iNumCalls, TFunction function, const int iNumRuns = 5)
+{
+	std::vector<double> arrTimes(iNumRuns);
+	for (int iRun = 0; iRun < iNumRuns; iRun++)
+	{
+		const std::chrono::high_resolution_clock::time_point tStart = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < iNumCalls; i++)
+		{
+			function(i);
+		}
+		arrTimes[iRun] = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - tStart).count() / iNumCalls;
+	}
+	std::sort(arrTimes.begin(), arrTimes.end());
+	return arrTimes[iNumRuns / 2];
+}
+
+/**
+@brief Print the result of a benchmark and add it to the results
+@param cResults A CBenchmarkResults& variable which receives the result
+@param name A const std::string& variable containing the name of the benchmark
+@param dValue A const double variable containing the cost which was measured
+@param unit A const std::string& variable containing the unit of dValue
+*/
+inline void ReportResult(CBenchmarkResults& cResults, const std::string& name, const double dValue, const std::string& unit)
+{
+	std::cout << "  " << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(3)
+		<< std::setw(12) << dValue << ' ' << unit << std::endl;
+	cResults.Add(name, dValue, unit);
+}
@@ -0,0 +1,199 @@
+/**
+ CEngineBenchmark
+ @brief Microbenchmarks for the classes of the Library which the 2D engine calls often:
+		CCollisionManager, CLoadOBJ and CSpriteAnimation. They need no map or window.
+ By: agent
+ Date: Oct 2026
+ */
+#include "EngineBenchmark.h"
+
+// Include MeasureNanoseconds() and ReportResult()
+#include "BenchmarkTimer.h"
+
+// Include CCollisionManager
+#include "Primitives/CollisionManager.h"
+// Include CSpriteAnimation
+#include "Primitives/SpriteAnimation.h"
+// Include CLoadOBJ
+#include "System/LoadOBJ.h"
+// Include CRandom, so that the shapes are the same in every run
+#include "System/Random.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+// Stops the compiler from removing a result which is not used
+static volatile int iSink = 0;
+
+/**
+@brief Constructor
+*/
+CEngineBenchmark::CEngineBenchmark(void)
+	: iNumShapes(4096)
+	, iGridSize(64)
+{
+}
+
+/**
+@brief Destructor
+*/
+CEngineBenchmark::~CEngineBenchmark(void)
+{
+}
+
+/**
+@brief Run all the benchmarks, print them and add them to the results
+@param cResults A CBenchmarkResults& variable which receives the results
+*/
+void CEngineBenchmark::Run(CBenchmarkResults& cResults)
+{
+	cout << "== CCollisionManager ==" << endl;
+	RunCollision(cResults);
+
+	cout << endl << "== CLoadOBJ ==" << endl;
+	RunLoadOBJ(cResults);
+
+	cout << endl << "== CSpriteAnimation ==" << endl;
+	RunSpriteAnimation(cResults);
+}
+
+/**
+@brief Measure the collision tests of CCollisionManager, between pairs of random shapes in a 100 unit cube
+@param cResults A CBenchmarkResults& variable which receives the results
+*/
+void CEngineBenchmark::RunCollision(CBenchmarkResults& cResults)
+{
+	CRandom cRandom(1);
+	std::vector<glm::vec3> arrCentres(iNumShapes);
+	std::vector<float> arrRadii(iNumShapes);
+	std::vector<glm::vec3> arrDirections(iNumShapes);
+	for (int i = 0; i < iNumShapes; i++)
+	{
+		arrCentres[i] = glm::vec3(cRandom.Float(), cRandom.Float(), cRandom.Float()) * 100.0f;
+		arrRadii[i] = 1.0f + cRandom.Float() * 9.0f;
+		arrDirections[i] = glm::normalize(glm::vec3(cRandom.Float(), cRandom.Float(), cRandom.Float()) - 0.5f);
+	}
+	const int iMask = iNumShapes - 1;
+	const int iNumCalls = iNumShapes * 64;
+
+	ReportResult(cResults, "CCollisionManager::SphereSphereCollision", MeasureNanoseconds(iNumCalls, [&](const int i)
+	{
+		const int a = i & iMask, b = (i * 7 + 1) & iMask;
+		iSink = iSink + CCollisionManager::SphereSphereCollision(arrCentres[a], arrRadii[a], arrCentres[b], arrRadii[b]);
+	}), "ns");
+
+	ReportResult(cResults, "CCollisionManager::BoxBoxCollision", MeasureNanoseconds(iNumCalls, [&](const int i)
+	{
+		const int a = i & iMask, b = (i * 7 + 1) & iMask;
+		const glm::vec3 vec3A(arrRadii[a]), vec3B(arrRadii[b]);
+		iSink = iSink + CCollisionManager::BoxBoxCollision(arrCentres[a] - vec3A, arrCentres[a] + vec3A,
+			arrCentres[b] - vec3B, arrCentres[b] + vec3B);
+	}), "ns");
+
+	ReportResult(cResults, "CCollisionManager::RaySphereCollision", MeasureNanoseconds(iNumCalls, [&](const int i)
+	{
+		const int a = i & iMask, b = (i * 7 + 1) & iMask;
+		float t = 0.0f;
+		iSink = iSink + CCollisionManager::RaySphereCollision(arrCentres[a], arrRadii[a], arrCentres[b], arrDirections[b], t);
+	}), "ns");
+
+	ReportResult(cResults, "CCollisionManager::RayBoxCollision", MeasureNanoseconds(iNumCalls, [&](const int i)
+	{
+		const int a = i & iMask, b = (i * 7 + 1) & iMask;
+		const glm::vec3 vec3A(arrRadii[a]);
+		float t = 0.0f;
+		iSink = iSink + CCollisionManager::RayBoxCollision(arrCentres[a] - vec3A, arrCentres[a] + vec3A,
+			arrCentres[b], arrDirections[b], t);
+	}), "ns");
+
+	ReportResult(cResults, "CCollisionManager::RayBoxCollision segment", MeasureNanoseconds(iNumCalls, [&](const int i)
+	{
+		const int a = i & iMask, b = (i * 7 + 1) & iMask;
+		const glm::vec3 vec3A(arrRadii[a]);
+		iSink = iSink + CCollisionManager::RayBoxCollision(arrCentres[a] - vec3A, arrCentres[a] + vec3A,
+			arrCentres[b], arrCentres[b] + arrDirections[b] * 50.0f);
+	}), "ns");
+}
+
+/**
+@brief Measure CLoadOBJ::LoadOBJ on a grid of quads, which is written into the working directory and removed after
+@param cResults A CBenchmarkResults& variable which receives the results
+*/
+void CEngineBenchmark::RunLoadOBJ(CBenchmarkResults& cResults)
+{
+	const char* filename = "BenchmarkGrid.obj";
+	{
+		std::ofstream outputFile(filename);
+		if (!outputFile)
+		{
+			cout << "  Unable to write " << filename << ", so CLoadOBJ is not measured" << endl;
+			return;
+		}
+		outputFile << fixed << setprecision(4);
+		for (int iRow = 0; iRow <= iGridSize; iRow++)
+		{
+			for (int iCol = 0; iCol <= iGridSize; iCol++)
+			{
+				outputFile << "v " << (float)iCol << " 0.0 " << (float)iRow << '\n';
+				outputFile << "vt " << (float)iCol / iGridSize << ' ' << (float)iRow / iGridSize << '\n';
+			}
+		}
+		outputFile << "vn 0.0 1.0 0.0\n";
+		for (int iRow = 0; iRow < iGridSize; iRow++)
+		{
+			for (int iCol = 0; iCol < iGridSize; iCol++)
+			{
+				// OBJ indices start from 1
+				const int arrCorners[4] = {
+					iRow * (iGridSize + 1) + iCol + 1,
+					(iRow + 1) * (iGridSize + 1) + iCol + 1,
+					(iRow + 1) * (iGridSize + 1) + iCol + 2,
+					iRow * (iGridSize + 1) + iCol + 2 };
+				outputFile << 'f';
+				for (int i = 0; i < 4; i++)
+					outputFile << ' ' << arrCorners[i] << '/' << arrCorners[i] << "/1";
+				outputFile << '\n';
+			}
+		}
+	}
+
+	std::vector<glm::vec3> arrVertices;
+	std::vector<glm::vec2> arrUVs;
+	std::vector<glm::vec3> arrNormals;
+	const double dTime = MeasureNanoseconds(1, [&](const int)
+	{
+		arrVertices.clear();
+		arrUVs.clear();
+		arrNormals.clear();
+		iSink = iSink + CLoadOBJ::LoadOBJ(filename, arrVertices, arrUVs, arrNormals);
+	});
+	std::remove(filename);
+
+	ReportResult(cResults, "CLoadOBJ::LoadOBJ " + std::to_string(iGridSize * iGridSize) + " quads", dTime / 1000000.0, "ms");
+	ReportResult(cResults, "CLoadOBJ::LoadOBJ per vertex", dTime / std::max((size_t)1, arrVertices.size()), "ns");
+}
+
+/**
+@brief Measure CSpriteAnimation::Update on an animation which repeats forever, as the player's animations do
+@param cResults A CBenchmarkResults& variable which receives the results
+*/
+void CEngineBenchmark::RunSpriteAnimation(CBenchmarkResults& cResults)
+{
+	// The mesh is not built, as only the frames are updated. It is kept on the stack, since CMesh has no virtual destructor.
+	CSpriteAnimation cSpriteAnimation(4, 4);
+	cSpriteAnimation.AddAnimation("idle", 0, 1);
+	cSpriteAnimation.AddAnimation("right", 8, 11);
+	cSpriteAnimation.AddAnimation("left", 4, 7);
+	cSpriteAnimation.AddAnimation("up", 12, 15);
+	cSpriteAnimation.AddAnimation("down", 1, 3);
+	cSpriteAnimation.PlayAnimation("right", -1, 1.0f);
+
+	ReportResult(cResults, "CSpriteAnimation::Update", MeasureNanoseconds(1000000, [&cSpriteAnimation](const int)
+	{
+		cSpriteAnimation.Update(1.0 / 60.0);
+	}), "ns");
+}
@@ -0,0 +1,40 @@
+/**
+ CEngineBenchmark
+ @brief Microbenchmarks for the classes of the Library which the 2D engine calls often:
+		CCollisionManager, CLoadOBJ and CSpriteAnimation. They need no map or window.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include CBenchmarkResults
+#include "TimeControl/BenchmarkResults.h"
+
+class CEngineBenchmark
+{
+public:
+	// Constructor
+	CEngineBenchmark(void);
+
+	// Destructor
+	virtual ~CEngineBenchmark(void);
+
+	// Run all the benchmarks, print them and add them to the results
+	void Run(CBenchmarkResults& cResults);
+
+protected:
+	// Measure the collision tests of CCollisionManager
+	void RunCollision(CBenchmarkResults& cResults);
+
+	// Measure CLoadOBJ::LoadOBJ on a generated grid of quads
+	void RunLoadOBJ(CBenchmarkResults& cResults);
+
+	// Measure CSpriteAnimation::Update
+	void RunSpriteAnimation(CBenchmarkResults& cResults);
+
+	// The number of shapes in the collision benchmarks
+	const int iNumShapes;
+
+	// The number of quads along each side of the grid in the LoadOBJ benchmark
+	const int iGridSize;
+};
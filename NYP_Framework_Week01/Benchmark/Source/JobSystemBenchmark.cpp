@@ -0,0 +1,197 @@
+/**
+ CJobSystemBenchmark
+ @brief Microbenchmarks for CJobSystem. They measure the cost of scheduling a job
+		and how ParallelFor scales with the number of worker threads.
+ By: agent
+ Date: Oct 2026
+ */
+#include "JobSystemBenchmark.h"
+
+// Include CJobSystem
+#include "JobControl/JobSystem.h"
+// Include CPerfCounters, to count the hardware events of the work in the scaling benchmark
+#include "TimeControl/PerfCounters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// The time in milliseconds since a start time
+static double MillisecondsSince(const std::chrono::high_resolution_clock::time_point& tStart)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+}
+
+// Stops the compiler from removing a result which is not used
+static volatile double dSink = 0.0;
+
+/**
+@brief Constructor
+*/
+CJobSystemBenchmark::CJobSystemBenchmark(void)
+	: iNumJobs(100000)
+	, iNumElements(1 << 22)
+{
+}
+
+/**
+@brief Destructor
+*/
+CJobSystemBenchmark::~CJobSystemBenchmark(void)
+{
+}
+
+/**
+@brief Run all the benchmarks, print them and add them to the results
+@param cResults A CBenchmarkResults& variable which receives the results
+*/
+void CJobSystemBenchmark::Run(CBenchmarkResults& cResults)
+{
+	const int iMaxWorkers = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+
+	cout << "== CJobSystem: task overhead ==" << endl;
+	RunTaskOverhead(0, cResults);
+	RunTaskOverhead(iMaxWorkers, cResults);
+
+	cout << endl << "== CJobSystem: ParallelFor overhead ==" << endl;
+	RunParallelForOverhead(0, cResults);
+	RunParallelForOverhead(iMaxWorkers, cResults);
+
+	cout << endl << "== CJobSystem: ParallelFor scaling over " << iNumElements << " elements ==" << endl;
+	const double dBaseTime = RunScaling(0, cResults);
+	for (int iNumWorkers = 1; iNumWorkers <= iMaxWorkers; iNumWorkers *= 2)
+	{
+		const double dTime = RunScaling(iNumWorkers, cResults);
+		cout << "    speedup " << fixed << setprecision(2) << dBaseTime / dTime << "x" << endl;
+	}
+
+	CJobSystem::GetInstance()->Destroy();
+}
+
+/**
+@brief Measure the cost of scheduling and waiting for empty jobs
+@param iNumWorkers A const int variable containing the number of worker threads
+@param cResults A CBenchmarkResults& variable which receives the results
+*/
+void CJobSystemBenchmark::RunTaskOverhead(const int iNumWorkers, CBenchmarkResults& cResults)
+{
+	CJobSystem* cJobSystem = CJobSystem::GetInstance();
+	cJobSystem->Init(iNumWorkers);
+
+	// Calling the job directly, as the lower bound
+	std::function<void(void)> job = []() { dSink = dSink + 1.0; };
+	std::chrono::high_resolution_clock::time_point tStart = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < iNumJobs; i++)
+	{
+		job();
+	}
+	const double dDirectTime = MillisecondsSince(tStart);
+
+	// Scheduling all the jobs, then waiting for them
+	CJobCounter cCounter;
+	tStart = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < iNumJobs; i++)
+	{
+		cJobSystem->Schedule([]() {}, &cCounter);
+	}
+	cJobSystem->Wait(&cCounter);
+	const double dBatchTime = MillisecondsSince(tStart);
+
+	// Scheduling one job and waiting for it, as a job would when it depends on the one before it
+	tStart = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < iNumJobs / 10; i++)
+	{
+		CJobCounter cSingle;
+		cJobSystem->Schedule([]() {}, &cSingle);
+		cJobSystem->Wait(&cSingle);
+	}
+	const double dRoundTripTime = MillisecondsSince(tStart);
+
+	cout << "  " << iNumWorkers << " workers: "
+		<< fixed << setprecision(1)
+		<< "direct " << dDirectTime * 1000000.0 / iNumJobs << " ns/job, "
+		<< "batch " << dBatchTime * 1000000.0 / iNumJobs << " ns/job, "
+		<< "round trip " << dRoundTripTime * 1000000.0 / (iNumJobs / 10) << " ns/job, "
+		<< "stolen " << cJobSystem->GetNumJobsStolen() << endl;
+
+	const std::string workers = " " + std::to_string(iNumWorkers) + " workers";
+	cResults.Add("CJobSystem::Schedule batch" + workers, dBatchTime * 1000000.0 / iNumJobs, "ns");
+	cResults.Add("CJobSystem::Schedule round trip" + workers, dRoundTripTime * 1000000.0 / (iNumJobs / 10), "ns");
+}
+
+/**
+@brief Measure the cost of a ParallelFor over a small range, where the work is too small to gain from threads
+@param iNumWorkers A const int variable containing the number of worker threads
+@param cResults A CBenchmarkResults& variable which receives the results
+*/
+void CJobSystemBenchmark::RunParallelForOverhead(const int iNumWorkers, CBenchmarkResults& cResults)
+{
+	CJobSystem* cJobSystem = CJobSystem::GetInstance();
+	cJobSystem->Init(iNumWorkers);
+
+	const int iNumCalls = 10000;
+	std::vector<float> arrValues(256, 1.0f);
+
+	std::chrono::high_resolution_clock::time_point tStart = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < iNumCalls; i++)
+	{
+		cJobSystem->ParallelFor(0, (int)arrValues.size(), 16, [&arrValues](const int iBegin, const int iEnd)
+		{
+			for (int j = iBegin; j < iEnd; j++)
+			{
+				arrValues[j] *= 1.0001f;
+			}
+		});
+	}
+	const double dTime = MillisecondsSince(tStart);
+
+	cout << "  " << iNumWorkers << " workers: "
+		<< fixed << setprecision(2)
+		<< dTime * 1000.0 / iNumCalls << " us per ParallelFor of " << arrValues.size() << " elements in chunks of 16" << endl;
+	cResults.Add("CJobSystem::ParallelFor overhead " + std::to_string(iNumWorkers) + " workers", dTime * 1000.0 / iNumCalls, "us");
+	dSink = dSink + arrValues[0];
+}
+
+/**
+@brief Measure the time of a ParallelFor over a large range
+@param iNumWorkers A const int variable containing the number of worker threads
+@param cResults A CBenchmarkResults& variable which receives the results
+@return The best time out of a few runs, in milliseconds
+*/
+double CJobSystemBenchmark::RunScaling(const int iNumWorkers, CBenchmarkResults& cResults)
+{
+	CJobSystem* cJobSystem = CJobSystem::GetInstance();
+	cJobSystem->Init(iNumWorkers);
+
+	std::vector<double> arrResults(iNumElements);
+
+	double dBestTime = 0.0;
+	for (int iRun = 0; iRun < 5; iRun++)
+	{
+		std::chrono::high_resolution_clock::time_point tStart = std::chrono::high_resolution_clock::now();
+		cJobSystem->ParallelFor(0, iNumElements, 0, [&arrResults](const int iBegin, const int iEnd)
+		{
+			PROFILE_COUNTERS("ParallelFor scaling chunk");
+			for (int i = iBegin; i < iEnd; i++)
+			{
+				arrResults[i] = std::sqrt((double)i) * std::sin((double)i);
+			}
+		});
+		const double dTime = MillisecondsSince(tStart);
+		if ((iRun == 0) || (dTime < dBestTime))
+			dBestTime = dTime;
+	}
+
+	cout << "  " << iNumWorkers << " workers: " << fixed << setprecision(2) << dBestTime << " ms" << endl;
+	cResults.Add("CJobSystem::ParallelFor scaling " + std::to_string(iNumWorkers) + " workers", dBestTime, "ms");
+	dSink = dSink + arrResults[iNumElements / 2];
+
+	return dBestTime;
+}
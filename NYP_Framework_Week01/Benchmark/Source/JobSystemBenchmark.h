@@ -0,0 +1,40 @@
+/**
+ CJobSystemBenchmark
+ @brief Microbenchmarks for CJobSystem. They measure the cost of scheduling a job
+		and how ParallelFor scales with the number of worker threads.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include CBenchmarkResults
+#include "TimeControl/BenchmarkResults.h"
+
+class CJobSystemBenchmark
+{
+public:
+	// Constructor
+	CJobSystemBenchmark(void);
+
+	// Destructor
+	virtual ~CJobSystemBenchmark(void);
+
+	// Run all the benchmarks, print them and add them to the results
+	void Run(CBenchmarkResults& cResults);
+
+protected:
+	// Measure the cost of scheduling and waiting for empty jobs
+	void RunTaskOverhead(const int iNumWorkers, CBenchmarkResults& cResults);
+
+	// Measure the cost of a ParallelFor over a small range
+	void RunParallelForOverhead(const int iNumWorkers, CBenchmarkResults& cResults);
+
+	// Measure the time of a ParallelFor over a large range, and return it in milliseconds
+	double RunScaling(const int iNumWorkers, CBenchmarkResults& cResults);
+
+	// The number of jobs in the task overhead benchmark
+	const int iNumJobs;
+
+	// The number of elements in the scaling benchmark
+	const int iNumElements;
+};
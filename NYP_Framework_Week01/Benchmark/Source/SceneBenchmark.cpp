@@ -0,0 +1,464 @@
+/**
+ CSceneBenchmark
+ @brief Benchmarks for the Scene2D, which are built with the headless simulation. The microbenchmarks measure
+		CMap2D on the shipped maps, and the macro benchmarks run stress scenes with more enemies, bullets
+		and pickups in CHeadlessSimulation. The generated scenes sweep the size of the world and the number
+		of entities in levels from CStressSceneGenerator. Run it from the App folder, so that the maps are found.
+ By: agent
+ Date: Oct 2026
+ */
+#include "SceneBenchmark.h"
+
+// Include MeasureNanoseconds() and ReportResult()
+#include "BenchmarkTimer.h"
+
+// Include CHeadlessSimulation, which includes CMap2D and CSpatialHash2D
+#include "Headless/HeadlessSimulation.h"
+// Include CStressSceneGenerator, which generates the levels of the sweeps
+#include "Headless/StressSceneGenerator.h"
+// Include CSettings
+#include "GameControl/Settings.h"
+// Include CJobSystem
+#include "JobControl/JobSystem.h"
+// Include CFPSCounter, which keeps the times of the ticks
+#include "TimeControl/FPSCounter.h"
+// Include CMemoryTracker, which counts the allocations of the ticks
+#include "System/MemoryTracker.h"
+// Include CRandom, so that the tiles are the same in every run
+#include "System/Random.h"
+// Include CKeyboardController, whose key presses are cleared after each tick
+#include "Inputs/KeyboardController.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+using namespace std;
+
+// Stops the compiler from removing a result which is not used
+static volatile int iSink = 0;
+
+// The maps which the game loads, each once
+static const char* arrMapFilenames[] = {
+	"Maps/DM2213_Map_Level_01.csv",
+	"Maps/DM2213_Map_Level_01_topleft.csv",
+	"Maps/DM2213_Map_Level_01_topmiddle.csv",
+	"Maps/DM2213_Map_Level_01_topright.csv",
+	"Maps/DM2213_Map_Level_01_middleleft.csv",
+	"Maps/DM2213_Map_Level_01_middle.csv",
+	"Maps/DM2213_Map_Level_01_middleright.csv",
+	"Maps/DM2213_Map_Level_01_bottommiddle.csv",
+	"Maps/DM2213_Map_Level_01_bottomright.csv",
+	"Maps/DM2213_Map_Level_02_left.csv",
+	"Maps/DM2213_Map_Level_02_right.csv"
+};
+static const int iNumMaps = sizeof(arrMapFilenames) / sizeof(arrMapFilenames[0]);
+
+/**
+@brief Get the file which each generated level is written into, and removed from after its run. It is in the
+	   temporary folder, so that a run which is stopped leaves nothing in the App folder.
+*/
+static std::string GetGeneratedLevelFilename(void)
+{
+	const char* arrTempVariables[] = { "TMPDIR", "TEMP", "TMP" };
+	for (unsigned int i = 0; i < sizeof(arrTempVariables) / sizeof(arrTempVariables[0]); i++)
+	{
+		const char* pTempFolder = getenv(arrTempVariables[i]);
+		if ((pTempFolder) && (pTempFolder[0] != '\0'))
+			return std::string(pTempFolder) + "/BenchmarkLevel.csv";
+	}
+#ifdef __linux__
+	return "/tmp/BenchmarkLevel.csv";
+#else
+	return "BenchmarkLevel.csv";
+#endif
+}
+
+/**
+@brief Constructor
+*/
+CSceneBenchmark::CSceneBenchmark(void)
+	: iNumTicks(600)
+{
+}
+
+/**
+@brief Destructor
+*/
+CSceneBenchmark::~CSceneBenchmark(void)
+{
+}
+
+/**
+@brief Run all the benchmarks, print them and add them to the results
+@param cResults A CBenchmarkResults& variable which receives the results
+@param sweepFilename A const std::string& variable containing the CSV file to write the generated scenes into,
+	   one scene in each row, so that the frame time can be plotted against the size of the world and the number
+	   of entities. Nothing is written if it is empty.
+@return false if the maps cannot be loaded
+*/
+bool CSceneBenchmark::Run(CBenchmarkResults& cResults, const std::string& sweepFilename)
+{
+	cout << "== CMap2D ==" << endl;
+	if (RunMap2D(cResults) == false)
+		return false;
+
+	cout << endl << "== Bullet hit tests ==" << endl;
+	RunBulletHitTests(cResults);
+
+	// The stress scenes, from the shipped level alone to many of each kind of entity
+	const SStressScene arrScenes[] = {
+		{ "shipped", 0, 0, 0 },
+		{ "enemies x100", 100, 0, 0 },
+		{ "bullets x200", 0, 200, 0 },
+		{ "pickups x100", 0, 0, 100 },
+		{ "mixed x400", 100, 200, 100 }
+	};
+	cout << endl << "== Scene2D stress scenes, " << iNumTicks << " ticks each ==" << endl;
+	for (unsigned int i = 0; i < sizeof(arrScenes) / sizeof(arrScenes[0]); i++)
+	{
+		if (RunStressScene(arrScenes[i], "", cResults) == false)
+			return false;
+	}
+
+	return RunGeneratedScenes(cResults, sweepFilename);
+}
+
+/**
+@brief Measure CMap2D on the shipped maps: loading them, looking up and setting tiles, and finding paths
+@param cResults A CBenchmarkResults& variable which receives the results
+@return false if the maps cannot be loaded
+*/
+bool CSceneBenchmark::RunMap2D(CBenchmarkResults& cResults)
+{
+	CSettings* cSettings = CSettings::GetInstance();
+	CMap2D* cMap2D = CMap2D::GetInstance();
+	// The shipped maps are 32 by 24 tiles
+	if (cMap2D->Init(iNumMaps, 24, 32) == false)
+	{
+		cout << "Failed to load CMap2D" << endl;
+		cMap2D->Destroy();
+		return false;
+	}
+
+	bool bLoaded = true;
+	const double dLoadTime = MeasureNanoseconds(iNumMaps, [cMap2D, &bLoaded](const int i)
+	{
+		bLoaded = cMap2D->LoadMap(arrMapFilenames[i], i) && bLoaded;
+	});
+	if (bLoaded == false)
+	{
+		cout << "Failed to load the maps. Run it from the App folder." << endl;
+		cMap2D->Destroy();
+		return false;
+	}
+	ReportResult(cResults, "CMap2D::LoadMap", dLoadTime / 1000.0, "us");
+
+	// The level which the game starts in
+	cMap2D->SetCurrentLevel(5);
+	const unsigned int uiNumRows = cSettings->NUM_TILES_YAXIS;
+	const unsigned int uiNumCols = cSettings->NUM_TILES_XAXIS;
+
+	// A value which is not in the map, so that the whole map is searched
+	ReportResult(cResults, "CMap2D::FindValue whole map", MeasureNanoseconds(10000, [cMap2D](const int)
+	{
+		unsigned int uiRow = 0, uiCol = 0;
+		iSink = iSink + cMap2D->FindValue(-1, uiRow, uiCol);
+	}), "ns");
+
+	CRandom cRandom(1);
+	const int iNumTiles = 4096;
+	std::vector<glm::i32vec2> arrTiles(iNumTiles);
+	for (int i = 0; i < iNumTiles; i++)
+	{
+		arrTiles[i] = glm::i32vec2(cRandom.Range(uiNumCols), cRandom.Range(uiNumRows));
+	}
+	ReportResult(cResults, "CMap2D::GetMapInfo", MeasureNanoseconds(iNumTiles * 64, [cMap2D, &arrTiles, iNumTiles](const int i)
+	{
+		const glm::i32vec2& tile = arrTiles[i & (iNumTiles - 1)];
+		iSink = iSink + cMap2D->GetMapInfo(tile.y, tile.x);
+	}), "ns");
+	// Each tile is set to the value which it already has, so that the map does not change
+	ReportResult(cResults, "CMap2D::SetMapInfo", MeasureNanoseconds(iNumTiles * 64, [cMap2D, &arrTiles, iNumTiles](const int i)
+	{
+		const glm::i32vec2& tile = arrTiles[i & (iNumTiles - 1)];
+		cMap2D->SetMapInfo(tile.y, tile.x, cMap2D->GetMapInfo(tile.y, tile.x));
+	}), "ns");
+
+	// Paths between random pairs of empty tiles
+	std::vector<glm::vec2> arrEmptyTiles;
+	for (unsigned int uiRow = 0; uiRow < uiNumRows; uiRow++)
+	{
+		for (unsigned int uiCol = 0; uiCol < uiNumCols; uiCol++)
+		{
+			if (cMap2D->GetMapInfo(uiRow, uiCol) == 0)
+				arrEmptyTiles.push_back(glm::vec2(uiCol, uiRow));
+		}
+	}
+	const int iNumPaths = 256;
+	std::vector<glm::vec2> arrStarts(iNumPaths), arrTargets(iNumPaths);
+	for (int i = 0; i < iNumPaths; i++)
+	{
+		arrStarts[i] = arrEmptyTiles[cRandom.Range((int)arrEmptyTiles.size())];
+		arrTargets[i] = arrEmptyTiles[cRandom.Range((int)arrEmptyTiles.size())];
+	}
+	AStarContext context;
+	ReportResult(cResults, "CMap2D::PathFind HeuristicFunction", MeasureNanoseconds(iNumPaths, [&](const int i)
+	{
+		iSink = iSink + (int)cMap2D->PathFind(arrStarts[i], arrTargets[i], heuristic::euclidean, 10, context).size();
+	}) / 1000.0, "us");
+	SPath path;
+	ReportResult(cResults, "CMap2D::PathFind inlined euclidean", MeasureNanoseconds(iNumPaths, [&](const int i)
+	{
+		cMap2D->PathFind(glm::i16vec2(arrStarts[i]), glm::i16vec2(arrTargets[i]), heuristic::EUCLIDEAN, 10, context, path);
+		iSink = iSink + path.iNumNodes;
+	}) / 1000.0, "us");
+
+	cMap2D->Destroy();
+	return true;
+}
+
+/**
+@brief Measure the hit tests of the bullets against the enemies in one frame, on a map of 32 by 24 tiles with random
+	   positions. Each enemy tests every bullet, as the scene did before CSpatialHash2D, or only the bullets in the
+	   tiles around it. The hit box is the one of CEnemy2D, half a tile around the bullet.
+@param cResults A CBenchmarkResults& variable which receives the results
+*/
+void CSceneBenchmark::RunBulletHitTests(CBenchmarkResults& cResults)
+{
+	const int iNumCols = 32;
+	const int iNumRows = 24;
+	// The bullets and the enemies of each case
+	const int arrCases[][2] = {
+		{ 100, 50 },
+		{ 1000, 500 }
+	};
+
+	CRandom cRandom(1);
+	CSpatialHash2D<int> cBulletGrid;
+	cBulletGrid.Init(iNumCols, iNumRows);
+	for (unsigned int iCase = 0; iCase < sizeof(arrCases) / sizeof(arrCases[0]); iCase++)
+	{
+		const int iNumBullets = arrCases[iCase][0];
+		const int iNumEnemies = arrCases[iCase][1];
+		std::vector<glm::vec2> arrBullets(iNumBullets), arrEnemies(iNumEnemies);
+		for (int i = 0; i < iNumBullets; i++)
+		{
+			arrBullets[i] = glm::vec2(cRandom.Float() * iNumCols, cRandom.Float() * iNumRows);
+		}
+		for (int i = 0; i < iNumEnemies; i++)
+		{
+			arrEnemies[i] = glm::vec2(cRandom.Float() * iNumCols, cRandom.Float() * iNumRows);
+		}
+
+		int iNumBroadcastHits = 0;
+		const double dBroadcastTime = MeasureNanoseconds(10, [&](const int)
+		{
+			iNumBroadcastHits = 0;
+			for (int i = 0; i < iNumEnemies; i++)
+			{
+				for (int j = 0; j < iNumBullets; j++)
+				{
+					if ((fabs(arrEnemies[i].x - arrBullets[j].x) <= 0.5f) && (fabs(arrEnemies[i].y - arrBullets[j].y) <= 0.5f))
+						iNumBroadcastHits++;
+				}
+			}
+		});
+
+		// The grid is built in each frame, as the scene does
+		int iNumGridHits = 0;
+		const double dGridTime = MeasureNanoseconds(10, [&](const int)
+		{
+			iNumGridHits = 0;
+			cBulletGrid.Clear();
+			for (int j = 0; j < iNumBullets; j++)
+			{
+				cBulletGrid.Insert(arrBullets[j], j);
+			}
+			for (int i = 0; i < iNumEnemies; i++)
+			{
+				cBulletGrid.ForEachInRange(arrEnemies[i], 0.5f, [&](const int j)
+				{
+					if ((fabs(arrEnemies[i].x - arrBullets[j].x) <= 0.5f) && (fabs(arrEnemies[i].y - arrBullets[j].y) <= 0.5f))
+						iNumGridHits++;
+				});
+			}
+		});
+		if (iNumBroadcastHits != iNumGridHits)
+			cout << "  The grid found " << iNumGridHits << " hits instead of " << iNumBroadcastHits << endl;
+		iSink = iSink + iNumGridHits;
+
+		const std::string name = "Bullet hit tests " + std::to_string(iNumBullets) + " x " + std::to_string(iNumEnemies);
+		ReportResult(cResults, name + " every pair", dBroadcastTime / 1000000.0, "ms");
+		ReportResult(cResults, name + " CSpatialHash2D", dGridTime / 1000000.0, "ms");
+	}
+}
+
+/**
+@brief Run the generated scenes, which sweep the size of the world with the same entities, and then the number of
+	   entities, bullets and bosses in the same world. Each level is generated with the same seed, so that the runs can be compared.
+@param cResults A CBenchmarkResults& variable which receives the results
+@param sweepFilename A const std::string& variable containing the CSV file to write the scenes into, or an empty string
+@return false if a level cannot be generated or loaded
+*/
+bool CSceneBenchmark::RunGeneratedScenes(CBenchmarkResults& cResults, const std::string& sweepFilename)
+{
+	// The rows, columns, enemies, pickups and bosses of each level, and the bullets fired at the player in it.
+	// CStressSceneGenerator places no bullets, so they are placed on empty tiles when the level is loaded.
+	const unsigned int arrScenes[][6] = {
+		// The size of the world
+		{ 24, 32, 50, 25, 0, 50 },
+		{ 48, 64, 50, 25, 0, 50 },
+		{ 96, 128, 50, 25, 0, 50 },
+		{ 192, 256, 50, 25, 0, 50 },
+		// The number of entities
+		{ 48, 64, 100, 50, 0, 50 },
+		{ 48, 64, 200, 100, 0, 50 },
+		{ 48, 64, 400, 200, 0, 50 },
+		// The number of bullets
+		{ 48, 64, 50, 25, 0, 200 },
+		{ 48, 64, 50, 25, 0, 800 },
+		// The number of bosses
+		{ 48, 64, 50, 25, 1, 50 },
+		{ 48, 64, 50, 25, 4, 50 }
+	};
+
+	ofstream sweepFile;
+	if (!sweepFilename.empty())
+	{
+		sweepFile.open(sweepFilename.c_str());
+		if (!sweepFile)
+		{
+			cout << "Unable to write the sweep into " << sweepFilename << endl;
+			return false;
+		}
+		sweepFile << "rows,cols,obstacle density,enemies,pickups,bosses,bullets,frame mean ms,frame p99 ms,update mean ms,allocations per tick\n";
+	}
+
+	cout << endl << "== Scene2D generated scenes, " << iNumTicks << " ticks each ==" << endl;
+	CStressSceneGenerator cGenerator;
+	const std::string generatedLevelFilename = GetGeneratedLevelFilename();
+	for (unsigned int i = 0; i < sizeof(arrScenes) / sizeof(arrScenes[0]); i++)
+	{
+		CStressSceneGenerator::SParameters sParameters;
+		sParameters.uiNumRows = arrScenes[i][0];
+		sParameters.uiNumCols = arrScenes[i][1];
+		sParameters.uiNumEnemies = arrScenes[i][2];
+		sParameters.uiNumPickUps = arrScenes[i][3];
+		sParameters.uiNumBosses = arrScenes[i][4];
+		const unsigned int uiNumBullets = arrScenes[i][5];
+		if ((cGenerator.Generate(sParameters) == false) || (cGenerator.SaveMap(generatedLevelFilename) == false))
+		{
+			remove(generatedLevelFilename.c_str());
+			return false;
+		}
+
+		std::ostringstream name;
+		name << sParameters.uiNumCols << "x" << sParameters.uiNumRows << " e" << sParameters.uiNumEnemies
+			<< " p" << sParameters.uiNumPickUps << " b" << sParameters.uiNumBosses << " s" << uiNumBullets;
+		const std::string sceneName = name.str();
+		const SStressScene sScene = { sceneName.c_str(), 0, uiNumBullets, 0 };
+		const bool bRun = RunStressScene(sScene, generatedLevelFilename, cResults);
+		remove(generatedLevelFilename.c_str());
+		if (bRun == false)
+			return false;
+
+		if (sweepFile.is_open())
+		{
+			const std::string prefix = "Scene2D " + sceneName;
+			const CBenchmarkResults::SResult* pAllocations = cResults.Find(prefix + " allocations per tick");
+			sweepFile << sParameters.uiNumRows << "," << sParameters.uiNumCols << "," << sParameters.fObstacleDensity << ","
+				<< sParameters.uiNumEnemies << "," << sParameters.uiNumPickUps << "," << sParameters.uiNumBosses << ","
+				<< uiNumBullets << ","
+				<< cResults.Find(prefix + " frame mean")->dValue << ","
+				<< cResults.Find(prefix + " frame p99")->dValue << ","
+				<< cResults.Find(prefix + " update mean")->dValue << ","
+				<< (pAllocations ? pAllocations->dValue : 0.0) << "\n";
+		}
+	}
+	return true;
+}
+
+/**
+@brief Run a stress scene in CHeadlessSimulation and measure its ticks, in the same way as the HeadlessSimulation does
+@param sScene A const SStressScene& variable containing the entities to add
+@param levelFilename A const std::string& variable containing a generated level to run, or an empty string for the shipped maps
+@param cResults A CBenchmarkResults& variable which receives the results
+@return false if the scene cannot be loaded
+*/
+bool CSceneBenchmark::RunStressScene(const SStressScene& sScene, const std::string& levelFilename, CBenchmarkResults& cResults)
+{
+	// The same seed in every run, so that the scenes are the same
+	CSettings* cSettings = CSettings::GetInstance();
+	cSettings->iRandomSeed = 1;
+	cSettings->bDeterministic = true;
+	cSettings->iStressEnemies = sScene.iNumEnemies;
+	cSettings->iStressBullets = sScene.iNumBullets;
+	cSettings->iStressPickUps = sScene.iNumPickUps;
+
+	CJobSystem::GetInstance()->Init();
+	CHeadlessSimulation cSimulation;
+	if (cSimulation.Init(levelFilename) == false)
+	{
+		cout << "Failed to load the stress scene " << sScene.pName << ". Run it from the App folder." << endl;
+		CJobSystem::GetInstance()->Destroy();
+		return false;
+	}
+	const int iNumEnemies = cSimulation.GetNumActiveEnemies();
+	const int iNumBullets = cSimulation.GetNumActiveBullets();
+	const int iNumPickUps = cSimulation.GetNumActivePickUps();
+
+	CFPSCounter* cFPSCounter = CFPSCounter::GetInstance();
+	cFPSCounter->Init();
+	// End the frame which holds the allocations of Init(), so that only those of the ticks are counted
+	CMemoryTracker::EndFrame();
+	const uint64_t uiStartFrames = CMemoryTracker::GetNumFrames();
+	uint64_t uiStartAllocations = 0;
+	for (int iTag = 0; iTag < CMemoryTracker::NUM_TAGS; iTag++)
+	{
+		uiStartAllocations += CMemoryTracker::GetTotalAllocations((CMemoryTracker::TAG)iTag);
+	}
+
+	for (int i = 0; i < iNumTicks; i++)
+	{
+		const std::chrono::steady_clock::time_point tTickStart = std::chrono::steady_clock::now();
+		CJobSystem::GetInstance()->ResetScratchArenas();
+		cSimulation.Update(cSettings->dTickGameTime);
+		CKeyboardController::GetInstance()->PostUpdate();
+		const double dTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - tTickStart).count();
+		cFPSCounter->SetUpdateTime(dTime);
+		cFPSCounter->Update(dTime);
+		CMemoryTracker::EndFrame();
+	}
+
+	const std::string prefix = "Scene2D " + std::string(sScene.pName);
+	CBenchmarkResults cSceneResults;
+	cFPSCounter->AddToResults(cSceneResults, prefix);
+	if (CMemoryTracker::IsEnabled())
+	{
+		uint64_t uiAllocations = 0;
+		for (int iTag = 0; iTag < CMemoryTracker::NUM_TAGS; iTag++)
+		{
+			uiAllocations += CMemoryTracker::GetTotalAllocations((CMemoryTracker::TAG)iTag);
+		}
+		const uint64_t uiNumFrames = std::max((uint64_t)1, CMemoryTracker::GetNumFrames() - uiStartFrames);
+		cSceneResults.Add(prefix + " allocations per tick", (double)(uiAllocations - uiStartAllocations) / uiNumFrames, "allocs");
+	}
+
+	cout << "  " << sScene.pName << " (" << iNumEnemies << " enemies, " << iNumBullets << " bullets, "
+		<< iNumPickUps << " pickups at the start)" << endl;
+	const std::vector<CBenchmarkResults::SResult>& results = cSceneResults.GetResults();
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		ReportResult(cResults, results[i].name, results[i].dValue, results[i].unit);
+	}
+
+	cSimulation.Destroy();
+	CJobSystem::GetInstance()->Destroy();
+	cFPSCounter->Destroy();
+	return true;
+}
@@ -0,0 +1,54 @@
+/**
+ CSceneBenchmark
+ @brief Benchmarks for the Scene2D, which are built with the headless simulation. The microbenchmarks measure
+		CMap2D on the shipped maps, and the macro benchmarks run stress scenes with more enemies, bullets
+		and pickups in CHeadlessSimulation. The generated scenes sweep the size of the world and the number
+		of entities in levels from CStressSceneGenerator. Run it from the App folder, so that the maps are found.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include CBenchmarkResults
+#include "TimeControl/BenchmarkResults.h"
+
+#include <string>
+
+class CSceneBenchmark
+{
+public:
+	// Constructor
+	CSceneBenchmark(void);
+
+	// Destructor
+	virtual ~CSceneBenchmark(void);
+
+	// Run all the benchmarks, print them and add them to the results, and write the generated scenes into a sweep file
+	// if it is named. Returns false if the maps cannot be loaded.
+	bool Run(CBenchmarkResults& cResults, const std::string& sweepFilename);
+
+protected:
+	// A stress scene, with the entities which are added to the first map
+	struct SStressScene
+	{
+		const char* pName;
+		unsigned int iNumEnemies;
+		unsigned int iNumBullets;
+		unsigned int iNumPickUps;
+	};
+
+	// Measure CMap2D on the shipped maps
+	bool RunMap2D(CBenchmarkResults& cResults);
+
+	// Measure the hit tests of the bullets against the enemies, testing every pair and looking them up in CSpatialHash2D
+	void RunBulletHitTests(CBenchmarkResults& cResults);
+
+	// Run the generated scenes, which sweep the size of the world and the number of entities and bullets
+	bool RunGeneratedScenes(CBenchmarkResults& cResults, const std::string& sweepFilename);
+
+	// Run a stress scene in CHeadlessSimulation and measure its ticks, on the shipped maps or a generated level
+	bool RunStressScene(const SStressScene& sScene, const std::string& levelFilename, CBenchmarkResults& cResults);
+
+	// The number of ticks of each stress scene
+	const int iNumTicks;
+};
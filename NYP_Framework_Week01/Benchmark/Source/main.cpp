@@ -0,0 +1,119 @@
+/**
+ Benchmark
+ @brief This file runs the benchmarks of the Library and, in the headless build, of the Scene2D. Build it in Release.
+		Run it from the App folder, so that the maps are found.
+		Usage: Benchmark [-results file] [-baseline file] [-tolerance percent] [-sweep file]
+		-results writes the results into a CSV file, one benchmark in each row.
+		-sweep writes the generated scenes of the headless build into a CSV file, one scene in each row, so that
+		the frame time can be plotted against the size of the world and the number of entities.
+		-baseline compares the results against a CSV file written by an earlier run, and returns 1 if any
+		benchmark is worse by more than the tolerance, which is 10 percent by default. Without it, they are compared
+		against Benchmark/Baseline.csv, which is kept with the code. It was measured on one machine, so write a new
+		one with -baseline none -results ../Benchmark/Baseline.csv before comparing on another.
+ By: agent
+ Date: Oct 2026
+ */
+#include "JobSystemBenchmark.h"
+#include "EngineBenchmark.h"
+#ifdef HEADLESS
+#include "SceneBenchmark.h"
+#endif
+
+// Include CBenchmarkResults, to write and compare the results
+#include "TimeControl/BenchmarkResults.h"
+// Include CPerfCounters, to print the hardware events of the zones next to the times
+#include "TimeControl/PerfCounters.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+using namespace std;
+
+// The baseline which is kept with the code, from the App folder
+static const char* pDefaultBaselineFilename = "../Benchmark/Baseline.csv";
+
+int main(int argc, char* argv[])
+{
+	std::string resultsFilename;
+	std::string baselineFilename;
+	std::string sweepFilename;
+	double dTolerance = 10.0;
+	bool bValidArguments = (argc % 2 == 1);
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "-results") == 0)
+			resultsFilename = argv[i + 1];
+		else if (strcmp(argv[i], "-baseline") == 0)
+			baselineFilename = argv[i + 1];
+		else if (strcmp(argv[i], "-tolerance") == 0)
+			dTolerance = atof(argv[i + 1]);
+		else if (strcmp(argv[i], "-sweep") == 0)
+			sweepFilename = argv[i + 1];
+		else
+			bValidArguments = false;
+	}
+	if ((bValidArguments == false) || (dTolerance < 0.0))
+	{
+		cout << "Usage: " << argv[0] << " [-results file] [-baseline file] [-tolerance percent] [-sweep file]" << endl;
+		return 2;
+	}
+
+	// Compare against the baseline which is kept with the code, if it is there
+	if (baselineFilename.empty())
+	{
+		if (std::ifstream(pDefaultBaselineFilename))
+			baselineFilename = pDefaultBaselineFilename;
+		else
+			cout << "There is no " << pDefaultBaselineFilename << " to compare against. Run it from the App folder." << endl;
+	}
+	else if (baselineFilename == "none")
+	{
+		baselineFilename.clear();
+	}
+
+	// Load the baseline first, so that a wrong filename does not waste a whole run
+	CBenchmarkResults cBaseline;
+	if ((!baselineFilename.empty()) && (cBaseline.LoadCSV(baselineFilename) == false))
+		return 2;
+
+	CBenchmarkResults cResults;
+
+	// Run the CJobSystem benchmarks
+	CJobSystemBenchmark cJobSystemBenchmark;
+	cJobSystemBenchmark.Run(cResults);
+
+	// Run the benchmarks of the Library classes which the 2D engine uses
+	cout << endl;
+	CEngineBenchmark cEngineBenchmark;
+	cEngineBenchmark.Run(cResults);
+
+#ifdef HEADLESS
+	// Run the benchmarks of the Scene2D, which need the null OpenGL of the headless build
+	cout << endl;
+	CSceneBenchmark cSceneBenchmark;
+	if (cSceneBenchmark.Run(cResults, sweepFilename) == false)
+		return 2;
+#endif
+
+	// Print the hardware events of the zones, when it is built with ENABLE_PERF_COUNTERS
+	if (CPerfCounters::IsEnabled())
+	{
+		cout << endl;
+		CPerfCounters::GetInstance()->PrintReport(cout);
+	}
+	CPerfCounters::GetInstance()->Destroy();
+
+	if ((!resultsFilename.empty()) && (cResults.WriteCSV(resultsFilename) == false))
+		return 2;
+
+	if (!baselineFilename.empty())
+	{
+		cout << endl << "== Compared with " << baselineFilename << " ==" << endl;
+		if (cResults.Compare(cBaseline, dTolerance, cout) > 0)
+			return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,141 @@
+/**
+ Resource registry template
+ @brief Stores resources in an array and gives each one a dense integer handle when it is registered.
+		The handle is resolved by indexing the array, so per-frame code should keep and use handles.
+		Lookup by name is still available for load-time code.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+template <typename T>
+class CResourceRegistry
+{
+public:
+	// The handle of a resource which is not in this registry
+	static const int INVALID_HANDLE = -1;
+
+	// Constructor
+	CResourceRegistry(void)
+	{
+	}
+
+	// Destructor
+	virtual ~CResourceRegistry(void)
+	{
+	}
+
+	/**
+	 @brief Register a resource
+	 @param _name A const std::string& variable containing the name of the resource
+	 @param _resource A T variable containing the resource
+	 @return The handle of the resource, or INVALID_HANDLE if the name is empty or already registered
+	 */
+	int Register(const std::string& _name, T _resource)
+	{
+		if ((_name.empty()) || (nameMap.count(_name) != 0))
+			return INVALID_HANDLE;
+
+		const int iHandle = (int)resources.size();
+		resources.push_back(_resource);
+		names.push_back(_name);
+		nameMap[_name] = iHandle;
+		return iHandle;
+	}
+
+	/**
+	 @brief Remove a resource. Its handle is not given out again, so other handles stay valid.
+	 @param iHandle A const int variable containing the handle of the resource
+	 @return true if the resource was removed
+	 */
+	bool Remove(const int iHandle)
+	{
+		if (!IsValid(iHandle))
+			return false;
+
+		nameMap.erase(names[iHandle]);
+		resources[iHandle] = T();
+		names[iHandle].clear();
+		return true;
+	}
+
+	/**
+	 @brief Remove all the resources and reset the handles
+	 */
+	void Clear(void)
+	{
+		resources.clear();
+		names.clear();
+		nameMap.clear();
+	}
+
+	/**
+	 @brief Get the handle of a resource by its name. Use this at load time and keep the handle.
+	 @param _name A const std::string& variable containing the name of the resource
+	 @return The handle of the resource, or INVALID_HANDLE if it is not registered
+	 */
+	int GetHandle(const std::string& _name) const
+	{
+		typename std::unordered_map<std::string, int>::const_iterator it = nameMap.find(_name);
+		if (it == nameMap.end())
+			return INVALID_HANDLE;
+		return it->second;
+	}
+
+	/**
+	 @brief Check if a handle refers to a resource in this registry
+	 @param iHandle A const int variable containing the handle of the resource
+	 */
+	bool IsValid(const int iHandle) const
+	{
+		return (iHandle >= 0) && (iHandle < (int)resources.size()) && (!names[iHandle].empty());
+	}
+
+	/**
+	 @brief Get a resource by its handle
+	 @param iHandle A const int variable containing the handle of the resource
+	 @return The resource, or T() if the handle is not valid
+	 */
+	T Get(const int iHandle) const
+	{
+		if (!IsValid(iHandle))
+			return T();
+		return resources[iHandle];
+	}
+
+	/**
+	 @brief Get the name of a resource by its handle
+	 @param iHandle A const int variable containing the handle of the resource
+	 */
+	const std::string& GetName(const int iHandle) const
+	{
+		static const std::string sEmpty;
+		if (!IsValid(iHandle))
+			return sEmpty;
+		return names[iHandle];
+	}
+
+	// Get the number of handles given out. Loop from 0 to this and check IsValid() to visit every resource.
+	int GetNumHandles(void) const
+	{
+		return (int)resources.size();
+	}
+
+protected:
+	// The resources, indexed by their handles
+	std::vector<T> resources;
+
+	// The names of the resources, indexed by their handles. A removed resource has an empty name.
+	std::vector<std::string> names;
+
+	// The handles of the resources, by their names
+	std::unordered_map<std::string, int> nameMap;
+};
+
+// INVALID_HANDLE is defined here as well, for when it is passed by reference
+template <typename T>
+const int CResourceRegistry<T>::INVALID_HANDLE;
@@ -8,7 +8,9 @@
 // Include SingletonTemplate
 #include "../DesignPatterns/SingletonTemplate.h"
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
 // Include GLEW
 #ifndef GLEW_STATIC
@@ -18,6 +20,9 @@
 // Include GLFW
 #include <GLFW/glfw3.h>
 
+// Include CFramePacer for its modes
+#include "../TimeControl/FramePacer.h"
+
 class CSettings : public CSingletonTemplate<CSettings>
 {
 	friend CSingletonTemplate<CSettings>;
@@ -49,6 +54,21 @@ public:
 	// Frame Rate Information
 	const unsigned char FPS = 30; // FPS of this game
 	const unsigned int frameTime = 1000 / FPS; // time for each frame
+	CFramePacer::MODE ePacingMode = CFramePacer::CAPPED; // How the frames are held to FPS. A replay is always UNCAPPED
+
+	// Simulation Information
+	unsigned int iTickRate = 30; // Number of updates per second, independent of the frame rate
+	const double dTickGameTime = 1.0 / 60.0; // Game time which each update steps. The game was tuned at 30 updates a second, each stepping 1/60 of a second
+	unsigned int iMaxTicksPerFrame = 5; // Limits the updates in one frame, so that a slow frame cannot make the next frames slower
+	float fTickInterpolation = 1.0f; // Fraction of a tick from the last update to this frame, used to render the entities between the ticks
+	unsigned int iRandomSeed = 0; // Seed of the random numbers. 0 takes one from the clock, any other value repeats the same run
+	bool bDeterministic = false; // Nothing in the simulation depends on the time which the ticks take, so that a run repeats exactly. Set for recordings, replays and headless runs
+
+	// Stress Scene Information
+	// Extra entities which are placed on empty tiles of the first map when a scene starts, for the benchmarks
+	unsigned int iStressEnemies = 0;
+	unsigned int iStressBullets = 0;
+	unsigned int iStressPickUps = 0;
 
 	// Input control
 	//const bool bActivateMouseInput
@@ -0,0 +1,426 @@
+/**
+ CInputRecorder
+ @brief A class to record the state of the keyboard and the mouse at each tick into a file,
+		and to replay it later through the same controllers. With the seed of the random numbers,
+		which is stored in the file, a replay runs the same game again.
+ By: agent
+ Date: Oct 2026
+ */
+#include "InputRecorder.h"
+
+// Include CMouseController
+#include "MouseController.h"
+// Include CSettings
+#include "../GameControl/Settings.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+// The file starts with this header. The numbers are stored in the byte order of the machine which recorded them.
+struct SInputFileHeader
+{
+	char cMagic[4];				// "NYPI"
+	unsigned int uiVersion;		// The version of this format
+	unsigned int uiTickRate;	// The ticks per second of the recording
+	unsigned int uiRandomSeed;	// The seed of the random numbers
+	unsigned int uiNumKeys;		// The number of keys of CKeyboardController
+	unsigned int uiNumTicks;	// The number of ticks which follow
+};
+static const unsigned int INPUT_FILE_VERSION = 1;
+
+// The mouse buttons which are recorded, which are all the buttons which GLFW has
+static const int NUM_RECORDED_BUTTONS = 8;
+
+/**
+@brief Constructor
+*/
+CInputRecorder::CInputRecorder(void)
+	: eMode(IDLE)
+	, uiReplayPos(0)
+	, uiNumReplayTicks(0)
+	, bReplayFinished(false)
+	, bFirstTick(true)
+	, uiNumTicks(0)
+{
+}
+
+/**
+@brief Destructor
+*/
+CInputRecorder::~CInputRecorder(void)
+{
+	Stop();
+}
+
+/**
+@brief Start recording into a file. Call this before the scene is initialised, so that its seed is recorded.
+	   If there is no seed in CSettings, one is taken from the clock and set in CSettings.
+@param filename A const std::string& variable containing the name of the file
+*/
+bool CInputRecorder::StartRecording(const std::string& filename)
+{
+	Stop();
+
+	recordFile.open(filename.c_str(), std::ios::binary | std::ios::trunc);
+	if (!recordFile.is_open())
+	{
+		cout << "CInputRecorder::StartRecording - Unable to open " << filename << endl;
+		return false;
+	}
+
+	// The scene is seeded from CSettings, so the seed must be known now to be recorded
+	CSettings* cSettings = CSettings::GetInstance();
+	if (cSettings->iRandomSeed == 0)
+		cSettings->iRandomSeed = (unsigned int)std::chrono::high_resolution_clock::now().time_since_epoch().count() | 1;
+	// The replay must step the world the same way as the recording did
+	cSettings->bDeterministic = true;
+
+	SInputFileHeader sHeader;
+	memcpy(sHeader.cMagic, "NYPI", 4);
+	sHeader.uiVersion = INPUT_FILE_VERSION;
+	sHeader.uiTickRate = cSettings->iTickRate;
+	sHeader.uiRandomSeed = cSettings->iRandomSeed;
+	sHeader.uiNumKeys = CKeyboardController::MAX_KEYS;
+	sHeader.uiNumTicks = 0;
+	recordFile.write((const char*)&sHeader, sizeof(sHeader));
+
+	eMode = RECORDING;
+	bFirstTick = true;
+	uiNumTicks = 0;
+
+	cout << "CInputRecorder::StartRecording - " << filename << ", seed " << sHeader.uiRandomSeed << endl;
+
+	return true;
+}
+
+/**
+@brief Start replaying a file. Call this before the scene is initialised, so that the recorded seed is used.
+	   The recorded tick rate and seed are set in CSettings.
+@param filename A const std::string& variable containing the name of the file
+*/
+bool CInputRecorder::StartReplay(const std::string& filename)
+{
+	Stop();
+
+	std::ifstream replayFile(filename.c_str(), std::ios::binary | std::ios::ate);
+	if (!replayFile.is_open())
+	{
+		cout << "CInputRecorder::StartReplay - Unable to open " << filename << endl;
+		return false;
+	}
+	const std::streamsize iSize = replayFile.tellg();
+	if (iSize < (std::streamsize)sizeof(SInputFileHeader))
+	{
+		cout << "CInputRecorder::StartReplay - " << filename << " is too short" << endl;
+		return false;
+	}
+	replayFile.seekg(0, std::ios::beg);
+	replayData.resize((size_t)iSize);
+	replayFile.read((char*)&replayData[0], iSize);
+
+	SInputFileHeader sHeader;
+	memcpy(&sHeader, &replayData[0], sizeof(sHeader));
+	if ((memcmp(sHeader.cMagic, "NYPI", 4) != 0) || (sHeader.uiVersion != INPUT_FILE_VERSION))
+	{
+		cout << "CInputRecorder::StartReplay - " << filename << " is not an input recording of this version" << endl;
+		replayData.clear();
+		return false;
+	}
+	if (sHeader.uiNumKeys != CKeyboardController::MAX_KEYS)
+	{
+		cout << "CInputRecorder::StartReplay - " << filename << " was recorded with " << sHeader.uiNumKeys << " keys" << endl;
+		replayData.clear();
+		return false;
+	}
+	if (sHeader.uiNumTicks == 0)
+	{
+		cout << "CInputRecorder::StartReplay - " << filename << " has no ticks" << endl;
+		replayData.clear();
+		return false;
+	}
+
+	// Run the replay at the rate and with the seed of the recording
+	CSettings* cSettings = CSettings::GetInstance();
+	cSettings->iTickRate = sHeader.uiTickRate;
+	cSettings->iRandomSeed = sHeader.uiRandomSeed;
+	cSettings->bDeterministic = true;
+
+	eMode = REPLAYING;
+	uiReplayPos = sizeof(SInputFileHeader);
+	uiNumReplayTicks = sHeader.uiNumTicks;
+	bReplayFinished = false;
+	uiNumTicks = 0;
+
+	cout << "CInputRecorder::StartReplay - " << filename << ", " << uiNumReplayTicks << " ticks at "
+		<< sHeader.uiTickRate << " ticks per second, seed " << sHeader.uiRandomSeed << endl;
+
+	return true;
+}
+
+/**
+@brief Stop recording or replaying. A recording is written to its file.
+*/
+void CInputRecorder::Stop(void)
+{
+	if (eMode == RECORDING)
+	{
+		// Write the number of ticks into the header
+		recordFile.seekp(offsetof(SInputFileHeader, uiNumTicks), std::ios::beg);
+		recordFile.write((const char*)&uiNumTicks, sizeof(uiNumTicks));
+		recordFile.close();
+
+		cout << "CInputRecorder::Stop - recorded " << uiNumTicks << " ticks" << endl;
+	}
+	else if (eMode == REPLAYING)
+	{
+		replayData.clear();
+	}
+
+	eMode = IDLE;
+}
+
+/**
+@brief Record or replay the state of the controllers for one tick. CWorld2D calls this at the start of each tick,
+	   so that a recording starts at the first tick of the world and not in the menus. The replay is finished
+	   as soon as its last tick is played, so that the run can end before the next tick.
+*/
+void CInputRecorder::Tick(void)
+{
+	if (eMode == RECORDING)
+	{
+		SInputState sState;
+		ReadState(sState);
+		WriteTick(sState);
+		uiNumTicks++;
+	}
+	else if (eMode == REPLAYING)
+	{
+		if (ReplayTick())
+		{
+			uiNumTicks++;
+			if (uiNumTicks >= uiNumReplayTicks)
+			{
+				Stop();
+				bReplayFinished = true;
+			}
+		}
+		else
+		{
+			// Release the keys and buttons which are still held, so that the game does not carry on with them
+			CKeyboardController::GetInstance()->Reset();
+			for (int i = 0; i < NUM_RECORDED_BUTTONS; i++)
+			{
+				CMouseController::GetInstance()->UpdateMouseButtonReleased(i);
+			}
+			Stop();
+			bReplayFinished = true;
+		}
+	}
+}
+
+/**
+@brief Get the mode
+*/
+CInputRecorder::MODE CInputRecorder::GetMode(void) const
+{
+	return eMode;
+}
+
+/**
+@brief Check if a file is being recorded
+*/
+bool CInputRecorder::IsRecording(void) const
+{
+	return eMode == RECORDING;
+}
+
+/**
+@brief Check if a file is being replayed. The live inputs should then be ignored.
+*/
+bool CInputRecorder::IsReplaying(void) const
+{
+	return eMode == REPLAYING;
+}
+
+/**
+@brief Check if the last replay has played all its ticks
+*/
+bool CInputRecorder::IsReplayFinished(void) const
+{
+	return bReplayFinished;
+}
+
+/**
+@brief Get the number of ticks recorded or replayed so far
+*/
+unsigned int CInputRecorder::GetNumTicks(void) const
+{
+	return uiNumTicks;
+}
+
+/**
+@brief Get the number of ticks in the file being replayed
+*/
+unsigned int CInputRecorder::GetNumReplayTicks(void) const
+{
+	return uiNumReplayTicks;
+}
+
+/**
+@brief Read the state of the controllers
+@param sState A SInputState& variable which receives the state
+*/
+void CInputRecorder::ReadState(SInputState& sState) const
+{
+	CKeyboardController* cKeyboardController = CKeyboardController::GetInstance();
+	for (int i = 0; i < CKeyboardController::MAX_KEYS; i++)
+	{
+		sState.keys.set(i, cKeyboardController->IsKeyDown(i));
+	}
+
+	CMouseController* cMouseController = CMouseController::GetInstance();
+	sState.dMouseX = cMouseController->GetMousePositionX();
+	sState.dMouseY = cMouseController->GetMousePositionY();
+	sState.ucButtons = 0;
+	for (int i = 0; i < NUM_RECORDED_BUTTONS; i++)
+	{
+		if (cMouseController->IsButtonDown(i))
+			sState.ucButtons |= 1 << i;
+	}
+	sState.dScrollX = cMouseController->GetMouseScrollStatus(CMouseController::SCROLL_TYPE_XOFFSET);
+	sState.dScrollY = cMouseController->GetMouseScrollStatus(CMouseController::SCROLL_TYPE_YOFFSET);
+}
+
+/**
+@brief Write the state which has changed since the last tick to the file. A tick where
+	   nothing has changed takes one byte.
+@param sState A const SInputState& variable containing the state of this tick
+*/
+void CInputRecorder::WriteTick(const SInputState& sState)
+{
+	unsigned char ucFlags = 0;
+	if ((bFirstTick) || (sState.keys != sLastState.keys))
+		ucFlags |= KEYS_CHANGED;
+	if ((bFirstTick) || (sState.dMouseX != sLastState.dMouseX) || (sState.dMouseY != sLastState.dMouseY))
+		ucFlags |= MOUSE_MOVED;
+	if ((bFirstTick) || (sState.ucButtons != sLastState.ucButtons))
+		ucFlags |= BUTTONS_CHANGED;
+	if ((bFirstTick) || (sState.dScrollX != sLastState.dScrollX) || (sState.dScrollY != sLastState.dScrollY))
+		ucFlags |= SCROLL_CHANGED;
+	recordFile.write((const char*)&ucFlags, sizeof(ucFlags));
+
+	// The keys which are down, as only a few are at any time
+	if (ucFlags & KEYS_CHANGED)
+	{
+		unsigned short usNumKeysDown = (unsigned short)sState.keys.count();
+		recordFile.write((const char*)&usNumKeysDown, sizeof(usNumKeysDown));
+		for (unsigned short i = 0; i < CKeyboardController::MAX_KEYS; i++)
+		{
+			if (sState.keys.test(i))
+				recordFile.write((const char*)&i, sizeof(i));
+		}
+	}
+	if (ucFlags & MOUSE_MOVED)
+	{
+		recordFile.write((const char*)&sState.dMouseX, sizeof(sState.dMouseX));
+		recordFile.write((const char*)&sState.dMouseY, sizeof(sState.dMouseY));
+	}
+	if (ucFlags & BUTTONS_CHANGED)
+	{
+		recordFile.write((const char*)&sState.ucButtons, sizeof(sState.ucButtons));
+	}
+	if (ucFlags & SCROLL_CHANGED)
+	{
+		recordFile.write((const char*)&sState.dScrollX, sizeof(sState.dScrollX));
+		recordFile.write((const char*)&sState.dScrollY, sizeof(sState.dScrollY));
+	}
+
+	sLastState = sState;
+	bFirstTick = false;
+}
+
+/**
+@brief Read the next tick from the replay, and apply it to the controllers through the same
+	   methods which the GLFW callbacks use. Only the inputs which differ are applied.
+@return false if there are no more ticks
+*/
+bool CInputRecorder::ReplayTick(void)
+{
+	if ((uiNumTicks >= uiNumReplayTicks) || (uiReplayPos >= replayData.size()))
+		return false;
+
+	const unsigned char* pData = &replayData[0];
+	const size_t uiSize = replayData.size();
+	const unsigned char ucFlags = pData[uiReplayPos++];
+
+	CKeyboardController* cKeyboardController = CKeyboardController::GetInstance();
+	CMouseController* cMouseController = CMouseController::GetInstance();
+
+	if (ucFlags & KEYS_CHANGED)
+	{
+		unsigned short usNumKeysDown = 0;
+		if (uiReplayPos + sizeof(usNumKeysDown) > uiSize)
+			return false;
+		memcpy(&usNumKeysDown, pData + uiReplayPos, sizeof(usNumKeysDown));
+		uiReplayPos += sizeof(usNumKeysDown);
+		if (uiReplayPos + usNumKeysDown * sizeof(unsigned short) > uiSize)
+			return false;
+
+		std::bitset<CKeyboardController::MAX_KEYS> keys;
+		for (unsigned short i = 0; i < usNumKeysDown; i++)
+		{
+			unsigned short usKey = 0;
+			memcpy(&usKey, pData + uiReplayPos, sizeof(usKey));
+			uiReplayPos += sizeof(usKey);
+			if (usKey < CKeyboardController::MAX_KEYS)
+				keys.set(usKey);
+		}
+		for (int i = 0; i < CKeyboardController::MAX_KEYS; i++)
+		{
+			if (keys.test(i) != cKeyboardController->IsKeyDown(i))
+				cKeyboardController->Update(i, keys.test(i) ? GLFW_PRESS : GLFW_RELEASE);
+		}
+	}
+	if (ucFlags & MOUSE_MOVED)
+	{
+		double arrPosition[2];
+		if (uiReplayPos + sizeof(arrPosition) > uiSize)
+			return false;
+		memcpy(arrPosition, pData + uiReplayPos, sizeof(arrPosition));
+		uiReplayPos += sizeof(arrPosition);
+		cMouseController->UpdateMousePosition(arrPosition[0], arrPosition[1]);
+	}
+	if (ucFlags & BUTTONS_CHANGED)
+	{
+		if (uiReplayPos + 1 > uiSize)
+			return false;
+		const unsigned char ucButtons = pData[uiReplayPos++];
+		for (int i = 0; i < NUM_RECORDED_BUTTONS; i++)
+		{
+			const bool bDown = (ucButtons & (1 << i)) != 0;
+			if (bDown == cMouseController->IsButtonDown(i))
+				continue;
+			if (bDown)
+				cMouseController->UpdateMouseButtonPressed(i);
+			else
+				cMouseController->UpdateMouseButtonReleased(i);
+		}
+	}
+	if (ucFlags & SCROLL_CHANGED)
+	{
+		double arrScroll[2];
+		if (uiReplayPos + sizeof(arrScroll) > uiSize)
+			return false;
+		memcpy(arrScroll, pData + uiReplayPos, sizeof(arrScroll));
+		uiReplayPos += sizeof(arrScroll);
+		// The controller adds up the scrolling, so add the difference to reach the recorded status
+		cMouseController->UpdateMouseScroll(
+			arrScroll[0] - cMouseController->GetMouseScrollStatus(CMouseController::SCROLL_TYPE_XOFFSET),
+			arrScroll[1] - cMouseController->GetMouseScrollStatus(CMouseController::SCROLL_TYPE_YOFFSET));
+	}
+
+	return true;
+}
@@ -0,0 +1,116 @@
+/**
+ CInputRecorder
+ @brief A class to record the state of the keyboard and the mouse at each tick into a file,
+		and to replay it later through the same controllers. With the seed of the random numbers,
+		which is stored in the file, a replay runs the same game again.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include CKeyboardController
+#include "KeyboardController.h"
+
+#include <bitset>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class CInputRecorder : public CSingletonTemplate<CInputRecorder>
+{
+	friend CSingletonTemplate<CInputRecorder>;
+public:
+	enum MODE
+	{
+		IDLE = 0,
+		RECORDING,
+		REPLAYING,
+		NUM_MODES
+	};
+
+	// Start recording into a file. Call this before the scene is initialised, so that its seed is recorded.
+	bool StartRecording(const std::string& filename);
+
+	// Start replaying a file. Call this before the scene is initialised, so that the recorded seed is used.
+	bool StartReplay(const std::string& filename);
+
+	// Stop recording or replaying. A recording is written to its file.
+	void Stop(void);
+
+	// Record or replay the state of the controllers for one tick. CWorld2D calls this at the start of each tick.
+	void Tick(void);
+
+	// Get the mode
+	MODE GetMode(void) const;
+
+	// Check if a file is being recorded
+	bool IsRecording(void) const;
+
+	// Check if a file is being replayed. The live inputs should then be ignored.
+	bool IsReplaying(void) const;
+
+	// Check if the last replay has played all its ticks. The run should then end before the next tick.
+	bool IsReplayFinished(void) const;
+
+	// Get the number of ticks recorded or replayed so far
+	unsigned int GetNumTicks(void) const;
+
+	// Get the number of ticks in the file being replayed
+	unsigned int GetNumReplayTicks(void) const;
+
+protected:
+	// The flags at the start of each tick, which tell what has changed since the last tick
+	enum TICK_FLAGS
+	{
+		KEYS_CHANGED = 1 << 0,
+		MOUSE_MOVED = 1 << 1,
+		BUTTONS_CHANGED = 1 << 2,
+		SCROLL_CHANGED = 1 << 3
+	};
+
+	// The state of the controllers at a tick
+	struct SInputState
+	{
+		std::bitset<CKeyboardController::MAX_KEYS> keys;
+		double dMouseX, dMouseY;
+		unsigned char ucButtons;
+		double dScrollX, dScrollY;
+	};
+
+	// Constructor
+	CInputRecorder(void);
+
+	// Destructor
+	virtual ~CInputRecorder(void);
+
+	// Read the state of the controllers
+	void ReadState(SInputState& sState) const;
+
+	// Write the state which has changed since the last tick to the file
+	void WriteTick(const SInputState& sState);
+
+	// Read the next tick from the replay, and apply it to the controllers
+	bool ReplayTick(void);
+
+	// The mode
+	MODE eMode;
+
+	// The file being recorded
+	std::ofstream recordFile;
+
+	// The file being replayed, read into memory, and the position of the next tick in it
+	std::vector<unsigned char> replayData;
+	size_t uiReplayPos;
+	unsigned int uiNumReplayTicks;
+	bool bReplayFinished;
+
+	// The state at the last tick, which the next tick is compared with. The first tick is written in full.
+	SInputState sLastState;
+	bool bFirstTick;
+
+	// The number of ticks recorded or replayed so far
+	unsigned int uiNumTicks;
+};
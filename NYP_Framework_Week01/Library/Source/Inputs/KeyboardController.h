@@ -7,7 +7,9 @@
 
 #include "../DesignPatterns/SingletonTemplate.h"
 #include <bitset>
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 class CKeyboardController : public CSingletonTemplate<CKeyboardController>
 {
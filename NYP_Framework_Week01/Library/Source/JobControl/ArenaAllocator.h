@@ -0,0 +1,89 @@
+/**
+ CArenaAllocator
+ @brief An STL allocator which takes its memory from a CScratchArena, so that the temporary containers of a tick
+		do not go through the heap. Freeing a block from the arena does nothing, as the whole arena is released
+		by CJobSystem::ResetScratchArenas() before each tick. When the arena is full, the allocator falls back to
+		the heap, so a container may grow past the arena, but it is then as slow as a std::vector.
+		By default it uses the scratch arena of the calling thread, so CJobSystem must have been initialised.
+		A container which uses it must not be kept after the tick which created it.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include CJobSystem, for the scratch arena of the calling thread
+#include "JobSystem.h"
+
+#include <cstddef>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+template <typename T>
+class CArenaAllocator
+{
+	template <typename U> friend class CArenaAllocator;
+public:
+	typedef T value_type;
+
+	// Constructor, with the scratch arena of the calling thread
+	CArenaAllocator(void)
+		: pArena(&CJobSystem::GetInstance()->GetScratchArena())
+	{
+	}
+
+	// Constructor, with an arena
+	explicit CArenaAllocator(CScratchArena& cArena)
+		: pArena(&cArena)
+	{
+	}
+
+	// Constructor, with the arena of an allocator of another type, as the containers need
+	template <typename U>
+	CArenaAllocator(const CArenaAllocator<U>& cOther)
+		: pArena(cOther.pArena)
+	{
+	}
+
+	// Allocate memory for a number of elements, from the arena if it has room, otherwise from the heap
+	T* allocate(const size_t uiCount)
+	{
+		void* pBlock = pArena->Allocate(uiCount * sizeof(T), alignof(T));
+		if (pBlock == NULL)
+			pBlock = ::operator new(uiCount * sizeof(T));
+		return static_cast<T*>(pBlock);
+	}
+
+	// Free memory from allocate(). Only the memory from the heap is freed now.
+	void deallocate(T* pBlock, const size_t)
+	{
+		if (!pArena->Owns(pBlock))
+			::operator delete(pBlock);
+	}
+
+	// Two allocators are equal if they use the same arena, as one can then free the memory of the other
+	template <typename U>
+	bool operator==(const CArenaAllocator<U>& cOther) const
+	{
+		return pArena == cOther.pArena;
+	}
+
+	template <typename U>
+	bool operator!=(const CArenaAllocator<U>& cOther) const
+	{
+		return pArena != cOther.pArena;
+	}
+
+protected:
+	// The arena which the memory comes from
+	CScratchArena* pArena;
+};
+
+// A std::vector whose memory comes from the scratch arena of the calling thread
+template <typename T>
+using ScratchVector = std::vector<T, CArenaAllocator<T> >;
+
+// A std::string and a std::ostringstream whose memory comes from the scratch arena of the calling thread
+typedef std::basic_string<char, std::char_traits<char>, CArenaAllocator<char> > ScratchString;
+typedef std::basic_ostringstream<char, std::char_traits<char>, CArenaAllocator<char> > ScratchStringStream;
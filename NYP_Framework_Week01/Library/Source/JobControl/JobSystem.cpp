@@ -0,0 +1,450 @@
+/**
+ CJobSystem
+ @brief A pool of worker threads which run jobs. Each thread has its own queue of jobs,
+		and a thread which runs out of jobs steals the oldest job from another queue.
+ By: agent
+ Date: Oct 2026
+ */
+#include "JobSystem.h"
+
+// Include CProfiler to time the jobs
+#include "../TimeControl/Profiler.h"
+
+#include <algorithm>
+#include <iostream>
+using namespace std;
+
+thread_local int CJobSystem::iThreadIndex = -1;
+
+/**
+@brief Constructor
+*/
+CJobCounter::CJobCounter(void)
+	: iValue(0)
+{
+}
+
+/**
+@brief Destructor
+*/
+CJobCounter::~CJobCounter(void)
+{
+}
+
+/**
+@brief Check if all the jobs counted by this counter are finished
+*/
+bool CJobCounter::IsDone(void) const
+{
+	return iValue.load() == 0;
+}
+
+/**
+@brief Get the number of jobs which are not finished yet
+*/
+int CJobCounter::GetValue(void) const
+{
+	return iValue.load();
+}
+
+/**
+@brief Constructor
+*/
+CJobSystem::CJobSystem(void)
+	: iNumWorkers(0)
+	, bRunning(false)
+	, iNumQueued(0)
+	, uiNumJobsRun(0)
+	, uiNumJobsStolen(0)
+{
+}
+
+/**
+@brief Destructor
+*/
+CJobSystem::~CJobSystem(void)
+{
+	Exit();
+}
+
+/**
+@brief Initialise this class instance
+@param iNumWorkers A const int variable containing the number of worker threads.
+	   A negative number uses one less than the number of cores, as the main thread also runs jobs in Wait().
+@param uiScratchArenaSize A const size_t variable containing the size in bytes of each thread's scratch arena
+*/
+bool CJobSystem::Init(const int iNumWorkers, const size_t uiScratchArenaSize)
+{
+	// Stop the workers from an earlier Init()
+	Exit();
+
+	int iWorkers = iNumWorkers;
+	if (iWorkers < 0)
+		iWorkers = std::max(0, (int)std::thread::hardware_concurrency() - 1);
+
+	// One queue and arena for each worker, and one more for the other threads
+	for (int i = 0; i <= iWorkers; i++)
+	{
+		queues.push_back(new SWorkQueue());
+		CScratchArena* cScratchArena = new CScratchArena();
+		cScratchArena->Init(uiScratchArenaSize);
+		scratchArenas.push_back(cScratchArena);
+	}
+
+	uiNumJobsRun = 0;
+	uiNumJobsStolen = 0;
+	this->iNumWorkers = iWorkers;
+	bRunning = true;
+
+	for (int i = 0; i < iWorkers; i++)
+	{
+		workers.push_back(std::thread(&CJobSystem::WorkerMain, this, i));
+	}
+
+	cout << "CJobSystem::Init - " << iWorkers << " worker threads" << endl;
+
+	return true;
+}
+
+/**
+@brief Stop the worker threads. The jobs which are still queued are run on this thread first,
+	   so that no counter is left waiting. Call this from Application::Destroy().
+*/
+void CJobSystem::Exit(void)
+{
+	if (queues.empty())
+		return;
+
+	// Wake up and stop the workers
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		bRunning = false;
+	}
+	sleepCondition.notify_all();
+	for (unsigned int i = 0; i < workers.size(); i++)
+	{
+		workers[i].join();
+	}
+	workers.clear();
+	iNumWorkers = 0;
+
+	// Run the jobs left behind
+	SJob sJob;
+	while (TakeJob((int)queues.size() - 1, sJob))
+	{
+		Run(sJob);
+	}
+
+	for (unsigned int i = 0; i < queues.size(); i++)
+	{
+		delete queues[i];
+		delete scratchArenas[i];
+	}
+	queues.clear();
+	scratchArenas.clear();
+}
+
+/**
+@brief Schedule a job
+@param job A const JobFunction& variable containing the job
+@param pCounter A CJobCounter* variable which is incremented now and decremented when the job finishes. It can be NULL.
+*/
+void CJobSystem::Schedule(const JobFunction& job, CJobCounter* pCounter)
+{
+	if (pCounter)
+		pCounter->iValue++;
+
+	SJob sJob;
+	sJob.function = job;
+	sJob.pCounter = pCounter;
+
+	// Without a queue, run the job now
+	if (queues.empty())
+	{
+		Run(sJob);
+		return;
+	}
+
+	Push(sJob);
+}
+
+/**
+@brief Schedule a job which is started only after the dependency reaches zero
+@param pDependency A CJobCounter* variable which must reach zero before the job starts
+@param job A const JobFunction& variable containing the job
+@param pCounter A CJobCounter* variable which is incremented now and decremented when the job finishes. It can be NULL.
+*/
+void CJobSystem::ScheduleAfter(CJobCounter* pDependency, const JobFunction& job, CJobCounter* pCounter)
+{
+	if (pDependency)
+	{
+		std::unique_lock<std::mutex> lock(pDependency->waitingMutex);
+		if (pDependency->iValue.load() != 0)
+		{
+			// Release() will schedule the job when the dependency reaches zero
+			if (pCounter)
+				pCounter->iValue++;
+			pDependency->waitingJobs.push_back(std::make_pair(job, pCounter));
+			return;
+		}
+	}
+
+	// The dependency is already done, so the job can start now
+	Schedule(job, pCounter);
+}
+
+/**
+@brief Run jobs on this thread until the counter reaches zero
+@param pCounter A CJobCounter* variable to wait on
+*/
+void CJobSystem::Wait(CJobCounter* pCounter)
+{
+	if (pCounter == NULL)
+		return;
+
+	const int iIndex = GetThreadIndex();
+	SJob sJob;
+	while (pCounter->iValue.load() != 0)
+	{
+		if ((!queues.empty()) && (TakeJob(iIndex, sJob)))
+			Run(sJob);
+		else
+			std::this_thread::yield();
+	}
+
+	// The job which released the counter may still be holding its mutex.
+	// Wait for it, so that the counter can be destroyed safely after this returns.
+	std::lock_guard<std::mutex> lock(pCounter->waitingMutex);
+}
+
+/**
+@brief Split a range of indices into chunks, run them on all the threads and wait for them
+@param iBegin A const int variable containing the first index
+@param iEnd A const int variable containing the index after the last index
+@param iGrainSize A const int variable containing the number of indices in each chunk. 0 picks one from the number of threads.
+@param func A const RangeFunction& variable which is called once for each chunk
+*/
+void CJobSystem::ParallelFor(const int iBegin, const int iEnd, const int iGrainSize, const RangeFunction& func)
+{
+	if (iEnd <= iBegin)
+		return;
+
+	// Aim for a few chunks per thread, so that a slow chunk can be balanced by stealing
+	int iGrain = iGrainSize;
+	if (iGrain <= 0)
+		iGrain = std::max(1, (iEnd - iBegin) / (GetNumThreads() * 4));
+
+	// Not worth splitting, so run it on this thread
+	if ((iNumWorkers == 0) || (iEnd - iBegin <= iGrain))
+	{
+		func(iBegin, iEnd);
+		return;
+	}
+
+	CJobCounter cCounter;
+	int iChunkBegin = iBegin;
+	while (iChunkBegin + iGrain < iEnd)
+	{
+		const int iChunkEnd = iChunkBegin + iGrain;
+		Schedule([&func, iChunkBegin, iChunkEnd]() { func(iChunkBegin, iChunkEnd); }, &cCounter);
+		iChunkBegin = iChunkEnd;
+	}
+
+	// This thread runs the last chunk itself, then helps with the rest
+	func(iChunkBegin, iEnd);
+	Wait(&cCounter);
+}
+
+/**
+@brief Get the number of worker threads
+*/
+int CJobSystem::GetNumWorkers(void) const
+{
+	return iNumWorkers;
+}
+
+/**
+@brief Get the number of threads which run jobs, i.e. the workers and the thread which calls Wait()
+*/
+int CJobSystem::GetNumThreads(void) const
+{
+	return iNumWorkers + 1;
+}
+
+/**
+@brief Get the index of this thread. Workers are 0 to GetNumWorkers()-1, any other thread is GetNumWorkers().
+*/
+int CJobSystem::GetThreadIndex(void) const
+{
+	if (iThreadIndex < 0)
+		return iNumWorkers;
+	return iThreadIndex;
+}
+
+/**
+@brief Get the scratch arena of this thread. The threads which are not workers share one arena,
+	   so only the main thread should use it outside of a job.
+*/
+CScratchArena& CJobSystem::GetScratchArena(void)
+{
+	return *scratchArenas[GetThreadIndex()];
+}
+
+/**
+@brief Reset the scratch arenas of all the threads. Call this only when no jobs are running.
+*/
+void CJobSystem::ResetScratchArenas(void)
+{
+	for (unsigned int i = 0; i < scratchArenas.size(); i++)
+	{
+		scratchArenas[i]->Reset();
+	}
+}
+
+/**
+@brief Get the number of jobs run since Init()
+*/
+unsigned int CJobSystem::GetNumJobsRun(void) const
+{
+	return uiNumJobsRun.load();
+}
+
+/**
+@brief Get the number of jobs which were stolen from another thread's queue since Init()
+*/
+unsigned int CJobSystem::GetNumJobsStolen(void) const
+{
+	return uiNumJobsStolen.load();
+}
+
+/**
+@brief The loop of a worker thread
+@param iIndex A const int variable containing the index of this worker
+*/
+void CJobSystem::WorkerMain(const int iIndex)
+{
+	iThreadIndex = iIndex;
+	PROFILE_THREAD("Worker");
+
+	SJob sJob;
+	while (bRunning.load())
+	{
+		if (TakeJob(iIndex, sJob))
+		{
+			Run(sJob);
+			continue;
+		}
+
+		// Nothing to do, so sleep until a job is pushed
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleepCondition.wait(lock, [this]() { return (!bRunning.load()) || (iNumQueued.load() > 0); });
+	}
+}
+
+/**
+@brief Add a job to the queue of this thread
+@param sJob A const SJob& variable containing the job
+*/
+void CJobSystem::Push(const SJob& sJob)
+{
+	SWorkQueue* sQueue = queues[GetThreadIndex()];
+	{
+		std::lock_guard<std::mutex> lock(sQueue->mutex);
+		sQueue->jobs.push_back(sJob);
+	}
+
+	// Count the job under the sleep mutex, so that a worker going to sleep cannot miss it
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		iNumQueued++;
+	}
+	sleepCondition.notify_one();
+}
+
+/**
+@brief Take the newest job from a thread's own queue, or steal the oldest job from another queue
+@param iIndex A const int variable containing the index of the thread
+@param sJob A SJob& variable which receives the job
+@return true if a job was taken
+*/
+bool CJobSystem::TakeJob(const int iIndex, SJob& sJob)
+{
+	if (iNumQueued.load() == 0)
+		return false;
+
+	// The own queue first, newest job first, as its data is most likely still in the cache
+	{
+		SWorkQueue* sQueue = queues[iIndex];
+		std::lock_guard<std::mutex> lock(sQueue->mutex);
+		if (!sQueue->jobs.empty())
+		{
+			sJob = sQueue->jobs.back();
+			sQueue->jobs.pop_back();
+			iNumQueued--;
+			return true;
+		}
+	}
+
+	// Then the other queues, oldest job first
+	const int iNumQueues = (int)queues.size();
+	for (int i = 1; i < iNumQueues; i++)
+	{
+		SWorkQueue* sQueue = queues[(iIndex + i) % iNumQueues];
+		std::lock_guard<std::mutex> lock(sQueue->mutex);
+		if (!sQueue->jobs.empty())
+		{
+			sJob = sQueue->jobs.front();
+			sQueue->jobs.pop_front();
+			iNumQueued--;
+			uiNumJobsStolen++;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+@brief Run a job and release its counter
+@param sJob A SJob& variable containing the job
+*/
+void CJobSystem::Run(SJob& sJob)
+{
+	PROFILE_ZONE("Job");
+
+	sJob.function();
+	sJob.function = nullptr;
+	uiNumJobsRun++;
+
+	Release(sJob.pCounter);
+}
+
+/**
+@brief Release a counter after one of its jobs has finished. If it reaches zero, the jobs
+	   waiting on it are scheduled.
+@param pCounter A CJobCounter* variable containing the counter. It can be NULL.
+*/
+void CJobSystem::Release(CJobCounter* pCounter)
+{
+	if (pCounter == NULL)
+		return;
+
+	std::vector<std::pair<std::function<void(void)>, CJobCounter*> > releasedJobs;
+	{
+		std::lock_guard<std::mutex> lock(pCounter->waitingMutex);
+		if (--pCounter->iValue == 0)
+			releasedJobs.swap(pCounter->waitingJobs);
+	}
+
+	// The counter may be destroyed from here on, so only the local copy is used
+	for (unsigned int i = 0; i < releasedJobs.size(); i++)
+	{
+		SJob sJob;
+		sJob.function = releasedJobs[i].first;
+		sJob.pCounter = releasedJobs[i].second;
+		if (queues.empty())
+			Run(sJob);
+		else
+			Push(sJob);
+	}
+}
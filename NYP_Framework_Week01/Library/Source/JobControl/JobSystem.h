@@ -0,0 +1,175 @@
+/**
+ CJobSystem
+ @brief A pool of worker threads which run jobs. Each thread has its own queue of jobs,
+		and a thread which runs out of jobs steals the oldest job from another queue.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include CScratchArena
+#include "ScratchArena.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ CJobCounter
+ @brief Counts the jobs which are not finished yet. Wait on it to know when a group of jobs
+		are done, or schedule jobs after it so that they start only when it reaches zero.
+ */
+class CJobCounter
+{
+	friend class CJobSystem;
+public:
+	// Constructor
+	CJobCounter(void);
+
+	// Destructor
+	~CJobCounter(void);
+
+	// Check if all the jobs counted by this counter are finished
+	bool IsDone(void) const;
+
+	// Get the number of jobs which are not finished yet
+	int GetValue(void) const;
+
+protected:
+	// The number of jobs which are not finished yet
+	std::atomic<int> iValue;
+
+	// Protects waitingJobs, and is held while the counter is released
+	std::mutex waitingMutex;
+
+	// The jobs which start when this counter reaches zero
+	std::vector<std::pair<std::function<void(void)>, CJobCounter*> > waitingJobs;
+
+private:
+	// A counter is shared by address, so it cannot be copied
+	CJobCounter(const CJobCounter&);
+	CJobCounter& operator=(const CJobCounter&);
+};
+
+class CJobSystem : public CSingletonTemplate<CJobSystem>
+{
+	friend CSingletonTemplate<CJobSystem>;
+public:
+	// A job
+	typedef std::function<void(void)> JobFunction;
+
+	// A job which runs over a range of indices, from iBegin to before iEnd
+	typedef std::function<void(const int iBegin, const int iEnd)> RangeFunction;
+
+	// Initialise this class instance. A negative number of workers uses one less than the number of cores.
+	bool Init(const int iNumWorkers = -1, const size_t uiScratchArenaSize = 1024 * 1024);
+
+	// Stop the worker threads. The jobs which are still queued are run on this thread first.
+	void Exit(void);
+
+	// Schedule a job. The counter, if any, is incremented now and decremented when the job finishes.
+	void Schedule(const JobFunction& job, CJobCounter* pCounter = NULL);
+
+	// Schedule a job which is started only after the dependency reaches zero
+	void ScheduleAfter(CJobCounter* pDependency, const JobFunction& job, CJobCounter* pCounter = NULL);
+
+	// Run jobs on this thread until the counter reaches zero
+	void Wait(CJobCounter* pCounter);
+
+	// Split a range of indices into chunks, run them on all the threads and wait for them.
+	// A grain size of 0 picks a chunk size from the number of threads.
+	void ParallelFor(const int iBegin, const int iEnd, const int iGrainSize, const RangeFunction& func);
+
+	// Get the number of worker threads
+	int GetNumWorkers(void) const;
+
+	// Get the number of threads which run jobs, i.e. the workers and the thread which calls Wait()
+	int GetNumThreads(void) const;
+
+	// Get the index of this thread. Workers are 0 to GetNumWorkers()-1, any other thread is GetNumWorkers().
+	int GetThreadIndex(void) const;
+
+	// Get the scratch arena of this thread
+	CScratchArena& GetScratchArena(void);
+
+	// Reset the scratch arenas of all the threads. Call this only when no jobs are running.
+	void ResetScratchArenas(void);
+
+	// Get the number of jobs run since Init()
+	unsigned int GetNumJobsRun(void) const;
+
+	// Get the number of jobs which were stolen from another thread's queue since Init()
+	unsigned int GetNumJobsStolen(void) const;
+
+protected:
+	// A job waiting in a queue
+	struct SJob
+	{
+		JobFunction function;
+		CJobCounter* pCounter;
+	};
+
+	// The queue of a thread. The owner takes the newest job, a thief takes the oldest.
+	struct SWorkQueue
+	{
+		std::mutex mutex;
+		std::deque<SJob> jobs;
+	};
+
+	// Constructor
+	CJobSystem(void);
+
+	// Destructor
+	virtual ~CJobSystem(void);
+
+	// The loop of a worker thread
+	void WorkerMain(const int iIndex);
+
+	// Add a job to the queue of this thread
+	void Push(const SJob& sJob);
+
+	// Take a job from a thread's own queue, or steal one from another queue
+	bool TakeJob(const int iIndex, SJob& sJob);
+
+	// Run a job and release its counter
+	void Run(SJob& sJob);
+
+	// Release a counter after one of its jobs has finished
+	void Release(CJobCounter* pCounter);
+
+	// The worker threads
+	std::vector<std::thread> workers;
+
+	// The number of worker threads. It is kept apart from workers, which is only changed by Init() and Exit().
+	int iNumWorkers;
+
+	// The queues of the threads. The last queue is shared by all the threads which are not workers.
+	std::vector<SWorkQueue*> queues;
+
+	// The scratch arenas of the threads, indexed the same way as the queues
+	std::vector<CScratchArena*> scratchArenas;
+
+	// Set to false to stop the workers
+	std::atomic<bool> bRunning;
+
+	// The number of jobs in all the queues
+	std::atomic<int> iNumQueued;
+
+	// The idle workers sleep on this until a job is pushed
+	std::mutex sleepMutex;
+	std::condition_variable sleepCondition;
+
+	// Statistics
+	std::atomic<unsigned int> uiNumJobsRun;
+	std::atomic<unsigned int> uiNumJobsStolen;
+
+	// The index of the worker which is this thread, or -1 if this thread is not a worker
+	static thread_local int iThreadIndex;
+};
@@ -0,0 +1,113 @@
+/**
+ CScratchArena
+ @brief A block of memory which hands out allocations by moving a pointer forward.
+		All the allocations are released together by Reset(), so a job can use it for
+		temporary buffers without calling new or delete.
+ By: agent
+ Date: Oct 2026
+ */
+#include "ScratchArena.h"
+
+/**
+@brief Constructor
+*/
+CScratchArena::CScratchArena(void)
+	: pMemory(NULL)
+	, uiCapacity(0)
+	, uiOffset(0)
+	, uiPeak(0)
+{
+}
+
+/**
+@brief Destructor
+*/
+CScratchArena::~CScratchArena(void)
+{
+	if (pMemory)
+	{
+		delete[] pMemory;
+		pMemory = NULL;
+	}
+}
+
+/**
+@brief Initialise this class instance with a capacity in bytes
+@param uiCapacity A const size_t variable containing the capacity in bytes
+*/
+bool CScratchArena::Init(const size_t uiCapacity)
+{
+	if (pMemory)
+	{
+		delete[] pMemory;
+		pMemory = NULL;
+	}
+
+	pMemory = new unsigned char[uiCapacity];
+	this->uiCapacity = uiCapacity;
+	uiOffset = 0;
+	uiPeak = 0;
+
+	return true;
+}
+
+/**
+@brief Allocate a block of memory
+@param uiSize A const size_t variable containing the number of bytes
+@param uiAlignment A const size_t variable containing the alignment, which must be a power of 2
+@return The block of memory, or NULL if the arena is full
+*/
+void* CScratchArena::Allocate(const size_t uiSize, const size_t uiAlignment)
+{
+	const size_t uiStart = (uiOffset + uiAlignment - 1) & ~(uiAlignment - 1);
+	if (uiStart + uiSize > uiCapacity)
+		return NULL;
+
+	uiOffset = uiStart + uiSize;
+	if (uiOffset > uiPeak)
+		uiPeak = uiOffset;
+
+	return pMemory + uiStart;
+}
+
+/**
+@brief Release all the allocations
+*/
+void CScratchArena::Reset(void)
+{
+	uiOffset = 0;
+}
+
+/**
+@brief Check if a block of memory is inside this arena
+@param pBlock A const void* variable containing the block of memory
+*/
+bool CScratchArena::Owns(const void* pBlock) const
+{
+	const unsigned char* pByte = static_cast<const unsigned char*>(pBlock);
+	return (pMemory != NULL) && (pByte >= pMemory) && (pByte < pMemory + uiCapacity);
+}
+
+/**
+@brief Get the number of bytes allocated since the last Reset()
+*/
+size_t CScratchArena::GetUsed(void) const
+{
+	return uiOffset;
+}
+
+/**
+@brief Get the most bytes allocated between two Reset()
+*/
+size_t CScratchArena::GetPeak(void) const
+{
+	return uiPeak;
+}
+
+/**
+@brief Get the capacity in bytes
+*/
+size_t CScratchArena::GetCapacity(void) const
+{
+	return uiCapacity;
+}
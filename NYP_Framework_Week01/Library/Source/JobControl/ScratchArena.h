@@ -0,0 +1,67 @@
+/**
+ CScratchArena
+ @brief A block of memory which hands out allocations by moving a pointer forward.
+		All the allocations are released together by Reset(), so a job can use it for
+		temporary buffers without calling new or delete.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+#include <cstddef>
+
+class CScratchArena
+{
+public:
+	// Constructor
+	CScratchArena(void);
+
+	// Destructor
+	virtual ~CScratchArena(void);
+
+	// Initialise this class instance with a capacity in bytes
+	bool Init(const size_t uiCapacity);
+
+	// Allocate a block of memory. Returns NULL if the arena is full.
+	void* Allocate(const size_t uiSize, const size_t uiAlignment = sizeof(void*));
+
+	// Allocate an array of a type. The constructors are not called.
+	template <typename T>
+	T* AllocateArray(const size_t uiCount)
+	{
+		return static_cast<T*>(Allocate(uiCount * sizeof(T), alignof(T)));
+	}
+
+	// Release all the allocations
+	void Reset(void);
+
+	// Check if a block of memory is inside this arena
+	bool Owns(const void* pBlock) const;
+
+	// Get the number of bytes allocated since the last Reset()
+	size_t GetUsed(void) const;
+
+	// Get the most bytes allocated between two Reset()
+	size_t GetPeak(void) const;
+
+	// Get the capacity in bytes
+	size_t GetCapacity(void) const;
+
+protected:
+	// The memory of this arena
+	unsigned char* pMemory;
+
+	// The capacity in bytes
+	size_t uiCapacity;
+
+	// The offset of the next allocation
+	size_t uiOffset;
+
+	// The most bytes allocated between two Reset()
+	size_t uiPeak;
+
+private:
+	// An arena owns its memory, so it cannot be copied
+	CScratchArena(const CScratchArena&);
+	CScratchArena& operator=(const CScratchArena&);
+};
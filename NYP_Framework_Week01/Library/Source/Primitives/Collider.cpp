@@ -1,7 +1,10 @@
 #include "Collider.h"
 
 // Include Shader Manager
-#include "..\RenderControl\ShaderManager.h"
+#include "../RenderControl/ShaderManager.h"
+#include "../RenderControl/RenderState.h"
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "../RenderControl/GLTelemetry.h"
 
 #include <GLFW/glfw3.h>
 
@@ -120,8 +123,8 @@ void CCollider::SetColliderShader(const std::string& _name)
 void CCollider::PreRender(void)
 {
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CRenderState::GetInstance()->SetBlend(true);
+	CRenderState::GetInstance()->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Use the shader defined for this class
 	CShaderManager::GetInstance()->Use(sColliderShaderName);
@@ -140,9 +143,9 @@ void CCollider::Render(void)
 	CShaderManager::GetInstance()->activeShader->setMat4("projection", colliderProjection);
 
 	// render box
-	glBindVertexArray(colliderVAO);
+	CRenderState::GetInstance()->BindVertexArray(colliderVAO);
 	glDrawArrays(GL_LINE_LOOP, 0, 36);
-	glBindVertexArray(0);
+	CRenderState::GetInstance()->BindVertexArray(0);
 }
 
 /**
@@ -151,5 +154,5 @@ void CCollider::Render(void)
 void CCollider::PostRender(void)
 {
 	// Deactivate blending mode
-	glDisable(GL_BLEND);
+	CRenderState::GetInstance()->SetBlend(false);
 }
@@ -7,14 +7,20 @@
 #include "MeshBuilder.h"
 
  // Include Shader Manager
-#include "..\RenderControl\ShaderManager.h"
+#include "../RenderControl/ShaderManager.h"
+// Include Render State
+#include "../RenderControl/RenderState.h"
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "../RenderControl/GLTelemetry.h"
 
 // Include ImageLoader
-#include "..\System\ImageLoader.h"
+#include "../System/ImageLoader.h"
 
 #include <iostream>
 using namespace std;
 
+unsigned int CEntity2D::uiNumEntitiesCreated = 0;
+
 /**
  @brief Constructor This constructor has protected access modifier as this class will be a Singleton
  */
@@ -23,8 +29,10 @@ CEntity2D::CEntity2D(void)
 	, VBO(0)
 	, EBO(0)
 	, iTextureID(0)
+	, iShaderHandle(CResourceRegistry<CShader*>::INVALID_HANDLE)
 	, cSettings(NULL)
 	, mesh(NULL)
+	, uiEntityID(uiNumEntitiesCreated++)
 {
 	transform = glm::mat4(1.0f);	// make sure to initialize matrix to identity matrix first
 
@@ -36,6 +44,7 @@ CEntity2D::CEntity2D(void)
 
 	// Initialise vec2UVCoordinate
 	vec2UVCoordinate = glm::vec2(0.0f);
+	vec2PrevUVCoordinate = glm::vec2(0.0f);
 }
 
 /**
@@ -116,6 +125,7 @@ bool CEntity2D::Init(void)
  void CEntity2D::SetShader(const std::string& _name)
  {
 	 this->sShaderName = _name;
+	 this->iShaderHandle = CShaderManager::GetInstance()->GetHandle(_name);
  }
 
 /**
@@ -131,14 +141,14 @@ void CEntity2D::Update(const double dElapsedTime)
 void CEntity2D::PreRender(void)
 {
 	// bind textures on corresponding texture units
-	glActiveTexture(GL_TEXTURE0);
+	CRenderState::GetInstance()->ActiveTexture(GL_TEXTURE0);
 
 	// Activate blending mode
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	CRenderState::GetInstance()->SetBlend(true);
+	CRenderState::GetInstance()->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// Activate the shader
-	CShaderManager::GetInstance()->Use("Shader2D");
+	CShaderManager::GetInstance()->Use(iShaderHandle);
 }
 
 /**
@@ -146,27 +156,27 @@ void CEntity2D::PreRender(void)
  */
 void CEntity2D::Render(void)
 {
-	// get matrix's uniform location and set matrix
-	unsigned int transformLoc = glGetUniformLocation(CShaderManager::GetInstance()->activeShader->ID, "transform");
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
+	// get matrix's uniform handle
+	CShader* activeShader = CShaderManager::GetInstance()->activeShader;
+	activeShader->cacheUniform("transform", transformUniform);
 
 	transform = glm::mat4(1.0f); // make sure to initialize matrix to identity matrix first
 	transform = glm::translate(transform, glm::vec3(vec2UVCoordinate.x,
 													vec2UVCoordinate.y,
 													0.0f));
 	// Update the shaders with the latest transform
-	glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(transform));
+	activeShader->set(transformUniform, transform);
 
 	// Get the texture to be rendered
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, iTextureID);
-		glBindVertexArray(VAO);
+	CRenderState::GetInstance()->ActiveTexture(GL_TEXTURE0);
+	CRenderState::GetInstance()->BindTexture2D(iTextureID);
+		CRenderState::GetInstance()->BindVertexArray(VAO);
 
 		//CS: Use mesh to render
 		mesh->Render();
 
-		glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
+		CRenderState::GetInstance()->BindVertexArray(0);
+	CRenderState::GetInstance()->BindTexture2D(0);
 }
 
 /**
@@ -175,5 +185,29 @@ void CEntity2D::Render(void)
 void CEntity2D::PostRender(void)
 {
 	// Disable blending
-	glDisable(GL_BLEND);
+	CRenderState::GetInstance()->SetBlend(false);
+}
+
+/**
+ @brief Get the number of this entity, in the order which the entities were created
+ */
+unsigned int CEntity2D::GetEntityID(void) const
+{
+	return uiEntityID;
+}
+
+/**
+ @brief Get the UV coordinates to render at, between the tick before and the last tick.
+		An entity which moved more than a tile in one tick, such as one which has just spawned, is not interpolated.
+ @param vec2PrevUVCoordinate A const glm::vec2& variable containing the UV coordinates of the tick before
+ @param vec2UVCoordinate A const glm::vec2& variable containing the UV coordinates of the last tick
+ */
+glm::vec2 CEntity2D::InterpolateUVCoordinate(const glm::vec2& vec2PrevUVCoordinate, const glm::vec2& vec2UVCoordinate) const
+{
+	CSettings* cSettings = CSettings::GetInstance();
+	if ((fabs(vec2UVCoordinate.x - vec2PrevUVCoordinate.x) > cSettings->TILE_WIDTH) ||
+		(fabs(vec2UVCoordinate.y - vec2PrevUVCoordinate.y) > cSettings->TILE_HEIGHT))
+		return vec2UVCoordinate;
+
+	return glm::mix(vec2PrevUVCoordinate, vec2UVCoordinate, cSettings->fTickInterpolation);
 }
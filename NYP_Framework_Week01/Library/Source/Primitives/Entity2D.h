@@ -17,11 +17,14 @@
 #include <includes/gtc/type_ptr.hpp>
 
 // Include Settings
-#include "..\GameControl\Settings.h"
+#include "../GameControl/Settings.h"
 #include <string>
 
 //CS: Include Mesh.h to use to draw (include vertex and index buffers)
 #include "Mesh.h"
+
+// Include CUniform
+#include "../RenderControl/Shader.h"
 using namespace std;
 
 class CEntity2D
@@ -51,6 +54,9 @@ public:
 	// PostRender
 	virtual void PostRender(void);
 
+	// Get the number of this entity, in the order which the entities were created
+	unsigned int GetEntityID(void) const;
+
 	// The vec2 which stores the indices of an Entity2D in the Map2D
 	glm::vec2 vec2Index;
 
@@ -61,10 +67,19 @@ public:
 	// The vec2 variable which stores the UV coordinates to render the Entity2D
 	glm::vec2 vec2UVCoordinate;
 
+	// The UV coordinates of the tick before, to render the Entity2D between the ticks
+	glm::vec2 vec2PrevUVCoordinate;
+
 protected:
+	// Get the UV coordinates to render at, between the tick before and the last tick
+	glm::vec2 InterpolateUVCoordinate(const glm::vec2& vec2PrevUVCoordinate, const glm::vec2& vec2UVCoordinate) const;
+
 	// Name of Shader Program instance
 	std::string sShaderName;
 
+	// Handle of the Shader Program instance in the CShaderManager
+	int iShaderHandle;
+
 	//CS: The mesh that is used to draw objects
 	CMesh* mesh;
 
@@ -77,6 +92,15 @@ protected:
 	// A transformation matrix for controlling where to render the entities
 	glm::mat4 transform;
 
+	// The handle to the transform uniform of the shader
+	CUniform<glm::mat4> transformUniform;
+
 	// Settings
 	CSettings* cSettings;
+
+	// The number of this entity. The entities are created on the main thread, so the numbers are the same in every run.
+	unsigned int uiEntityID;
+
+	// The number of entities created so far
+	static unsigned int uiNumEntitiesCreated;
 };
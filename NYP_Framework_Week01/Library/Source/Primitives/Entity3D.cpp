@@ -6,7 +6,9 @@
 #include "Entity3D.h"
 
 // Include ImageLoader
-#include "..\System\ImageLoader.h"
+#include "../System/ImageLoader.h"
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "../RenderControl/GLTelemetry.h"
 
 #include <iostream>
 using namespace std;
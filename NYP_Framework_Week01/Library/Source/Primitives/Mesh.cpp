@@ -5,6 +5,8 @@
 #include <GL/glew.h>
 #define GLEW_STATIC
 #endif
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "../RenderControl/GLTelemetry.h"
 
 /**
  @brief Constructor
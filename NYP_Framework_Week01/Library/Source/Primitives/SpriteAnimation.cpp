@@ -8,7 +8,9 @@ Sprite Animation
 */
 /******************************************************************************/
 #include "SpriteAnimation.h"
-#include "GL\glew.h"
+#include "GL/glew.h"
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "../RenderControl/GLTelemetry.h"
 
 /******************************************************************************/
 /*!
@@ -285,4 +287,29 @@ void CSpriteAnimation::Reset()
 {
 	currentFrame = animationList[currentAnimation]->frames[0];
 	playCount = 0;
-}
\ No newline at end of file
+}
+
+/******************************************************************************/
+/*!
+\brief
+Get the texture coordinates of the current frame, using the same layout
+as CMeshBuilder::GenerateSpriteAnimation
+
+param uvMin - the bottom-left texture coordinate of the frame
+
+param uvMax - the top-right texture coordinate of the frame
+
+\exception None
+\return None
+*/
+/******************************************************************************/
+void CSpriteAnimation::GetCurrentFrameUV(glm::vec2& uvMin, glm::vec2& uvMax) const
+{
+	float width = 1.f / col;
+	float height = 1.f / row;
+	int i = currentFrame / col;
+	int j = currentFrame % col;
+
+	uvMin = glm::vec2(j * width, 1.f - height - i * height);
+	uvMax = uvMin + glm::vec2(width, height);
+}
@@ -79,6 +79,9 @@ public:
 	void Resume();
 	void Reset();
 
+	//Get the texture coordinates of the current frame
+	void GetCurrentFrameUV(glm::vec2& uvMin, glm::vec2& uvMax) const;
+
 private:
 	//number of rows
 	int row;
@@ -0,0 +1,465 @@
+/**
+ CGLTelemetry
+ @brief A class which counts the OpenGL calls of each frame: the draws, the texture binds, the program
+		switches, the vertex array binds and the buffer and texture uploads. It also tracks the textures,
+		buffers and vertex arrays which are alive, with the file and line which created each of them,
+		so that the objects which are never deleted can be reported at shutdown.
+		The calls are only counted when ENABLE_GL_TELEMETRY is defined. Then this header replaces the
+		OpenGL functions which it counts with macros, which call them through this class. Include it in
+		each file which makes these calls; it includes GLEW itself.
+ By: agent
+ Date: Oct 2026
+ */
+// This file calls the real OpenGL functions
+#define GL_TELEMETRY_NO_REDIRECT
+#include "GLTelemetry.h"
+
+#ifndef HEADLESS
+// Include ImGui, for the panel
+#include "../GUI/imgui.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Shorten a path from __FILE__ to the part after the Source folder
+static const char* ShortenPath(const char* pFile)
+{
+	const char* pShort = pFile;
+	for (const char* p = pFile; *p != '\0'; p++)
+	{
+		if ((strncmp(p, "Source/", 7) == 0) || (strncmp(p, "Source\\", 7) == 0))
+			pShort = p + 7;
+	}
+	return pShort;
+}
+
+/**
+@brief Constructor
+*/
+CGLTelemetry::CGLTelemetry(void)
+	: uiNumUploadBytes(0)
+	, uiLastNumUploadBytes(0)
+	, uiFrame(0)
+{
+	for (int i = 0; i < NUM_COUNTERS; i++)
+	{
+		arrNumCalls[i] = 0;
+		arrLastNumCalls[i] = 0;
+	}
+}
+
+/**
+@brief Destructor
+*/
+CGLTelemetry::~CGLTelemetry(void)
+{
+}
+
+/**
+@brief Check if the calls are counted in this build
+*/
+bool CGLTelemetry::IsEnabled(void)
+{
+#ifdef ENABLE_GL_TELEMETRY
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+@brief Start a new frame. The counters of the last frame are kept for display.
+*/
+void CGLTelemetry::NewFrame(void)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	for (int i = 0; i < NUM_COUNTERS; i++)
+	{
+		arrLastNumCalls[i] = arrNumCalls[i];
+		arrNumCalls[i] = 0;
+	}
+	uiLastNumUploadBytes = uiNumUploadBytes;
+	uiNumUploadBytes = 0;
+	uiFrame++;
+}
+
+/**
+@brief Get the number of calls of a counter in the last frame
+@param eCounter A const COUNTER variable containing the counter
+*/
+unsigned int CGLTelemetry::GetNumCalls(const COUNTER eCounter) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return arrLastNumCalls[eCounter];
+}
+
+/**
+@brief Get the number of bytes uploaded into buffers and textures in the last frame
+*/
+uint64_t CGLTelemetry::GetNumUploadBytes(void) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return uiLastNumUploadBytes;
+}
+
+/**
+@brief Get the number of objects of a kind which are alive
+@param eObject A const OBJECT variable containing the kind of object
+*/
+unsigned int CGLTelemetry::GetNumLive(const OBJECT eObject) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return (unsigned int)arrLiveObjects[eObject].size();
+}
+
+/**
+@brief Print the objects which are still alive, grouped by the file and line which created them, with the
+	   sites which created the most objects first. Call it at shutdown, after the objects should have been deleted.
+@param os A std::ostream& variable to print into
+@return The number of objects which are still alive
+*/
+unsigned int CGLTelemetry::PrintLeakReport(std::ostream& os) const
+{
+	if (!IsEnabled())
+	{
+		os << "GL telemetry: not enabled in this build (ENABLE_GL_TELEMETRY)" << endl;
+		return 0;
+	}
+
+	const std::vector<SCreatorSite> sites = GetCreatorSites();
+	unsigned int uiNumLive = 0;
+	for (size_t i = 0; i < sites.size(); i++)
+	{
+		uiNumLive += sites[i].uiCount;
+	}
+
+	if (uiNumLive == 0)
+	{
+		os << "GL telemetry: no textures, buffers or vertex arrays were left alive" << endl;
+		return 0;
+	}
+
+	os << "GL telemetry: " << uiNumLive << " objects were never deleted" << endl;
+	os << setfill(' ') << left << setw(14) << "Object" << right << setw(8) << "Count" << "  Created at" << endl;
+	for (size_t i = 0; i < sites.size(); i++)
+	{
+		os << left << setw(14) << GetObjectName(sites[i].eObject) << right << setw(8) << sites[i].uiCount
+			<< "  " << ShortenPath(sites[i].pFile) << ":" << sites[i].iLine << endl;
+	}
+	return uiNumLive;
+}
+
+/**
+@brief Show the counters of the last frame, the live objects and the lines which created most of them in an ImGui window.
+	   Call it between ImGui::NewFrame() and ImGui::Render().
+@param pbOpen A bool* variable which is set to false when the window is closed, or NULL
+*/
+void CGLTelemetry::RenderImGui(bool* pbOpen)
+{
+#ifndef HEADLESS
+	ImGui::SetNextWindowSize(ImVec2(420.0f, 320.0f), ImGuiCond_FirstUseEver);
+	ImGui::Begin("GL telemetry", pbOpen);
+	if (!IsEnabled())
+	{
+		ImGui::TextColored(ImVec4(1, 1, 0, 1), "The OpenGL calls are not counted in this build. Build it with ENABLE_GL_TELEMETRY.");
+		ImGui::End();
+		return;
+	}
+
+	for (int i = 0; i < NUM_COUNTERS; i++)
+	{
+		ImGui::Text("%-20s %6u", GetCounterName((COUNTER)i), GetNumCalls((COUNTER)i));
+	}
+	ImGui::Text("%-20s %6.1f KB", "Uploaded", GetNumUploadBytes() / 1024.0);
+	ImGui::Separator();
+	for (int i = 0; i < NUM_OBJECTS; i++)
+	{
+		ImGui::Text("Live %-15s %6u", GetObjectName((OBJECT)i), GetNumLive((OBJECT)i));
+	}
+
+	if (ImGui::CollapsingHeader("Created at"))
+	{
+		const std::vector<SCreatorSite> sites = GetCreatorSites();
+		for (size_t i = 0; i < sites.size(); i++)
+		{
+			ImGui::Text("%6u %-13s %s:%d", sites[i].uiCount, GetObjectName(sites[i].eObject), ShortenPath(sites[i].pFile), sites[i].iLine);
+		}
+	}
+	ImGui::End();
+#else
+	(void)pbOpen;
+#endif
+}
+
+/**
+@brief Get the name of a counter
+@param eCounter A const COUNTER variable containing the counter
+*/
+const char* CGLTelemetry::GetCounterName(const COUNTER eCounter)
+{
+	switch (eCounter)
+	{
+	case DRAWS:
+		return "Draws";
+	case TEXTURE_BINDS:
+		return "Texture binds";
+	case PROGRAM_SWITCHES:
+		return "Program switches";
+	case VERTEX_ARRAY_BINDS:
+		return "Vertex array binds";
+	case BUFFER_UPLOADS:
+		return "Buffer uploads";
+	case TEXTURE_UPLOADS:
+		return "Texture uploads";
+	default:
+		return "Unknown";
+	}
+}
+
+/**
+@brief Get the name of a kind of object
+@param eObject A const OBJECT variable containing the kind of object
+*/
+const char* CGLTelemetry::GetObjectName(const OBJECT eObject)
+{
+	switch (eObject)
+	{
+	case TEXTURE:
+		return "Textures";
+	case BUFFER:
+		return "Buffers";
+	case VERTEX_ARRAY:
+		return "Vertex arrays";
+	default:
+		return "Unknown";
+	}
+}
+
+/**
+@brief Count a call
+@param eCounter A const COUNTER variable containing the counter
+@param uiUploadBytes A const uint64_t variable containing the number of bytes which the call uploads
+*/
+void CGLTelemetry::Count(const COUNTER eCounter, const uint64_t uiUploadBytes)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	arrNumCalls[eCounter]++;
+	uiNumUploadBytes += uiUploadBytes;
+}
+
+/**
+@brief Track the objects which were created
+@param eObject A const OBJECT variable containing the kind of the objects
+@param pFile A const char* variable containing the file which created them
+@param iLine A const int variable containing the line which created them
+@param n A GLsizei variable containing the number of objects
+@param names A const GLuint* variable containing the names of the objects
+*/
+void CGLTelemetry::AddObjects(const OBJECT eObject, const char* pFile, const int iLine, GLsizei n, const GLuint* names)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	for (GLsizei i = 0; i < n; i++)
+	{
+		SCreator sCreator;
+		sCreator.pFile = pFile;
+		sCreator.iLine = iLine;
+		sCreator.uiFrame = uiFrame;
+		arrLiveObjects[eObject][names[i]] = sCreator;
+	}
+}
+
+/**
+@brief Track the objects which were deleted. The names which are not alive, such as 0, are skipped, as OpenGL does.
+@param eObject A const OBJECT variable containing the kind of the objects
+@param n A GLsizei variable containing the number of objects
+@param names A const GLuint* variable containing the names of the objects
+*/
+void CGLTelemetry::RemoveObjects(const OBJECT eObject, GLsizei n, const GLuint* names)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	for (GLsizei i = 0; i < n; i++)
+	{
+		arrLiveObjects[eObject].erase(names[i]);
+	}
+}
+
+/**
+@brief Group the live objects by the kind and the line which created them, with the lines which created the most first
+*/
+std::vector<CGLTelemetry::SCreatorSite> CGLTelemetry::GetCreatorSites(void) const
+{
+	std::vector<SCreatorSite> sites;
+	std::lock_guard<std::mutex> lock(mutex);
+	for (int iObject = 0; iObject < NUM_OBJECTS; iObject++)
+	{
+		for (std::unordered_map<GLuint, SCreator>::const_iterator it = arrLiveObjects[iObject].begin(); it != arrLiveObjects[iObject].end(); ++it)
+		{
+			// The pointers from __FILE__ may differ for the same file, so the names are compared
+			size_t i = 0;
+			while ((i < sites.size()) &&
+				((sites[i].eObject != iObject) || (sites[i].iLine != it->second.iLine) || (strcmp(sites[i].pFile, it->second.pFile) != 0)))
+			{
+				i++;
+			}
+			if (i == sites.size())
+			{
+				SCreatorSite sSite;
+				sSite.eObject = (OBJECT)iObject;
+				sSite.pFile = it->second.pFile;
+				sSite.iLine = it->second.iLine;
+				sSite.uiCount = 0;
+				sites.push_back(sSite);
+			}
+			sites[i].uiCount++;
+		}
+	}
+	std::stable_sort(sites.begin(), sites.end(),
+		[](const SCreatorSite& a, const SCreatorSite& b) { return a.uiCount > b.uiCount; });
+	return sites;
+}
+
+/**
+@brief glGenTextures, which tracks the textures
+*/
+void CGLTelemetry::GenTextures(const char* pFile, const int iLine, GLsizei n, GLuint* textures)
+{
+	glGenTextures(n, textures);
+	GetInstance()->AddObjects(TEXTURE, pFile, iLine, n, textures);
+}
+
+/**
+@brief glDeleteTextures, which tracks the textures
+*/
+void CGLTelemetry::DeleteTextures(const char*, const int, GLsizei n, const GLuint* textures)
+{
+	glDeleteTextures(n, textures);
+	GetInstance()->RemoveObjects(TEXTURE, n, textures);
+}
+
+/**
+@brief glGenBuffers, which tracks the buffers
+*/
+void CGLTelemetry::GenBuffers(const char* pFile, const int iLine, GLsizei n, GLuint* buffers)
+{
+	glGenBuffers(n, buffers);
+	GetInstance()->AddObjects(BUFFER, pFile, iLine, n, buffers);
+}
+
+/**
+@brief glDeleteBuffers, which tracks the buffers
+*/
+void CGLTelemetry::DeleteBuffers(const char*, const int, GLsizei n, const GLuint* buffers)
+{
+	glDeleteBuffers(n, buffers);
+	GetInstance()->RemoveObjects(BUFFER, n, buffers);
+}
+
+/**
+@brief glGenVertexArrays, which tracks the vertex arrays
+*/
+void CGLTelemetry::GenVertexArrays(const char* pFile, const int iLine, GLsizei n, GLuint* arrays)
+{
+	glGenVertexArrays(n, arrays);
+	GetInstance()->AddObjects(VERTEX_ARRAY, pFile, iLine, n, arrays);
+}
+
+/**
+@brief glDeleteVertexArrays, which tracks the vertex arrays
+*/
+void CGLTelemetry::DeleteVertexArrays(const char*, const int, GLsizei n, const GLuint* arrays)
+{
+	glDeleteVertexArrays(n, arrays);
+	GetInstance()->RemoveObjects(VERTEX_ARRAY, n, arrays);
+}
+
+/**
+@brief glBindTexture, which counts the binds
+*/
+void CGLTelemetry::BindTexture(GLenum target, GLuint texture)
+{
+	glBindTexture(target, texture);
+	GetInstance()->Count(TEXTURE_BINDS);
+}
+
+/**
+@brief glUseProgram, which counts the program switches
+*/
+void CGLTelemetry::UseProgram(GLuint program)
+{
+	glUseProgram(program);
+	GetInstance()->Count(PROGRAM_SWITCHES);
+}
+
+/**
+@brief glBindVertexArray, which counts the binds
+*/
+void CGLTelemetry::BindVertexArray(GLuint array)
+{
+	glBindVertexArray(array);
+	GetInstance()->Count(VERTEX_ARRAY_BINDS);
+}
+
+/**
+@brief glBufferData, which counts the uploads and their bytes
+*/
+void CGLTelemetry::BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+	glBufferData(target, size, data, usage);
+	GetInstance()->Count(BUFFER_UPLOADS, (data != NULL) ? (uint64_t)size : 0);
+}
+
+/**
+@brief glBufferSubData, which counts the uploads and their bytes
+*/
+void CGLTelemetry::BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+	glBufferSubData(target, offset, size, data);
+	GetInstance()->Count(BUFFER_UPLOADS, (uint64_t)size);
+}
+
+/**
+@brief glTexImage2D, which counts the uploads and their bytes. The bytes are worked out for the 8 bit formats.
+*/
+void CGLTelemetry::TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+	GLint border, GLenum format, GLenum type, const void* pixels)
+{
+	glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+	uint64_t uiBytesPerPixel = 4;
+	if (format == GL_RGB)
+		uiBytesPerPixel = 3;
+	else if (format == GL_LUMINANCE)
+		uiBytesPerPixel = 1;
+	GetInstance()->Count(TEXTURE_UPLOADS, (pixels != NULL) ? (uint64_t)width * height * uiBytesPerPixel : 0);
+}
+
+/**
+@brief glDrawElements, which counts the draws
+*/
+void CGLTelemetry::DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+{
+	glDrawElements(mode, count, type, indices);
+	GetInstance()->Count(DRAWS);
+}
+
+/**
+@brief glDrawElementsBaseVertex, which counts the draws
+*/
+void CGLTelemetry::DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex)
+{
+	glDrawElementsBaseVertex(mode, count, type, indices, basevertex);
+	GetInstance()->Count(DRAWS);
+}
+
+/**
+@brief glDrawArrays, which counts the draws
+*/
+void CGLTelemetry::DrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+	glDrawArrays(mode, first, count);
+	GetInstance()->Count(DRAWS);
+}
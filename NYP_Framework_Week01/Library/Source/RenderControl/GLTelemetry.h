@@ -0,0 +1,183 @@
+/**
+ CGLTelemetry
+ @brief A class which counts the OpenGL calls of each frame: the draws, the texture binds, the program
+		switches, the vertex array binds and the buffer and texture uploads. It also tracks the textures,
+		buffers and vertex arrays which are alive, with the file and line which created each of them,
+		so that the objects which are never deleted can be reported at shutdown.
+		The calls are only counted when ENABLE_GL_TELEMETRY is defined. Then this header replaces the
+		OpenGL functions which it counts with macros, which call them through this class. Include it in
+		each file which makes these calls; it includes GLEW itself.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+class CGLTelemetry : public CSingletonTemplate<CGLTelemetry>
+{
+	friend CSingletonTemplate<CGLTelemetry>;
+public:
+	// The calls which are counted in each frame
+	enum COUNTER
+	{
+		DRAWS = 0,
+		TEXTURE_BINDS,
+		PROGRAM_SWITCHES,
+		VERTEX_ARRAY_BINDS,
+		BUFFER_UPLOADS,
+		TEXTURE_UPLOADS,
+		NUM_COUNTERS
+	};
+
+	// The kinds of objects which are tracked
+	enum OBJECT
+	{
+		TEXTURE = 0,
+		BUFFER,
+		VERTEX_ARRAY,
+		NUM_OBJECTS
+	};
+
+	// Check if the calls are counted in this build
+	static bool IsEnabled(void);
+
+	// Start a new frame. The counters of the last frame are kept.
+	void NewFrame(void);
+
+	// Get the number of calls of a counter in the last frame
+	unsigned int GetNumCalls(const COUNTER eCounter) const;
+
+	// Get the number of bytes uploaded into buffers and textures in the last frame
+	uint64_t GetNumUploadBytes(void) const;
+
+	// Get the number of objects of a kind which are alive
+	unsigned int GetNumLive(const OBJECT eObject) const;
+
+	// Print the objects which are still alive, grouped by the file and line which created them.
+	// Returns the number of objects printed.
+	unsigned int PrintLeakReport(std::ostream& os) const;
+
+	// Show the counters and the live objects in an ImGui window.
+	// Call it between ImGui::NewFrame() and ImGui::Render().
+	void RenderImGui(bool* pbOpen = NULL);
+
+	// Get the name of a counter or a kind of object
+	static const char* GetCounterName(const COUNTER eCounter);
+	static const char* GetObjectName(const OBJECT eObject);
+
+	// The OpenGL functions which are counted, called through the macros below
+	static void GenTextures(const char* pFile, const int iLine, GLsizei n, GLuint* textures);
+	static void DeleteTextures(const char* pFile, const int iLine, GLsizei n, const GLuint* textures);
+	static void GenBuffers(const char* pFile, const int iLine, GLsizei n, GLuint* buffers);
+	static void DeleteBuffers(const char* pFile, const int iLine, GLsizei n, const GLuint* buffers);
+	static void GenVertexArrays(const char* pFile, const int iLine, GLsizei n, GLuint* arrays);
+	static void DeleteVertexArrays(const char* pFile, const int iLine, GLsizei n, const GLuint* arrays);
+	static void BindTexture(GLenum target, GLuint texture);
+	static void UseProgram(GLuint program);
+	static void BindVertexArray(GLuint array);
+	static void BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+	static void BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+	static void TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+		GLint border, GLenum format, GLenum type, const void* pixels);
+	static void DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices);
+	static void DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex);
+	static void DrawArrays(GLenum mode, GLint first, GLsizei count);
+
+protected:
+	// The file and line which created an object, and the frame which it was created in
+	struct SCreator
+	{
+		const char* pFile;
+		int iLine;
+		uint64_t uiFrame;
+	};
+
+	// The live objects of one kind which were created at one line
+	struct SCreatorSite
+	{
+		OBJECT eObject;
+		const char* pFile;
+		int iLine;
+		unsigned int uiCount;
+	};
+
+	// Constructor
+	CGLTelemetry(void);
+
+	// Destructor
+	virtual ~CGLTelemetry(void);
+
+	// Count a call
+	void Count(const COUNTER eCounter, const uint64_t uiUploadBytes = 0);
+
+	// Track the objects which were created or deleted
+	void AddObjects(const OBJECT eObject, const char* pFile, const int iLine, GLsizei n, const GLuint* names);
+	void RemoveObjects(const OBJECT eObject, GLsizei n, const GLuint* names);
+
+	// Group the live objects by the line which created them, with the most first
+	std::vector<SCreatorSite> GetCreatorSites(void) const;
+
+	// The objects may be created by the entities on the threads of the CJobSystem
+	mutable std::mutex mutex;
+
+	// The counters of this frame and of the last frame
+	unsigned int arrNumCalls[NUM_COUNTERS];
+	unsigned int arrLastNumCalls[NUM_COUNTERS];
+	uint64_t uiNumUploadBytes;
+	uint64_t uiLastNumUploadBytes;
+
+	// The live objects of each kind, by their names
+	std::unordered_map<GLuint, SCreator> arrLiveObjects[NUM_OBJECTS];
+
+	// The number of frames since this class instance was created
+	uint64_t uiFrame;
+};
+
+// Replace the counted OpenGL functions with macros which record where they were called from.
+// GLTelemetry.cpp calls the real functions, so it defines GL_TELEMETRY_NO_REDIRECT before including this header.
+#if defined(ENABLE_GL_TELEMETRY) && !defined(GL_TELEMETRY_NO_REDIRECT)
+	#undef glGenTextures
+	#undef glDeleteTextures
+	#undef glGenBuffers
+	#undef glDeleteBuffers
+	#undef glGenVertexArrays
+	#undef glDeleteVertexArrays
+	#undef glBindTexture
+	#undef glUseProgram
+	#undef glBindVertexArray
+	#undef glBufferData
+	#undef glBufferSubData
+	#undef glTexImage2D
+	#undef glDrawElements
+	#undef glDrawElementsBaseVertex
+	#undef glDrawArrays
+	#define glGenTextures(n, textures) CGLTelemetry::GenTextures(__FILE__, __LINE__, n, textures)
+	#define glDeleteTextures(n, textures) CGLTelemetry::DeleteTextures(__FILE__, __LINE__, n, textures)
+	#define glGenBuffers(n, buffers) CGLTelemetry::GenBuffers(__FILE__, __LINE__, n, buffers)
+	#define glDeleteBuffers(n, buffers) CGLTelemetry::DeleteBuffers(__FILE__, __LINE__, n, buffers)
+	#define glGenVertexArrays(n, arrays) CGLTelemetry::GenVertexArrays(__FILE__, __LINE__, n, arrays)
+	#define glDeleteVertexArrays(n, arrays) CGLTelemetry::DeleteVertexArrays(__FILE__, __LINE__, n, arrays)
+	#define glBindTexture CGLTelemetry::BindTexture
+	#define glUseProgram CGLTelemetry::UseProgram
+	#define glBindVertexArray CGLTelemetry::BindVertexArray
+	#define glBufferData CGLTelemetry::BufferData
+	#define glBufferSubData CGLTelemetry::BufferSubData
+	#define glTexImage2D CGLTelemetry::TexImage2D
+	#define glDrawElements CGLTelemetry::DrawElements
+	#define glDrawElementsBaseVertex CGLTelemetry::DrawElementsBaseVertex
+	#define glDrawArrays CGLTelemetry::DrawArrays
+#endif
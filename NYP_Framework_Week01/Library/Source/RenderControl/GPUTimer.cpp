@@ -0,0 +1,202 @@
+/**
+ CGPUTimer
+ @brief This class times the render passes on the GPU with GL_TIME_ELAPSED queries. A query is read back
+		NUM_FRAMES - 1 frames after it was issued, only if its result is ready by then, so that the CPU never
+		waits for the GPU. The times are shown with the frame times, passed to the CFramePacer, and added to
+		the captures of the CProfiler in a "GPU" row.
+ By: agent
+ Date: Oct 2026
+ */
+#include "GPUTimer.h"
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "GLTelemetry.h"
+
+// Include CProfiler, to add the passes to its captures
+#include "../TimeControl/Profiler.h"
+
+#include <iostream>
+using namespace std;
+
+/**
+@brief Constructor
+*/
+CGPUTimer::CGPUTimer(void)
+	: iFrame(0)
+	, iActivePass(NUM_PASSES)
+	, bInitialised(false)
+	, dFrameTime(0.0)
+	, uiNumDropped(0)
+	, pProfileTrack(NULL)
+{
+	for (int i = 0; i < NUM_FRAMES; i++)
+	{
+		for (int j = 0; j < NUM_PASSES; j++)
+		{
+			arrQueries[i][j] = 0;
+			arrIssued[i][j] = false;
+			arrCPUStart[i][j] = 0;
+		}
+	}
+	for (int j = 0; j < NUM_PASSES; j++)
+	{
+		arrPassTimes[j] = 0.0;
+	}
+}
+
+/**
+@brief Destructor. It must be called while the OpenGL context still exists.
+*/
+CGPUTimer::~CGPUTimer(void)
+{
+	if (bInitialised)
+		glDeleteQueries(NUM_FRAMES * NUM_PASSES, &arrQueries[0][0]);
+}
+
+/**
+@brief Create the queries. It needs an OpenGL 3.3 context.
+@return true if the queries were created, otherwise false
+*/
+bool CGPUTimer::Init(void)
+{
+	if (bInitialised)
+		return true;
+
+#ifndef HEADLESS
+	if (!GLEW_VERSION_3_3)
+	{
+		cout << "CGPUTimer::Init - OpenGL 3.3 is needed for the timer queries" << endl;
+		return false;
+	}
+#endif
+
+	glGenQueries(NUM_FRAMES * NUM_PASSES, &arrQueries[0][0]);
+	bInitialised = true;
+
+#ifdef ENABLE_PROFILER
+	pProfileTrack = CProfiler::GetInstance()->CreateTrack("GPU");
+#endif
+	return true;
+}
+
+/**
+@brief Start timing a pass. Only the first time that a pass is rendered in a frame is timed,
+	   and a pass which starts while another is being timed is not timed.
+@param ePass A const PASS variable containing the pass
+*/
+void CGPUTimer::BeginPass(const PASS ePass)
+{
+	if ((!bInitialised) || (iActivePass != NUM_PASSES) || (arrIssued[iFrame][ePass]))
+		return;
+
+	arrCPUStart[iFrame][ePass] = CProfiler::GetTime();
+	glBeginQuery(GL_TIME_ELAPSED, arrQueries[iFrame][ePass]);
+	arrIssued[iFrame][ePass] = true;
+	iActivePass = ePass;
+}
+
+/**
+@brief Stop timing a pass
+@param ePass A const PASS variable containing the pass
+*/
+void CGPUTimer::EndPass(const PASS ePass)
+{
+	if (iActivePass != ePass)
+		return;
+
+	glEndQuery(GL_TIME_ELAPSED);
+	iActivePass = NUM_PASSES;
+}
+
+/**
+@brief Read back the queries which are ready, and start a new frame. Call it once per frame, after the rendering.
+*/
+void CGPUTimer::EndFrame(void)
+{
+	if (!bInitialised)
+		return;
+
+	// The oldest slot was issued NUM_FRAMES - 1 frames ago. Its queries are read now, or dropped if they are
+	// still not ready, as waiting for them would stall the CPU until the GPU has caught up.
+	iFrame = (iFrame + 1) % NUM_FRAMES;
+
+	bool bAnyRead = false;
+	double dSum = 0.0;
+	for (int j = 0; j < NUM_PASSES; j++)
+	{
+		if (!arrIssued[iFrame][j])
+			continue;
+		arrIssued[iFrame][j] = false;
+
+		GLint iAvailable = GL_FALSE;
+		glGetQueryObjectiv(arrQueries[iFrame][j], GL_QUERY_RESULT_AVAILABLE, &iAvailable);
+		if (iAvailable == GL_FALSE)
+		{
+			uiNumDropped++;
+			continue;
+		}
+
+		GLuint64 uiElapsed = 0;
+		glGetQueryObjectui64v(arrQueries[iFrame][j], GL_QUERY_RESULT, &uiElapsed);
+		arrPassTimes[j] = uiElapsed / 1000000.0;
+		dSum += arrPassTimes[j];
+		bAnyRead = true;
+
+		// The GPU only gives the duration, so the pass is placed at the time that the CPU issued it
+		if (pProfileTrack)
+		{
+			const SProfileEvent sEvent = { GetPassName((PASS)j), arrCPUStart[iFrame][j],
+				arrCPUStart[iFrame][j] + uiElapsed, 0, 0 };
+			CProfiler::GetInstance()->AddTrackEvent(pProfileTrack, sEvent);
+		}
+	}
+	if (bAnyRead)
+		dFrameTime = dSum;
+}
+
+/**
+@brief Get the time in milliseconds which the GPU took for a pass, in the last frame which has been read back
+@param ePass A const PASS variable containing the pass
+*/
+double CGPUTimer::GetPassTime(const PASS ePass) const
+{
+	if ((ePass < BACKGROUND) || (ePass >= NUM_PASSES))
+		return 0.0;
+	return arrPassTimes[ePass];
+}
+
+/**
+@brief Get the time in milliseconds which the GPU took for all the passes, in the last frame which has been read back
+*/
+double CGPUTimer::GetFrameTime(void) const
+{
+	return dFrameTime;
+}
+
+/**
+@brief Get the number of queries which were not ready when they were read back, and so were dropped
+*/
+unsigned int CGPUTimer::GetNumDropped(void) const
+{
+	return uiNumDropped;
+}
+
+/**
+@brief Get the name of a pass
+@param ePass A const PASS variable containing the pass
+*/
+const char* CGPUTimer::GetPassName(const PASS ePass)
+{
+	switch (ePass)
+	{
+	case BACKGROUND:
+		return "GPU Background";
+	case MAP:
+		return "GPU Map";
+	case ENTITIES:
+		return "GPU Entities";
+	case GUI:
+		return "GPU GUI";
+	default:
+		return "GPU";
+	}
+}
@@ -0,0 +1,88 @@
+/**
+ CGPUTimer
+ @brief This class times the render passes on the GPU with GL_TIME_ELAPSED queries. A query is read back
+		NUM_FRAMES - 1 frames after it was issued, only if its result is ready by then, so that the CPU never
+		waits for the GPU. The times are shown with the frame times, passed to the CFramePacer, and added to
+		the captures of the CProfiler in a "GPU" row.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+#include <cstdint>
+
+class CProfileThread;
+
+class CGPUTimer : public CSingletonTemplate<CGPUTimer>
+{
+	friend CSingletonTemplate<CGPUTimer>;
+public:
+	// The passes which are timed. Only one pass can be timed at a time, so they cannot be inside each other.
+	enum PASS
+	{
+		BACKGROUND = 0,	// The full-screen backgrounds
+		MAP,			// The tilemap
+		ENTITIES,		// The player, the enemies, the pickups and the bullets
+		GUI,			// ImGui
+		NUM_PASSES
+	};
+
+	// The number of frames of queries. The queries of a frame are read back when their slot comes round again.
+	enum { NUM_FRAMES = 4 };
+
+	// Create the queries. It needs an OpenGL 3.3 context.
+	bool Init(void);
+
+	// Start timing a pass. Only the first time that a pass is rendered in a frame is timed.
+	void BeginPass(const PASS ePass);
+	// Stop timing a pass
+	void EndPass(const PASS ePass);
+
+	// Read back the queries which are ready, and start a new frame. Call it once per frame, after the rendering.
+	void EndFrame(void);
+
+	// Get the time in milliseconds which the GPU took for a pass, in the last frame which has been read back
+	double GetPassTime(const PASS ePass) const;
+	// Get the time in milliseconds which the GPU took for all the passes, in the last frame which has been read back
+	double GetFrameTime(void) const;
+	// Get the number of queries which were not ready when they were read back, and so were dropped
+	unsigned int GetNumDropped(void) const;
+
+	// Get the name of a pass
+	static const char* GetPassName(const PASS ePass);
+
+protected:
+	// Constructor
+	CGPUTimer(void);
+
+	// Destructor
+	virtual ~CGPUTimer(void);
+
+	// The queries of each frame and pass, if they were issued, and when the CPU issued them, in nanoseconds
+	GLuint arrQueries[NUM_FRAMES][NUM_PASSES];
+	bool arrIssued[NUM_FRAMES][NUM_PASSES];
+	uint64_t arrCPUStart[NUM_FRAMES][NUM_PASSES];
+
+	// The frame whose queries are being issued
+	int iFrame;
+	// The pass which is being timed, or NUM_PASSES if none is
+	int iActivePass;
+	bool bInitialised;
+
+	// The times in milliseconds of the last frame which has been read back
+	double arrPassTimes[NUM_PASSES];
+	double dFrameTime;
+	unsigned int uiNumDropped;
+
+	// The row of the CProfiler which the passes are added to
+	CProfileThread* pProfileTrack;
+};
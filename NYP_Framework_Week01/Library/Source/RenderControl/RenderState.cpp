@@ -0,0 +1,243 @@
+/**
+ CRenderState
+ @brief This class remembers the OpenGL states which are changed most often while rendering,
+		and skips the calls which would set a state to the value it already has.
+ By: agent
+ Date: Oct 2026
+ */
+#include "RenderState.h"
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "GLTelemetry.h"
+
+/**
+@brief Constructor
+*/
+CRenderState::CRenderState(void)
+{
+	for (int i = 0; i < NUM_STATES; i++)
+	{
+		arrNumCalls[i] = 0;
+		arrNumAvoided[i] = 0;
+		arrLastNumCalls[i] = 0;
+		arrLastNumAvoided[i] = 0;
+	}
+
+	Invalidate();
+}
+
+/**
+@brief Destructor
+*/
+CRenderState::~CRenderState(void)
+{
+}
+
+/**
+@brief Start a new frame. The counters of the last frame are kept for display,
+	   and the cached states are forgotten as textures and VAOs may have been bound
+	   directly while loading during the update.
+*/
+void CRenderState::NewFrame(void)
+{
+	for (int i = 0; i < NUM_STATES; i++)
+	{
+		arrLastNumCalls[i] = arrNumCalls[i];
+		arrLastNumAvoided[i] = arrNumAvoided[i];
+		arrNumCalls[i] = 0;
+		arrNumAvoided[i] = 0;
+	}
+
+	Invalidate();
+}
+
+/**
+@brief Forget the cached states, so that the next call for each state is always made
+*/
+void CRenderState::Invalidate(void)
+{
+	uiProgram = UNKNOWN;
+	uiBlend = UNKNOWN;
+	eSourceFactor = UNKNOWN;
+	eDestinationFactor = UNKNOWN;
+	eActiveTexture = UNKNOWN;
+	for (int i = 0; i < NUM_TEXTURE_UNITS; i++)
+	{
+		arrTextures[i] = UNKNOWN;
+	}
+	uiVAO = UNKNOWN;
+}
+
+/**
+@brief Use a shader program
+@param uiProgram A const GLuint variable containing the ID of the program
+*/
+void CRenderState::UseProgram(const GLuint uiProgram)
+{
+	if (this->uiProgram == uiProgram)
+	{
+		Count(PROGRAM, true);
+		return;
+	}
+
+	glUseProgram(uiProgram);
+	this->uiProgram = uiProgram;
+	Count(PROGRAM, false);
+}
+
+/**
+@brief Enable or disable blending
+@param bEnable A const bool variable which is true to enable blending
+*/
+void CRenderState::SetBlend(const bool bEnable)
+{
+	const GLuint uiBlend = bEnable ? GL_TRUE : GL_FALSE;
+	if (this->uiBlend == uiBlend)
+	{
+		Count(BLEND, true);
+		return;
+	}
+
+	if (bEnable)
+		glEnable(GL_BLEND);
+	else
+		glDisable(GL_BLEND);
+	this->uiBlend = uiBlend;
+	Count(BLEND, false);
+}
+
+/**
+@brief Set the blending function
+@param eSourceFactor A const GLenum variable containing the source factor
+@param eDestinationFactor A const GLenum variable containing the destination factor
+*/
+void CRenderState::BlendFunc(const GLenum eSourceFactor, const GLenum eDestinationFactor)
+{
+	if ((this->eSourceFactor == eSourceFactor) && (this->eDestinationFactor == eDestinationFactor))
+	{
+		Count(BLEND_FUNC, true);
+		return;
+	}
+
+	glBlendFunc(eSourceFactor, eDestinationFactor);
+	this->eSourceFactor = eSourceFactor;
+	this->eDestinationFactor = eDestinationFactor;
+	Count(BLEND_FUNC, false);
+}
+
+/**
+@brief Select the active texture unit
+@param eTextureUnit A const GLenum variable containing the texture unit, e.g. GL_TEXTURE0
+*/
+void CRenderState::ActiveTexture(const GLenum eTextureUnit)
+{
+	if (eActiveTexture == eTextureUnit)
+	{
+		Count(ACTIVE_TEXTURE, true);
+		return;
+	}
+
+	glActiveTexture(eTextureUnit);
+	eActiveTexture = eTextureUnit;
+	Count(ACTIVE_TEXTURE, false);
+}
+
+/**
+@brief Bind a 2D texture to the active texture unit
+@param uiTexture A const GLuint variable containing the ID of the texture
+*/
+void CRenderState::BindTexture2D(const GLuint uiTexture)
+{
+	const int iUnit = (eActiveTexture == UNKNOWN) ? -1 : (int)(eActiveTexture - GL_TEXTURE0);
+
+	// The texture of an unknown or uncached unit is never skipped
+	if ((iUnit < 0) || (iUnit >= NUM_TEXTURE_UNITS))
+	{
+		glBindTexture(GL_TEXTURE_2D, uiTexture);
+		Count(TEXTURE, false);
+		return;
+	}
+
+	if (arrTextures[iUnit] == uiTexture)
+	{
+		Count(TEXTURE, true);
+		return;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, uiTexture);
+	arrTextures[iUnit] = uiTexture;
+	Count(TEXTURE, false);
+}
+
+/**
+@brief Bind a vertex array object
+@param uiVAO A const GLuint variable containing the ID of the vertex array object
+*/
+void CRenderState::BindVertexArray(const GLuint uiVAO)
+{
+	if (this->uiVAO == uiVAO)
+	{
+		Count(VERTEX_ARRAY, true);
+		return;
+	}
+
+	glBindVertexArray(uiVAO);
+	this->uiVAO = uiVAO;
+	Count(VERTEX_ARRAY, false);
+}
+
+/**
+@brief Get the number of calls made for a state in the last frame
+@param sState A const STATE variable containing the state
+*/
+unsigned int CRenderState::GetNumCalls(const STATE sState) const
+{
+	return arrLastNumCalls[sState];
+}
+
+/**
+@brief Get the number of calls avoided for a state in the last frame
+@param sState A const STATE variable containing the state
+*/
+unsigned int CRenderState::GetNumAvoided(const STATE sState) const
+{
+	return arrLastNumAvoided[sState];
+}
+
+/**
+@brief Get the number of calls made for all states in the last frame
+*/
+unsigned int CRenderState::GetTotalCalls(void) const
+{
+	unsigned int uiTotal = 0;
+	for (int i = 0; i < NUM_STATES; i++)
+	{
+		uiTotal += arrLastNumCalls[i];
+	}
+	return uiTotal;
+}
+
+/**
+@brief Get the number of calls avoided for all states in the last frame
+*/
+unsigned int CRenderState::GetTotalAvoided(void) const
+{
+	unsigned int uiTotal = 0;
+	for (int i = 0; i < NUM_STATES; i++)
+	{
+		uiTotal += arrLastNumAvoided[i];
+	}
+	return uiTotal;
+}
+
+/**
+@brief Count a call which was made or avoided
+@param sState A const STATE variable containing the state
+@param bAvoided A const bool variable which is true if the call was avoided
+*/
+void CRenderState::Count(const STATE sState, const bool bAvoided)
+{
+	if (bAvoided)
+		arrNumAvoided[sState]++;
+	else
+		arrNumCalls[sState]++;
+}
@@ -0,0 +1,103 @@
+/**
+ CRenderState
+ @brief This class remembers the OpenGL states which are changed most often while rendering,
+		and skips the calls which would set a state to the value it already has.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+class CRenderState : public CSingletonTemplate<CRenderState>
+{
+	friend CSingletonTemplate<CRenderState>;
+public:
+	// The states which are cached
+	enum STATE
+	{
+		PROGRAM = 0,
+		BLEND,
+		BLEND_FUNC,
+		ACTIVE_TEXTURE,
+		TEXTURE,
+		VERTEX_ARRAY,
+		NUM_STATES
+	};
+
+	// Start a new frame. The counters of the last frame are kept and the cached states are forgotten.
+	void NewFrame(void);
+
+	// Forget the cached states, e.g. after other code has changed them directly
+	void Invalidate(void);
+
+	// Use a shader program
+	void UseProgram(const GLuint uiProgram);
+
+	// Enable or disable blending
+	void SetBlend(const bool bEnable);
+
+	// Set the blending function
+	void BlendFunc(const GLenum eSourceFactor, const GLenum eDestinationFactor);
+
+	// Select the active texture unit
+	void ActiveTexture(const GLenum eTextureUnit);
+
+	// Bind a 2D texture to the active texture unit
+	void BindTexture2D(const GLuint uiTexture);
+
+	// Bind a vertex array object
+	void BindVertexArray(const GLuint uiVAO);
+
+	// Get the number of calls made for a state in the last frame
+	unsigned int GetNumCalls(const STATE sState) const;
+
+	// Get the number of calls avoided for a state in the last frame
+	unsigned int GetNumAvoided(const STATE sState) const;
+
+	// Get the number of calls made for all states in the last frame
+	unsigned int GetTotalCalls(void) const;
+
+	// Get the number of calls avoided for all states in the last frame
+	unsigned int GetTotalAvoided(void) const;
+
+protected:
+	// The value of a state which is not known
+	static const GLuint UNKNOWN = 0xFFFFFFFF;
+
+	// The number of texture units which are cached
+	static const int NUM_TEXTURE_UNITS = 16;
+
+	// Constructor
+	CRenderState(void);
+
+	// Destructor
+	virtual ~CRenderState(void);
+
+	// Count a call which was made or avoided
+	void Count(const STATE sState, const bool bAvoided);
+
+	// The cached states
+	GLuint uiProgram;
+	GLuint uiBlend;
+	GLenum eSourceFactor;
+	GLenum eDestinationFactor;
+	GLenum eActiveTexture;
+	GLuint arrTextures[NUM_TEXTURE_UNITS];
+	GLuint uiVAO;
+
+	// The counters of this frame
+	unsigned int arrNumCalls[NUM_STATES];
+	unsigned int arrNumAvoided[NUM_STATES];
+
+	// The counters of the last frame
+	unsigned int arrLastNumCalls[NUM_STATES];
+	unsigned int arrLastNumAvoided[NUM_STATES];
+};
@@ -11,6 +11,8 @@
 #include <GL/glew.h>
 #define GLEW_STATIC
 #endif
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "GLTelemetry.h"
 
 //#include <glm/glm.hpp>
 #include <includes/glm.hpp>
@@ -21,6 +23,35 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+// A handle to a uniform of a shader, made from the shader's uniform table.
+// The template parameter is the type of the value, so a value of the wrong type cannot be set.
+template <typename T>
+struct CUniform
+{
+    // the location of the uniform, or -1 if the shader does not have it
+    GLint location;
+    // the shader program which this handle was made from
+    unsigned int program;
+
+    CUniform(void) : location(-1), program(0) {}
+    CUniform(GLint location, unsigned int program) : location(location), program(program) {}
+};
+
+// The GL types of the uniforms which a CUniform<T> can be set into
+template <typename T> struct CUniformType { static bool accepts(GLenum type) { return false; } };
+template <> struct CUniformType<bool> { static bool accepts(GLenum type) { return type == GL_BOOL || type == GL_INT; } };
+template <> struct CUniformType<int> { static bool accepts(GLenum type) { return type == GL_INT || type == GL_BOOL || type == GL_SAMPLER_2D || type == GL_SAMPLER_2D_ARRAY || type == GL_SAMPLER_CUBE; } };
+template <> struct CUniformType<float> { static bool accepts(GLenum type) { return type == GL_FLOAT; } };
+template <> struct CUniformType<glm::vec2> { static bool accepts(GLenum type) { return type == GL_FLOAT_VEC2; } };
+template <> struct CUniformType<glm::vec3> { static bool accepts(GLenum type) { return type == GL_FLOAT_VEC3; } };
+template <> struct CUniformType<glm::vec4> { static bool accepts(GLenum type) { return type == GL_FLOAT_VEC4; } };
+template <> struct CUniformType<glm::mat2> { static bool accepts(GLenum type) { return type == GL_FLOAT_MAT2; } };
+template <> struct CUniformType<glm::mat3> { static bool accepts(GLenum type) { return type == GL_FLOAT_MAT3; } };
+template <> struct CUniformType<glm::mat4> { static bool accepts(GLenum type) { return type == GL_FLOAT_MAT4; } };
 
 class CShader
 {
@@ -104,6 +135,8 @@ public:
             glAttachShader(ID, geometry);
         glLinkProgram(ID);
         checkCompileErrors(ID, "PROGRAM");
+        // find all the active uniforms once, so the setters do not look them up by name
+        buildUniformTable();
         // delete the shaders as they're linked into our program now and no longer necessery
         glDeleteShader(vertex);
         glDeleteShader(fragment);
@@ -121,66 +154,200 @@ public:
     { 
         glUseProgram(ID); 
     }
+    // get a handle to a uniform from the uniform table
+    // ------------------------------------------------------------------------
+    template <typename T>
+    CUniform<T> getUniform(const std::string &name) const
+    {
+        std::unordered_map<std::string, UniformInfo>::const_iterator it = uniformTable.find(name);
+        if (it == uniformTable.end())
+        {
+#ifdef _DEBUG
+            if (reportedUniforms.insert(name).second)
+                std::cout << "ERROR::SHADER::UNKNOWN_UNIFORM: " << name << " is not an active uniform of program " << ID << std::endl;
+#endif
+            return CUniform<T>(-1, ID);
+        }
+#ifdef _DEBUG
+        if ((!CUniformType<T>::accepts(it->second.type)) && (reportedUniforms.insert(name).second))
+            std::cout << "ERROR::SHADER::UNIFORM_TYPE_MISMATCH: " << name << " of program " << ID << std::endl;
+#endif
+        return CUniform<T>(it->second.location, ID);
+    }
+    // update a cached handle only if it was not made from this shader
+    // ------------------------------------------------------------------------
+    template <typename T>
+    void cacheUniform(const std::string &name, CUniform<T> &uniform) const
+    {
+        if (uniform.program != ID)
+            uniform = getUniform<T>(name);
+    }
     // utility uniform functions
     // ------------------------------------------------------------------------
+    void set(const CUniform<bool> &uniform, bool value) const
+    {
+        checkUniform(uniform.location, uniform.program);
+        glUniform1i(uniform.location, (int)value);
+    }
+    // ------------------------------------------------------------------------
+    void set(const CUniform<int> &uniform, int value) const
+    {
+        checkUniform(uniform.location, uniform.program);
+        glUniform1i(uniform.location, value);
+    }
+    // ------------------------------------------------------------------------
+    void set(const CUniform<float> &uniform, float value) const
+    {
+        checkUniform(uniform.location, uniform.program);
+        glUniform1f(uniform.location, value);
+    }
+    // ------------------------------------------------------------------------
+    void set(const CUniform<glm::vec2> &uniform, const glm::vec2 &value) const
+    {
+        checkUniform(uniform.location, uniform.program);
+        glUniform2fv(uniform.location, 1, &value[0]);
+    }
+    // ------------------------------------------------------------------------
+    void set(const CUniform<glm::vec3> &uniform, const glm::vec3 &value) const
+    {
+        checkUniform(uniform.location, uniform.program);
+        glUniform3fv(uniform.location, 1, &value[0]);
+    }
+    // ------------------------------------------------------------------------
+    void set(const CUniform<glm::vec4> &uniform, const glm::vec4 &value) const
+    {
+        checkUniform(uniform.location, uniform.program);
+        glUniform4fv(uniform.location, 1, &value[0]);
+    }
+    // ------------------------------------------------------------------------
+    void set(const CUniform<glm::mat2> &uniform, const glm::mat2 &mat) const
+    {
+        checkUniform(uniform.location, uniform.program);
+        glUniformMatrix2fv(uniform.location, 1, GL_FALSE, &mat[0][0]);
+    }
+    // ------------------------------------------------------------------------
+    void set(const CUniform<glm::mat3> &uniform, const glm::mat3 &mat) const
+    {
+        checkUniform(uniform.location, uniform.program);
+        glUniformMatrix3fv(uniform.location, 1, GL_FALSE, &mat[0][0]);
+    }
+    // ------------------------------------------------------------------------
+    void set(const CUniform<glm::mat4> &uniform, const glm::mat4 &mat) const
+    {
+        checkUniform(uniform.location, uniform.program);
+        glUniformMatrix4fv(uniform.location, 1, GL_FALSE, &mat[0][0]);
+    }
+    // setters by name, which look up the uniform table instead of the driver
+    // ------------------------------------------------------------------------
     void setBool(const std::string &name, bool value) const
     {         
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value); 
+        set(getUniform<bool>(name), value);
     }
     // ------------------------------------------------------------------------
     void setInt(const std::string &name, int value) const
     { 
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), value); 
+        set(getUniform<int>(name), value);
     }
     // ------------------------------------------------------------------------
     void setFloat(const std::string &name, float value) const
     { 
-        glUniform1f(glGetUniformLocation(ID, name.c_str()), value); 
+        set(getUniform<float>(name), value);
     }
     // ------------------------------------------------------------------------
     void setVec2(const std::string &name, const glm::vec2 &value) const
     { 
-        glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]); 
+        set(getUniform<glm::vec2>(name), value);
     }
     void setVec2(const std::string &name, float x, float y) const
     { 
-        glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y); 
+        set(getUniform<glm::vec2>(name), glm::vec2(x, y));
     }
     // ------------------------------------------------------------------------
     void setVec3(const std::string &name, const glm::vec3 &value) const
     { 
-        glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]); 
+        set(getUniform<glm::vec3>(name), value);
     }
     void setVec3(const std::string &name, float x, float y, float z) const
     { 
-        glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z); 
+        set(getUniform<glm::vec3>(name), glm::vec3(x, y, z));
     }
     // ------------------------------------------------------------------------
     void setVec4(const std::string &name, const glm::vec4 &value) const
     { 
-        glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]); 
+        set(getUniform<glm::vec4>(name), value);
     }
     void setVec4(const std::string &name, float x, float y, float z, float w) 
     { 
-        glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w); 
+        set(getUniform<glm::vec4>(name), glm::vec4(x, y, z, w));
     }
     // ------------------------------------------------------------------------
     void setMat2(const std::string &name, const glm::mat2 &mat) const
     {
-        glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        set(getUniform<glm::mat2>(name), mat);
     }
     // ------------------------------------------------------------------------
     void setMat3(const std::string &name, const glm::mat3 &mat) const
     {
-        glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        set(getUniform<glm::mat3>(name), mat);
     }
     // ------------------------------------------------------------------------
     void setMat4(const std::string &name, const glm::mat4 &mat) const
     {
-        glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        set(getUniform<glm::mat4>(name), mat);
     }
 
 private:
+    // the location and GL type of an active uniform
+    struct UniformInfo
+    {
+        GLint location;
+        GLenum type;
+    };
+    // the active uniforms of this shader, by name
+    std::unordered_map<std::string, UniformInfo> uniformTable;
+    // the uniforms and the other programs which have been reported, so that each is reported once and not at every draw
+    mutable std::unordered_set<std::string> reportedUniforms;
+    mutable std::unordered_set<unsigned int> reportedPrograms;
+
+    // utility function for building the uniform table after linking.
+    // ------------------------------------------------------------------------
+    void buildUniformTable(void)
+    {
+        GLint count = 0;
+        GLint maxLength = 0;
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+        std::vector<GLchar> nameBuffer(maxLength > 0 ? maxLength : 1);
+        for (GLint i = 0; i < count; ++i)
+        {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(ID, (GLuint)i, (GLsizei)nameBuffer.size(), &length, &size, &type, &nameBuffer[0]);
+            std::string name(&nameBuffer[0], length);
+            // arrays are reported as "name[0]"; store them by their plain name
+            if ((name.size() > 3) && (name.compare(name.size() - 3, 3, "[0]") == 0))
+                name.erase(name.size() - 3);
+            UniformInfo info;
+            info.location = glGetUniformLocation(ID, name.c_str());
+            info.type = type;
+            uniformTable[name] = info;
+        }
+    }
+    // utility function for catching a handle which this shader does not have.
+    // a handle to an unknown uniform was reported by name once, when getUniform() made it.
+    // ------------------------------------------------------------------------
+    void checkUniform(GLint location, unsigned int program) const
+    {
+#ifdef _DEBUG
+        (void)location;
+        if ((program != ID) && (reportedPrograms.insert(program).second))
+            std::cout << "ERROR::SHADER::UNIFORM_FROM_OTHER_PROGRAM: handle of program " << program << " used with program " << ID << std::endl;
+#else
+        (void)location;
+        (void)program;
+#endif
+    }
     // utility function for checking shader compilation/linking errors.
     // ------------------------------------------------------------------------
     void checkCompileErrors(GLuint shader, std::string type)
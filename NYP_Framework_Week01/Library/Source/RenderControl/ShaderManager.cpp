@@ -7,6 +7,11 @@
 #include "ShaderManager.h"
 #include <stdexcept>      // std::invalid_argument
 
+// Include Render State
+#include "RenderState.h"
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "GLTelemetry.h"
+
 /**
 @brief Constructor
 */
@@ -32,14 +37,11 @@ void CShaderManager::Exit(void)
 	// Delete all scenes stored and empty the entire map
 	//activeShader->Release();
 	//activeShader = nullptr;
-	std::map<std::string, CShader*>::iterator it, end;
-	end = shaderMap.end();
-	for (it = shaderMap.begin(); it != end; ++it)
+	for (int iHandle = 0; iHandle < shaderRegistry.GetNumHandles(); iHandle++)
 	{
-		delete it->second;
-		it->second = nullptr;
+		delete shaderRegistry.Get(iHandle);
 	}
-	shaderMap.clear();
+	shaderRegistry.Clear();
 }
 
 /**
@@ -53,15 +55,15 @@ void CShaderManager::Add(	const std::string& _name,
 	if (Check(_name))
 	{
 		// Scene Exist, unable to proceed
-		throw std::exception("Duplicate shader name provided");
+		throw std::runtime_error("Duplicate shader name provided");
 		//Change to avoid crashing
 		return;
 	}
 
 	CShader* cNewShader = new CShader(vertexPath, fragmentPath);
 
-	// Nothing wrong, add the scene to our map
-	shaderMap[_name] = cNewShader;
+	// Nothing wrong, add the scene to our registry
+	shaderRegistry.Register(_name, cNewShader);
 }
 
 /**
@@ -73,20 +75,21 @@ void CShaderManager::Remove(const std::string& _name)
 	if (!Check(_name))
 		return;
 
-	CShader* target = shaderMap[_name];
+	const int iHandle = shaderRegistry.GetHandle(_name);
+	CShader* target = shaderRegistry.Get(iHandle);
 	try {
 		if (target == activeShader)
 		{
-			throw std::exception("Unable to remove active Shader");
+			throw std::runtime_error("Unable to remove active Shader");
 		}
 	}
 	catch (const std::exception& e) {
 		std::cerr << e.what() << std::endl;
 	}
 
-	// Delete and remove from our map
+	// Delete and remove from our registry
 	delete target;
-	shaderMap.erase(_name);
+	shaderRegistry.Remove(iHandle);
 }
 
 /**
@@ -94,20 +97,34 @@ void CShaderManager::Remove(const std::string& _name)
 */
 void CShaderManager::Use(const std::string& _name)
 {
-	try {
-		if (!Check(_name))
-		{
-			// Shader does not exist
-			throw std::exception("Shader does not exist");
-		}
+	const int iHandle = shaderRegistry.GetHandle(_name);
+	if (iHandle == CResourceRegistry<CShader*>::INVALID_HANDLE)
+	{
+		// Shader does not exist, so keep the current one
+		std::cerr << "Shader does not exist: " << _name << std::endl;
+		return;
 	}
-	catch (const std::exception& e) {
-		std::cerr << e.what() << std::endl;
+
+	Use(iHandle);
+}
+
+/**
+@brief Use a Shader by its handle. This is an array index, so use it on per-frame paths.
+*/
+void CShaderManager::Use(const int iHandle)
+{
+	CShader* cShader = shaderRegistry.Get(iHandle);
+	if (cShader == nullptr)
+	{
+		// Shader does not exist, so keep the current one
+		std::cerr << "Shader handle does not exist: " << iHandle << std::endl;
+		return;
 	}
 
-	// if Shader exist, set the activeShader pointer to that Shader
-	activeShader = shaderMap[_name];
-	activeShader->use();
+	// if Shader exist, set the activeShader pointer to that Shader.
+	// The render state skips glUseProgram if it is already in use.
+	activeShader = cShader;
+	CRenderState::GetInstance()->UseProgram(activeShader->ID);
 }
 
 /**
@@ -115,5 +132,13 @@ void CShaderManager::Use(const std::string& _name)
 */
 bool CShaderManager::Check(const std::string& _name)
 {
-	return shaderMap.count(_name) != 0;
+	return shaderRegistry.GetHandle(_name) != CResourceRegistry<CShader*>::INVALID_HANDLE;
+}
+
+/**
+@brief Get the handle of a Shader, to be kept by the caller for Use()
+*/
+int CShaderManager::GetHandle(const std::string& _name) const
+{
+	return shaderRegistry.GetHandle(_name);
 }
\ No newline at end of file
@@ -7,9 +7,10 @@
 #pragma once
 
 // Include SingletonTemplate
-#include "..\DesignPatterns\SingletonTemplate.h"
+#include "../DesignPatterns/SingletonTemplate.h"
+// Include ResourceRegistry
+#include "../DesignPatterns/ResourceRegistry.h"
 
-#include <map>
 #include <string>
 #include "Shader.h"
 
@@ -23,7 +24,9 @@ public:
 	void Add(const std::string& _name, const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr);
 	void Remove(const std::string& _name);
 	void Use(const std::string& _name);
+	void Use(const int iHandle);
 	bool Check(const std::string& _name);
+	int GetHandle(const std::string& _name) const;
 
 	// The current active shader
 	CShader* activeShader;
@@ -35,6 +38,6 @@ protected:
 	// Destructor
 	virtual ~CShaderManager(void);
 
-	// The map containing all the shaders loaded
-	std::map<std::string, CShader*> shaderMap;
+	// The registry containing all the shaders loaded
+	CResourceRegistry<CShader*> shaderRegistry;
 };
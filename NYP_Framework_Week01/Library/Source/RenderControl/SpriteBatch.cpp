@@ -0,0 +1,294 @@
+/**
+ CSpriteBatch
+ @brief This class collects the sprites of the 2D entities for a frame, sorts them by
+		texture and draws them from one streaming vertex buffer.
+ By: agent
+ Date: Oct 2026
+ */
+#include "SpriteBatch.h"
+
+#include "ShaderManager.h"
+#include "RenderState.h"
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "GLTelemetry.h"
+// Include CProfiler to time the drawing of the sprites
+#include "../TimeControl/Profiler.h"
+
+#include <algorithm>
+
+/**
+@brief Constructor
+*/
+CSpriteBatch::CSpriteBatch(void)
+	: sShaderName("Shader2D_Colour")
+	, iShaderHandle(CResourceRegistry<CShader*>::INVALID_HANDLE)
+	, iLayer(0)
+	, VAO(0)
+	, VBO(0)
+	, EBO(0)
+	, uiCapacity(0)
+	, uiNumDrawCalls(0)
+	, uiNumVertices(0)
+	, uiNumSprites(0)
+{
+}
+
+/**
+@brief Destructor
+*/
+CSpriteBatch::~CSpriteBatch(void)
+{
+	if (VAO != 0)
+	{
+		glDeleteVertexArrays(1, &VAO);
+		glDeleteBuffers(1, &VBO);
+		glDeleteBuffers(1, &EBO);
+	}
+}
+
+/**
+@brief Init this class instance
+*/
+bool CSpriteBatch::Init(void)
+{
+	if (VAO != 0)
+		return true;
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &EBO);
+
+	// The vertex layout is the same as CMesh
+	CRenderState::GetInstance()->BindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(glm::vec3));
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(sizeof(glm::vec3) + sizeof(glm::vec4)));
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	CRenderState::GetInstance()->BindVertexArray(0);
+
+	Reserve(512);
+
+	return true;
+}
+
+/**
+@brief Set the name of the shader used to draw the sprites
+@param _name A const std::string& variable containing the name of the shader
+*/
+void CSpriteBatch::SetShader(const std::string& _name)
+{
+	sShaderName = _name;
+	iShaderHandle = CResourceRegistry<CShader*>::INVALID_HANDLE;
+}
+
+/**
+@brief Set the layer of the sprites submitted after this call. Lower layers are drawn first,
+	   so that the sprites of different textures still overlap in the order they were submitted.
+@param iLayer A const int variable containing the layer
+*/
+void CSpriteBatch::SetLayer(const int iLayer)
+{
+	this->iLayer = iLayer;
+}
+
+/**
+@brief Start collecting the sprites for a new frame
+*/
+void CSpriteBatch::Begin(void)
+{
+	sprites.clear();
+	iLayer = 0;
+}
+
+/**
+@brief Add a sprite to be drawn
+@param iTextureID A const unsigned int variable containing the texture of the sprite
+@param vec2Position A const glm::vec2& variable containing the centre of the sprite
+@param vec2Size A const glm::vec2& variable containing the width and height of the sprite
+@param vec4Colour A const glm::vec4& variable containing the tint of the sprite
+@param vec2UVMin A const glm::vec2& variable containing the bottom-left texture coordinate
+@param vec2UVMax A const glm::vec2& variable containing the top-right texture coordinate
+*/
+void CSpriteBatch::Submit(	const unsigned int iTextureID,
+							const glm::vec2& vec2Position,
+							const glm::vec2& vec2Size,
+							const glm::vec4& vec4Colour,
+							const glm::vec2& vec2UVMin,
+							const glm::vec2& vec2UVMax)
+{
+	SSprite sSprite;
+	sSprite.iLayer = iLayer;
+	sSprite.iTextureID = iTextureID;
+	sSprite.vec2Position = vec2Position;
+	sSprite.vec2Size = vec2Size;
+	sSprite.vec4Colour = vec4Colour;
+	sSprite.vec2UVMin = vec2UVMin;
+	sSprite.vec2UVMax = vec2UVMax;
+	sprites.push_back(sSprite);
+}
+
+/**
+@brief Draw all the sprites submitted since Begin(), one draw call for each texture in each layer
+*/
+void CSpriteBatch::End(void)
+{
+	PROFILE_ZONE("CSpriteBatch::End");
+	uiNumDrawCalls = 0;
+	uiNumVertices = 0;
+	uiNumSprites = (unsigned int)sprites.size();
+
+	if (sprites.empty())
+		return;
+
+	if (uiNumSprites > uiCapacity)
+		Reserve(std::max(uiNumSprites, uiCapacity * 2));
+
+	// Sort the sprites by layer, then by texture. Sprites with the same layer and texture keep their order.
+	order.resize(sprites.size());
+	for (unsigned int i = 0; i < order.size(); i++)
+	{
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), [this](const unsigned int a, const unsigned int b)
+	{
+		if (sprites[a].iLayer != sprites[b].iLayer)
+			return sprites[a].iLayer < sprites[b].iLayer;
+		return sprites[a].iTextureID < sprites[b].iTextureID;
+	});
+
+	// Build the vertices in the sorted order
+	vertices.resize(sprites.size() * 4);
+	Vertex* pVertex = &vertices[0];
+	for (unsigned int i = 0; i < order.size(); i++)
+	{
+		const SSprite& sSprite = sprites[order[i]];
+		const glm::vec2 vec2HalfSize = sSprite.vec2Size * 0.5f;
+
+		pVertex[0].position = glm::vec3(sSprite.vec2Position.x - vec2HalfSize.x, sSprite.vec2Position.y - vec2HalfSize.y, 0.0f);
+		pVertex[0].texCoord = glm::vec2(sSprite.vec2UVMin.x, sSprite.vec2UVMin.y);
+		pVertex[1].position = glm::vec3(sSprite.vec2Position.x + vec2HalfSize.x, sSprite.vec2Position.y - vec2HalfSize.y, 0.0f);
+		pVertex[1].texCoord = glm::vec2(sSprite.vec2UVMax.x, sSprite.vec2UVMin.y);
+		pVertex[2].position = glm::vec3(sSprite.vec2Position.x + vec2HalfSize.x, sSprite.vec2Position.y + vec2HalfSize.y, 0.0f);
+		pVertex[2].texCoord = glm::vec2(sSprite.vec2UVMax.x, sSprite.vec2UVMax.y);
+		pVertex[3].position = glm::vec3(sSprite.vec2Position.x - vec2HalfSize.x, sSprite.vec2Position.y + vec2HalfSize.y, 0.0f);
+		pVertex[3].texCoord = glm::vec2(sSprite.vec2UVMin.x, sSprite.vec2UVMax.y);
+		for (int j = 0; j < 4; j++)
+		{
+			pVertex[j].color = sSprite.vec4Colour;
+		}
+		pVertex += 4;
+	}
+
+	// Stream the vertices into the vertex buffer. Orphan the old storage so the driver does not wait for the last frame.
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, uiCapacity * 4 * sizeof(Vertex), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Vertex), &vertices[0]);
+
+	// bind textures on corresponding texture units
+	CRenderState* cRenderState = CRenderState::GetInstance();
+	cRenderState->ActiveTexture(GL_TEXTURE0);
+
+	// Activate blending mode
+	cRenderState->SetBlend(true);
+	cRenderState->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	// Activate the shader. The vertices are already in screen space and carry their own tint.
+	if (iShaderHandle == CResourceRegistry<CShader*>::INVALID_HANDLE)
+		iShaderHandle = CShaderManager::GetInstance()->GetHandle(sShaderName);
+	CShaderManager::GetInstance()->Use(iShaderHandle);
+	CShader* activeShader = CShaderManager::GetInstance()->activeShader;
+	activeShader->cacheUniform("transform", transformUniform);
+	activeShader->cacheUniform("runtimeColour", colourUniform);
+	activeShader->set(transformUniform, glm::mat4(1.0f));
+	activeShader->set(colourUniform, glm::vec4(1.0f));
+
+	cRenderState->BindVertexArray(VAO);
+
+	// Draw each run of sprites with the same layer and texture
+	unsigned int uiStart = 0;
+	while (uiStart < order.size())
+	{
+		const SSprite& sFirst = sprites[order[uiStart]];
+		unsigned int uiEnd = uiStart + 1;
+		while ((uiEnd < order.size()) &&
+			(sprites[order[uiEnd]].iLayer == sFirst.iLayer) &&
+			(sprites[order[uiEnd]].iTextureID == sFirst.iTextureID))
+		{
+			uiEnd++;
+		}
+
+		cRenderState->BindTexture2D(sFirst.iTextureID);
+		glDrawElements(GL_TRIANGLES, (uiEnd - uiStart) * 6, GL_UNSIGNED_INT, (void*)(uiStart * 6 * sizeof(GLuint)));
+
+		uiNumDrawCalls++;
+		uiStart = uiEnd;
+	}
+	uiNumVertices = uiNumSprites * 4;
+
+	cRenderState->BindVertexArray(0);
+	cRenderState->BindTexture2D(0);
+
+	// Disable blending
+	cRenderState->SetBlend(false);
+
+	sprites.clear();
+}
+
+/**
+@brief Get the number of draw calls in the last frame
+*/
+unsigned int CSpriteBatch::GetNumDrawCalls(void) const
+{
+	return uiNumDrawCalls;
+}
+
+/**
+@brief Get the number of vertices in the last frame
+*/
+unsigned int CSpriteBatch::GetNumVertices(void) const
+{
+	return uiNumVertices;
+}
+
+/**
+@brief Get the number of sprites in the last frame
+*/
+unsigned int CSpriteBatch::GetNumSprites(void) const
+{
+	return uiNumSprites;
+}
+
+/**
+@brief Resize the buffers to hold a number of sprites. The index buffer never changes
+	   after this, as every sprite is a quad with the same winding as CMeshBuilder::GenerateQuad.
+@param uiNumSprites A const unsigned int variable containing the number of sprites
+*/
+void CSpriteBatch::Reserve(const unsigned int uiNumSprites)
+{
+	uiCapacity = uiNumSprites;
+
+	std::vector<GLuint> index_buffer_data;
+	index_buffer_data.reserve(uiCapacity * 6);
+	for (unsigned int i = 0; i < uiCapacity; i++)
+	{
+		const GLuint offset = i * 4;
+		index_buffer_data.push_back(offset + 3);
+		index_buffer_data.push_back(offset + 0);
+		index_buffer_data.push_back(offset + 2);
+		index_buffer_data.push_back(offset + 1);
+		index_buffer_data.push_back(offset + 2);
+		index_buffer_data.push_back(offset + 0);
+	}
+
+	CRenderState::GetInstance()->BindVertexArray(VAO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_buffer_data.size() * sizeof(GLuint), &index_buffer_data[0], GL_STATIC_DRAW);
+	CRenderState::GetInstance()->BindVertexArray(0);
+
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, uiCapacity * 4 * sizeof(Vertex), NULL, GL_STREAM_DRAW);
+}
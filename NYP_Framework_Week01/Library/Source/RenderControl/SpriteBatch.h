@@ -0,0 +1,121 @@
+/**
+ CSpriteBatch
+ @brief This class collects the sprites of the 2D entities for a frame, sorts them by
+		texture and draws them from one streaming vertex buffer.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include GLM
+#include <includes/glm.hpp>
+
+// Include Vertex
+#include "../Primitives/Mesh.h"
+
+// Include CUniform
+#include "Shader.h"
+
+#include <vector>
+#include <string>
+
+class CSpriteBatch : public CSingletonTemplate<CSpriteBatch>
+{
+	friend CSingletonTemplate<CSpriteBatch>;
+public:
+	// Init
+	bool Init(void);
+
+	// Set the name of the shader used to draw the sprites
+	void SetShader(const std::string& _name);
+
+	// Set the layer of the sprites submitted after this call. Lower layers are drawn first.
+	void SetLayer(const int iLayer);
+
+	// Start collecting the sprites for a new frame
+	void Begin(void);
+
+	// Add a sprite to be drawn
+	void Submit(const unsigned int iTextureID,
+				const glm::vec2& vec2Position,
+				const glm::vec2& vec2Size,
+				const glm::vec4& vec4Colour = glm::vec4(1.0f),
+				const glm::vec2& vec2UVMin = glm::vec2(0.0f),
+				const glm::vec2& vec2UVMax = glm::vec2(1.0f));
+
+	// Draw all the sprites submitted since Begin()
+	void End(void);
+
+	// Get the number of draw calls in the last frame
+	unsigned int GetNumDrawCalls(void) const;
+
+	// Get the number of vertices in the last frame
+	unsigned int GetNumVertices(void) const;
+
+	// Get the number of sprites in the last frame
+	unsigned int GetNumSprites(void) const;
+
+protected:
+	// A sprite waiting to be drawn
+	struct SSprite
+	{
+		int iLayer;
+		unsigned int iTextureID;
+		glm::vec2 vec2Position;
+		glm::vec2 vec2Size;
+		glm::vec4 vec4Colour;
+		glm::vec2 vec2UVMin;
+		glm::vec2 vec2UVMax;
+	};
+
+	// Constructor
+	CSpriteBatch(void);
+
+	// Destructor
+	virtual ~CSpriteBatch(void);
+
+	// Resize the buffers to hold a number of sprites
+	void Reserve(const unsigned int uiNumSprites);
+
+	// The name of the shader
+	std::string sShaderName;
+
+	// The handle of the shader, resolved from its name on the first draw
+	int iShaderHandle;
+
+	// The layer of the next sprites
+	int iLayer;
+
+	// The sprites for this frame
+	std::vector<SSprite> sprites;
+
+	// The order to draw the sprites in
+	std::vector<unsigned int> order;
+
+	// The vertices built from the sprites
+	std::vector<Vertex> vertices;
+
+	// OpenGL objects
+	unsigned int VAO, VBO, EBO;
+
+	// The handles to the uniforms of the shader
+	CUniform<glm::mat4> transformUniform;
+	CUniform<glm::vec4> colourUniform;
+
+	// The number of sprites which the buffers can hold
+	unsigned int uiCapacity;
+
+	// Statistics of the last frame
+	unsigned int uiNumDrawCalls;
+	unsigned int uiNumVertices;
+	unsigned int uiNumSprites;
+};
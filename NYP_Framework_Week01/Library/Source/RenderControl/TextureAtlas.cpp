@@ -0,0 +1,335 @@
+/**
+ CTextureAtlas
+ @brief A class which packs many images into one texture, so that the sprites which use them can be
+		drawn without switching textures. The images may have different sizes. Each image is given
+		its index in the order which it was added, and the rectangle of texture coordinates which it
+		was packed into.
+ By: agent
+ Date: Oct 2026
+ */
+#include "TextureAtlas.h"
+
+// Include CRenderState to bind the texture
+#include "RenderState.h"
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "GLTelemetry.h"
+// Include CImageLoader to load the images
+#include "../System/ImageLoader.h"
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+using namespace std;
+
+/**
+@brief Constructor
+*/
+CTextureAtlas::CTextureAtlas(void)
+	: uiTextureID(0)
+	, iWidth(0)
+	, iHeight(0)
+{
+}
+
+/**
+@brief Destructor
+*/
+CTextureAtlas::~CTextureAtlas(void)
+{
+	Clear();
+}
+
+/**
+@brief Add an image to be packed. Call Build() after all the images are added.
+@param filename A const std::string& variable containing the name of the image file
+@return The index of the image. An image which was already added keeps its index, so it is only packed once.
+*/
+unsigned int CTextureAtlas::AddImage(const std::string& filename)
+{
+	for (unsigned int i = 0; i < images.size(); i++)
+	{
+		if (images[i].filename == filename)
+			return i;
+	}
+
+	SImage sImage;
+	sImage.filename = filename;
+	sImage.iWidth = 0;
+	sImage.iHeight = 0;
+	sImage.iX = 0;
+	sImage.iY = 0;
+	sImage.vec2UVMin = glm::vec2(0.0f);
+	sImage.vec2UVMax = glm::vec2(1.0f);
+	images.push_back(sImage);
+	return (unsigned int)images.size() - 1;
+}
+
+/**
+@brief Load the images and pack them into one texture. The texture is filtered linearly without mipmaps,
+	   as the mipmaps would blend the images together, so the images are scaled down to about the size
+	   which they are drawn at.
+@param bInvert A const bool variable which is true if the images are flipped vertically, as CImageLoader does
+@param iMaxImageSize A const int variable containing the largest width or height of an image in the atlas
+@return false if an image cannot be loaded or the images do not fit into the largest texture
+*/
+bool CTextureAtlas::Build(const bool bInvert, const int iMaxImageSize)
+{
+	if (images.empty())
+	{
+		cout << "CTextureAtlas::Build() : there are no images to pack" << endl;
+		return false;
+	}
+
+#ifdef HEADLESS
+	// There is no graphics card in the HEADLESS build, so the images are not decoded. Each image takes a cell
+	// of the same size in one row, so that every image still has its own texture coordinates.
+	(void)bInvert;
+	for (unsigned int i = 0; i < images.size(); i++)
+	{
+		images[i].iWidth = iMaxImageSize;
+		images[i].iHeight = iMaxImageSize;
+	}
+#else
+	for (unsigned int i = 0; i < images.size(); i++)
+	{
+		if (LoadPixels(images[i], bInvert, iMaxImageSize) == false)
+			return false;
+	}
+#endif
+
+	// Use the narrowest texture which is about as tall as it is wide
+	const int iMaxTextureSize = 4096;
+	iWidth = 64;
+	iHeight = Pack(iWidth);
+	while ((iHeight > iWidth) && (iWidth < iMaxTextureSize))
+	{
+		iWidth *= 2;
+		iHeight = Pack(iWidth);
+	}
+	if (iHeight > iMaxTextureSize)
+	{
+		cout << "CTextureAtlas::Build() : the images do not fit into a texture of " << iMaxTextureSize << " by " << iMaxTextureSize << endl;
+		return false;
+	}
+
+	// The texture coordinates cover each image exactly. The padding keeps the filtering at its edges within its own pixels.
+	for (unsigned int i = 0; i < images.size(); i++)
+	{
+		SImage& sImage = images[i];
+		sImage.vec2UVMin = glm::vec2((float)sImage.iX / iWidth, (float)sImage.iY / iHeight);
+		sImage.vec2UVMax = glm::vec2((float)(sImage.iX + sImage.iWidth) / iWidth, (float)(sImage.iY + sImage.iHeight) / iHeight);
+	}
+
+	if (uiTextureID != 0)
+		glDeleteTextures(1, &uiTextureID);
+	glGenTextures(1, &uiTextureID);
+
+#ifndef HEADLESS
+	// Copy the images into the atlas, with their edge pixels repeated into the padding around them
+	std::vector<unsigned char> pixels(iWidth * iHeight * 4, 0);
+	for (unsigned int i = 0; i < images.size(); i++)
+	{
+		const SImage& sImage = images[i];
+		for (int iY = -iPadding; iY < sImage.iHeight + iPadding; iY++)
+		{
+			const int iSourceY = std::min(std::max(iY, 0), sImage.iHeight - 1);
+			for (int iX = -iPadding; iX < sImage.iWidth + iPadding; iX++)
+			{
+				const int iSourceX = std::min(std::max(iX, 0), sImage.iWidth - 1);
+				const unsigned char* pSource = &sImage.pixels[(iSourceY * sImage.iWidth + iSourceX) * 4];
+				unsigned char* pTarget = &pixels[((sImage.iY + iY) * iWidth + (sImage.iX + iX)) * 4];
+				std::copy(pSource, pSource + 4, pTarget);
+			}
+		}
+	}
+
+	CRenderState::GetInstance()->BindTexture2D(uiTextureID);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+#if defined(GL_UNPACK_ROW_LENGTH) && !defined(__EMSCRIPTEN__)
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, iWidth, iHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+	CRenderState::GetInstance()->BindTexture2D(0);
+
+	// The pixels are in the graphics card now
+	for (unsigned int i = 0; i < images.size(); i++)
+	{
+		std::vector<unsigned char>().swap(images[i].pixels);
+	}
+#endif
+
+	return true;
+}
+
+/**
+@brief Delete the texture and forget the images
+*/
+void CTextureAtlas::Clear(void)
+{
+	if (uiTextureID != 0)
+	{
+		glDeleteTextures(1, &uiTextureID);
+		uiTextureID = 0;
+	}
+	images.clear();
+	iWidth = 0;
+	iHeight = 0;
+}
+
+/**
+@brief Get the texture which the images were packed into, or 0 if Build() was not called
+*/
+unsigned int CTextureAtlas::GetTextureID(void) const
+{
+	return uiTextureID;
+}
+
+/**
+@brief Get the number of images
+*/
+unsigned int CTextureAtlas::GetNumImages(void) const
+{
+	return (unsigned int)images.size();
+}
+
+/**
+@brief Get the width of the texture
+*/
+int CTextureAtlas::GetWidth(void) const
+{
+	return iWidth;
+}
+
+/**
+@brief Get the height of the texture
+*/
+int CTextureAtlas::GetHeight(void) const
+{
+	return iHeight;
+}
+
+/**
+@brief Get the texture coordinates of an image
+@param uiIndex A const unsigned int variable containing the index of the image
+@param vec2UVMin A glm::vec2& variable which receives the bottom-left texture coordinate
+@param vec2UVMax A glm::vec2& variable which receives the top-right texture coordinate
+*/
+void CTextureAtlas::GetUV(const unsigned int uiIndex, glm::vec2& vec2UVMin, glm::vec2& vec2UVMax) const
+{
+	vec2UVMin = images[uiIndex].vec2UVMin;
+	vec2UVMax = images[uiIndex].vec2UVMax;
+}
+
+/**
+@brief Load an image into RGBA pixels. An image which is larger than iMaxImageSize is scaled down,
+	   keeping its shape, by averaging the pixels which fall into each new pixel.
+@param sImage A SImage& variable containing the name of the image, which receives its pixels and size
+@param bInvert A const bool variable which is true if the image is flipped vertically
+@param iMaxImageSize A const int variable containing the largest width or height of the image
+*/
+bool CTextureAtlas::LoadPixels(SImage& sImage, const bool bInvert, const int iMaxImageSize) const
+{
+	int iSourceWidth = 0;
+	int iSourceHeight = 0;
+	int iNumChannels = 0;
+	unsigned char* pData = CImageLoader::GetInstance()->Load(sImage.filename.c_str(), iSourceWidth, iSourceHeight, iNumChannels, bInvert);
+	if (pData == NULL)
+	{
+		cout << "CTextureAtlas::LoadPixels() : Unable to load " << sImage.filename << endl;
+		return false;
+	}
+
+	const int iLargest = std::max(iSourceWidth, iSourceHeight);
+	if (iLargest > iMaxImageSize)
+	{
+		sImage.iWidth = std::max(1, iSourceWidth * iMaxImageSize / iLargest);
+		sImage.iHeight = std::max(1, iSourceHeight * iMaxImageSize / iLargest);
+	}
+	else
+	{
+		sImage.iWidth = iSourceWidth;
+		sImage.iHeight = iSourceHeight;
+	}
+
+	sImage.pixels.assign(sImage.iWidth * sImage.iHeight * 4, 0);
+	for (int iY = 0; iY < sImage.iHeight; iY++)
+	{
+		const int iSourceY0 = iY * iSourceHeight / sImage.iHeight;
+		const int iSourceY1 = std::max(iSourceY0 + 1, (iY + 1) * iSourceHeight / sImage.iHeight);
+		for (int iX = 0; iX < sImage.iWidth; iX++)
+		{
+			const int iSourceX0 = iX * iSourceWidth / sImage.iWidth;
+			const int iSourceX1 = std::max(iSourceX0 + 1, (iX + 1) * iSourceWidth / sImage.iWidth);
+
+			// Average the source pixels which this pixel covers. A missing colour is white, and a missing alpha is opaque.
+			unsigned int arrSum[4] = { 0, 0, 0, 0 };
+			for (int iSourceY = iSourceY0; iSourceY < iSourceY1; iSourceY++)
+			{
+				for (int iSourceX = iSourceX0; iSourceX < iSourceX1; iSourceX++)
+				{
+					const unsigned char* pSource = &pData[(iSourceY * iSourceWidth + iSourceX) * iNumChannels];
+					arrSum[0] += pSource[0];
+					arrSum[1] += (iNumChannels >= 3) ? pSource[1] : pSource[0];
+					arrSum[2] += (iNumChannels >= 3) ? pSource[2] : pSource[0];
+					arrSum[3] += (iNumChannels == 4) ? pSource[3] : ((iNumChannels == 2) ? pSource[1] : 255);
+				}
+			}
+			const unsigned int uiNumSamples = (iSourceY1 - iSourceY0) * (iSourceX1 - iSourceX0);
+			unsigned char* pTarget = &sImage.pixels[(iY * sImage.iWidth + iX) * 4];
+			for (int i = 0; i < 4; i++)
+			{
+				pTarget[i] = (unsigned char)(arrSum[i] / uiNumSamples);
+			}
+		}
+	}
+
+	CImageLoader::GetInstance()->Free(pData);
+	return true;
+}
+
+/**
+@brief Place the images in rows across a texture of a width, with the tallest images first, so that
+	   each row wastes little space above its shorter images
+@param iTextureWidth A const int variable containing the width of the texture
+@return The height of the texture which is used, or a height larger than the largest texture if an image is too wide
+*/
+int CTextureAtlas::Pack(const int iTextureWidth)
+{
+	std::vector<unsigned int> order(images.size());
+	for (unsigned int i = 0; i < order.size(); i++)
+	{
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), [this](const unsigned int a, const unsigned int b)
+	{
+		return images[a].iHeight > images[b].iHeight;
+	});
+
+	int iRowX = 0;
+	int iRowY = 0;
+	int iRowHeight = 0;
+	for (unsigned int i = 0; i < order.size(); i++)
+	{
+		SImage& sImage = images[order[i]];
+		const int iSlotWidth = sImage.iWidth + iPadding * 2;
+		const int iSlotHeight = sImage.iHeight + iPadding * 2;
+		if (iSlotWidth > iTextureWidth)
+			return INT_MAX;
+
+		// Start a new row when this image does not fit into the current one
+		if (iRowX + iSlotWidth > iTextureWidth)
+		{
+			iRowX = 0;
+			iRowY += iRowHeight;
+			iRowHeight = 0;
+		}
+		sImage.iX = iRowX + iPadding;
+		sImage.iY = iRowY + iPadding;
+		iRowX += iSlotWidth;
+		iRowHeight = std::max(iRowHeight, iSlotHeight);
+	}
+	return iRowY + iRowHeight;
+}
@@ -0,0 +1,87 @@
+/**
+ CTextureAtlas
+ @brief A class which packs many images into one texture, so that the sprites which use them can be
+		drawn without switching textures. The images may have different sizes. Each image is given
+		its index in the order which it was added, and the rectangle of texture coordinates which it
+		was packed into.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include GLEW
+#ifndef GLEW_STATIC
+#include <GL/glew.h>
+#define GLEW_STATIC
+#endif
+
+// Include GLM
+#include <includes/glm.hpp>
+
+#include <string>
+#include <vector>
+
+class CTextureAtlas
+{
+public:
+	// Constructor
+	CTextureAtlas(void);
+
+	// Destructor
+	virtual ~CTextureAtlas(void);
+
+	// Add an image to be packed, and return its index. An image which was already added keeps its index.
+	unsigned int AddImage(const std::string& filename);
+
+	// Load the images and pack them into one texture. Images larger than iMaxImageSize are scaled down.
+	bool Build(const bool bInvert = true, const int iMaxImageSize = 64);
+
+	// Delete the texture and forget the images
+	void Clear(void);
+
+	// Get the texture which the images were packed into
+	unsigned int GetTextureID(void) const;
+
+	// Get the number of images
+	unsigned int GetNumImages(void) const;
+
+	// Get the size of the texture
+	int GetWidth(void) const;
+	int GetHeight(void) const;
+
+	// Get the texture coordinates of an image
+	void GetUV(const unsigned int uiIndex, glm::vec2& vec2UVMin, glm::vec2& vec2UVMax) const;
+
+protected:
+	// An image which is packed into the atlas
+	struct SImage
+	{
+		std::string filename;
+		// The pixels in RGBA, after they are scaled down
+		std::vector<unsigned char> pixels;
+		int iWidth;
+		int iHeight;
+		// The bottom-left corner of the image in the atlas
+		int iX;
+		int iY;
+		// The texture coordinates of the image
+		glm::vec2 vec2UVMin;
+		glm::vec2 vec2UVMax;
+	};
+
+	// Load an image into RGBA pixels, scaled down to fit in iMaxImageSize
+	bool LoadPixels(SImage& sImage, const bool bInvert, const int iMaxImageSize) const;
+
+	// Place the images in rows across a texture of a width. Returns the height which is used.
+	int Pack(const int iTextureWidth);
+
+	// The number of pixels around each image which repeat its edge, so that filtering does not sample its neighbours
+	static const int iPadding = 1;
+
+	std::vector<SImage> images;
+
+	// The texture which the images were packed into
+	GLuint uiTextureID;
+	int iWidth;
+	int iHeight;
+};
@@ -0,0 +1,69 @@
+/**
+ CChecksum
+ @brief A class to hash the state of the game (FNV-1a, 64 bits, 8 bytes at a time). Two runs which hash the same values
+		in the same order get the same checksum, so a change in the gameplay shows up as a different checksum.
+ By: agent
+ Date: Oct 2026
+ */
+#include "Checksum.h"
+
+#include <cstring>
+
+// The constants of the 64-bit FNV-1a hash
+static const uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+static const uint64_t FNV_PRIME = 0x100000001B3ULL;
+
+/**
+@brief Constructor
+*/
+CChecksum::CChecksum(void)
+	: uiValue(FNV_OFFSET_BASIS)
+{
+}
+
+/**
+@brief Destructor
+*/
+CChecksum::~CChecksum(void)
+{
+}
+
+/**
+@brief Start a new checksum
+*/
+void CChecksum::Reset(void)
+{
+	uiValue = FNV_OFFSET_BASIS;
+}
+
+/**
+@brief Add some bytes to the checksum
+@param pData A const void* variable containing the bytes
+@param uiSize A const size_t variable containing the number of bytes
+*/
+void CChecksum::Add(const void* pData, const size_t uiSize)
+{
+	const unsigned char* pBytes = (const unsigned char*)pData;
+
+	// Hash 8 bytes at a time, as a map of tiles would take too long one byte at a time
+	size_t i = 0;
+	for (; i + sizeof(uint64_t) <= uiSize; i += sizeof(uint64_t))
+	{
+		uint64_t uiWord;
+		memcpy(&uiWord, pBytes + i, sizeof(uiWord));
+		uiValue = (uiValue ^ uiWord) * FNV_PRIME;
+		uiValue ^= uiValue >> 32;
+	}
+	for (; i < uiSize; i++)
+	{
+		uiValue = (uiValue ^ pBytes[i]) * FNV_PRIME;
+	}
+}
+
+/**
+@brief Get the checksum
+*/
+uint64_t CChecksum::GetValue(void) const
+{
+	return uiValue;
+}
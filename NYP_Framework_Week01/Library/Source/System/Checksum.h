@@ -0,0 +1,41 @@
+/**
+ CChecksum
+ @brief A class to hash the state of the game (FNV-1a, 64 bits, 8 bytes at a time). Two runs which hash the same values
+		in the same order get the same checksum, so a change in the gameplay shows up as a different checksum.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class CChecksum
+{
+public:
+	// Constructor
+	CChecksum(void);
+
+	// Destructor
+	~CChecksum(void);
+
+	// Start a new checksum
+	void Reset(void);
+
+	// Add some bytes to the checksum
+	void Add(const void* pData, const size_t uiSize);
+
+	// Add a value to the checksum. Use it only for types without padding, e.g. int, float, bool and glm::vec2.
+	template <typename T>
+	void Add(const T& value)
+	{
+		Add(&value, sizeof(T));
+	}
+
+	// Get the checksum
+	uint64_t GetValue(void) const;
+
+protected:
+	// The checksum so far
+	uint64_t uiValue;
+};
@@ -14,6 +14,8 @@ using namespace std;
 #include <GL/glew.h>
 #define GLEW_STATIC
 #endif
+// Include CGLTelemetry to count the OpenGL calls of the frame
+#include "../RenderControl/GLTelemetry.h"
 
 // STB Image
 #ifndef STB_IMAGE_IMPLEMENTATION
@@ -65,6 +67,15 @@ unsigned char * CImageLoader::Load(const char* filename, int& width, int& height
 	return data;
 }
 
+/**
+ @brief Free an image returned by Load()
+ @param data A unsigned char* storing the image
+ */
+void CImageLoader::Free(unsigned char* data)
+{
+	stbi_image_free(data);
+}
+
 /**
  @brief Load an image into the graphics card and return its ID.
  @param filename A const char* storing the name of the image file
@@ -72,6 +83,14 @@ unsigned char * CImageLoader::Load(const char* filename, int& width, int& height
  */
 unsigned int CImageLoader::LoadTextureGetID(const char* filename,  const bool bInvert)
 {
+#ifdef HEADLESS
+	// There is no graphics card in the HEADLESS build, so the image is not decoded. Only a texture name is given out.
+	(void)filename;
+	(void)bInvert;
+	GLuint image_texture;
+	glGenTextures(1, &image_texture);
+	return image_texture;
+#else
 	// Load from file
 	int image_width = 0;
 	int image_height = 0;
@@ -118,5 +137,6 @@ unsigned int CImageLoader::LoadTextureGetID(const char* filename,  const bool bI
 	stbi_image_free(data);
 
 	return image_texture;
+#endif
 }
 
@@ -29,6 +29,9 @@ public:
 
 	// Load an image and return as a Texture ID
 	unsigned int LoadTextureGetID(const char* filename, const bool bInvert);
+
+	// Free an image returned by Load()
+	void Free(unsigned char* data);
 protected:
 	// Constructor
 	CImageLoader(void);
@@ -7,6 +7,13 @@
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <cstdio>
+#include <cstring>
+
+// sscanf_s is only in the Microsoft C runtime. The formats below only read numbers, where sscanf does the same.
+#ifndef _MSC_VER
+#define sscanf_s sscanf
+#endif
 
 #include "LoadOBJ.h"
 
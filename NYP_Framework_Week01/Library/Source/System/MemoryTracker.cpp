@@ -0,0 +1,419 @@
+/**
+ CMemoryTracker
+ @brief A class to count the allocations of each subsystem in each frame. When ENABLE_MEMORY_TRACKING is defined,
+		the global operator new and operator delete are replaced, so every allocation through new, including those
+		of the STL containers, is counted under the tag of its thread, which is set by MEMORY_TAG.
+		A zone marked by MEMORY_ZERO_ALLOC must not allocate. An allocation inside it is counted as a violation,
+		and in the ZERO_ALLOC_ASSERT mode it is also printed and asserted on, to find where it came from.
+		It only has static members, as operator new cannot use a singleton which is itself created with new.
+		Without ENABLE_MEMORY_TRACKING the macros are empty, and the counts stay at 0.
+ By: agent
+ Date: Oct 2026
+ */
+#include "MemoryTracker.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+using namespace std;
+
+// Each block starts with a header, which keeps its size and its tag for operator delete.
+// It is 16 bytes so that the memory after it keeps the alignment of malloc().
+struct SAllocationHeader
+{
+	uint64_t uiSize;
+	uint32_t uiTag;
+	uint32_t uiPadding;
+};
+static_assert(sizeof(SAllocationHeader) == 16, "The header must keep the alignment of malloc()");
+
+// The counts of the frame which is running, which any thread may add to
+static std::atomic<uint64_t> arrFrameAllocations[CMemoryTracker::NUM_TAGS];
+static std::atomic<uint64_t> arrFrameBytes[CMemoryTracker::NUM_TAGS];
+static std::atomic<int64_t> arrLiveBytes[CMemoryTracker::NUM_TAGS];
+static std::atomic<uint64_t> uiNumViolations;
+static std::atomic<const char*> pLastViolationZone;
+
+// The counts of the last frame and of all the frames, which only EndFrame() writes
+static uint64_t arrLastFrameAllocations[CMemoryTracker::NUM_TAGS];
+static uint64_t arrLastFrameBytes[CMemoryTracker::NUM_TAGS];
+static uint64_t arrTotalAllocations[CMemoryTracker::NUM_TAGS];
+static uint64_t arrTotalBytes[CMemoryTracker::NUM_TAGS];
+static uint64_t uiNumFrames = 0;
+static uint64_t uiNumFramesOverBudget = 0;
+static unsigned int uiFrameBudget = 0;
+static CMemoryTracker::ZERO_ALLOC_MODE eZeroAllocMode = CMemoryTracker::ZERO_ALLOC_COUNT;
+
+// The tag and the zone which must not allocate of each thread, and whether it is printing a violation
+static thread_local CMemoryTracker::TAG eCurrentTag = CMemoryTracker::GENERAL;
+static thread_local const char* pCurrentZeroAllocZone = nullptr;
+static thread_local bool bReporting = false;
+
+/**
+@brief Check if the allocations are counted in this build
+*/
+bool CMemoryTracker::IsEnabled(void)
+{
+#ifdef ENABLE_MEMORY_TRACKING
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+@brief Allocate a block of memory and count it under the tag of the calling thread
+@param uiSize A const size_t variable containing the number of bytes
+@return The block of memory, or NULL if there is no memory left
+*/
+void* CMemoryTracker::Allocate(const size_t uiSize)
+{
+	SAllocationHeader* pHeader = static_cast<SAllocationHeader*>(malloc(sizeof(SAllocationHeader) + uiSize));
+	if (pHeader == NULL)
+		return NULL;
+
+	const TAG eTag = eCurrentTag;
+	pHeader->uiSize = uiSize;
+	pHeader->uiTag = eTag;
+	arrFrameAllocations[eTag].fetch_add(1, std::memory_order_relaxed);
+	arrFrameBytes[eTag].fetch_add(uiSize, std::memory_order_relaxed);
+	arrLiveBytes[eTag].fetch_add((int64_t)uiSize, std::memory_order_relaxed);
+
+	if ((pCurrentZeroAllocZone) && (eZeroAllocMode != ZERO_ALLOC_OFF) && (!bReporting))
+	{
+		uiNumViolations.fetch_add(1, std::memory_order_relaxed);
+		pLastViolationZone.store(pCurrentZeroAllocZone, std::memory_order_relaxed);
+		if (eZeroAllocMode == ZERO_ALLOC_ASSERT)
+		{
+			// Printing may allocate, which must not be reported again
+			bReporting = true;
+			cout << "CMemoryTracker::Allocate - " << uiSize << " bytes were allocated in the zero-allocation zone "
+				<< pCurrentZeroAllocZone << endl;
+			bReporting = false;
+			assert(false && "An allocation was made in a zone marked by MEMORY_ZERO_ALLOC");
+		}
+	}
+
+	return pHeader + 1;
+}
+
+/**
+@brief Free a block of memory from Allocate()
+@param pMemory A void* variable containing the block of memory. Nothing is done if it is NULL.
+*/
+void CMemoryTracker::Free(void* pMemory)
+{
+	if (pMemory == NULL)
+		return;
+
+	SAllocationHeader* pHeader = static_cast<SAllocationHeader*>(pMemory) - 1;
+	arrLiveBytes[pHeader->uiTag].fetch_sub((int64_t)pHeader->uiSize, std::memory_order_relaxed);
+	free(pHeader);
+}
+
+/**
+@brief Set the tag of the calling thread
+@param eTag A const TAG variable containing the tag
+@return The tag which it replaces
+*/
+CMemoryTracker::TAG CMemoryTracker::SetTag(const TAG eTag)
+{
+	const TAG eOuterTag = eCurrentTag;
+	eCurrentTag = eTag;
+	return eOuterTag;
+}
+
+/**
+@brief Enter a zone which must not allocate
+@param pName A const char* variable containing the name of the zone. It must be a string literal.
+@return The zone which it is inside, or NULL if there is none
+*/
+const char* CMemoryTracker::EnterZeroAllocZone(const char* pName)
+{
+	const char* pOuterName = pCurrentZeroAllocZone;
+	pCurrentZeroAllocZone = pName;
+	return pOuterName;
+}
+
+/**
+@brief Leave a zone which must not allocate
+@param pOuterName A const char* variable containing the zone which it was inside, from EnterZeroAllocZone()
+*/
+void CMemoryTracker::LeaveZeroAllocZone(const char* pOuterName)
+{
+	pCurrentZeroAllocZone = pOuterName;
+}
+
+/**
+@brief End the frame: keep its counts, and start counting the next frame
+*/
+void CMemoryTracker::EndFrame(void)
+{
+	uint64_t uiFrameAllocations = 0;
+	for (int i = 0; i < NUM_TAGS; i++)
+	{
+		arrLastFrameAllocations[i] = arrFrameAllocations[i].exchange(0, std::memory_order_relaxed);
+		arrLastFrameBytes[i] = arrFrameBytes[i].exchange(0, std::memory_order_relaxed);
+		arrTotalAllocations[i] += arrLastFrameAllocations[i];
+		arrTotalBytes[i] += arrLastFrameBytes[i];
+		uiFrameAllocations += arrLastFrameAllocations[i];
+	}
+	uiNumFrames++;
+
+	if ((uiFrameBudget > 0) && (uiFrameAllocations > uiFrameBudget))
+		uiNumFramesOverBudget++;
+}
+
+/**
+@brief Get the number of allocations under a tag in the last frame
+@param eTag A const TAG variable containing the tag
+*/
+uint64_t CMemoryTracker::GetFrameAllocations(const TAG eTag)
+{
+	if ((eTag < GENERAL) || (eTag >= NUM_TAGS))
+		return 0;
+	return arrLastFrameAllocations[eTag];
+}
+
+/**
+@brief Get the bytes allocated under a tag in the last frame
+@param eTag A const TAG variable containing the tag
+*/
+uint64_t CMemoryTracker::GetFrameBytes(const TAG eTag)
+{
+	if ((eTag < GENERAL) || (eTag >= NUM_TAGS))
+		return 0;
+	return arrLastFrameBytes[eTag];
+}
+
+/**
+@brief Get the number of allocations under a tag in all the frames so far
+@param eTag A const TAG variable containing the tag
+*/
+uint64_t CMemoryTracker::GetTotalAllocations(const TAG eTag)
+{
+	if ((eTag < GENERAL) || (eTag >= NUM_TAGS))
+		return 0;
+	return arrTotalAllocations[eTag];
+}
+
+/**
+@brief Get the bytes allocated under a tag in all the frames so far
+@param eTag A const TAG variable containing the tag
+*/
+uint64_t CMemoryTracker::GetTotalBytes(const TAG eTag)
+{
+	if ((eTag < GENERAL) || (eTag >= NUM_TAGS))
+		return 0;
+	return arrTotalBytes[eTag];
+}
+
+/**
+@brief Get the bytes allocated under a tag which have not been freed yet. A block is freed under the tag which allocated it.
+@param eTag A const TAG variable containing the tag
+*/
+int64_t CMemoryTracker::GetLiveBytes(const TAG eTag)
+{
+	if ((eTag < GENERAL) || (eTag >= NUM_TAGS))
+		return 0;
+	return arrLiveBytes[eTag].load(std::memory_order_relaxed);
+}
+
+/**
+@brief Get the number of frames which have ended
+*/
+uint64_t CMemoryTracker::GetNumFrames(void)
+{
+	return uiNumFrames;
+}
+
+/**
+@brief Set the most allocations which a frame may make
+@param uiMaxAllocations A const unsigned int variable containing the number of allocations, or 0 for no budget
+*/
+void CMemoryTracker::SetFrameBudget(const unsigned int uiMaxAllocations)
+{
+	uiFrameBudget = uiMaxAllocations;
+}
+
+/**
+@brief Get the most allocations which a frame may make, or 0 if there is no budget
+*/
+unsigned int CMemoryTracker::GetFrameBudget(void)
+{
+	return uiFrameBudget;
+}
+
+/**
+@brief Get the number of frames which made more allocations than the budget
+*/
+uint64_t CMemoryTracker::GetNumFramesOverBudget(void)
+{
+	return uiNumFramesOverBudget;
+}
+
+/**
+@brief Set what to do when a zone marked by MEMORY_ZERO_ALLOC allocates. Set it before the worker threads start.
+@param eMode A const ZERO_ALLOC_MODE variable containing the mode
+*/
+void CMemoryTracker::SetZeroAllocMode(const ZERO_ALLOC_MODE eMode)
+{
+	if ((eMode < ZERO_ALLOC_OFF) || (eMode >= NUM_ZERO_ALLOC_MODES))
+		return;
+	eZeroAllocMode = eMode;
+}
+
+/**
+@brief Get what is done when a zone marked by MEMORY_ZERO_ALLOC allocates
+*/
+CMemoryTracker::ZERO_ALLOC_MODE CMemoryTracker::GetZeroAllocMode(void)
+{
+	return eZeroAllocMode;
+}
+
+/**
+@brief Get the number of allocations in zones which must not allocate
+*/
+uint64_t CMemoryTracker::GetNumViolations(void)
+{
+	return uiNumViolations.load(std::memory_order_relaxed);
+}
+
+/**
+@brief Get the name of the last zone which allocated when it must not, or NULL if none has
+*/
+const char* CMemoryTracker::GetLastViolationZone(void)
+{
+	return pLastViolationZone.load(std::memory_order_relaxed);
+}
+
+/**
+@brief Get the name of a tag
+@param eTag A const TAG variable containing the tag
+*/
+const char* CMemoryTracker::GetTagName(const TAG eTag)
+{
+	switch (eTag)
+	{
+	case GENERAL:
+		return "General";
+	case SCENE:
+		return "Scene";
+	case ENTITIES:
+		return "Entities";
+	case BULLETS:
+		return "Bullets";
+	case PATHFINDING:
+		return "PathFinding";
+	case MAP:
+		return "Map";
+	case GUI:
+		return "GUI";
+	case RENDER:
+		return "Render";
+	default:
+		return "Unknown";
+	}
+}
+
+/**
+@brief Print the allocations of each tag per frame, in the last frame and on average over all the frames
+@param os A std::ostream& variable which the report is printed into
+*/
+void CMemoryTracker::PrintReport(std::ostream& os)
+{
+	if (!IsEnabled())
+	{
+		os << "Allocations: not counted in this build (ENABLE_MEMORY_TRACKING)" << endl;
+		return;
+	}
+
+	const std::ios_base::fmtflags flags = os.flags();
+	const std::streamsize precision = os.precision();
+	const char cFill = os.fill(' ');
+	const double dNumFrames = (double)(uiNumFrames > 0 ? uiNumFrames : 1);
+	os << "Allocations over " << uiNumFrames << " frames:" << endl;
+	os << std::left << std::setw(14) << "Tag" << std::right
+		<< std::setw(12) << "Last allocs" << std::setw(12) << "Last bytes"
+		<< std::setw(12) << "Avg allocs" << std::setw(14) << "Avg bytes" << std::setw(14) << "Live bytes" << endl;
+	os << std::fixed << std::setprecision(1);
+	for (int i = 0; i < NUM_TAGS; i++)
+	{
+		os << std::left << std::setw(14) << GetTagName((TAG)i) << std::right
+			<< std::setw(12) << arrLastFrameAllocations[i] << std::setw(12) << arrLastFrameBytes[i]
+			<< std::setw(12) << arrTotalAllocations[i] / dNumFrames << std::setw(14) << arrTotalBytes[i] / dNumFrames
+			<< std::setw(14) << arrLiveBytes[i].load(std::memory_order_relaxed) << endl;
+	}
+	if (uiFrameBudget > 0)
+		os << "Frames over the budget of " << uiFrameBudget << " allocations: " << uiNumFramesOverBudget << endl;
+	os << "Allocations in zero-allocation zones: " << GetNumViolations();
+	if (GetLastViolationZone())
+		os << " (last in " << GetLastViolationZone() << ")";
+	os << endl;
+	os.flags(flags);
+	os.precision(precision);
+	os.fill(cFill);
+}
+
+#ifdef ENABLE_MEMORY_TRACKING
+// Replace the global operator new and operator delete, so that every allocation is counted.
+// They are in this file so that the linker takes them whenever CMemoryTracker is used.
+void* operator new(std::size_t uiSize)
+{
+	void* pMemory = CMemoryTracker::Allocate(uiSize);
+	if (pMemory == NULL)
+		throw std::bad_alloc();
+	return pMemory;
+}
+
+void* operator new[](std::size_t uiSize)
+{
+	void* pMemory = CMemoryTracker::Allocate(uiSize);
+	if (pMemory == NULL)
+		throw std::bad_alloc();
+	return pMemory;
+}
+
+void* operator new(std::size_t uiSize, const std::nothrow_t&) noexcept
+{
+	return CMemoryTracker::Allocate(uiSize);
+}
+
+void* operator new[](std::size_t uiSize, const std::nothrow_t&) noexcept
+{
+	return CMemoryTracker::Allocate(uiSize);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	CMemoryTracker::Free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+	CMemoryTracker::Free(pMemory);
+}
+
+void operator delete(void* pMemory, std::size_t) noexcept
+{
+	CMemoryTracker::Free(pMemory);
+}
+
+void operator delete[](void* pMemory, std::size_t) noexcept
+{
+	CMemoryTracker::Free(pMemory);
+}
+
+void operator delete(void* pMemory, const std::nothrow_t&) noexcept
+{
+	CMemoryTracker::Free(pMemory);
+}
+
+void operator delete[](void* pMemory, const std::nothrow_t&) noexcept
+{
+	CMemoryTracker::Free(pMemory);
+}
+#endif
@@ -0,0 +1,160 @@
+/**
+ CMemoryTracker
+ @brief A class to count the allocations of each subsystem in each frame. When ENABLE_MEMORY_TRACKING is defined,
+		the global operator new and operator delete are replaced, so every allocation through new, including those
+		of the STL containers, is counted under the tag of its thread, which is set by MEMORY_TAG.
+		A zone marked by MEMORY_ZERO_ALLOC must not allocate. An allocation inside it is counted as a violation,
+		and in the ZERO_ALLOC_ASSERT mode it is also printed and asserted on, to find where it came from.
+		It only has static members, as operator new cannot use a singleton which is itself created with new.
+		Without ENABLE_MEMORY_TRACKING the macros are empty, and the counts stay at 0.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#ifdef ENABLE_MEMORY_TRACKING
+	#define MEMORY_JOIN_NAME(a, b) a##b
+	#define MEMORY_MAKE_NAME(a, b) MEMORY_JOIN_NAME(a, b)
+	// Count the allocations of the rest of this scope under a tag of CMemoryTracker, e.g. MEMORY_TAG(PATHFINDING)
+	#define MEMORY_TAG(tag) CMemoryTag MEMORY_MAKE_NAME(cMemoryTag, __LINE__)(CMemoryTracker::tag)
+	// Mark the rest of this scope as a zone which must not allocate. The name must be a string literal.
+	#define MEMORY_ZERO_ALLOC(name) CZeroAllocZone MEMORY_MAKE_NAME(cZeroAllocZone, __LINE__)(name)
+#else
+	#define MEMORY_TAG(tag)
+	#define MEMORY_ZERO_ALLOC(name)
+#endif
+
+class CMemoryTracker
+{
+public:
+	// The subsystems which the allocations are counted under
+	enum TAG
+	{
+		GENERAL = 0,	// Anything which is not tagged
+		SCENE,			// The scene, the spawning and the pickups
+		ENTITIES,		// The player and the enemies
+		BULLETS,		// The bullets
+		PATHFINDING,	// The A* searches and their paths
+		MAP,			// The loading of the maps
+		GUI,			// The GUI and ImGui
+		RENDER,			// The rendering
+		NUM_TAGS
+	};
+
+	// What to do when a zone marked by MEMORY_ZERO_ALLOC allocates
+	enum ZERO_ALLOC_MODE
+	{
+		ZERO_ALLOC_OFF = 0,		// Ignore it
+		ZERO_ALLOC_COUNT,		// Count it as a violation
+		ZERO_ALLOC_ASSERT,		// Count it, print it and assert
+		NUM_ZERO_ALLOC_MODES
+	};
+
+	// Check if the allocations are counted in this build
+	static bool IsEnabled(void);
+
+	// Allocate a block of memory and count it under the tag of the calling thread. It is called by operator new.
+	static void* Allocate(const size_t uiSize);
+	// Free a block of memory from Allocate(). It is called by operator delete.
+	static void Free(void* pMemory);
+
+	// Set the tag of the calling thread, and return the tag which it replaces
+	static TAG SetTag(const TAG eTag);
+	// Enter a zone which must not allocate, and return the zone which it is inside, if any
+	static const char* EnterZeroAllocZone(const char* pName);
+	// Leave a zone which must not allocate, back to the zone which it was inside
+	static void LeaveZeroAllocZone(const char* pOuterName);
+
+	// End the frame: keep its counts, and start counting the next frame. Call it once per frame, on the main thread.
+	static void EndFrame(void);
+
+	// Get the number of allocations and the bytes allocated under a tag in the last frame
+	static uint64_t GetFrameAllocations(const TAG eTag);
+	static uint64_t GetFrameBytes(const TAG eTag);
+	// Get the number of allocations and the bytes allocated under a tag in all the frames so far
+	static uint64_t GetTotalAllocations(const TAG eTag);
+	static uint64_t GetTotalBytes(const TAG eTag);
+	// Get the bytes allocated under a tag which have not been freed yet
+	static int64_t GetLiveBytes(const TAG eTag);
+	// Get the number of frames which have ended
+	static uint64_t GetNumFrames(void);
+
+	// Set the most allocations which a frame may make, or 0 for no budget
+	static void SetFrameBudget(const unsigned int uiMaxAllocations);
+	static unsigned int GetFrameBudget(void);
+	// Get the number of frames which made more allocations than the budget
+	static uint64_t GetNumFramesOverBudget(void);
+
+	// Set what to do when a zone marked by MEMORY_ZERO_ALLOC allocates
+	static void SetZeroAllocMode(const ZERO_ALLOC_MODE eMode);
+	static ZERO_ALLOC_MODE GetZeroAllocMode(void);
+	// Get the number of allocations in zones which must not allocate, and the name of the last of those zones
+	static uint64_t GetNumViolations(void);
+	static const char* GetLastViolationZone(void);
+
+	// Get the name of a tag
+	static const char* GetTagName(const TAG eTag);
+
+	// Print the allocations of each tag per frame, in the last frame and on average
+	static void PrintReport(std::ostream& os);
+};
+
+/**
+ CMemoryTag
+ @brief Counts the allocations of a scope under a tag, from when it is created until it is destroyed. Use it through MEMORY_TAG.
+ */
+class CMemoryTag
+{
+public:
+	// Constructor
+	explicit CMemoryTag(const CMemoryTracker::TAG eTag)
+		: eOuterTag(CMemoryTracker::SetTag(eTag))
+	{
+	}
+
+	// Destructor
+	~CMemoryTag(void)
+	{
+		CMemoryTracker::SetTag(eOuterTag);
+	}
+
+protected:
+	// The tag which this scope is inside
+	CMemoryTracker::TAG eOuterTag;
+
+private:
+	CMemoryTag(const CMemoryTag&);
+	CMemoryTag& operator=(const CMemoryTag&);
+};
+
+/**
+ CZeroAllocZone
+ @brief Marks a scope which must not allocate, from when it is created until it is destroyed. Use it through MEMORY_ZERO_ALLOC.
+ */
+class CZeroAllocZone
+{
+public:
+	// Constructor
+	explicit CZeroAllocZone(const char* pName)
+		: pOuterName(CMemoryTracker::EnterZeroAllocZone(pName))
+	{
+	}
+
+	// Destructor
+	~CZeroAllocZone(void)
+	{
+		CMemoryTracker::LeaveZeroAllocZone(pOuterName);
+	}
+
+protected:
+	// The zone which this zone is inside, if any
+	const char* pOuterName;
+
+private:
+	CZeroAllocZone(const CZeroAllocZone&);
+	CZeroAllocZone& operator=(const CZeroAllocZone&);
+};
@@ -0,0 +1,170 @@
+/**
+ CRandom
+ @brief A fast random number generator (xoshiro128**). Each system and entity has its own,
+		so that they do not share rand() across threads, and a run can be repeated from its seed.
+ By: agent
+ Date: Oct 2026
+ */
+#include "Random.h"
+
+#include <chrono>
+#include <iostream>
+using namespace std;
+
+// Mix a 64-bit value into another one (splitmix64). It spreads a small seed over all the bits of the state.
+static uint64_t SplitMix64(uint64_t& uiValue)
+{
+	uint64_t z = (uiValue += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+// Rotate the bits of a 32-bit value to the left
+static inline uint32_t RotateLeft(const uint32_t uiValue, const int iBits)
+{
+	return (uiValue << iBits) | (uiValue >> (32 - iBits));
+}
+
+/**
+@brief Constructor
+@param uiSeed A const uint64_t variable containing the seed
+*/
+CRandom::CRandom(const uint64_t uiSeed)
+{
+	Seed(uiSeed);
+}
+
+/**
+@brief Destructor
+*/
+CRandom::~CRandom(void)
+{
+}
+
+/**
+@brief Set the seed. The same seed always gives the same numbers.
+@param uiSeed A const uint64_t variable containing the seed
+*/
+void CRandom::Seed(const uint64_t uiSeed)
+{
+	uint64_t uiValue = uiSeed;
+	const uint64_t uiLow = SplitMix64(uiValue);
+	const uint64_t uiHigh = SplitMix64(uiValue);
+	uiState[0] = (uint32_t)uiLow;
+	uiState[1] = (uint32_t)(uiLow >> 32);
+	uiState[2] = (uint32_t)uiHigh;
+	uiState[3] = (uint32_t)(uiHigh >> 32);
+}
+
+/**
+@brief Get the next random number, from 0 to 0xFFFFFFFF
+*/
+uint32_t CRandom::Next(void)
+{
+	const uint32_t uiResult = RotateLeft(uiState[1] * 5, 7) * 9;
+	const uint32_t t = uiState[1] << 9;
+
+	uiState[2] ^= uiState[0];
+	uiState[3] ^= uiState[1];
+	uiState[1] ^= uiState[2];
+	uiState[0] ^= uiState[3];
+	uiState[2] ^= t;
+	uiState[3] = RotateLeft(uiState[3], 11);
+
+	return uiResult;
+}
+
+/**
+@brief Get a random int from 0 to before iRange
+@param iRange A const int variable containing the number of values. It must be more than 0.
+*/
+int CRandom::Range(const int iRange)
+{
+	// Scale the number instead of using %, which is slower and favours the small values
+	return (int)(((uint64_t)Next() * (uint32_t)iRange) >> 32);
+}
+
+/**
+@brief Get a random int from iMin to iMax, including both
+@param iMin A const int variable containing the smallest value
+@param iMax A const int variable containing the largest value
+*/
+int CRandom::Range(const int iMin, const int iMax)
+{
+	return iMin + Range(iMax - iMin + 1);
+}
+
+/**
+@brief Get a random float from 0 to before 1
+*/
+float CRandom::Float(void)
+{
+	// The top 24 bits fit exactly into the mantissa of a float
+	return (Next() >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+@brief Constructor
+*/
+CRandomService::CRandomService(void)
+	: uiSeed(0)
+{
+}
+
+/**
+@brief Destructor
+*/
+CRandomService::~CRandomService(void)
+{
+}
+
+/**
+@brief Initialise this class instance. Call it before the entities are created, in each run.
+@param uiSeed A const uint64_t variable containing the seed of this run. 0 takes one from the clock.
+*/
+bool CRandomService::Init(const uint64_t uiSeed)
+{
+	this->uiSeed = uiSeed;
+	if (this->uiSeed == 0)
+		this->uiSeed = (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count();
+
+	// Give each stream a different seed, so that they do not repeat each other
+	uint64_t uiValue = this->uiSeed;
+	for (int i = 0; i < NUM_STREAMS; i++)
+	{
+		streams[i].Seed(SplitMix64(uiValue));
+	}
+
+	cout << "CRandomService::Init - seed " << this->uiSeed << endl;
+
+	return true;
+}
+
+/**
+@brief Get the seed of this run, to repeat it later
+*/
+uint64_t CRandomService::GetSeed(void) const
+{
+	return uiSeed;
+}
+
+/**
+@brief Get the stream of a system. Use it only from the main thread.
+@param eStream A const STREAM variable containing the system
+*/
+CRandom& CRandomService::GetStream(const STREAM eStream)
+{
+	return streams[eStream];
+}
+
+/**
+@brief Create a stream for a new entity. Call this from the main thread, in the same order in each run,
+	   e.g. from the entity's Init(). The entity can then use it from a worker thread.
+*/
+CRandom CRandomService::CreateEntityStream(void)
+{
+	CRandom& cEntityStream = streams[ENTITY];
+	const uint64_t uiEntitySeed = ((uint64_t)cEntityStream.Next() << 32) | cEntityStream.Next();
+	return CRandom(uiEntitySeed);
+}
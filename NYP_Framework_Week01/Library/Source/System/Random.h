@@ -0,0 +1,81 @@
+/**
+ CRandom
+ @brief A fast random number generator (xoshiro128**). Each system and entity has its own,
+		so that they do not share rand() across threads, and a run can be repeated from its seed.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+#include <cstdint>
+
+class CRandom
+{
+public:
+	// Constructor
+	CRandom(const uint64_t uiSeed = 0);
+
+	// Destructor
+	~CRandom(void);
+
+	// Set the seed. The same seed always gives the same numbers.
+	void Seed(const uint64_t uiSeed);
+
+	// Get the next random number, from 0 to 0xFFFFFFFF
+	uint32_t Next(void);
+
+	// Get a random int from 0 to before iRange
+	int Range(const int iRange);
+
+	// Get a random int from iMin to iMax, including both
+	int Range(const int iMin, const int iMax);
+
+	// Get a random float from 0 to before 1
+	float Float(void);
+
+protected:
+	// The state of the generator
+	uint32_t uiState[4];
+};
+
+class CRandomService : public CSingletonTemplate<CRandomService>
+{
+	friend CSingletonTemplate<CRandomService>;
+public:
+	// The streams of the systems. Each is seeded from the seed of the run and its own index.
+	enum STREAM
+	{
+		SPAWN = 0,	// Where and which enemies spawn
+		BOSS,		// The boss's moves and its summons
+		ENTITY,		// Seeds the streams of the entities
+		NUM_STREAMS
+	};
+
+	// Initialise this class instance. A seed of 0 takes one from the clock.
+	bool Init(const uint64_t uiSeed = 0);
+
+	// Get the seed of this run, to repeat it later
+	uint64_t GetSeed(void) const;
+
+	// Get the stream of a system. Use it only from the main thread.
+	CRandom& GetStream(const STREAM eStream);
+
+	// Create a stream for a new entity. Call this from the main thread, in the same order in each run.
+	CRandom CreateEntityStream(void);
+
+protected:
+	// Constructor
+	CRandomService(void);
+
+	// Destructor
+	virtual ~CRandomService(void);
+
+	// The seed of this run
+	uint64_t uiSeed;
+
+	// The streams of the systems
+	CRandom streams[NUM_STREAMS];
+};
@@ -25,11 +25,22 @@ private:
 public:
 	static std::string getPath(const std::string& path)
 	{
+		// An absolute path, such as one in the temporary folder, is used as it is
+		if (isAbsolute(path))
+			return path;
 		static std::string(*pathBuilder)(std::string const &) = getPathBuilder();
 		return (*pathBuilder)(path);
 	}
 
 private:
+	static bool isAbsolute(const std::string& path)
+	{
+		if ((path.size() > 0) && ((path[0] == '/') || (path[0] == '\\')))
+			return true;
+		// A drive letter, such as C:
+		return (path.size() > 1) && (path[1] == ':');
+	}
+
 	static std::string const & getRoot()
 	{
 		char buff[FILENAME_MAX]; //create string buffer to hold path
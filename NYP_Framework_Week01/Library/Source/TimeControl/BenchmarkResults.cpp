@@ -0,0 +1,192 @@
+/**
+ CBenchmarkResults
+ @brief A class which keeps the results of a benchmark run, writes them into a CSV file, and compares
+		them against the results of an earlier run, so that each optimisation can be measured.
+		Every result is a cost, e.g. a time or a number of allocations, so a lower value is better.
+ By: agent
+ Date: Oct 2026
+ */
+#include "BenchmarkResults.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+using namespace std;
+
+/**
+@brief Constructor
+*/
+CBenchmarkResults::CBenchmarkResults(void)
+{
+}
+
+/**
+@brief Destructor
+*/
+CBenchmarkResults::~CBenchmarkResults(void)
+{
+}
+
+/**
+@brief Add a result
+@param name A const std::string& variable containing the name of the benchmark. It must not contain a comma.
+@param dValue A const double variable containing the cost which was measured
+@param unit A const std::string& variable containing the unit of dValue, e.g. "ns" or "ms"
+*/
+void CBenchmarkResults::Add(const std::string& name, const double dValue, const std::string& unit)
+{
+	SResult sResult;
+	sResult.name = name;
+	sResult.dValue = dValue;
+	sResult.unit = unit;
+	results.push_back(sResult);
+}
+
+/**
+@brief Remove all the results
+*/
+void CBenchmarkResults::Clear(void)
+{
+	results.clear();
+}
+
+/**
+@brief Get the results, in the order they were added
+*/
+const std::vector<CBenchmarkResults::SResult>& CBenchmarkResults::GetResults(void) const
+{
+	return results;
+}
+
+/**
+@brief Find a result by its name
+@param name A const std::string& variable containing the name of the benchmark
+@return The result, or NULL if there is none
+*/
+const CBenchmarkResults::SResult* CBenchmarkResults::Find(const std::string& name) const
+{
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		if (results[i].name == name)
+			return &results[i];
+	}
+	return NULL;
+}
+
+/**
+@brief Write the results into a CSV file, one result in each row
+@param filename A const std::string& variable containing the name of the file
+*/
+bool CBenchmarkResults::WriteCSV(const std::string& filename) const
+{
+	std::ofstream outputFile(filename.c_str());
+	if (!outputFile)
+	{
+		cout << "CBenchmarkResults: Unable to open " << filename << endl;
+		return false;
+	}
+
+	outputFile << "benchmark,value,unit" << endl;
+	outputFile << setprecision(6);
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		outputFile << results[i].name << ',' << results[i].dValue << ',' << results[i].unit << '\n';
+	}
+	if (!outputFile)
+	{
+		cout << "CBenchmarkResults: Unable to write " << filename << endl;
+		return false;
+	}
+
+	cout << "CBenchmarkResults: Wrote " << results.size() << " results into " << filename << endl;
+	return true;
+}
+
+/**
+@brief Load the results from a CSV file written by WriteCSV(). The results loaded before are removed.
+@param filename A const std::string& variable containing the name of the file
+*/
+bool CBenchmarkResults::LoadCSV(const std::string& filename)
+{
+	std::ifstream inputFile(filename.c_str());
+	if (!inputFile)
+	{
+		cout << "CBenchmarkResults: Unable to open " << filename << endl;
+		return false;
+	}
+
+	results.clear();
+	std::string line;
+	// Skip the header
+	std::getline(inputFile, line);
+	while (std::getline(inputFile, line))
+	{
+		const size_t uiFirstComma = line.find(',');
+		const size_t uiLastComma = line.rfind(',');
+		if ((uiFirstComma == std::string::npos) || (uiFirstComma == uiLastComma))
+		{
+			cout << "CBenchmarkResults: Skipping a row of " << filename << " which is not name,value,unit: " << line << endl;
+			continue;
+		}
+		Add(line.substr(0, uiFirstComma),
+			atof(line.substr(uiFirstComma + 1, uiLastComma - uiFirstComma - 1).c_str()),
+			line.substr(uiLastComma + 1));
+	}
+
+	return true;
+}
+
+/**
+@brief Print the results next to those of a baseline
+@param cBaseline A const CBenchmarkResults& variable containing the results of the earlier run
+@param dTolerance A const double variable containing how many percent worse a result may be before it counts as a regression
+@param os A std::ostream& variable which the comparison is printed into
+@return The number of results which are worse than the baseline by more than dTolerance percent
+*/
+int CBenchmarkResults::Compare(const CBenchmarkResults& cBaseline, const double dTolerance, std::ostream& os) const
+{
+	const std::ios::fmtflags flags = os.flags();
+	const std::streamsize precision = os.precision();
+	const char cFill = os.fill();
+
+	int iNumRegressions = 0;
+	os << setfill(' ') << left << setw(48) << "Benchmark" << right
+		<< setw(14) << "Baseline" << setw(14) << "Current" << setw(10) << "Change" << endl;
+	os << fixed;
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const SResult& sResult = results[i];
+		os << left << setw(48) << sResult.name << right;
+
+		const SResult* pBaseline = cBaseline.Find(sResult.name);
+		if (pBaseline == NULL)
+		{
+			os << setw(14) << "-" << setw(11) << setprecision(3) << sResult.dValue << ' ' << setw(2) << left << sResult.unit << right
+				<< setw(10) << "new" << endl;
+			continue;
+		}
+
+		const double dChange = (pBaseline->dValue > 0.0) ? (sResult.dValue - pBaseline->dValue) * 100.0 / pBaseline->dValue : 0.0;
+		os << setw(11) << setprecision(3) << pBaseline->dValue << ' ' << setw(2) << left << pBaseline->unit << right
+			<< setw(11) << sResult.dValue << ' ' << setw(2) << left << sResult.unit << right
+			<< setw(9) << setprecision(1) << showpos << dChange << noshowpos << '%';
+		if (dChange > dTolerance)
+		{
+			os << "  REGRESSED";
+			iNumRegressions++;
+		}
+		else if (dChange < -dTolerance)
+		{
+			os << "  improved";
+		}
+		os << endl;
+	}
+	os << iNumRegressions << " of " << results.size() << " benchmarks are more than " << setprecision(1) << dTolerance
+		<< "% worse than the baseline" << endl;
+
+	os.flags(flags);
+	os.precision(precision);
+	os.fill(cFill);
+	return iNumRegressions;
+}
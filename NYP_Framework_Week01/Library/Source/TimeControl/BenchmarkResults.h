@@ -0,0 +1,55 @@
+/**
+ CBenchmarkResults
+ @brief A class which keeps the results of a benchmark run, writes them into a CSV file, and compares
+		them against the results of an earlier run, so that each optimisation can be measured.
+		Every result is a cost, e.g. a time or a number of allocations, so a lower value is better.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+class CBenchmarkResults
+{
+public:
+	// A result of a benchmark
+	struct SResult
+	{
+		std::string name;
+		double dValue;
+		std::string unit;
+	};
+
+	// Constructor
+	CBenchmarkResults(void);
+
+	// Destructor
+	virtual ~CBenchmarkResults(void);
+
+	// Add a result. The name must not contain a comma.
+	void Add(const std::string& name, const double dValue, const std::string& unit);
+
+	// Remove all the results
+	void Clear(void);
+
+	// Get the results, in the order they were added
+	const std::vector<SResult>& GetResults(void) const;
+
+	// Find a result by its name. Returns NULL if there is none.
+	const SResult* Find(const std::string& name) const;
+
+	// Write the results into a CSV file, one result in each row
+	bool WriteCSV(const std::string& filename) const;
+
+	// Load the results from a CSV file written by WriteCSV()
+	bool LoadCSV(const std::string& filename);
+
+	// Print the results next to those of a baseline, and return the number which are worse by more than dTolerance percent
+	int Compare(const CBenchmarkResults& cBaseline, const double dTolerance, std::ostream& os) const;
+
+protected:
+	std::vector<SResult> results;
+};
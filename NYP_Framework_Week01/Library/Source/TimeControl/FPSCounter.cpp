@@ -1,10 +1,18 @@
 /**
  CFPSCounter
- @brief A class to calculate the Frames-Per-Second
+ @brief A class to calculate the Frames-Per-Second. It also keeps the frame times of the last NUM_SAMPLES frames,
+		for their percentiles, histogram and graph, counts the hitches, and writes the frame times of the whole run
+		into a CSV file when it is destroyed, so that two builds can be compared.
  By: Toh Da Jun
  Date: Mar 2020
  */
 #include "FPSCounter.h"
+// Include CBenchmarkResults
+#include "BenchmarkResults.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 using namespace std;
 
@@ -13,6 +21,23 @@ CFPSCounter::CFPSCounter()
 	, nFrames(0)
 	, iFrameRate(0)
 	, dFrameTime(0.0)
+	, dSumFrameTime(0.0)
+	, dSumSquaredFrameTime(0.0)
+	, dCurrMinFrameTime(0.0)
+	, dCurrMaxFrameTime(0.0)
+	, dJitter(0.0)
+	, dMinFrameTime(0.0)
+	, dMaxFrameTime(0.0)
+	, dPendingUpdateTime(0.0)
+	, dPendingRenderTime(0.0)
+	, dPendingGPUTime(0.0)
+	, iNumSamples(0)
+	, iSampleOffset(0)
+	, dAverageUpdateTime(0.0)
+	, dAverageRenderTime(0.0)
+	, dAverageGPUTime(0.0)
+	, dHitchThreshold(50.0)
+	, uiNumHitches(0)
 {
 	Init();
 }
@@ -20,6 +45,8 @@ CFPSCounter::CFPSCounter()
 
 CFPSCounter::~CFPSCounter()
 {
+	if (!csvFilename.empty())
+		WriteCSV(csvFilename);
 }
 
 
@@ -30,6 +57,30 @@ void CFPSCounter::Init(void)
 	nFrames = 0;
 	iFrameRate = 0;
 	dFrameTime = 60;
+	dSumFrameTime = 0.0;
+	dSumSquaredFrameTime = 0.0;
+	dCurrMinFrameTime = 0.0;
+	dCurrMaxFrameTime = 0.0;
+	dJitter = 0.0;
+	dMinFrameTime = 0.0;
+	dMaxFrameTime = 0.0;
+
+	dPendingUpdateTime = 0.0;
+	dPendingRenderTime = 0.0;
+	dPendingGPUTime = 0.0;
+	iNumSamples = 0;
+	iSampleOffset = 0;
+	std::fill(arrFrameTimes, arrFrameTimes + NUM_SAMPLES, 0.0f);
+	std::fill(arrPercentiles, arrPercentiles + NUM_PERCENTILES, 0.0);
+	dAverageUpdateTime = 0.0;
+	dAverageRenderTime = 0.0;
+	dAverageGPUTime = 0.0;
+	std::fill(arrHistogram, arrHistogram + NUM_HISTOGRAM_BUCKETS, 0.0f);
+	uiNumHitches = 0;
+	// Reserve the whole history now, so that no frame pays for the vector growing. Its pages are only
+	// used as the frames are added.
+	history.clear();
+	history.reserve(MAX_HISTORY);
 }
 
 // Update the class instance
@@ -41,13 +92,61 @@ void CFPSCounter::Update(const double deltaTime)
 	// Update the frame count
 	nFrames++;
 
+	// Update the statistics of the frame times
+	const double dTime = deltaTime * 1000.0;
+	dSumFrameTime += dTime;
+	dSumSquaredFrameTime += dTime * dTime;
+	if (nFrames == 1)
+	{
+		dCurrMinFrameTime = dTime;
+		dCurrMaxFrameTime = dTime;
+	}
+	else
+	{
+		dCurrMinFrameTime = std::min(dCurrMinFrameTime, dTime);
+		dCurrMaxFrameTime = std::max(dCurrMaxFrameTime, dTime);
+	}
+
+	// Add the frame to the rolling window, over the oldest one
+	SSample sSample;
+	sSample.fFrameTime = (float)dTime;
+	sSample.fUpdateTime = (float)(dPendingUpdateTime * 1000.0);
+	sSample.fRenderTime = (float)(dPendingRenderTime * 1000.0);
+	sSample.fGPUTime = (float)(dPendingGPUTime * 1000.0);
+	dPendingUpdateTime = 0.0;
+	dPendingRenderTime = 0.0;
+	dPendingGPUTime = 0.0;
+	const int iIndex = (iSampleOffset + iNumSamples) % NUM_SAMPLES;
+	arrSamples[iIndex] = sSample;
+	arrFrameTimes[iIndex] = sSample.fFrameTime;
+	if (iNumSamples < NUM_SAMPLES)
+		iNumSamples++;
+	else
+		iSampleOffset = (iSampleOffset + 1) % NUM_SAMPLES;
+
+	if (dTime > dHitchThreshold)
+		uiNumHitches++;
+	if (history.size() < MAX_HISTORY)
+		history.push_back(sSample);
+
 	if (dElapsedTime >= 1.0){ // If last update was more than 1 sec ago...
 		// Calculate the current frame rate
 		dFrameTime = 1000.0 / double(nFrames);
 
+		// Calculate the jitter from the mean and the mean of the squares of the frame times
+		const double dMean = dSumFrameTime / nFrames;
+		const double dVariance = dSumSquaredFrameTime / nFrames - dMean * dMean;
+		dJitter = sqrt(std::max(0.0, dVariance));
+		dMinFrameTime = dCurrMinFrameTime;
+		dMaxFrameTime = dCurrMaxFrameTime;
+		dSumFrameTime = 0.0;
+		dSumSquaredFrameTime = 0.0;
+
 		// Update the frame count for the last 1 second
 		iFrameRate = nFrames;
 
+		UpdateWindowStatistics();
+
 		// Reset timer and update the lastTime
 		nFrames = 0;
 		dElapsedTime = 0.0;
@@ -71,3 +170,199 @@ double CFPSCounter::GetFrameTime(void) const
 {
 	return dFrameTime;
 }
+
+// Get the jitter, which is the standard deviation of the frame times in the last 1 second, in milliseconds
+double CFPSCounter::GetJitter(void) const
+{
+	return dJitter;
+}
+
+// Get the shortest frame time in the last 1 second, in milliseconds
+double CFPSCounter::GetMinFrameTime(void) const
+{
+	return dMinFrameTime;
+}
+
+// Get the longest frame time in the last 1 second, in milliseconds
+double CFPSCounter::GetMaxFrameTime(void) const
+{
+	return dMaxFrameTime;
+}
+
+// Set the time in seconds which the updates of this frame took. Call it before Update().
+void CFPSCounter::SetUpdateTime(const double dUpdateTime)
+{
+	dPendingUpdateTime = dUpdateTime;
+}
+
+// Set the time in seconds which the rendering of this frame took. Call it before Update().
+void CFPSCounter::SetRenderTime(const double dRenderTime)
+{
+	dPendingRenderTime = dRenderTime;
+}
+
+// Set the time in seconds which the GPU took for the latest frame which it has finished. Call it before Update().
+void CFPSCounter::SetGPUTime(const double dGPUTime)
+{
+	dPendingGPUTime = dGPUTime;
+}
+
+// Set the frame time in milliseconds above which a frame is counted as a hitch
+void CFPSCounter::SetHitchThreshold(const double dHitchThreshold)
+{
+	this->dHitchThreshold = dHitchThreshold;
+}
+
+// Get the frame time in milliseconds above which a frame is counted as a hitch
+double CFPSCounter::GetHitchThreshold(void) const
+{
+	return dHitchThreshold;
+}
+
+// Get the number of hitches since Init()
+unsigned int CFPSCounter::GetNumHitches(void) const
+{
+	return uiNumHitches;
+}
+
+// Get a percentile of the frame times in the rolling window, in milliseconds. It is updated every 1 second.
+double CFPSCounter::GetFrameTimePercentile(const PERCENTILE ePercentile) const
+{
+	if ((ePercentile < P50) || (ePercentile >= NUM_PERCENTILES))
+		return 0.0;
+	return arrPercentiles[ePercentile];
+}
+
+// Get the average time of the updates in the rolling window, in milliseconds
+double CFPSCounter::GetAverageUpdateTime(void) const
+{
+	return dAverageUpdateTime;
+}
+
+// Get the average time of the rendering in the rolling window, in milliseconds
+double CFPSCounter::GetAverageRenderTime(void) const
+{
+	return dAverageRenderTime;
+}
+
+// Get the average time of the GPU in the rolling window, in milliseconds
+double CFPSCounter::GetAverageGPUTime(void) const
+{
+	return dAverageGPUTime;
+}
+
+// Get the frame times in the rolling window, in milliseconds. The oldest one is at GetSampleOffset().
+const float* CFPSCounter::GetFrameTimeSamples(void) const
+{
+	return arrFrameTimes;
+}
+
+// Get the number of frames in the rolling window
+int CFPSCounter::GetNumSamples(void) const
+{
+	return iNumSamples;
+}
+
+// Get the index of the oldest frame in the rolling window
+int CFPSCounter::GetSampleOffset(void) const
+{
+	return iSampleOffset;
+}
+
+// Get the number of frames in each bucket of the histogram of the rolling window
+const float* CFPSCounter::GetHistogram(void) const
+{
+	return arrHistogram;
+}
+
+// Set the CSV file which the frame times are written into when this class instance is destroyed
+void CFPSCounter::SetCSVFilename(const std::string& filename)
+{
+	csvFilename = filename;
+}
+
+// Write the frame times since Init() into a CSV file, one frame in each row
+bool CFPSCounter::WriteCSV(const std::string& filename) const
+{
+	std::ofstream outputFile(filename.c_str());
+	if (!outputFile)
+	{
+		cout << "CFPSCounter: Unable to open " << filename << endl;
+		return false;
+	}
+
+	outputFile << "frame,frame_ms,update_ms,render_ms,gpu_ms,hitch" << endl;
+	outputFile << fixed << setprecision(3);
+	for (size_t i = 0; i < history.size(); i++)
+	{
+		outputFile << i << ',' << history[i].fFrameTime << ',' << history[i].fUpdateTime << ','
+			<< history[i].fRenderTime << ',' << history[i].fGPUTime << ',' << ((history[i].fFrameTime > dHitchThreshold) ? 1 : 0) << '\n';
+	}
+	if (!outputFile)
+	{
+		cout << "CFPSCounter: Unable to write " << filename << endl;
+		return false;
+	}
+
+	cout << "CFPSCounter: Wrote " << history.size() << " frames into " << filename
+		<< ", " << uiNumHitches << " hitches above " << dHitchThreshold << " ms" << endl;
+	return true;
+}
+
+// Add the percentiles and the averages of the frame times since Init() to the results of a benchmark,
+// with their names starting with prefix. Unlike the rolling window, this covers the whole run.
+void CFPSCounter::AddToResults(CBenchmarkResults& cResults, const std::string& prefix) const
+{
+	if (history.empty())
+		return;
+
+	std::vector<float> arrSortedFrameTimes(history.size());
+	double dTotalFrameTime = 0.0, dTotalUpdateTime = 0.0, dTotalRenderTime = 0.0;
+	for (size_t i = 0; i < history.size(); i++)
+	{
+		arrSortedFrameTimes[i] = history[i].fFrameTime;
+		dTotalFrameTime += history[i].fFrameTime;
+		dTotalUpdateTime += history[i].fUpdateTime;
+		dTotalRenderTime += history[i].fRenderTime;
+	}
+	std::sort(arrSortedFrameTimes.begin(), arrSortedFrameTimes.end());
+	const size_t uiLast = arrSortedFrameTimes.size() - 1;
+
+	cResults.Add(prefix + " frame mean", dTotalFrameTime / history.size(), "ms");
+	cResults.Add(prefix + " frame p50", arrSortedFrameTimes[uiLast * 50 / 100], "ms");
+	cResults.Add(prefix + " frame p95", arrSortedFrameTimes[uiLast * 95 / 100], "ms");
+	cResults.Add(prefix + " frame p99", arrSortedFrameTimes[uiLast * 99 / 100], "ms");
+	cResults.Add(prefix + " frame max", arrSortedFrameTimes[uiLast], "ms");
+	cResults.Add(prefix + " update mean", dTotalUpdateTime / history.size(), "ms");
+	cResults.Add(prefix + " render mean", dTotalRenderTime / history.size(), "ms");
+}
+
+// Update the percentiles, the averages and the histogram of the rolling window
+void CFPSCounter::UpdateWindowStatistics(void)
+{
+	if (iNumSamples == 0)
+		return;
+
+	std::vector<float> frameTimes(arrFrameTimes, arrFrameTimes + iNumSamples);
+	double dSumUpdateTime = 0.0, dSumRenderTime = 0.0, dSumGPUTime = 0.0;
+	std::fill(arrHistogram, arrHistogram + NUM_HISTOGRAM_BUCKETS, 0.0f);
+	for (int i = 0; i < iNumSamples; i++)
+	{
+		dSumUpdateTime += arrSamples[i].fUpdateTime;
+		dSumRenderTime += arrSamples[i].fRenderTime;
+		dSumGPUTime += arrSamples[i].fGPUTime;
+		arrHistogram[std::min((int)arrSamples[i].fFrameTime, (int)NUM_HISTOGRAM_BUCKETS - 1)] += 1.0f;
+	}
+	dAverageUpdateTime = dSumUpdateTime / iNumSamples;
+	dAverageRenderTime = dSumRenderTime / iNumSamples;
+	dAverageGPUTime = dSumGPUTime / iNumSamples;
+
+	// The nearest rank of each percentile
+	const double arrFractions[NUM_PERCENTILES] = { 0.50, 0.95, 0.99, 1.0 };
+	for (int i = 0; i < NUM_PERCENTILES; i++)
+	{
+		const int iRank = std::max((int)ceil(arrFractions[i] * iNumSamples) - 1, 0);
+		std::nth_element(frameTimes.begin(), frameTimes.begin() + iRank, frameTimes.end());
+		arrPercentiles[i] = frameTimes[iRank];
+	}
+}
@@ -1,6 +1,8 @@
 /**
  CFPSCounter
- @brief A class to calculate the Frames-Per-Second
+ @brief A class to calculate the Frames-Per-Second. It also keeps the frame times of the last NUM_SAMPLES frames,
+		for their percentiles, histogram and graph, counts the hitches, and writes the frame times of the whole run
+		into a CSV file when it is destroyed, so that two builds can be compared.
  By: Toh Da Jun
  Date: Mar 2020
  */
@@ -10,12 +12,32 @@
 #include "../DesignPatterns/SingletonTemplate.h"
 
 #include <string>
+#include <vector>
+
+class CBenchmarkResults;
 
 class CFPSCounter : public CSingletonTemplate<CFPSCounter>
 {
 	friend CSingletonTemplate<CFPSCounter>;
 
 public:
+	enum
+	{
+		NUM_SAMPLES = 600,				// The number of frames in the rolling window
+		NUM_HISTOGRAM_BUCKETS = 50,		// The buckets of the histogram are 1 ms wide. The last one also holds the longer frames.
+		MAX_HISTORY = 1024 * 1024		// The most frames kept for the CSV file
+	};
+
+	// The percentiles of the frame times in the rolling window
+	enum PERCENTILE
+	{
+		P50 = 0,
+		P95,
+		P99,
+		P100,	// The longest frame time
+		NUM_PERCENTILES
+	};
+
 	// Destructor
 	virtual ~CFPSCounter(void);
 
@@ -34,6 +56,53 @@ public:
 	// Get the current frame time
 	double GetFrameTime(void) const;
 
+	// Get the jitter, which is the standard deviation of the frame times in the last 1 second, in milliseconds
+	double GetJitter(void) const;
+
+	// Get the shortest frame time in the last 1 second, in milliseconds
+	double GetMinFrameTime(void) const;
+
+	// Get the longest frame time in the last 1 second, in milliseconds
+	double GetMaxFrameTime(void) const;
+
+	// Set the time in seconds which the updates of this frame took. Call it before Update().
+	void SetUpdateTime(const double dUpdateTime);
+	// Set the time in seconds which the rendering of this frame took. Call it before Update().
+	void SetRenderTime(const double dRenderTime);
+	// Set the time in seconds which the GPU took for the latest frame which it has finished. Call it before Update().
+	void SetGPUTime(const double dGPUTime);
+
+	// Set the frame time in milliseconds above which a frame is counted as a hitch
+	void SetHitchThreshold(const double dHitchThreshold);
+	// Get the frame time in milliseconds above which a frame is counted as a hitch
+	double GetHitchThreshold(void) const;
+	// Get the number of hitches since Init()
+	unsigned int GetNumHitches(void) const;
+
+	// Get a percentile of the frame times in the rolling window, in milliseconds. It is updated every 1 second.
+	double GetFrameTimePercentile(const PERCENTILE ePercentile) const;
+	// Update the percentiles, the averages and the histogram of the rolling window now, instead of at the end of this second
+	void UpdateWindowStatistics(void);
+	// Get the average times of the updates and the rendering in the rolling window, in milliseconds
+	double GetAverageUpdateTime(void) const;
+	double GetAverageRenderTime(void) const;
+	// Get the average time of the GPU in the rolling window, in milliseconds
+	double GetAverageGPUTime(void) const;
+
+	// Get the frame times in the rolling window, in milliseconds. The oldest one is at GetSampleOffset().
+	const float* GetFrameTimeSamples(void) const;
+	int GetNumSamples(void) const;
+	int GetSampleOffset(void) const;
+	// Get the number of frames in each bucket of the histogram of the rolling window
+	const float* GetHistogram(void) const;
+
+	// Set the CSV file which the frame times are written into when this class instance is destroyed
+	void SetCSVFilename(const std::string& filename);
+	// Write the frame times since Init() into a CSV file
+	bool WriteCSV(const std::string& filename) const;
+	// Add the percentiles and the averages of the frame times since Init() to the results of a benchmark
+	void AddToResults(CBenchmarkResults& cResults, const std::string& prefix) const;
+
 protected:
 	// Count the elapsed time since the last reset
 	double dElapsedTime;
@@ -44,6 +113,52 @@ protected:
 	// Count the elapsed time since the last reset
 	double dFrameTime;
 
+	// The sum of the frame times and of their squares, and the shortest and longest frame times, for the current second
+	double dSumFrameTime;
+	double dSumSquaredFrameTime;
+	double dCurrMinFrameTime;
+	double dCurrMaxFrameTime;
+
+	// The jitter, shortest and longest frame times for the last 1 second, in milliseconds
+	double dJitter;
+	double dMinFrameTime;
+	double dMaxFrameTime;
+
+	// A frame, in milliseconds
+	struct SSample
+	{
+		float fFrameTime;
+		float fUpdateTime;
+		float fRenderTime;
+		float fGPUTime;
+	};
+
+	// The update, render and GPU times set for the current frame, in seconds
+	double dPendingUpdateTime;
+	double dPendingRenderTime;
+	double dPendingGPUTime;
+
+	// The rolling window of frames, and the index of the oldest one
+	SSample arrSamples[NUM_SAMPLES];
+	float arrFrameTimes[NUM_SAMPLES];
+	int iNumSamples;
+	int iSampleOffset;
+
+	// The statistics of the rolling window, updated every 1 second
+	double arrPercentiles[NUM_PERCENTILES];
+	double dAverageUpdateTime;
+	double dAverageRenderTime;
+	double dAverageGPUTime;
+	float arrHistogram[NUM_HISTOGRAM_BUCKETS];
+
+	// The hitches
+	double dHitchThreshold;
+	unsigned int uiNumHitches;
+
+	// The frames since Init(), for the CSV file
+	std::vector<SSample> history;
+	std::string csvFilename;
+
 	// Constructor
 	CFPSCounter(void);
 };
@@ -0,0 +1,145 @@
+/**
+ CFramePacer
+ @brief A class to hold the frames to a frame rate. It sleeps until shortly before the end of a frame,
+		then spins for the rest, so that each frame ends within a fraction of a millisecond of its deadline.
+ By: agent
+ Date: Oct 2026
+ */
+#include "FramePacer.h"
+
+#include <algorithm>
+
+// How much of the new work time is taken into the smoothed work time in each frame
+#define WORK_TIME_SMOOTHING 0.1
+// How much slower than the smoothed work time the ADAPTIVE mode holds the frames to, so that a slightly slow frame is not late
+#define WORK_TIME_HEADROOM 1.1
+
+/**
+@brief Constructor
+*/
+CFramePacer::CFramePacer(void)
+	: eMode(CAPPED)
+	, dTargetFrameTime(1.0 / 30.0)
+	, dCPUTime(0.0)
+	, dGPUTime(0.0)
+	, dWorkTime(0.0)
+	, dFrameTimeTarget(1.0 / 30.0)
+{
+}
+
+/**
+@brief Destructor
+*/
+CFramePacer::~CFramePacer(void)
+{
+}
+
+/**
+@brief Initialise this class instance. The first frame starts now.
+@param eMode A const MODE variable containing the mode
+@param dTargetFrameRate A const double variable containing the target number of frames per second
+*/
+void CFramePacer::Init(const MODE eMode, const double dTargetFrameRate)
+{
+	SetMode(eMode);
+	SetTargetFrameRate(dTargetFrameRate);
+	dCPUTime = 0.0;
+	dGPUTime = 0.0;
+	dWorkTime = 0.0;
+	dFrameTimeTarget = dTargetFrameTime;
+
+	cStopWatch.Init();
+}
+
+/**
+@brief Set the mode
+@param eMode A const MODE variable containing the mode
+*/
+void CFramePacer::SetMode(const MODE eMode)
+{
+	this->eMode = eMode;
+}
+
+/**
+@brief Get the mode
+*/
+CFramePacer::MODE CFramePacer::GetMode(void) const
+{
+	return eMode;
+}
+
+/**
+@brief Set the target frame rate
+@param dTargetFrameRate A const double variable containing the target number of frames per second
+*/
+void CFramePacer::SetTargetFrameRate(const double dTargetFrameRate)
+{
+	if (dTargetFrameRate > 0.0)
+		dTargetFrameTime = 1.0 / dTargetFrameRate;
+}
+
+/**
+@brief Get the target frame rate
+*/
+double CFramePacer::GetTargetFrameRate(void) const
+{
+	return 1.0 / dTargetFrameTime;
+}
+
+/**
+@brief Set the time in seconds which the GPU took for the last frame, for the ADAPTIVE mode
+@param dGPUTime A const double variable containing the time in seconds
+*/
+void CFramePacer::SetGPUTime(const double dGPUTime)
+{
+	this->dGPUTime = dGPUTime;
+}
+
+/**
+@brief Wait until the end of this frame
+@return The time in seconds since the end of the last frame, including the wait
+*/
+double CFramePacer::Pace(void)
+{
+	dCPUTime = cStopWatch.PeekElapsedTime();
+
+	switch (eMode)
+	{
+	case UNCAPPED:
+		dFrameTimeTarget = 0.0;
+		break;
+
+	case ADAPTIVE:
+		// A frame rate which the machine cannot keep is lowered to one which it can,
+		// so that the frames are evenly paced instead of alternating between fast and slow
+		dWorkTime += (std::max(dCPUTime, dGPUTime) - dWorkTime) * WORK_TIME_SMOOTHING;
+		dFrameTimeTarget = std::max(dTargetFrameTime, dWorkTime * WORK_TIME_HEADROOM);
+		break;
+
+	case CAPPED:
+	default:
+		dFrameTimeTarget = dTargetFrameTime;
+		break;
+	}
+
+	if (dFrameTimeTarget > dCPUTime)
+		cStopWatch.WaitUntilTime(dFrameTimeTarget);
+
+	return cStopWatch.GetElapsedTime();
+}
+
+/**
+@brief Get the time in seconds which the CPU took for the last frame, before it waited
+*/
+double CFramePacer::GetCPUTime(void) const
+{
+	return dCPUTime;
+}
+
+/**
+@brief Get the time in seconds which the last frame was held to
+*/
+double CFramePacer::GetFrameTimeTarget(void) const
+{
+	return dFrameTimeTarget;
+}
@@ -0,0 +1,70 @@
+/**
+ CFramePacer
+ @brief A class to hold the frames to a frame rate. It sleeps until shortly before the end of a frame,
+		then spins for the rest, so that each frame ends within a fraction of a millisecond of its deadline.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include CStopWatch
+#include "StopWatch.h"
+
+class CFramePacer
+{
+public:
+	enum MODE
+	{
+		CAPPED = 0,	// Hold each frame to the target frame rate
+		UNCAPPED,	// Do not wait at all
+		ADAPTIVE,	// Hold each frame to the target frame rate, or lower if the CPU and GPU cannot keep up with it
+		NUM_MODES
+	};
+
+	// Constructor
+	CFramePacer(void);
+
+	// Destructor
+	~CFramePacer(void);
+
+	// Initialise this class instance
+	void Init(const MODE eMode, const double dTargetFrameRate);
+
+	// Set the mode
+	void SetMode(const MODE eMode);
+	// Get the mode
+	MODE GetMode(void) const;
+
+	// Set the target frame rate
+	void SetTargetFrameRate(const double dTargetFrameRate);
+	// Get the target frame rate
+	double GetTargetFrameRate(void) const;
+
+	// Set the time in seconds which the GPU took for the last frame, for the ADAPTIVE mode
+	void SetGPUTime(const double dGPUTime);
+
+	// Wait until the end of this frame, and return the time in seconds since the end of the last frame
+	double Pace(void);
+
+	// Get the time in seconds which the CPU took for the last frame, before it waited
+	double GetCPUTime(void) const;
+	// Get the time in seconds which the last frame was held to
+	double GetFrameTimeTarget(void) const;
+
+protected:
+	// The stop watch which times the frames
+	CStopWatch cStopWatch;
+
+	// The mode
+	MODE eMode;
+	// The target time in seconds of a frame
+	double dTargetFrameTime;
+
+	// The time in seconds which the CPU and the GPU took for the last frame
+	double dCPUTime;
+	double dGPUTime;
+	// The smoothed time in seconds which the slower of the CPU and GPU takes for a frame, for the ADAPTIVE mode
+	double dWorkTime;
+	// The time in seconds which the last frame was held to
+	double dFrameTimeTarget;
+};
@@ -0,0 +1,446 @@
+/**
+ CPerfCounters
+ @brief A class to count the hardware events of zones of code with the perf_event counters of Linux:
+		the cycles, the instructions, the cache misses and the branch mispredictions. Each thread opens its
+		own counters the first time it enters a zone, and adds the counts of each zone into its own table,
+		so that the threads do not share anything while counting. Only the user-space events are counted.
+		A zone is counted by PROFILE_COUNTERS, which also times it as a PROFILE_ZONE. It is only counted when
+		ENABLE_PERF_COUNTERS is defined. Reading the counters takes a system call at each end of a zone, so
+		only use it in builds which are tuning the data layouts.
+		Where perf_event cannot be opened, e.g. on Windows, in most virtual machines or when
+		/proc/sys/kernel/perf_event_paranoid forbids it, the zones are still timed and the counters are shown as n/a.
+ By: agent
+ Date: Oct 2026
+ */
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+using namespace std;
+
+thread_local CPerfCounterThread* CPerfCounters::pCurrentThread = nullptr;
+
+#ifdef __linux__
+// The hardware events of each counter, in the order of SPerfZoneStats::COUNTER
+static const uint64_t arrPerfEvents[SPerfZoneStats::NUM_COUNTERS] =
+{
+	PERF_COUNT_HW_CPU_CYCLES,
+	PERF_COUNT_HW_INSTRUCTIONS,
+	PERF_COUNT_HW_CACHE_MISSES,
+	PERF_COUNT_HW_BRANCH_MISSES
+};
+
+/**
+@brief Open a counter of the calling thread. glibc has no wrapper for perf_event_open, so the system call is made directly.
+@param uiEvent A const uint64_t variable containing the hardware event
+@param iGroup A const int variable containing the file descriptor of the leader of the group, or -1 for a new group
+@return the file descriptor, or -1 if it could not be opened
+*/
+static int OpenCounter(const uint64_t uiEvent, const int iGroup)
+{
+	perf_event_attr sAttr;
+	memset(&sAttr, 0, sizeof(sAttr));
+	sAttr.size = sizeof(sAttr);
+	sAttr.type = PERF_TYPE_HARDWARE;
+	sAttr.config = uiEvent;
+	sAttr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	sAttr.exclude_kernel = 1;
+	sAttr.exclude_hv = 1;
+	// The leader starts disabled, and the whole group is enabled once all of it has been opened
+	sAttr.disabled = (iGroup == -1) ? 1 : 0;
+	return (int)syscall(__NR_perf_event_open, &sAttr, 0, -1, iGroup, 0);
+}
+#endif
+
+/**
+@brief Constructor
+*/
+CPerfCounterThread::CPerfCounterThread(void)
+	: bOpen(false)
+{
+	for (int i = 0; i < SPerfZoneStats::NUM_COUNTERS; i++)
+	{
+		arrFileDescriptors[i] = -1;
+	}
+}
+
+/**
+@brief Destructor
+*/
+CPerfCounterThread::~CPerfCounterThread(void)
+{
+#ifdef __linux__
+	// Close the members of the group before its leader
+	for (int i = SPerfZoneStats::NUM_COUNTERS - 1; i >= 0; i--)
+	{
+		if (arrFileDescriptors[i] != -1)
+			close(arrFileDescriptors[i]);
+	}
+#endif
+}
+
+/**
+@brief Open the counters of the calling thread. A counter which the machine does not have is left out of the group.
+@param iError An int& variable which the error of the first counter which failed is put into
+@return true if at least the first counter was opened, otherwise false
+*/
+bool CPerfCounterThread::Open(int& iError)
+{
+	iError = 0;
+#ifdef __linux__
+	int iLeader = -1;
+	for (int i = 0; i < SPerfZoneStats::NUM_COUNTERS; i++)
+	{
+		arrFileDescriptors[i] = OpenCounter(arrPerfEvents[i], iLeader);
+		if (arrFileDescriptors[i] == -1)
+		{
+			if (iError == 0)
+				iError = errno;
+			// Without the cycles there is no group, and no IPC, so give up on all of them
+			if (i == SPerfZoneStats::CYCLES)
+				return false;
+			continue;
+		}
+		if (iLeader == -1)
+			iLeader = arrFileDescriptors[i];
+	}
+
+	ioctl(iLeader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(iLeader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	bOpen = true;
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+@brief Read the counters now. If the kernel had to share the hardware with other counters,
+	   the counts are scaled up by the fraction of the time that they were counting.
+@param arrValues A uint64_t array which the count of each counter is put into. A counter which is not open is 0.
+@return true if the counters were read, otherwise false
+*/
+bool CPerfCounterThread::Read(uint64_t arrValues[SPerfZoneStats::NUM_COUNTERS])
+{
+	for (int i = 0; i < SPerfZoneStats::NUM_COUNTERS; i++)
+	{
+		arrValues[i] = 0;
+	}
+	if (!bOpen)
+		return false;
+
+#ifdef __linux__
+	// The number of counters, the times enabled and running, then the count of each counter in the order they were opened
+	uint64_t arrBuffer[3 + SPerfZoneStats::NUM_COUNTERS];
+	const ssize_t iRead = read(arrFileDescriptors[SPerfZoneStats::CYCLES], arrBuffer, sizeof(arrBuffer));
+	if ((iRead < (ssize_t)(3 * sizeof(uint64_t))) || (arrBuffer[2] == 0))
+		return false;
+
+	const uint64_t uiNumValues = arrBuffer[0];
+	const double dScale = (double)arrBuffer[1] / (double)arrBuffer[2];
+	uint64_t uiValue = 0;
+	for (int i = 0; (i < SPerfZoneStats::NUM_COUNTERS) && (uiValue < uiNumValues); i++)
+	{
+		if (arrFileDescriptors[i] == -1)
+			continue;
+		arrValues[i] = (uint64_t)(arrBuffer[3 + uiValue] * dScale);
+		uiValue++;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+@brief Get the index of a zone in the table of this thread, where it is added the first time.
+	   The zones are found by the address of their names, as there are only a few of them.
+@param pName A const char* variable containing the name of the zone
+*/
+size_t CPerfCounterThread::GetZone(const char* pName)
+{
+	for (size_t i = 0; i < zones.size(); i++)
+	{
+		if (zones[i].pName == pName)
+			return i;
+	}
+
+	SPerfZoneStats sStats;
+	memset(&sStats, 0, sizeof(sStats));
+	sStats.pName = pName;
+	zones.push_back(sStats);
+	return zones.size() - 1;
+}
+
+/**
+@brief Constructor
+*/
+CPerfCounters::CPerfCounters(void)
+	: bTried(false)
+{
+	for (int i = 0; i < SPerfZoneStats::NUM_COUNTERS; i++)
+	{
+		arrAvailable[i] = false;
+	}
+}
+
+/**
+@brief Destructor. No thread may enter a zone after this.
+*/
+CPerfCounters::~CPerfCounters(void)
+{
+	std::lock_guard<std::mutex> lock(threadMutex);
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		delete threads[i];
+	}
+	threads.clear();
+	pCurrentThread = nullptr;
+}
+
+/**
+@brief Get the counters of the calling thread
+*/
+CPerfCounterThread* CPerfCounters::GetThread(void)
+{
+	if (pCurrentThread == nullptr)
+		pCurrentThread = GetInstance()->RegisterThread();
+	return pCurrentThread;
+}
+
+/**
+@brief Check if the zones are counted in this build
+*/
+bool CPerfCounters::IsEnabled(void)
+{
+#ifdef ENABLE_PERF_COUNTERS
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+@brief Check if the counters could be opened
+*/
+bool CPerfCounters::IsAvailable(void) const
+{
+	return IsCounterAvailable(SPerfZoneStats::CYCLES);
+}
+
+/**
+@brief Check if a counter could be opened
+@param eCounter A const SPerfZoneStats::COUNTER variable containing the counter
+*/
+bool CPerfCounters::IsCounterAvailable(const SPerfZoneStats::COUNTER eCounter) const
+{
+	if ((eCounter < SPerfZoneStats::CYCLES) || (eCounter >= SPerfZoneStats::NUM_COUNTERS))
+		return false;
+
+	std::lock_guard<std::mutex> lock(threadMutex);
+	return arrAvailable[eCounter];
+}
+
+/**
+@brief Create the counters of the calling thread, and open them. If the first thread cannot open them,
+	   the reason is printed once, and the zones are only timed from then on.
+*/
+CPerfCounterThread* CPerfCounters::RegisterThread(void)
+{
+	CPerfCounterThread* pThread = new CPerfCounterThread();
+	int iError = 0;
+	const bool bOpened = pThread->Open(iError);
+
+	std::lock_guard<std::mutex> lock(threadMutex);
+	threads.push_back(pThread);
+	if (!bTried)
+	{
+		bTried = true;
+		for (int i = 0; i < SPerfZoneStats::NUM_COUNTERS; i++)
+		{
+			arrAvailable[i] = (pThread->arrFileDescriptors[i] != -1);
+		}
+#ifdef __linux__
+		if (!bOpened)
+		{
+			cout << "CPerfCounters::RegisterThread - perf_event is not available (" << strerror(iError)
+				<< "), so the zones are only timed. Check /proc/sys/kernel/perf_event_paranoid." << endl;
+		}
+		else if (iError != 0)
+		{
+			cout << "CPerfCounters::RegisterThread - Some counters are not available (" << strerror(iError) << ")" << endl;
+		}
+#else
+		(void)bOpened;
+		cout << "CPerfCounters::RegisterThread - perf_event is only available on Linux, so the zones are only timed" << endl;
+#endif
+	}
+	return pThread;
+}
+
+/**
+@brief Add up the counts of each zone over all the threads, sorted by their total times
+@param totals A std::vector<SPerfZoneStats>& variable which the counts are put into
+*/
+void CPerfCounters::GetTotals(std::vector<SPerfZoneStats>& totals) const
+{
+	totals.clear();
+
+	std::lock_guard<std::mutex> lock(threadMutex);
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		const std::vector<SPerfZoneStats>& zones = threads[i]->zones;
+		for (size_t j = 0; j < zones.size(); j++)
+		{
+			size_t k = 0;
+			while ((k < totals.size()) && (totals[k].pName != zones[j].pName))
+			{
+				k++;
+			}
+			if (k == totals.size())
+			{
+				totals.push_back(zones[j]);
+				continue;
+			}
+			totals[k].uiNumCalls += zones[j].uiNumCalls;
+			totals[k].uiTime += zones[j].uiTime;
+			for (int c = 0; c < SPerfZoneStats::NUM_COUNTERS; c++)
+			{
+				totals[k].arrCounts[c] += zones[j].arrCounts[c];
+			}
+		}
+	}
+
+	std::sort(totals.begin(), totals.end(),
+		[](const SPerfZoneStats& a, const SPerfZoneStats& b) { return a.uiTime > b.uiTime; });
+}
+
+/**
+@brief Print the counts of each zone over all the threads, per call, next to their times. A zone includes the zones inside it.
+@param os A std::ostream& variable which the report is printed into
+*/
+void CPerfCounters::PrintReport(std::ostream& os) const
+{
+	if (!IsEnabled())
+	{
+		os << "Perf counters: not enabled in this build (ENABLE_PERF_COUNTERS)" << endl;
+		return;
+	}
+
+	std::vector<SPerfZoneStats> totals;
+	GetTotals(totals);
+	if (totals.empty())
+	{
+		os << "Perf counters: no zones were entered" << endl;
+		return;
+	}
+
+	bool arrShown[SPerfZoneStats::NUM_COUNTERS];
+	for (int c = 0; c < SPerfZoneStats::NUM_COUNTERS; c++)
+	{
+		arrShown[c] = IsCounterAvailable((SPerfZoneStats::COUNTER)c);
+	}
+
+	const std::ios_base::fmtflags flags = os.flags();
+	const std::streamsize precision = os.precision();
+	const char cFill = os.fill(' ');
+	os << "Perf counters (per call):" << endl;
+	os << std::left << std::setw(28) << "Zone" << std::right
+		<< std::setw(10) << "Calls" << std::setw(12) << "us/call"
+		<< std::setw(14) << "Cycles" << std::setw(14) << "Instructions" << std::setw(7) << "IPC"
+		<< std::setw(13) << "CacheMisses" << std::setw(14) << "BranchMisses" << endl;
+	os << std::fixed;
+	for (size_t i = 0; i < totals.size(); i++)
+	{
+		const SPerfZoneStats& sStats = totals[i];
+		const double dCalls = (double)std::max<uint64_t>(sStats.uiNumCalls, 1);
+		os << std::left << std::setw(28) << sStats.pName << std::right
+			<< std::setw(10) << sStats.uiNumCalls
+			<< std::setw(12) << std::setprecision(2) << sStats.uiTime / dCalls / 1000.0
+			<< std::setprecision(0);
+		for (int c = SPerfZoneStats::CYCLES; c <= SPerfZoneStats::INSTRUCTIONS; c++)
+		{
+			os << std::setw(14);
+			if (arrShown[c])
+				os << sStats.arrCounts[c] / dCalls;
+			else
+				os << "n/a";
+		}
+		os << std::setw(7);
+		if ((arrShown[SPerfZoneStats::CYCLES]) && (arrShown[SPerfZoneStats::INSTRUCTIONS]) && (sStats.arrCounts[SPerfZoneStats::CYCLES] > 0))
+			os << std::setprecision(2) << (double)sStats.arrCounts[SPerfZoneStats::INSTRUCTIONS] / sStats.arrCounts[SPerfZoneStats::CYCLES];
+		else
+			os << "n/a";
+		os << std::setprecision(1);
+		for (int c = SPerfZoneStats::CACHE_MISSES; c <= SPerfZoneStats::BRANCH_MISSES; c++)
+		{
+			os << std::setw(c == SPerfZoneStats::CACHE_MISSES ? 13 : 14);
+			if (arrShown[c])
+				os << sStats.arrCounts[c] / dCalls;
+			else
+				os << "n/a";
+		}
+		os << endl;
+	}
+	os.flags(flags);
+	os.precision(precision);
+	os.fill(cFill);
+}
+
+/**
+@brief Forget the counts of all the zones. Call it when no thread is inside a zone.
+*/
+void CPerfCounters::Reset(void)
+{
+	std::lock_guard<std::mutex> lock(threadMutex);
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		threads[i]->zones.clear();
+	}
+}
+
+/**
+@brief Constructor. Read the counters at the start of the zone, after the table has been looked up,
+	   so that the look up is not counted.
+@param pName A const char* variable containing the name of the zone. It must be a string literal.
+*/
+CPerfCounterZone::CPerfCounterZone(const char* pName)
+	: pThread(CPerfCounters::GetThread())
+	, uiZone(0)
+{
+	uiZone = pThread->GetZone(pName);
+	uiStart = CProfiler::GetTime();
+	bCounted = pThread->Read(arrStart);
+}
+
+/**
+@brief Destructor. Read the counters at the end of the zone, and add the difference into its counts.
+*/
+CPerfCounterZone::~CPerfCounterZone(void)
+{
+	uint64_t arrEnd[SPerfZoneStats::NUM_COUNTERS];
+	const bool bRead = bCounted && pThread->Read(arrEnd);
+	const uint64_t uiEnd = CProfiler::GetTime();
+
+	SPerfZoneStats& sStats = pThread->zones[uiZone];
+	sStats.uiNumCalls++;
+	sStats.uiTime += uiEnd - uiStart;
+	if (!bRead)
+		return;
+	for (int c = 0; c < SPerfZoneStats::NUM_COUNTERS; c++)
+	{
+		// The scaled counts of a counter which is shared with others may step back a little
+		if (arrEnd[c] > arrStart[c])
+			sStats.arrCounts[c] += arrEnd[c] - arrStart[c];
+	}
+}
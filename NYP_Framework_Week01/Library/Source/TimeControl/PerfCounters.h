@@ -0,0 +1,166 @@
+/**
+ CPerfCounters
+ @brief A class to count the hardware events of zones of code with the perf_event counters of Linux:
+		the cycles, the instructions, the cache misses and the branch mispredictions. Each thread opens its
+		own counters the first time it enters a zone, and adds the counts of each zone into its own table,
+		so that the threads do not share anything while counting. Only the user-space events are counted.
+		A zone is counted by PROFILE_COUNTERS, which also times it as a PROFILE_ZONE. It is only counted when
+		ENABLE_PERF_COUNTERS is defined. Reading the counters takes a system call at each end of a zone, so
+		only use it in builds which are tuning the data layouts.
+		Where perf_event cannot be opened, e.g. on Windows, in most virtual machines or when
+		/proc/sys/kernel/perf_event_paranoid forbids it, the zones are still timed and the counters are shown as n/a.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+// Include CProfiler, for PROFILE_ZONE
+#include "Profiler.h"
+
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#ifdef ENABLE_PERF_COUNTERS
+	#define PERF_JOIN_NAME(a, b) a##b
+	#define PERF_MAKE_NAME(a, b) PERF_JOIN_NAME(a, b)
+	// Time the rest of this scope as a zone, and count its hardware events. The name must be a string literal.
+	#define PROFILE_COUNTERS(name) PROFILE_ZONE(name); CPerfCounterZone PERF_MAKE_NAME(cPerfCounterZone, __LINE__)(name)
+#else
+	#define PROFILE_COUNTERS(name) PROFILE_ZONE(name)
+#endif
+
+// The counts of one zone on one thread
+struct SPerfZoneStats
+{
+	enum COUNTER
+	{
+		CYCLES = 0,
+		INSTRUCTIONS,
+		CACHE_MISSES,
+		BRANCH_MISSES,
+		NUM_COUNTERS
+	};
+
+	// The name of the zone
+	const char* pName;
+	// The number of times that the zone was entered
+	uint64_t uiNumCalls;
+	// The time in the zone, in nanoseconds
+	uint64_t uiTime;
+	// The hardware events in the zone
+	uint64_t arrCounts[NUM_COUNTERS];
+};
+
+/**
+ CPerfCounterThread
+ @brief The counters and the table of zones of one thread
+ */
+class CPerfCounterThread
+{
+	friend class CPerfCounters;
+	friend class CPerfCounterZone;
+public:
+	// Constructor
+	CPerfCounterThread(void);
+
+	// Destructor
+	~CPerfCounterThread(void);
+
+	// Read the counters now. It returns false if they are not open.
+	bool Read(uint64_t arrValues[SPerfZoneStats::NUM_COUNTERS]);
+
+	// Get the index of a zone in the table, where it is added the first time
+	size_t GetZone(const char* pName);
+
+protected:
+	// Open the counters of the calling thread. The error of the first counter which failed is put into iError.
+	bool Open(int& iError);
+
+	// The file descriptors of the counters, or -1 if a counter could not be opened.
+	// The first one leads the group, so that they are all read at once.
+	int arrFileDescriptors[SPerfZoneStats::NUM_COUNTERS];
+	bool bOpen;
+
+	// The counts of the zones. A zone keeps the index of its counts, as the table may grow while it is running.
+	std::vector<SPerfZoneStats> zones;
+
+private:
+	CPerfCounterThread(const CPerfCounterThread&);
+	CPerfCounterThread& operator=(const CPerfCounterThread&);
+};
+
+class CPerfCounters : public CSingletonTemplate<CPerfCounters>
+{
+	friend CSingletonTemplate<CPerfCounters>;
+public:
+	// Get the counters of the calling thread, which are opened the first time that the thread enters a zone
+	static CPerfCounterThread* GetThread(void);
+
+	// Check if the zones are counted in this build
+	static bool IsEnabled(void);
+
+	// Check if the counters could be opened. It is false until a thread has tried to open them.
+	bool IsAvailable(void) const;
+	// Check if a counter could be opened, as some machines do not have all of them
+	bool IsCounterAvailable(const SPerfZoneStats::COUNTER eCounter) const;
+
+	// Add up the counts of each zone over all the threads. Call it when no thread is inside a zone.
+	void GetTotals(std::vector<SPerfZoneStats>& totals) const;
+
+	// Print the counts of each zone over all the threads, per call, next to their times
+	void PrintReport(std::ostream& os) const;
+
+	// Forget the counts of all the zones
+	void Reset(void);
+
+protected:
+	// Constructor
+	CPerfCounters(void);
+
+	// Destructor
+	virtual ~CPerfCounters(void);
+
+	// Create the counters of the calling thread
+	CPerfCounterThread* RegisterThread(void);
+
+	// The counters of the calling thread
+	static thread_local CPerfCounterThread* pCurrentThread;
+
+	// Protects threads and the availability of the counters
+	mutable std::mutex threadMutex;
+	// The counters of all the threads which have entered a zone
+	std::vector<CPerfCounterThread*> threads;
+	// Whether each counter could be opened by the first thread which tried, and whether a thread has tried
+	bool arrAvailable[SPerfZoneStats::NUM_COUNTERS];
+	bool bTried;
+};
+
+/**
+ CPerfCounterZone
+ @brief Counts the hardware events of a zone, from when it is created until it is destroyed. Use it through PROFILE_COUNTERS.
+ */
+class CPerfCounterZone
+{
+public:
+	// Constructor
+	explicit CPerfCounterZone(const char* pName);
+
+	// Destructor
+	~CPerfCounterZone(void);
+
+protected:
+	CPerfCounterThread* pThread;
+	size_t uiZone;
+	uint64_t uiStart;
+	uint64_t arrStart[SPerfZoneStats::NUM_COUNTERS];
+	bool bCounted;
+
+private:
+	CPerfCounterZone(const CPerfCounterZone&);
+	CPerfCounterZone& operator=(const CPerfCounterZone&);
+};
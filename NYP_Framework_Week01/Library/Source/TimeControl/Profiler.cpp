@@ -0,0 +1,418 @@
+/**
+ CProfiler
+ @brief A class to time nested zones of code on every thread. A zone is timed by PROFILE_ZONE, which writes it
+		into a ring buffer of its thread when it ends. Each ring buffer has one writer, its thread, and one reader,
+		EndFrame(), so no lock is taken while timing. The zones of the last frame are shown in a flame view in
+		ImGui, and the zones of a capture are written into a file in the Chrome trace format, which can be
+		opened in chrome://tracing or ui.perfetto.dev.
+		The zones are only timed when ENABLE_PROFILER is defined. Otherwise the macros are empty, and cost nothing.
+ By: agent
+ Date: Oct 2026
+ */
+#include "Profiler.h"
+
+#ifndef HEADLESS
+// Include ImGui, for the flame view
+#include "../GUI/imgui.h"
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+using namespace std;
+
+// The most zones which a capture keeps, so that a long capture does not use up the memory
+#define MAX_CAPTURE_EVENTS (4 * 1024 * 1024)
+
+thread_local CProfileThread* CProfiler::pCurrentThread = nullptr;
+
+/**
+@brief Constructor
+@param uiThreadID A const unsigned int variable containing the index of the thread
+*/
+CProfileThread::CProfileThread(const unsigned int uiThreadID)
+	: uiWriteIndex(0)
+	, uiReadIndex(0)
+	, uiNumDropped(0)
+	, uiDepth(0)
+	, uiThreadID(uiThreadID)
+{
+}
+
+/**
+@brief Destructor
+*/
+CProfileThread::~CProfileThread(void)
+{
+}
+
+/**
+@brief Add a zone which has ended. It is called only by the thread of this ring buffer.
+@param sEvent A const SProfileEvent& variable containing the zone
+*/
+void CProfileThread::Push(const SProfileEvent& sEvent)
+{
+	const uint32_t uiWrite = uiWriteIndex.load(std::memory_order_relaxed);
+	if (uiWrite - uiReadIndex.load(std::memory_order_acquire) >= BUFFER_SIZE)
+	{
+		uiNumDropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	arrEvents[uiWrite & (BUFFER_SIZE - 1)] = sEvent;
+	// Publish the zone only after it has been written
+	uiWriteIndex.store(uiWrite + 1, std::memory_order_release);
+}
+
+/**
+@brief Move the zones in the ring buffer into a vector. It is called only by EndFrame().
+@param events A std::vector<SProfileEvent>& variable which the zones are added to
+*/
+void CProfileThread::Drain(std::vector<SProfileEvent>& events)
+{
+	const uint32_t uiWrite = uiWriteIndex.load(std::memory_order_acquire);
+	uint32_t uiRead = uiReadIndex.load(std::memory_order_relaxed);
+	for (; uiRead != uiWrite; uiRead++)
+	{
+		events.push_back(arrEvents[uiRead & (BUFFER_SIZE - 1)]);
+	}
+	// Give the slots back to the thread only after they have been read
+	uiReadIndex.store(uiRead, std::memory_order_release);
+}
+
+/**
+@brief Constructor. Create the CProfiler before the worker threads start, as they create their ring buffers through it.
+*/
+CProfiler::CProfiler(void)
+	: uiFrameStart(GetTime())
+	, uiFrameEnd(uiFrameStart)
+	, bCapturing(false)
+	, uiCaptureStart(0)
+	, bPaused(false)
+{
+}
+
+/**
+@brief Destructor. No thread may time a zone after this.
+*/
+CProfiler::~CProfiler(void)
+{
+	if (bCapturing)
+		StopCapture();
+
+	std::lock_guard<std::mutex> lock(threadMutex);
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		delete threads[i];
+	}
+	threads.clear();
+	pCurrentThread = nullptr;
+}
+
+/**
+@brief Name the calling thread
+@param pName A const char* variable containing the name
+*/
+void CProfiler::SetThreadName(const char* pName)
+{
+	CProfileThread* pThread = GetThread();
+
+	std::lock_guard<std::mutex> lock(GetInstance()->threadMutex);
+	pThread->name = pName;
+}
+
+/**
+@brief Check if the zones are timed in this build
+*/
+bool CProfiler::IsEnabled(void)
+{
+#ifdef ENABLE_PROFILER
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+@brief Create the ring buffer of the calling thread
+*/
+CProfileThread* CProfiler::RegisterThread(void)
+{
+	std::lock_guard<std::mutex> lock(threadMutex);
+	CProfileThread* pThread = new CProfileThread((unsigned int)threads.size());
+	pThread->name = "Thread " + std::to_string(threads.size());
+	threads.push_back(pThread);
+	return pThread;
+}
+
+/**
+@brief Create a row for zones which are not timed on a thread, e.g. on the GPU. Only one thread may add zones to it.
+@param pName A const char* variable containing the name of the row
+@return The ring buffer of the row
+*/
+CProfileThread* CProfiler::CreateTrack(const char* pName)
+{
+	std::lock_guard<std::mutex> lock(threadMutex);
+	CProfileThread* pTrack = new CProfileThread((unsigned int)threads.size());
+	pTrack->name = pName;
+	threads.push_back(pTrack);
+	return pTrack;
+}
+
+/**
+@brief Add a zone to a row created by CreateTrack()
+@param pTrack A CProfileThread* variable containing the row
+@param sEvent A const SProfileEvent& variable containing the zone. Its thread is set to the row.
+*/
+void CProfiler::AddTrackEvent(CProfileThread* pTrack, const SProfileEvent& sEvent)
+{
+	SProfileEvent sTrackEvent = sEvent;
+	sTrackEvent.uiThreadID = pTrack->uiThreadID;
+	pTrack->Push(sTrackEvent);
+}
+
+/**
+@brief Collect the zones of the frame which has just ended, from the ring buffers of all the threads.
+	   Call it once per frame, on the main thread.
+*/
+void CProfiler::EndFrame(void)
+{
+	const uint64_t uiNow = GetTime();
+
+	// The zones are collected into the vector of the frame before last, so that its memory is reused
+	std::vector<SProfileEvent>& events = drainEvents;
+	events.clear();
+	{
+		std::lock_guard<std::mutex> lock(threadMutex);
+		for (size_t i = 0; i < threads.size(); i++)
+		{
+			threads[i]->Drain(events);
+		}
+	}
+
+	if (bCapturing)
+	{
+		if (captureEvents.size() + events.size() > MAX_CAPTURE_EVENTS)
+		{
+			cout << "CProfiler: The capture is full, so it is stopped" << endl;
+			StopCapture();
+		}
+		else
+		{
+			captureEvents.insert(captureEvents.end(), events.begin(), events.end());
+		}
+	}
+
+	if (!bPaused)
+	{
+		frameEvents.swap(events);
+		uiFrameStart = uiFrameEnd;
+		uiFrameEnd = uiNow;
+	}
+}
+
+/**
+@brief Start to keep the zones of each frame, until StopCapture() is called
+@param filename A const std::string& variable containing the name of the file which the capture is written into
+@return true if the capture has started, otherwise false
+*/
+bool CProfiler::StartCapture(const std::string& filename)
+{
+	if (!IsEnabled())
+	{
+		cout << "CProfiler: The zones are not timed in this build. Build it with ENABLE_PROFILER." << endl;
+		return false;
+	}
+	if (bCapturing)
+	{
+		cout << "CProfiler: A capture is already running into " << captureFilename << endl;
+		return false;
+	}
+
+	captureFilename = filename;
+	captureEvents.clear();
+	bCapturing = true;
+	uiCaptureStart = GetTime();
+	return true;
+}
+
+/**
+@brief Stop the capture and write its zones into its file, in the Chrome trace format
+@return true if the file was written, otherwise false
+*/
+bool CProfiler::StopCapture(void)
+{
+	if (!bCapturing)
+		return false;
+	bCapturing = false;
+
+	const bool bResult = WriteCapture();
+	if (bResult)
+		cout << "CProfiler: Wrote " << captureEvents.size() << " zones into " << captureFilename << endl;
+
+	captureEvents.clear();
+	captureEvents.shrink_to_fit();
+	return bResult;
+}
+
+/**
+@brief Check if a capture is running
+*/
+bool CProfiler::IsCapturing(void) const
+{
+	return bCapturing;
+}
+
+/**
+@brief Get the number of zones in the last frame
+*/
+size_t CProfiler::GetNumFrameEvents(void) const
+{
+	return frameEvents.size();
+}
+
+/**
+@brief Get the number of zones dropped as a ring buffer was full
+*/
+unsigned int CProfiler::GetNumDropped(void) const
+{
+	unsigned int uiNumDropped = 0;
+	std::lock_guard<std::mutex> lock(threadMutex);
+	for (size_t i = 0; i < threads.size(); i++)
+	{
+		uiNumDropped += threads[i]->uiNumDropped.load(std::memory_order_relaxed);
+	}
+	return uiNumDropped;
+}
+
+/**
+@brief Write the zones of the capture into its file, as complete events ("ph":"X") with their times in microseconds
+@return true if the file was written, otherwise false
+*/
+bool CProfiler::WriteCapture(void) const
+{
+	std::ofstream outputFile(captureFilename.c_str(), std::ios::binary);
+	if (!outputFile)
+	{
+		cout << "CProfiler: Unable to open " << captureFilename << endl;
+		return false;
+	}
+
+	outputFile << fixed << setprecision(3) << "{\"traceEvents\":[\n";
+	{
+		std::lock_guard<std::mutex> lock(threadMutex);
+		for (size_t i = 0; i < threads.size(); i++)
+		{
+			outputFile << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threads[i]->uiThreadID
+				<< ",\"args\":{\"name\":\"" << threads[i]->name << "\"}},\n";
+		}
+	}
+	for (size_t i = 0; i < captureEvents.size(); i++)
+	{
+		const SProfileEvent& sEvent = captureEvents[i];
+		// A zone which started before the capture is cut at its start
+		const uint64_t uiStart = std::max(sEvent.uiStart, uiCaptureStart);
+		outputFile << "{\"name\":\"" << sEvent.pName << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << sEvent.uiThreadID
+			<< ",\"ts\":" << (uiStart - uiCaptureStart) / 1000.0
+			<< ",\"dur\":" << (sEvent.uiEnd - std::min(uiStart, sEvent.uiEnd)) / 1000.0
+			<< ((i + 1 < captureEvents.size()) ? "},\n" : "}\n");
+	}
+	outputFile << "],\"displayTimeUnit\":\"ms\"}\n";
+
+	if (!outputFile)
+	{
+		cout << "CProfiler: Unable to write " << captureFilename << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+@brief Show the zones of the last frame in a flame view, with one row of zones for each depth of each thread.
+	   Call it between ImGui::NewFrame() and ImGui::Render().
+*/
+void CProfiler::RenderImGui(void)
+{
+#ifndef HEADLESS
+	ImGui::SetNextWindowSize(ImVec2(600.0f, 300.0f), ImGuiCond_FirstUseEver);
+	ImGui::Begin("Profiler", NULL);
+
+	const double dFrameTime = (uiFrameEnd - uiFrameStart) / 1000000.0;
+	ImGui::Checkbox("Pause", &bPaused);
+	ImGui::SameLine();
+	if (ImGui::Button(bCapturing ? "Stop capture" : "Capture"))
+	{
+		if (bCapturing)
+			StopCapture();
+		else
+			StartCapture("Profile.json");
+	}
+	ImGui::SameLine();
+	ImGui::Text("Frame: %.3f ms, %u zones, %u dropped", dFrameTime, (unsigned int)frameEvents.size(), GetNumDropped());
+	if (!IsEnabled())
+		ImGui::TextColored(ImVec4(1, 1, 0, 1), "The zones are not timed in this build. Build it with ENABLE_PROFILER.");
+
+	const float fRowHeight = ImGui::GetTextLineHeight() + 4.0f;
+	const ImVec2 vec2Origin = ImGui::GetCursorScreenPos();
+	const float fWidth = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+	const double dScale = (uiFrameEnd > uiFrameStart) ? fWidth / (double)(uiFrameEnd - uiFrameStart) : 0.0;
+	const ImVec2 vec2Mouse = ImGui::GetIO().MousePos;
+	ImDrawList* pDrawList = ImGui::GetWindowDrawList();
+
+	std::vector<std::pair<unsigned int, std::string> > threadNames;
+	{
+		std::lock_guard<std::mutex> lock(threadMutex);
+		for (size_t i = 0; i < threads.size(); i++)
+			threadNames.push_back(std::make_pair(threads[i]->uiThreadID, threads[i]->name));
+	}
+
+	float fY = vec2Origin.y;
+	for (size_t iThread = 0; iThread < threadNames.size(); iThread++)
+	{
+		// Leave out the threads which had no zones in this frame
+		unsigned int uiNumRows = 0;
+		for (size_t i = 0; i < frameEvents.size(); i++)
+		{
+			if (frameEvents[i].uiThreadID == threadNames[iThread].first)
+				uiNumRows = std::max(uiNumRows, frameEvents[i].uiDepth + 1);
+		}
+		if (uiNumRows == 0)
+			continue;
+
+		pDrawList->AddText(ImVec2(vec2Origin.x, fY), IM_COL32(200, 200, 200, 255), threadNames[iThread].second.c_str());
+		fY += fRowHeight;
+
+		for (size_t i = 0; i < frameEvents.size(); i++)
+		{
+			const SProfileEvent& sEvent = frameEvents[i];
+			if (sEvent.uiThreadID != threadNames[iThread].first)
+				continue;
+
+			// Cut the zones which started in the frame before
+			const uint64_t uiStart = std::max(sEvent.uiStart, uiFrameStart);
+			const float fX0 = vec2Origin.x + (float)((uiStart - uiFrameStart) * dScale);
+			const float fX1 = std::max(vec2Origin.x + (float)((sEvent.uiEnd - uiFrameStart) * dScale), fX0 + 1.0f);
+			const float fY0 = fY + sEvent.uiDepth * fRowHeight;
+			const ImVec2 vec2Min(fX0, fY0), vec2Max(fX1, fY0 + fRowHeight - 1.0f);
+
+			// Each name keeps the same colour from frame to frame
+			const uintptr_t uiHash = ((uintptr_t)sEvent.pName >> 3) * 2654435761u;
+			const ImU32 colour = IM_COL32(80 + (uiHash & 0x7F), 80 + ((uiHash >> 8) & 0x7F), 80 + ((uiHash >> 16) & 0x7F), 255);
+			pDrawList->AddRectFilled(vec2Min, vec2Max, colour);
+			pDrawList->AddRect(vec2Min, vec2Max, IM_COL32(0, 0, 0, 128));
+			if (fX1 - fX0 > ImGui::CalcTextSize(sEvent.pName).x + 4.0f)
+				pDrawList->AddText(ImVec2(fX0 + 2.0f, fY0 + 2.0f), IM_COL32(0, 0, 0, 255), sEvent.pName);
+
+			if ((vec2Mouse.x >= fX0) && (vec2Mouse.x < fX1) && (vec2Mouse.y >= fY0) && (vec2Mouse.y < vec2Max.y)
+				&& ImGui::IsWindowHovered())
+			{
+				ImGui::SetTooltip("%s: %.3f ms", sEvent.pName, (sEvent.uiEnd - sEvent.uiStart) / 1000000.0);
+			}
+		}
+		fY += uiNumRows * fRowHeight + 4.0f;
+	}
+	ImGui::Dummy(ImVec2(fWidth, std::max(fY - vec2Origin.y, 1.0f)));
+
+	ImGui::End();
+#endif
+}
@@ -0,0 +1,228 @@
+/**
+ CProfiler
+ @brief A class to time nested zones of code on every thread. A zone is timed by PROFILE_ZONE, which writes it
+		into a ring buffer of its thread when it ends. Each ring buffer has one writer, its thread, and one reader,
+		EndFrame(), so no lock is taken while timing. The zones of the last frame are shown in a flame view in
+		ImGui, and the zones of a capture are written into a file in the Chrome trace format, which can be
+		opened in chrome://tracing or ui.perfetto.dev.
+		The zones are only timed when ENABLE_PROFILER is defined. Otherwise the macros are empty, and cost nothing.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+// Include SingletonTemplate
+#include "../DesignPatterns/SingletonTemplate.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef ENABLE_PROFILER
+	#define PROFILE_JOIN_NAME(a, b) a##b
+	#define PROFILE_MAKE_NAME(a, b) PROFILE_JOIN_NAME(a, b)
+	// Time the rest of this scope. The name must be a string literal, as only its address is kept.
+	#define PROFILE_ZONE(name) CProfileZone PROFILE_MAKE_NAME(cProfileZone, __LINE__)(name)
+	// Name the calling thread in the flame view and in the captures
+	#define PROFILE_THREAD(name) CProfiler::SetThreadName(name)
+	// Collect the zones of the frame which has just ended
+	#define PROFILE_END_FRAME() CProfiler::GetInstance()->EndFrame()
+#else
+	#define PROFILE_ZONE(name)
+	#define PROFILE_THREAD(name)
+	#define PROFILE_END_FRAME()
+#endif
+
+// A zone which has ended
+struct SProfileEvent
+{
+	// The name of the zone
+	const char* pName;
+	// The start and the end of the zone, in nanoseconds
+	uint64_t uiStart;
+	uint64_t uiEnd;
+	// The number of zones which this zone is inside
+	unsigned int uiDepth;
+	// The index of the thread which timed this zone
+	unsigned int uiThreadID;
+};
+
+/**
+ CProfileThread
+ @brief The ring buffer of the zones of one thread. Only its thread writes into it, and only EndFrame() reads from it.
+ */
+class CProfileThread
+{
+	friend class CProfiler;
+	friend class CProfileZone;
+public:
+	// The number of zones which a thread can time between two calls to EndFrame(). It must be a power of 2.
+	enum { BUFFER_SIZE = 16384 };
+
+	// Constructor
+	CProfileThread(const unsigned int uiThreadID);
+
+	// Destructor
+	~CProfileThread(void);
+
+	// Add a zone which has ended. The zone is dropped if the ring buffer is full.
+	void Push(const SProfileEvent& sEvent);
+
+	// Move the zones in the ring buffer into a vector
+	void Drain(std::vector<SProfileEvent>& events);
+
+protected:
+	// The zones
+	SProfileEvent arrEvents[BUFFER_SIZE];
+	// The number of zones written and read so far. Only the thread writes uiWriteIndex, and only EndFrame() writes uiReadIndex.
+	std::atomic<uint32_t> uiWriteIndex;
+	std::atomic<uint32_t> uiReadIndex;
+	// The number of zones dropped as the ring buffer was full
+	std::atomic<uint32_t> uiNumDropped;
+
+	// The number of zones which the thread is inside now
+	unsigned int uiDepth;
+	// The index of the thread
+	unsigned int uiThreadID;
+	// The name of the thread. It is protected by the mutex of the CProfiler.
+	std::string name;
+
+private:
+	// A ring buffer is shared by address, so it cannot be copied
+	CProfileThread(const CProfileThread&);
+	CProfileThread& operator=(const CProfileThread&);
+};
+
+class CProfiler : public CSingletonTemplate<CProfiler>
+{
+	friend CSingletonTemplate<CProfiler>;
+public:
+	// Get the ring buffer of the calling thread, which is created the first time that the thread times a zone
+	static CProfileThread* GetThread(void);
+
+	// Name the calling thread
+	static void SetThreadName(const char* pName);
+
+	// Get the time now, in nanoseconds
+	static uint64_t GetTime(void);
+
+	// Check if the zones are timed in this build
+	static bool IsEnabled(void);
+
+	// Create a row for zones which are not timed on a thread, e.g. on the GPU. Only one thread may add zones to it.
+	CProfileThread* CreateTrack(const char* pName);
+	// Add a zone to a row created by CreateTrack()
+	void AddTrackEvent(CProfileThread* pTrack, const SProfileEvent& sEvent);
+
+	// Collect the zones of the frame which has just ended, from the ring buffers of all the threads
+	void EndFrame(void);
+
+	// Start to keep the zones of each frame, until StopCapture() is called
+	bool StartCapture(const std::string& filename);
+	// Stop the capture and write its zones into the file, in the Chrome trace format
+	bool StopCapture(void);
+	// Check if a capture is running
+	bool IsCapturing(void) const;
+
+	// Get the number of zones in the last frame
+	size_t GetNumFrameEvents(void) const;
+	// Get the number of zones dropped as a ring buffer was full
+	unsigned int GetNumDropped(void) const;
+
+	// Show the zones of the last frame in a flame view
+	void RenderImGui(void);
+
+protected:
+	// Constructor
+	CProfiler(void);
+
+	// Destructor
+	virtual ~CProfiler(void);
+
+	// Create the ring buffer of the calling thread
+	CProfileThread* RegisterThread(void);
+
+	// Write the zones of the capture into its file
+	bool WriteCapture(void) const;
+
+	// The ring buffer of the calling thread
+	static thread_local CProfileThread* pCurrentThread;
+
+	// Protects threads and the names of the threads
+	mutable std::mutex threadMutex;
+	// The ring buffers of all the threads which have timed a zone
+	std::vector<CProfileThread*> threads;
+
+	// The zones of the last frame, and when it started and ended
+	std::vector<SProfileEvent> frameEvents;
+	uint64_t uiFrameStart;
+	uint64_t uiFrameEnd;
+	// The zones being collected by EndFrame()
+	std::vector<SProfileEvent> drainEvents;
+
+	// The zones of the capture, and the file which they are written into
+	std::vector<SProfileEvent> captureEvents;
+	std::string captureFilename;
+	bool bCapturing;
+	uint64_t uiCaptureStart;
+
+	// Keep showing the same frame in the flame view
+	bool bPaused;
+};
+
+/**
+ CProfileZone
+ @brief Times a zone, from when it is created until it is destroyed. Use it through PROFILE_ZONE.
+ */
+class CProfileZone
+{
+public:
+	// Constructor
+	explicit CProfileZone(const char* pName)
+		: pName(pName)
+		, pThread(CProfiler::GetThread())
+	{
+		uiDepth = pThread->uiDepth++;
+		uiStart = CProfiler::GetTime();
+	}
+
+	// Destructor
+	~CProfileZone(void)
+	{
+		const SProfileEvent sEvent = { pName, uiStart, CProfiler::GetTime(), uiDepth, pThread->uiThreadID };
+		pThread->uiDepth--;
+		pThread->Push(sEvent);
+	}
+
+protected:
+	const char* pName;
+	CProfileThread* pThread;
+	uint64_t uiStart;
+	unsigned int uiDepth;
+
+private:
+	CProfileZone(const CProfileZone&);
+	CProfileZone& operator=(const CProfileZone&);
+};
+
+/**
+@brief Get the time now, in nanoseconds
+*/
+inline uint64_t CProfiler::GetTime(void)
+{
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+@brief Get the ring buffer of the calling thread
+*/
+inline CProfileThread* CProfiler::GetThread(void)
+{
+	if (pCurrentThread == nullptr)
+		pCurrentThread = GetInstance()->RegisterThread();
+	return pCurrentThread;
+}
@@ -6,24 +6,33 @@
  */
 #include "StopWatch.h"
 
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
 #define TARGET_RESOLUTION 1         // 1-millisecond target resolution
 
 /**
 @brief Constructor
 */
 CStopWatch::CStopWatch(void)
+	: dSpinTime(0.002)
+	, wTimerRes(0)
 {
-	QueryPerformanceFrequency(&frequency);
-
+#ifdef _WIN32
+	// Ask Windows to wake up sleeping threads every millisecond, instead of every 15.6 milliseconds
 	TIMECAPS tc;
 
-	if (timeGetDevCaps(&tc, sizeof(TIMECAPS)) != TIMERR_NOERROR)
+	if (timeGetDevCaps(&tc, sizeof(TIMECAPS)) == TIMERR_NOERROR)
 	{
-		// Error; application can't continue.
+		wTimerRes = min(max(tc.wPeriodMin, TARGET_RESOLUTION), tc.wPeriodMax);
+		timeBeginPeriod(wTimerRes);
 	}
+#endif
 
-	wTimerRes = min(max(tc.wPeriodMin, TARGET_RESOLUTION), tc.wPeriodMax);
-	timeBeginPeriod(wTimerRes);
+	prevTime = currTime = Clock::now();
 }
 
 /**
@@ -37,9 +46,9 @@ CStopWatch::~CStopWatch(void)
 /**
 @brief Initialise this class instance
 */
-void Init(void)
+void CStopWatch::Init(void)
 {
-
+	prevTime = currTime = Clock::now();
 }
 
 /**
@@ -47,7 +56,7 @@ void Init(void)
 */ 
 void CStopWatch::StartTimer(void)
 {
-	QueryPerformanceCounter(&prevTime);
+	prevTime = Clock::now();
 }
 
 
@@ -56,7 +65,13 @@ void CStopWatch::StartTimer(void)
  */
 void CStopWatch::StopTimer(void)
 {
-	timeEndPeriod(wTimerRes);
+#ifdef _WIN32
+	if (wTimerRes != 0)
+	{
+		timeEndPeriod(wTimerRes);
+		wTimerRes = 0;
+	}
+#endif
 }
 
 /**
@@ -64,37 +79,57 @@ void CStopWatch::StopTimer(void)
  */ 
 double CStopWatch::GetElapsedTime(void)
 {
-	LARGE_INTEGER time;
-	QueryPerformanceCounter(&currTime);
-	time.QuadPart = currTime.QuadPart - prevTime.QuadPart;
+	currTime = Clock::now();
+	const double dTime = std::chrono::duration<double>(currTime - prevTime).count();
 	prevTime = currTime;
-	return LIToSecs(time);
+	return dTime;
+}
+
+/**
+ @brief Get the time in seconds since the last call to GetElapsedTime(), without restarting it
+ */
+double CStopWatch::PeekElapsedTime(void) const
+{
+	return std::chrono::duration<double>(Clock::now() - prevTime).count();
 }
 
 /**
  @brief Wait until this time in milliseconds has passed
+ @param llTime A const long long variable containing the time in milliseconds since the last call to GetElapsedTime()
  */
 void CStopWatch::WaitUntil(const long long llTime)
 {
-	LARGE_INTEGER nowTime;
-	LONGLONG timeElapsed;
-	while (true)
+	WaitUntilTime(llTime * 0.001);
+}
+
+/**
+ @brief Wait until this time in seconds has passed since the last call to GetElapsedTime().
+		It sleeps until shortly before the deadline, then spins for the rest, so that it does not overshoot.
+ @param dTime A const double variable containing the time in seconds
+ */
+void CStopWatch::WaitUntilTime(const double dTime)
+{
+	const Clock::time_point deadline = prevTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(dTime));
+
+	// Sleep in short steps while the deadline is far away
+	const Clock::duration spinTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(dSpinTime));
+	while (deadline - Clock::now() > spinTime)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	// Spin for the rest
+	while (Clock::now() < deadline)
 	{
-		QueryPerformanceCounter(&nowTime);
-		timeElapsed = ((nowTime.QuadPart - prevTime.QuadPart) * 1000 / frequency.QuadPart);
-		if (timeElapsed > llTime)
-			return;
-		else if (llTime - timeElapsed > 1)
-			Sleep(1);
+		std::this_thread::yield();
 	}
 }
 
 /**
- @brief Convert from Large Integer to seconds in double
- @param L A LARGE_INTEGER & containing the time value
- @return The time in seconds unit and in double data type
+ @brief Set the time in seconds before a deadline when WaitUntilTime() stops sleeping and spins instead
+ @param dSpinTime A const double variable containing the time in seconds
  */
-double CStopWatch::LIToSecs(LARGE_INTEGER & L)
+void CStopWatch::SetSpinTime(const double dSpinTime)
 {
-	return ((double)L.QuadPart / (double)frequency.QuadPart);
+	this->dSpinTime = dSpinTime;
 }
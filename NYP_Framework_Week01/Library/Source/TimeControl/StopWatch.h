@@ -6,7 +6,7 @@
  */
 #pragma once
 
-#include <windows.h>
+#include <chrono>
 
 class CStopWatch
 {
@@ -29,14 +29,27 @@ public:
 	// Get elapsed time in seconds since the last call to this function
 	double GetElapsedTime(void);
 
+	// Get the time in seconds since the last call to GetElapsedTime(), without restarting it
+	double PeekElapsedTime(void) const;
+
 	// Wait until this time in milliseconds has passed
 	void WaitUntil(const long long llTime);
 
+	// Wait until this time in seconds has passed since the last call to GetElapsedTime()
+	void WaitUntilTime(const double dTime);
+
+	// Set the time in seconds before a deadline when WaitUntilTime() stops sleeping and spins instead
+	void SetSpinTime(const double dSpinTime);
+
 protected:
-	LARGE_INTEGER frequency;
-	LARGE_INTEGER prevTime, currTime;
-	UINT     wTimerRes;
+	typedef std::chrono::steady_clock Clock;
+
+	Clock::time_point prevTime, currTime;
+
+	// The time in seconds before a deadline when WaitUntilTime() stops sleeping and spins,
+	// as the operating system may wake up a thread a millisecond or more after asked to
+	double dSpinTime;
 
-	// Convert from Large Integer to seconds in double
-	double LIToSecs(LARGE_INTEGER & L);
+	// The resolution in milliseconds of the Windows timer, which is set while this instance exists
+	unsigned int wTimerRes;
 };
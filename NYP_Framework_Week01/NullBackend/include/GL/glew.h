@@ -0,0 +1,181 @@
+/**
+ Null GLEW
+ @brief A stand-in for GL/glew.h in the HEADLESS build. It declares the OpenGL types, constants and
+		functions used by the Library and the App, and the functions do nothing, so that the game logic
+		can be built and run without a graphics card, a window or the GLEW library.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+#include <cstddef>
+
+typedef unsigned int GLenum;
+typedef unsigned char GLboolean;
+typedef unsigned int GLbitfield;
+typedef void GLvoid;
+typedef signed char GLbyte;
+typedef unsigned char GLubyte;
+typedef short GLshort;
+typedef unsigned short GLushort;
+typedef int GLint;
+typedef unsigned int GLuint;
+typedef int GLsizei;
+typedef float GLfloat;
+typedef double GLdouble;
+typedef char GLchar;
+typedef std::ptrdiff_t GLintptr;
+typedef std::ptrdiff_t GLsizeiptr;
+typedef unsigned long long GLuint64;
+
+#define GL_FALSE						0
+#define GL_TRUE							1
+
+#define GL_LINES						0x0001
+#define GL_TRIANGLES					0x0004
+#define GL_TRIANGLE_STRIP				0x0005
+
+#define GL_SRC_ALPHA					0x0302
+#define GL_ONE_MINUS_SRC_ALPHA			0x0303
+#define GL_BLEND						0x0BE2
+#define GL_UNPACK_ROW_LENGTH			0x0CF2
+#define GL_TEXTURE_2D					0x0DE1
+
+#define GL_BYTE							0x1400
+#define GL_UNSIGNED_BYTE				0x1401
+#define GL_INT							0x1404
+#define GL_UNSIGNED_INT					0x1405
+#define GL_FLOAT						0x1406
+
+#define GL_RGB							0x1907
+#define GL_RGBA							0x1908
+#define GL_LUMINANCE					0x1909
+
+#define GL_LINEAR						0x2601
+#define GL_TEXTURE_MAG_FILTER			0x2800
+#define GL_TEXTURE_MIN_FILTER			0x2801
+#define GL_TEXTURE_WRAP_S				0x2802
+#define GL_TEXTURE_WRAP_T				0x2803
+#define GL_CLAMP_TO_EDGE				0x812F
+#define GL_TEXTURE0						0x84C0
+
+#define GL_QUERY_RESULT					0x8866
+#define GL_QUERY_RESULT_AVAILABLE		0x8867
+#define GL_ARRAY_BUFFER					0x8892
+#define GL_ELEMENT_ARRAY_BUFFER			0x8893
+#define GL_TIME_ELAPSED					0x88BF
+#define GL_STREAM_DRAW					0x88E0
+#define GL_STATIC_DRAW					0x88E4
+#define GL_DYNAMIC_DRAW					0x88E8
+
+#define GL_FLOAT_VEC2					0x8B50
+#define GL_FLOAT_VEC3					0x8B51
+#define GL_FLOAT_VEC4					0x8B52
+#define GL_BOOL							0x8B56
+#define GL_FLOAT_MAT2					0x8B5A
+#define GL_FLOAT_MAT3					0x8B5B
+#define GL_FLOAT_MAT4					0x8B5C
+#define GL_SAMPLER_2D					0x8B5E
+#define GL_SAMPLER_CUBE					0x8B60
+#define GL_SAMPLER_2D_ARRAY				0x8DC1
+
+#define GL_FRAGMENT_SHADER				0x8B30
+#define GL_VERTEX_SHADER				0x8B31
+#define GL_GEOMETRY_SHADER				0x8DD9
+#define GL_COMPILE_STATUS				0x8B81
+#define GL_LINK_STATUS					0x8B82
+#define GL_ACTIVE_UNIFORMS				0x8B86
+#define GL_ACTIVE_UNIFORM_MAX_LENGTH	0x8B87
+
+
+
+// Returns a new name for a buffer, texture, shader or program, so that the callers which check for 0 still work
+inline GLuint glNullGenName(void)
+{
+	static GLuint uiNextName = 0;
+	return ++uiNextName;
+}
+
+inline void glNullGenNames(GLsizei n, GLuint* names)
+{
+	for (GLsizei i = 0; i < n; i++)
+		names[i] = glNullGenName();
+}
+
+
+// Objects
+inline void glGenVertexArrays(GLsizei n, GLuint* arrays) { glNullGenNames(n, arrays); }
+inline void glGenBuffers(GLsizei n, GLuint* buffers) { glNullGenNames(n, buffers); }
+inline void glGenTextures(GLsizei n, GLuint* textures) { glNullGenNames(n, textures); }
+inline void glDeleteVertexArrays(GLsizei, const GLuint*) {}
+inline void glDeleteBuffers(GLsizei, const GLuint*) {}
+inline void glDeleteTextures(GLsizei, const GLuint*) {}
+inline void glBindVertexArray(GLuint) {}
+inline void glBindBuffer(GLenum, GLuint) {}
+inline void glBindTexture(GLenum, GLuint) {}
+inline void glActiveTexture(GLenum) {}
+
+// Buffers and vertex attributes
+inline void glBufferData(GLenum, GLsizeiptr, const void*, GLenum) {}
+inline void glBufferSubData(GLenum, GLintptr, GLsizeiptr, const void*) {}
+inline void glVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {}
+inline void glEnableVertexAttribArray(GLuint) {}
+inline void glDisableVertexAttribArray(GLuint) {}
+
+// Textures
+inline void glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*) {}
+inline void glTexParameteri(GLenum, GLenum, GLint) {}
+inline void glGenerateMipmap(GLenum) {}
+inline void glPixelStorei(GLenum, GLint) {}
+
+// Queries. Every query is ready at once, and took no time.
+inline void glGenQueries(GLsizei n, GLuint* ids) { glNullGenNames(n, ids); }
+inline void glDeleteQueries(GLsizei, const GLuint*) {}
+inline void glBeginQuery(GLenum, GLuint) {}
+inline void glEndQuery(GLenum) {}
+inline void glGetQueryObjectiv(GLuint, GLenum pname, GLint* params) { *params = (pname == GL_QUERY_RESULT_AVAILABLE) ? GL_TRUE : 0; }
+inline void glGetQueryObjectui64v(GLuint, GLenum, GLuint64* params) { *params = 0; }
+
+// State and drawing
+inline void glEnable(GLenum) {}
+inline void glDisable(GLenum) {}
+inline void glBlendFunc(GLenum, GLenum) {}
+inline void glDrawElements(GLenum, GLsizei, GLenum, const void*) {}
+inline void glDrawElementsBaseVertex(GLenum, GLsizei, GLenum, const void*, GLint) {}
+inline void glDrawArrays(GLenum, GLint, GLsizei) {}
+
+// Shaders and programs. Every shader compiles and every program links.
+inline GLuint glCreateShader(GLenum) { return glNullGenName(); }
+inline GLuint glCreateProgram(void) { return glNullGenName(); }
+inline void glShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) {}
+inline void glCompileShader(GLuint) {}
+inline void glAttachShader(GLuint, GLuint) {}
+inline void glLinkProgram(GLuint) {}
+inline void glDeleteShader(GLuint) {}
+inline void glDeleteProgram(GLuint) {}
+inline void glUseProgram(GLuint) {}
+inline void glGetShaderiv(GLuint, GLenum pname, GLint* params) { *params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0; }
+inline void glGetProgramiv(GLuint, GLenum pname, GLint* params) { *params = (pname == GL_LINK_STATUS) ? GL_TRUE : 0; }
+inline void glGetShaderInfoLog(GLuint, GLsizei, GLsizei* length, GLchar* infoLog) { if (length) *length = 0; if (infoLog) infoLog[0] = '\0'; }
+inline void glGetProgramInfoLog(GLuint, GLsizei, GLsizei* length, GLchar* infoLog) { if (length) *length = 0; if (infoLog) infoLog[0] = '\0'; }
+inline void glGetActiveUniform(GLuint, GLuint, GLsizei, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+	if (length) *length = 0;
+	if (size) *size = 0;
+	if (type) *type = 0;
+	if (name) name[0] = '\0';
+}
+
+// Uniforms
+inline GLint glGetUniformLocation(GLuint, const GLchar*) { return -1; }
+inline void glUniform1i(GLint, GLint) {}
+inline void glUniform1f(GLint, GLfloat) {}
+inline void glUniform2f(GLint, GLfloat, GLfloat) {}
+inline void glUniform3f(GLint, GLfloat, GLfloat, GLfloat) {}
+inline void glUniform4f(GLint, GLfloat, GLfloat, GLfloat, GLfloat) {}
+inline void glUniform2fv(GLint, GLsizei, const GLfloat*) {}
+inline void glUniform3fv(GLint, GLsizei, const GLfloat*) {}
+inline void glUniform4fv(GLint, GLsizei, const GLfloat*) {}
+inline void glUniformMatrix2fv(GLint, GLsizei, GLboolean, const GLfloat*) {}
+inline void glUniformMatrix3fv(GLint, GLsizei, GLboolean, const GLfloat*) {}
+inline void glUniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat*) {}
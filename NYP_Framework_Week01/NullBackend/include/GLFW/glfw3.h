@@ -0,0 +1,75 @@
+/**
+ Null GLFW
+ @brief A stand-in for GLFW/glfw3.h in the HEADLESS build. It declares the key codes and the few functions
+		used by the game logic, so that it can be built and run without a window or the GLFW library.
+ By: agent
+ Date: Oct 2026
+ */
+#pragma once
+
+#include <chrono>
+
+typedef struct GLFWwindow GLFWwindow;
+
+#define GLFW_RELEASE				0
+#define GLFW_PRESS					1
+#define GLFW_REPEAT					2
+
+#define GLFW_MOUSE_BUTTON_LEFT		0
+#define GLFW_MOUSE_BUTTON_RIGHT		1
+#define GLFW_MOUSE_BUTTON_MIDDLE	2
+#define GLFW_MOUSE_BUTTON_LAST		7
+
+#define GLFW_KEY_SPACE				32
+#define GLFW_KEY_0					48
+#define GLFW_KEY_1					49
+#define GLFW_KEY_2					50
+#define GLFW_KEY_3					51
+#define GLFW_KEY_4					52
+#define GLFW_KEY_5					53
+#define GLFW_KEY_6					54
+#define GLFW_KEY_7					55
+#define GLFW_KEY_8					56
+#define GLFW_KEY_9					57
+#define GLFW_KEY_A					65
+#define GLFW_KEY_B					66
+#define GLFW_KEY_C					67
+#define GLFW_KEY_D					68
+#define GLFW_KEY_E					69
+#define GLFW_KEY_F					70
+#define GLFW_KEY_G					71
+#define GLFW_KEY_H					72
+#define GLFW_KEY_I					73
+#define GLFW_KEY_J					74
+#define GLFW_KEY_K					75
+#define GLFW_KEY_L					76
+#define GLFW_KEY_M					77
+#define GLFW_KEY_N					78
+#define GLFW_KEY_O					79
+#define GLFW_KEY_P					80
+#define GLFW_KEY_Q					81
+#define GLFW_KEY_R					82
+#define GLFW_KEY_S					83
+#define GLFW_KEY_T					84
+#define GLFW_KEY_U					85
+#define GLFW_KEY_V					86
+#define GLFW_KEY_W					87
+#define GLFW_KEY_X					88
+#define GLFW_KEY_Y					89
+#define GLFW_KEY_Z					90
+#define GLFW_KEY_ESCAPE				256
+#define GLFW_KEY_ENTER				257
+#define GLFW_KEY_TAB				258
+#define GLFW_KEY_RIGHT				262
+#define GLFW_KEY_LEFT				263
+#define GLFW_KEY_DOWN				264
+#define GLFW_KEY_UP					265
+#define GLFW_KEY_LEFT_SHIFT			340
+#define GLFW_KEY_LAST				348
+
+// The time in seconds since the first call
+inline double glfwGetTime(void)
+{
+	static const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+}